@@ -640,12 +640,16 @@ inline void setupObjects()
         HelioCalibrationData windSpeedCalib(windSpeedSensor->getId(), Helio_UnitsType_Speed_MetersPerMin);
         windSpeedCalib.setFromTwoPoints(SETUP_WIND_SPEED_SENSOR_SCALE);
         windSpeedSensor->setUserCalibrationData(&windSpeedCalib);
+        windSpeedSensor->setMeasurementHistory(HELIO_SENSOR_HISTORY_DEFSIZE);
         trackingPanel->setWindSpeedSensor(windSpeedSensor);
-        trackingPanel->setStormingTrigger(new HelioMeasurementValueTrigger(windSpeedSensor, SETUP_PANEL_STORMING_SPEED, ACT_ABOVE, 0, SETUP_PANEL_STORMING_SPEED * 0.1f, 30000));
+        auto stormingTrigger = new HelioMeasurementValueTrigger(windSpeedSensor, SETUP_PANEL_STORMING_SPEED, ACT_ABOVE, 0, SETUP_PANEL_STORMING_SPEED * 0.1f, 30000);
+        stormingTrigger->setMeasurementStat(Helio_MeasurementStat_Mean); // rides out single gusts
+        trackingPanel->setStormingTrigger(stormingTrigger);
     }
     #endif
     #if SETUP_DHT_AIR_TEMP_HUMID_PIN >= 0
     {   auto dhtTemperatureSensor = helioController.addDHTTempHumiditySensor(SETUP_DHT_AIR_TEMP_HUMID_PIN, JOIN(Helio_DHTType,SETUP_DHT_SENSOR_TYPE));
+        dhtTemperatureSensor->setPollingPolicy(Helio_PollingPolicy_Adaptive, 1, HELIO_SENSOR_POLLING_MAXFRAMES, 0.5f); // air temp drifts slowly
         trackingPanel->setTemperatureSensor(dhtTemperatureSensor);
         #if !(SETUP_ICE_INDICATOR_PIN >= 0)
             trackingPanel->setHeatingTrigger(new HelioMeasurementValueTrigger(dhtTemperatureSensor, SETUP_PANEL_HEATER_TEMP, ACT_BELOW));
@@ -0,0 +1,173 @@
+/*  Helioduino: Simple automation controller for solar tracking systems.
+    Copyright (C) 2023 NachtRaveVL          <nachtravevl@gmail.com>
+    Helioduino Binary Data File to CSV Converter (host-side tool)
+*/
+
+// Converts binary .dat data files written by HelioPublisher (see HelioBinaryDataWriter) into the
+// same .csv layout the publisher otherwise writes. Optionally limits output to a time range, in
+// which case the time index footer (if present) is used to seek to the nearest prior keyframe.
+// Build: g++ -O2 -o HelioDataToCSV HelioDataToCSV.cpp
+// Usage: HelioDataToCSV <input.dat> [output.csv] [--from <unixtime>] [--to <unixtime>] [--info]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct Column {
+    uint32_t sensorKey;
+    uint8_t measurementRow;
+    int8_t units;
+    std::string title;
+};
+
+struct IndexEntry {
+    uint32_t timestamp;
+    uint32_t offset;
+};
+
+static bool readBytes(FILE *file, void *buffer, size_t length)
+{
+    return fread(buffer, 1, length, file) == length;
+}
+
+static uint32_t getLE(const uint8_t *buffer, int byteCount)
+{
+    uint32_t value = 0;
+    for (int byteIndex = 0; byteIndex < byteCount; ++byteIndex) { value |= (uint32_t)buffer[byteIndex] << (8 * byteIndex); }
+    return value;
+}
+
+static float getFloatLE(const uint8_t *buffer)
+{
+    uint32_t bits = getLE(buffer, 4);
+    float value; memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static bool readHeader(FILE *file, std::vector<Column> &columns)
+{
+    uint8_t buffer[8];
+    if (!readBytes(file, buffer, 5) || memcmp(buffer, "HDB", 3) != 0) {
+        fprintf(stderr, "Not a Helioduino binary data file\n");
+        return false;
+    }
+    if (buffer[3] != 1) {
+        fprintf(stderr, "Unsupported format version %d\n", buffer[3]);
+        return false;
+    }
+
+    columns.resize(buffer[4]);
+    for (auto &column : columns) {
+        if (!readBytes(file, buffer, 7)) { return false; }
+        column.sensorKey = getLE(buffer, 4);
+        column.measurementRow = buffer[4];
+        column.units = (int8_t)buffer[5];
+        column.title.resize(buffer[6]);
+        if (buffer[6] && !readBytes(file, &column.title[0], buffer[6])) { return false; }
+    }
+    return true;
+}
+
+static bool readIndex(FILE *file, std::vector<IndexEntry> &index)
+{
+    uint8_t buffer[8];
+    if (fseek(file, -8, SEEK_END) != 0 || !readBytes(file, buffer, 8) || memcmp(buffer + 4, "HDBX", 4) != 0) { return false; }
+    if (fseek(file, (long)getLE(buffer, 4), SEEK_SET) != 0 || !readBytes(file, buffer, 2) || buffer[0] != 'X') { return false; }
+
+    index.resize(buffer[1]);
+    for (auto &entry : index) {
+        if (!readBytes(file, buffer, 8)) { index.clear(); return false; }
+        entry.timestamp = getLE(buffer, 4);
+        entry.offset = getLE(buffer + 4, 4);
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *inputPath = nullptr, *outputPath = nullptr;
+    uint32_t fromTime = 0, toTime = UINT32_MAX;
+    bool infoOnly = false;
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex) {
+        if (!strcmp(argv[argIndex], "--from") && argIndex + 1 < argc) { fromTime = (uint32_t)strtoul(argv[++argIndex], nullptr, 10); }
+        else if (!strcmp(argv[argIndex], "--to") && argIndex + 1 < argc) { toTime = (uint32_t)strtoul(argv[++argIndex], nullptr, 10); }
+        else if (!strcmp(argv[argIndex], "--info")) { infoOnly = true; }
+        else if (!inputPath) { inputPath = argv[argIndex]; }
+        else if (!outputPath) { outputPath = argv[argIndex]; }
+    }
+    if (!inputPath) {
+        fprintf(stderr, "Usage: %s <input.dat> [output.csv] [--from <unixtime>] [--to <unixtime>] [--info]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *input = fopen(inputPath, "rb");
+    if (!input) { fprintf(stderr, "Cannot open %s\n", inputPath); return 1; }
+    FILE *output = outputPath ? fopen(outputPath, "w") : stdout;
+    if (!output) { fprintf(stderr, "Cannot open %s\n", outputPath); fclose(input); return 1; }
+
+    std::vector<Column> columns;
+    std::vector<IndexEntry> index;
+    if (!readHeader(input, columns)) { fclose(input); return 1; }
+    long dataOffset = ftell(input);
+    bool hasIndex = readIndex(input, index);
+
+    if (infoOnly) {
+        fprintf(output, "Columns: %d\n", (int)columns.size());
+        for (auto &column : columns) {
+            fprintf(output, "  %s (key: %08x, row: %d, units: %d)\n", column.title.c_str(), column.sensorKey, column.measurementRow, column.units);
+        }
+        fprintf(output, "Time index: %s, entries: %d\n", hasIndex ? "present" : "missing (unfinalized file)", (int)index.size());
+        for (auto &entry : index) { fprintf(output, "  %u @ %u\n", entry.timestamp, entry.offset); }
+        fclose(input); if (outputPath) { fclose(output); }
+        return 0;
+    }
+
+    long seekOffset = dataOffset;
+    for (auto &entry : index) {
+        if (entry.timestamp <= fromTime && (long)entry.offset >= dataOffset) { seekOffset = (long)entry.offset; }
+    }
+    fseek(input, seekOffset, SEEK_SET);
+
+    fprintf(output, "timestamp");
+    for (auto &column : columns) { fprintf(output, ",%s", column.title.c_str()); }
+    fprintf(output, "\n");
+
+    std::vector<uint8_t> values(4 * columns.size());
+    uint32_t timestamp = 0;
+    bool haveKeyframe = false;
+    uint8_t buffer[8];
+
+    while (readBytes(input, buffer, 1)) {
+        if (buffer[0] == 'K') {
+            if (!readBytes(input, buffer, 4)) { break; }
+            timestamp = getLE(buffer, 4);
+            haveKeyframe = true;
+        } else if (buffer[0] == 'D') {
+            if (!readBytes(input, buffer, 2)) { break; }
+            timestamp += getLE(buffer, 2);
+        } else if (buffer[0] == 'X') { // mid-file index footer, skip over
+            if (!readBytes(input, buffer, 1) || fseek(input, 8L * buffer[0] + 8, SEEK_CUR) != 0) { break; }
+            continue;
+        } else {
+            fprintf(stderr, "Corrupt record at offset %ld\n", ftell(input) - 1);
+            break;
+        }
+        if (values.size() && !readBytes(input, values.data(), values.size())) { break; } // truncated final row
+        if (!haveKeyframe || timestamp < fromTime) { continue; }
+        if (timestamp > toTime) { break; }
+
+        fprintf(output, "%u", timestamp);
+        for (size_t columnIndex = 0; columnIndex < columns.size(); ++columnIndex) {
+            fprintf(output, ",%.7g", getFloatLE(&values[4 * columnIndex]));
+        }
+        fprintf(output, "\n");
+    }
+
+    fclose(input);
+    if (outputPath) { fclose(output); }
+    return 0;
+}
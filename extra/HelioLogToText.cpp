@@ -0,0 +1,231 @@
+/*  Helioduino: Simple automation controller for solar tracking systems.
+    Copyright (C) 2023 NachtRaveVL          <nachtravevl@gmail.com>
+    Helioduino Binary Log File to Text Converter (host-side tool)
+*/
+
+// Converts binary .hlb log files written by HelioLogger (see HelioLogRecord) into the same .txt
+// log line layout the logger otherwise writes. Records store message string ids in place of
+// text, which are resolved against the firmware's own strings table read from its source tree
+// (HelioStrings.h/.cpp) - this must match the firmware that wrote the file, as string ids shift
+// when strings are added. Without it, string ids are printed as <#id>.
+// Build: g++ -O2 -o HelioLogToText HelioLogToText.cpp
+// Usage: HelioLogToText <input.hlb> [output.txt] [--strings <Helioduino src folder>]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+enum ArgType { ArgType_Int, ArgType_UInt, ArgType_Float, ArgType_String, ArgType_Key, ArgType_Text };
+static const uint8_t NameRecordType = 0x7F;
+static const uint16_t NoStringId = 0xFFFF;
+
+static std::vector<std::string> stringNames;                // HStr_ enum names, by string id
+static std::map<std::string, std::string> stringValues;     // String values, by HStr_ enum name
+static std::map<uint32_t, std::string> objectNames;         // Object display strings, by key
+
+static bool readFile(const std::string &path, std::string &contents)
+{
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) { return false; }
+    char buffer[4096];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) { contents.append(buffer, length); }
+    fclose(file);
+    return true;
+}
+
+// Reads string enum names (in order) from HelioStrings.h, and string values from HelioStrings.cpp
+static bool loadStrings(const std::string &srcFolder)
+{
+    std::string header, source;
+    if (!readFile(srcFolder + "/HelioStrings.h", header) || !readFile(srcFolder + "/HelioStrings.cpp", source)) {
+        fprintf(stderr, "Cannot read HelioStrings.h/.cpp from %s\n", srcFolder.c_str());
+        return false;
+    }
+
+    size_t pos = header.find("enum Helio_String");
+    size_t end = pos != std::string::npos ? header.find("};", pos) : std::string::npos;
+    if (end == std::string::npos) { return false; }
+    pos = header.find('{', pos) + 1;
+    while (pos < end) {
+        size_t nameBegin = header.find("HStr_", pos);
+        if (nameBegin == std::string::npos || nameBegin >= end) { break; }
+        size_t nameEnd = header.find_first_of(",\n ", nameBegin);
+        std::string name = header.substr(nameBegin, nameEnd - nameBegin);
+        if (name != "HStr_Count") { stringNames.push_back(name); }
+        pos = nameEnd;
+    }
+
+    for (pos = source.find("case HStr_"); pos != std::string::npos; pos = source.find("case HStr_", pos)) {
+        size_t nameEnd = source.find(':', pos);
+        std::string name = source.substr(pos + 5, nameEnd - pos - 5);
+        size_t valueBegin = source.find("{\"", nameEnd);
+        if (valueBegin == std::string::npos) { break; }
+        std::string value;
+        for (valueBegin += 2; valueBegin < source.size() && source[valueBegin] != '"'; ++valueBegin) {
+            if (source[valueBegin] == '\\' && valueBegin + 1 < source.size()) {
+                char escaped = source[++valueBegin];
+                value += escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped;
+            } else {
+                value += source[valueBegin];
+            }
+        }
+        stringValues[name] = value;
+        pos = valueBegin;
+    }
+
+    return stringNames.size() > 0;
+}
+
+static std::string stringForId(uint16_t stringId)
+{
+    if (stringId < stringNames.size()) {
+        auto valueIter = stringValues.find(stringNames[stringId]);
+        if (valueIter != stringValues.end()) { return valueIter->second; }
+    }
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "<#%u>", stringId);
+    return buffer;
+}
+
+static std::string stringForName(const char *name, const char *fallback)
+{
+    auto valueIter = stringValues.find(name);
+    return valueIter != stringValues.end() ? valueIter->second : fallback;
+}
+
+static std::string objectForKey(uint32_t key)
+{
+    auto nameIter = objectNames.find(key);
+    if (nameIter != objectNames.end()) { return nameIter->second; }
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "0x%x", key);
+    return buffer;
+}
+
+static uint32_t getLE(const uint8_t *buffer, int byteCount)
+{
+    uint32_t value = 0;
+    for (int byteIndex = 0; byteIndex < byteCount; ++byteIndex) { value |= (uint32_t)buffer[byteIndex] << (8 * byteIndex); }
+    return value;
+}
+
+// Formats log record as a .txt log line, returning false if malformed
+static bool formatRecord(const uint8_t *record, uint8_t length, int32_t timeZoneOffset, std::string &lineOut)
+{
+    if (length < 13) { return false; }
+    const uint8_t *recordEnd = record + length;
+    char buffer[64];
+
+    time_t localTime = (time_t)getLE(record + 2, 4) + timeZoneOffset;
+    struct tm *timeInfo = gmtime(&localTime);
+    strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S ", timeInfo);
+    lineOut = buffer;
+
+    int8_t level = (int8_t)record[1];
+    lineOut += level == 2 ? stringForName("HStr_Log_Prefix_Error", "[FAIL] ")
+             : level == 1 ? stringForName("HStr_Log_Prefix_Warning", "[WARN] ")
+                          : stringForName("HStr_Log_Prefix_Info", "[INFO] ");
+
+    uint32_t objKey = getLE(record + 8, 4);
+    if (objKey != UINT32_MAX) { lineOut += objectForKey(objKey); }
+    uint16_t msgId = (uint16_t)getLE(record + 6, 2);
+    if (msgId != NoStringId) { lineOut += stringForId(msgId); }
+
+    const uint8_t *recordPos = record + 13;
+    for (int argIndex = 0; argIndex < record[12]; ++argIndex) {
+        if (recordPos >= recordEnd) { return false; }
+        switch (*recordPos++) {
+            case ArgType_String:
+                if (recordPos + 2 > recordEnd) { return false; }
+                lineOut += stringForId((uint16_t)getLE(recordPos, 2));
+                recordPos += 2;
+                break;
+            case ArgType_Text:
+                if (recordPos + 1 > recordEnd || recordPos + 1 + *recordPos > recordEnd) { return false; }
+                lineOut.append((const char *)recordPos + 1, *recordPos);
+                recordPos += 1 + *recordPos;
+                break;
+            case ArgType_Int:
+            case ArgType_UInt:
+            case ArgType_Float:
+            case ArgType_Key: {
+                if (recordPos + 4 > recordEnd) { return false; }
+                uint32_t value = getLE(recordPos, 4);
+                switch (recordPos[-1]) {
+                    case ArgType_Int: snprintf(buffer, sizeof(buffer), "%d", (int32_t)value); break;
+                    case ArgType_UInt: snprintf(buffer, sizeof(buffer), "%u", value); break;
+                    case ArgType_Float: { float floatValue; memcpy(&floatValue, &value, sizeof(floatValue)); snprintf(buffer, sizeof(buffer), "%.2f", floatValue); } break;
+                    default: snprintf(buffer, sizeof(buffer), "%s", objectForKey(value).c_str()); break;
+                }
+                lineOut += buffer;
+                recordPos += 4;
+            } break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *inputPath = nullptr, *outputPath = nullptr, *stringsFolder = nullptr;
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex) {
+        if (!strcmp(argv[argIndex], "--strings") && argIndex + 1 < argc) { stringsFolder = argv[++argIndex]; }
+        else if (!inputPath) { inputPath = argv[argIndex]; }
+        else if (!outputPath) { outputPath = argv[argIndex]; }
+    }
+    if (!inputPath) {
+        fprintf(stderr, "Usage: %s <input.hlb> [output.txt] [--strings <Helioduino src folder>]\n", argv[0]);
+        return 1;
+    }
+    if (stringsFolder && !loadStrings(stringsFolder)) { return 1; }
+
+    FILE *input = fopen(inputPath, "rb");
+    if (!input) { fprintf(stderr, "Cannot open %s\n", inputPath); return 1; }
+    FILE *output = outputPath ? fopen(outputPath, "w") : stdout;
+    if (!output) { fprintf(stderr, "Cannot open %s\n", outputPath); fclose(input); return 1; }
+
+    uint8_t buffer[256];
+    if (fread(buffer, 1, 10, input) != 10 || memcmp(buffer, "HLB", 3) != 0) {
+        fprintf(stderr, "Not a Helioduino binary log file\n");
+        fclose(input); if (outputPath) { fclose(output); }
+        return 1;
+    }
+    if (buffer[3] != 1) {
+        fprintf(stderr, "Unsupported format version %d\n", buffer[3]);
+        fclose(input); if (outputPath) { fclose(output); }
+        return 1;
+    }
+    uint16_t stringsCount = (uint16_t)getLE(buffer + 4, 2);
+    int32_t timeZoneOffset = (int32_t)getLE(buffer + 6, 4);
+    if (stringsFolder && stringsCount != stringNames.size()) {
+        fprintf(stderr, "Warning: strings count mismatch (file: %u, source: %u), messages may be wrong\n", stringsCount, (unsigned)stringNames.size());
+    }
+
+    std::string line;
+    while (fread(buffer, 1, 1, input) == 1) {
+        uint8_t length = buffer[0];
+        if (length < 2 || fread(buffer + 1, 1, length - 1, input) != (size_t)(length - 1)) { break; } // truncated final record
+
+        if (buffer[1] == NameRecordType) {
+            if (length >= 6) { objectNames[getLE(buffer + 2, 4)] = std::string((const char *)buffer + 6, length - 6); }
+        } else if (formatRecord(buffer, length, timeZoneOffset, line)) {
+            fprintf(output, "%s\n", line.c_str());
+        } else {
+            fprintf(stderr, "Corrupt record at offset %ld\n", ftell(input) - length);
+        }
+    }
+
+    fclose(input);
+    if (outputPath) { fclose(output); }
+    return 0;
+}
@@ -184,6 +184,24 @@ void HelioActuator::update()
     _needsUpdate = false;
 }
 
+millis_t HelioActuator::getWakeDelay()
+{
+    if (_needsUpdate || _parentRail.needsResolved() || _parentPanel.needsResolved()) { return 0; }
+    millis_t wakeDelay = HELIO_CONTROL_LOOP_MAXSLEEP;
+
+    if (_handles.size()) {
+        millis_t time = nzMillis();
+        for (auto handleIter = _handles.begin(); handleIter != _handles.end(); ++handleIter) {
+            // only active forced timed handles may sleep until expiry, as others need enablement re-checked every tick
+            if (!(*handleIter)->isActive() || !(*handleIter)->isForced() || (*handleIter)->isUntimed()) { return 0; }
+            millis_t timeLeft = (*handleIter)->getTimeLeft();
+            wakeDelay = min(wakeDelay, timeLeft - min(time - (*handleIter)->checkTime, timeLeft));
+        }
+    }
+
+    return wakeDelay;
+}
+
 bool HelioActuator::getCanEnable()
 {
     if (getParentRail() && !getParentRail()->canActivate(this)) { return false; }
@@ -416,6 +434,11 @@ void HelioRelayMotorActuator::update()
     }
 }
 
+millis_t HelioRelayMotorActuator::getWakeDelay()
+{
+    return _travelTimeStart ? 0 : HelioActuator::getWakeDelay(); // travel time calc needs ticks
+}
+
 SharedPtr<HelioObjInterface> HelioRelayMotorActuator::getSharedPtrFor(const HelioObjInterface *obj) const
 {
     return obj->getKey() == _minimum.getKey() ? _minimum.getSharedPtrFor(obj) :
@@ -788,6 +811,7 @@ HelioMotorActuatorData::HelioMotorActuatorData()
     : HelioActuatorData(), outputPin2(), distanceUnits(Helio_UnitsType_Undefined), contSpeed(), positionSensor{0}, speedSensor{0}
 {
     _size = sizeof(*this);
+    _version = 2; // v2: trigger measurement stat field
 }
 
 void HelioMotorActuatorData::toJSONObject(JsonObject &objectOut) const
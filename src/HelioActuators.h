@@ -47,6 +47,7 @@ public:
     HelioActuator(const HelioActuatorData *dataIn);
 
     virtual void update() override;
+    virtual millis_t getWakeDelay() override;
 
     virtual bool getCanEnable() override;
 
@@ -94,7 +95,7 @@ public:
     inline Helio_ActuatorType getActuatorType() const { return _id.objTypeAs.actuatorType; }
     inline hposi_t getActuatorIndex() const { return _id.posIndex; }
 
-    inline void setNeedsUpdate() { _needsUpdate = true; }
+    inline void setNeedsUpdate() { _needsUpdate = true; wakeControlLoop(); }
     inline bool needsUpdate() { return _needsUpdate; }
 
     Signal<HelioActuator *, HELIO_ACTUATOR_SIGNAL_SLOTS> &getActivationSignal();
@@ -170,6 +171,7 @@ public:
     HelioRelayMotorActuator(const HelioMotorActuatorData *dataIn);
 
     virtual void update() override;
+    virtual millis_t getWakeDelay() override;
     virtual SharedPtr<HelioObjInterface> getSharedPtrFor(const HelioObjInterface *obj) const override;
 
     virtual bool getCanEnable() override;
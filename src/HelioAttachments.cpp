@@ -6,11 +6,11 @@
 #include "Helioduino.h"
 
 HelioDLinkObject::HelioDLinkObject()
-    : _key(hkey_none), _obj(nullptr), _keyStr(nullptr)
+    : _key(hkey_none), _obj(nullptr), _keyStr(nullptr), _handle()
 { ; }
 
 HelioDLinkObject::HelioDLinkObject(const HelioDLinkObject &obj)
-    : _key(obj._key), _obj(obj._obj), _keyStr(nullptr)
+    : _key(obj._key), _obj(obj._obj), _keyStr(nullptr), _handle(obj._handle)
 {
     if (obj._keyStr) {
         auto len = strnlen(obj._keyStr, HELIO_NAME_MAXSIZE);
@@ -38,13 +38,16 @@ void HelioDLinkObject::unresolve()
     }
     HELIO_HARD_ASSERT(!_obj || _key == _obj->getKey(), SFP(HStr_Err_OperationFailure));
     _obj = nullptr;
+    _handle = HelioObjectHandle();
 }
 
 SharedPtr<HelioObjInterface> HelioDLinkObject::resolveObject()
 {
+    if (_obj && !isCurrent() && !revalidate()) { unresolve(); } // dangling
     if (_obj || !isSet()) { return _obj; }
     if (Helioduino::_activeInstance) {
-        _obj = static_pointer_cast<HelioObjInterface>(Helioduino::_activeInstance->_objects[_key]);
+        _obj = static_pointer_cast<HelioObjInterface>(Helioduino::_activeInstance->_objects.find(_key));
+        updateHandle();
     }
     if (_obj && _keyStr) {
         free((void *)_keyStr); _keyStr = nullptr;
@@ -52,6 +55,12 @@ SharedPtr<HelioObjInterface> HelioDLinkObject::resolveObject()
     return _obj;
 }
 
+bool HelioDLinkObject::revalidate()
+{
+    updateHandle();
+    return _handle.isSet();
+}
+
 
 HelioAttachment::HelioAttachment(HelioObjInterface *parent, hposi_t subIndex)
     : HelioSubObject(parent), _obj(), _subIndex(subIndex)
@@ -232,10 +241,9 @@ void HelioSensorAttachment::detachObject()
 void HelioSensorAttachment::updateIfNeeded(bool poll)
 {
     if ((poll || _needsMeasurement) && resolve()) {
-        if (_handleSlot) { (*_handleSlot)(get()->getMeasurement()); }
-        else { handleMeasurement(get()->getMeasurement()); }
-
-        get()->takeMeasurement((poll || _needsMeasurement)); // purposeful recheck
+        auto measurement = get()->getMeasurement(_needsMeasurement); // stale measurement forces read, else as per sensor's polling policy
+        if (_handleSlot) { (*_handleSlot)(measurement); }
+        else { handleMeasurement(measurement); }
     }
 }
 
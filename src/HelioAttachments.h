@@ -22,6 +22,8 @@ class HelioDriverAttachment;
 // Delay/Dynamic Loaded/Linked Object Reference
 // Simple class for delay loading objects that get references to others during object
 // load. T should be a derived class of HelioObjInterface, with getId() method.
+// Resolved registry objects also keep a slot handle, which validates dereferences in O(1)
+// without SharedPtr copies and detects the object being unregistered (dangling reference).
 class HelioDLinkObject {
 public:
     HelioDLinkObject();
@@ -34,10 +36,13 @@ public:
     inline bool resolve() { return isResolved() || (bool)getObject(); }
     void unresolve();
     template<class U> inline void unresolveIf(U obj) { if (operator==(obj)) { unresolve(); } }
+    // Returns if resolved object's registry handle is still current (untracked objects are always current)
+    inline bool isCurrent() const;
 
     template<class U> inline void setObject(U obj) { operator=(obj); }
     template<class U = HelioObjInterface> inline SharedPtr<U> getObject() { return reinterpret_pointer_cast<U>(resolveObject()); }
-    template<class U = HelioObjInterface> inline U *get() { return getObject<U>().get(); }
+    template<class U = HelioObjInterface> inline U *get() { return _obj && isCurrent() ? reinterpret_cast<U *>(_obj.get()) : getObject<U>().get(); }
+    inline const HelioObjectHandle &getHandle() const { return _handle; }
 
     inline HelioIdentity getId() const { return _obj ? _obj->getId() : (_keyStr ? HelioIdentity(_keyStr) : HelioIdentity(_key)); }
     inline hkey_t getKey() const { return _key; }
@@ -64,9 +69,13 @@ protected:
     hkey_t _key;                                            // Object key
     SharedPtr<HelioObjInterface> _obj;                      // Shared pointer to object
     const char *_keyStr;                                    // Copy of id.keyString (if not resolved, or unresolved)
+    HelioObjectHandle _handle;                              // Registry handle of resolved object, else unset (untracked)
 
 private:
     SharedPtr<HelioObjInterface> resolveObject();
+    // Refreshes registry handle of resolved object, returning false if object is no longer registered
+    bool revalidate();
+    inline void updateHandle();
     friend class Helioduino;
     friend class HelioAttachment;
 };
@@ -98,7 +107,7 @@ public:
     template<class U> void setObject(U obj, bool modify = true);
     template<class U> inline void initObject(U obj) { setObject(obj, false); }
     template<class U = HelioObjInterface> SharedPtr<U> getObject();
-    template<class U = HelioObjInterface> inline U *get() { return getObject<U>().get(); }
+    template<class U = HelioObjInterface> inline U *get() { return _obj.isResolved() && _obj.isCurrent() ? reinterpret_cast<U *>(_obj._obj.get()) : getObject<U>().get(); }
 
     virtual void setParent(HelioObjInterface *parent) override;
     inline void setParent(HelioObjInterface *parent, hposi_t subIndex) { setParent(parent); setParentSubIndex(subIndex); }
@@ -269,6 +278,7 @@ public:
     virtual void detachObject() override;
 
     // Updates measurement attachment with sensor. Does not call sensor's update() (handled by system).
+    // Polling only reads sensor when due as per its polling policy, unless measurement is flagged as needed (forced read).
     virtual void updateIfNeeded(bool poll = false) override;
 
     // Sets the current measurement associated with this process. Required to be called by custom handlers.
@@ -5,10 +5,24 @@
 
 #include "Helioduino.h"
 
+inline bool HelioDLinkObject::isCurrent() const
+{
+    return !_handle.isSet() || (Helioduino::_activeInstance && Helioduino::_activeInstance->_objects.isCurrent(_handle));
+}
+
+inline void HelioDLinkObject::updateHandle()
+{
+    _handle = _obj && Helioduino::_activeInstance ? Helioduino::_activeInstance->_objects.handleOf(_key) : HelioObjectHandle();
+    if (_handle.isSet() && (HelioObjInterface *)Helioduino::_activeInstance->_objects.objectAt(_handle) != _obj.get()) {
+        _handle = HelioObjectHandle(); // same key, but not same object (e.g. sub-object)
+    }
+}
+
 inline HelioDLinkObject &HelioDLinkObject::operator=(HelioIdentity rhs)
 {
     _key = rhs.key;
     _obj = nullptr;
+    _handle = HelioObjectHandle();
     if (_keyStr) { free((void *)_keyStr); _keyStr = nullptr; }
 
     auto len = rhs.keyString.length();
@@ -23,6 +37,7 @@ inline HelioDLinkObject &HelioDLinkObject::operator=(const char *rhs)
 {
     _key = stringHash(rhs);
     _obj = nullptr;
+    _handle = HelioObjectHandle();
     if (_keyStr) { free((void *)_keyStr); _keyStr = nullptr; }
 
     auto len = strnlen(rhs, HELIO_NAME_MAXSIZE);
@@ -37,6 +52,7 @@ inline HelioDLinkObject &HelioDLinkObject::operator=(const HelioObjInterface *rh
 {
     _key = rhs ? rhs->getKey() : hkey_none;
     _obj = rhs ? rhs->getSharedPtr() : nullptr;
+    updateHandle();
     if (_keyStr) { free((void *)_keyStr); _keyStr = nullptr; }
 
     return *this;
@@ -46,6 +62,7 @@ inline HelioDLinkObject &HelioDLinkObject::operator=(const HelioAttachment *rhs)
 {
     _key = rhs ? rhs->getKey() : hkey_none;
     _obj = rhs && rhs->isResolved() ? rhs->getSharedPtr() : nullptr;
+    updateHandle();
     if (_keyStr) { free((void *)_keyStr); _keyStr = nullptr; }
 
     if (rhs && !rhs->isResolved()) {
@@ -64,6 +81,7 @@ inline HelioDLinkObject &HelioDLinkObject::operator=(SharedPtr<U> &rhs)
 {
     _key = rhs ? rhs->getKey() : hkey_none;
     _obj = rhs ? static_pointer_cast<HelioObjInterface>(rhs) : nullptr;
+    updateHandle();
     if (_keyStr) { free((void *)_keyStr); _keyStr = nullptr; }
 
     return *this;
@@ -93,6 +111,10 @@ void HelioAttachment::setObject(U obj, bool modify)
 template<class U>
 SharedPtr<U> HelioAttachment::getObject()
 {
+    if (_obj && !_obj.isCurrent() && !_obj.revalidate()) { // dangling, object unregistered
+        detachObject();
+        _obj.unresolve();
+    }
     if (_obj) { return _obj.getObject<U>(); }
     else if (!_obj.isSet()) { return nullptr; }
     else if (_obj.needsResolved() && _obj.resolveObject()) {
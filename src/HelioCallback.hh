@@ -70,6 +70,9 @@ public:
         }
     }
 
+    // Returns number of connected slots.
+    inline int getSlotCount() const { return _connections.size(); }
+
     // Visits each of its listeners and executes them via operator().
     void fire(ParameterType param) const {
         for (auto iter = _connections.begin(); iter != _connections.end(); ++iter) {
@@ -25,6 +25,12 @@ HelioData *newDataFromBinaryStream(Stream *streamIn)
         HelioData *data = _allocateDataFromBaseDecode(baseDecode);
         HELIO_SOFT_ASSERT(data, SFP(HStr_Err_AllocationFailure));
 
+        if (data && (data->_version != baseDecode._version || data->_size != baseDecode._size)) { // stored in a different layout, can't be read in place
+            HELIO_SOFT_ASSERT(false, SFP(HStr_Err_ImportFailure));
+            delete data;
+            return nullptr;
+        }
+
         if (data) {
             readBytes += deserializeDataFromBinaryStream(data, streamIn, readBytes + sizeof(void*));
             HELIO_SOFT_ASSERT(readBytes == data->_size - sizeof(void*), SFP(HStr_Err_ImportFailure));
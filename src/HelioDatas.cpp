@@ -24,7 +24,7 @@ HelioData *_allocateDataFromBaseDecode(const HelioData &baseDecode)
     HELIO_SOFT_ASSERT(retVal, F("Unknown data decode"));
     if (retVal) {
         retVal->id = baseDecode.id;
-        HELIO_SOFT_ASSERT(retVal->_version == baseDecode._version, F("Data version mismatch"));
+        HELIO_SOFT_ASSERT(retVal->_version >= baseDecode._version, F("Data version mismatch")); // older JSON data loads with defaults for newer fields
         retVal->_revision = baseDecode._revision;
         return retVal;
     }
@@ -90,7 +90,7 @@ HelioData *_allocateDataForObjType(int8_t idType, int8_t classType)
 }
 
 HelioSystemData::HelioSystemData()
-    : HelioData('H','S','Y','S', 1),
+    : HelioData('H','S','Y','S', 2), // v2: logger/publisher binary, MQTT, and rollup settings
       systemMode(Helio_SystemMode_Undefined), measureMode(Helio_MeasurementMode_Undefined),
       dispOutMode(Helio_DisplayOutputMode_Undefined), ctrlInMode(Helio_ControlInputMode_Undefined),
       systemName{0}, timeZoneOffset(0), pollingInterval(HELIO_DATA_LOOP_INTERVAL),
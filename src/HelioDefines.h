@@ -124,6 +124,15 @@
 #define HAS_LARGE_SRAM                  false               // Large SRAM size likely unavailable (memory saving features enabled)
 #endif
 #endif
+#ifndef NOINIT_ATTR                                         // Resolving no-init RAM section attribute (contents left as-is across warm resets), or define manually by build define (see BOARD for example)
+#if defined(ESP32)
+#define NOINIT_ATTR                     __NOINIT_ATTR       // From esp_attr.h
+#elif defined(ARDUINO_ARCH_RP2040)
+#define NOINIT_ATTR                     __attribute__((section(".uninitialized_data")))
+#else                                                       // Per AVR (also common to ARM linker scripts)
+#define NOINIT_ATTR                     __attribute__((section(".noinit")))
+#endif
+#endif
 
 // Standardized gfx WxH
 #ifdef HELIO_USE_GUI
@@ -167,6 +176,7 @@ typedef typeof(LOW)                     ard_pinstatus_t;    // Arduino pin statu
 #define HELIO_URL_MAXSIZE               64                  // URL string maximum size (max url length)
 #define HELIO_JSON_DOC_SYSSIZE          256                 // JSON document chunk data bytes for reading in main system data (serialization buffer size)
 #define HELIO_JSON_DOC_DEFSIZE          192                 // Default JSON document chunk data bytes (serialization buffer size)
+#define HELIO_JSON_DOC_DRVSIZE          640                 // JSON document chunk data bytes for object data with embedded driver data (panels with user assigned or PID axis drivers)
 #define HELIO_STRING_BUFFER_SIZE        32                  // Size in bytes of string serialization buffers
 #define HELIO_WIFISTREAM_BUFFER_SIZE    128                 // Size in bytes of WiFi serialization buffers
 // The following sizes only apply to architectures that do not have STL support (AVR/SAM)
@@ -179,7 +189,7 @@ typedef typeof(LOW)                     ard_pinstatus_t;    // Arduino pin statu
 #define HELIO_PUBLISH_SIGNAL_SLOTS      2                   // Maximum number of slots for data publish signal
 #define HELIO_PANEL_SIGNAL_SLOTS        2                   // Maximum number of slots for various panel signals
 #define HELIO_RAIL_SIGNAL_SLOTS         8                   // Maximum number of slots for rail capacity signal
-#define HELIO_SYS_OBJECTS_MAXSIZE       16                  // Maximum array size for system objects (max # of objects in system)
+#define HELIO_SYS_OBJECTS_MAXSIZE       16                  // Maximum array size for system objects (max # of objects in system, shared across all object type partitions - key index uses 2x this on large SRAM devices)
 #define HELIO_CAL_CALIBS_MAXSIZE        8                   // Maximum array size for calibration store objects (max # of different custom calibrations)
 #define HELIO_OBJ_LINKS_MAXSIZE         8                   // Maximum array size for object linkage list, per obj (max # of linked objects)
 #define HELIO_DRV_ACTUATORS_MAXSIZE     8                   // Maximum array size for driver actuators list (max # of actuators used)
@@ -189,8 +199,11 @@ typedef typeof(LOW)                     ard_pinstatus_t;    // Arduino pin statu
 #define HELIO_SYS_PINLOCKS_MAXSIZE      2                   // Maximum array size for pin locks list (max # of locks)
 #define HELIO_SYS_PINMUXERS_MAXSIZE     2                   // Maximum array size for pin muxers list (max # of muxers)
 #define HELIO_SYS_PINEXPANDERS_MAXSIZE  2                   // Maximum array size for pin expanders list (max # of expanders)
+#define HELIO_SYS_SUNPOS_MAXSIZE        4                   // Maximum array size for shared sun positions list (max # of distinct time quantum & lat/long bucket pairs kept, oldest evicted)
+#define HELIO_SYS_ANALOGSAMPLER_MAXSIZE 8                   // Maximum array size for analog sampler's round-robin sequence (max # of analog sensors sampled)
 
 #define HELIO_CONTROL_LOOP_INTERVAL     100                 // Run interval of main control loop, in milliseconds
+#define HELIO_CONTROL_LOOP_MAXSLEEP     60000               // Maximum time, in milliseconds, main control loop may sleep between object updates when no sooner wake deadline is reported (0 disables sleeping)
 #define HELIO_DATA_LOOP_INTERVAL        2000                // Default run interval of data loop, in milliseconds (customizable later)
 #define HELIO_MISC_LOOP_INTERVAL        250                 // Run interval of misc loop, in milliseconds
 
@@ -198,8 +211,22 @@ typedef typeof(LOW)                     ard_pinstatus_t;    // Arduino pin statu
 #define HELIO_ACT_TRAVELCALC_MINSPEED   0.05f               // What percentage of continuous speed an instantaneous speed sensor must achieve before it is used in travel/distance calculations (reduces near-zero error jitters)
 
 #define HELIO_DRV_FINETRAVEL_RATEMULT   0.5f                // Fine travel movement rate multiplier used on activations when actuator is within fine alignment distance with target.
+#define HELIO_DRV_SYNC_LEADGAIN         0.5f                // Default synchronized driver lead gain (rate multiplier reduction per distance unit an actuator leads trailing actuator)
+#define HELIO_DRV_SYNC_MINRATEMULT      0.1f                // Minimum rate multiplier a synchronized driver will slow leading actuators to (before max difference cutoff)
+#define HELIO_DRV_PID_PROPGAIN          1.0f                // Default PID driver proportional gain (travel rate units per distance unit of error)
+#define HELIO_DRV_PID_INTGAIN           0.1f                // Default PID driver integral gain (travel rate units per distance unit-sec of error)
+#define HELIO_DRV_PID_DERIVGAIN         0.2f                // Default PID driver derivative gain (travel rate units per distance unit/sec of motion)
+#define HELIO_DRV_PID_DERIVFILTER       0.5f                // Default PID driver derivative low-pass filter time constant, in seconds
+#define HELIO_DRV_PID_DEADBAND          0.1f                // Default PID driver output deadband, in travel rate units (outputs within are dropped)
+
+#define HELIO_LOG_RECORD_MAXARGS        4                   // Maximum # of typed arguments per binary log record
+#define HELIO_LOG_RECORD_MAXSIZE        96                  // Maximum size, in bytes, of an encoded binary log record (text arguments are truncated to fit)
+#define HELIO_LOG_RING_SIZE             (HAS_LARGE_SRAM ? 1024 : 256) // Size, in bytes (power of 2), of logger's lock-free RAM log ring that queues records for misc loop to drain out to log files (also keeps recently logged records), or 0 to disable and write records out directly
+#define HELIO_LOG_RING_NOINIT           false               // If logger's log ring should be placed in no-init RAM (see NOINIT_ATTR, needs platform linker script support) so undrained records survive warm resets and are recovered on boot (true), or heap allocated (false)
 
 #define HELIO_MUXERS_SHARED_ADDR_BUS    false               // Pin muxer channel selects should disable all pin muxers due to using same address bus (true), or not (false)
+#define HELIO_MUXERS_SETTLE_MICROS      0                   // Time to wait after a pin muxer channel switch for the muxed signal to settle, in microseconds, or 0 to disable
+#define HELIO_EXPANDERS_SHADOW_IO       false               // Pin expander I/O should batch pin writes/reads into one whole-port sync per control tick (true, opt-in: reads may lag by up to a tick w/o ISR, writes land at end of tick/task), or sync on every pin access (false)
 
 #define HELIO_NIGHT_START_HR            20                  // Hour of the day night starts (for resting panels, used if not able to calculate from location & time)
 #define HELIO_NIGHT_FINISH_HR           6                   // Hour of the day night finishes (for resting panels, used if not able to calculate from location & time)
@@ -208,11 +235,27 @@ typedef typeof(LOW)                     ard_pinstatus_t;    // Arduino pin statu
 #define HELIO_PANEL_ALIGN_DEGTOL        2.5f                // Default degrees error tolerance for panel alignment queries
 #define HELIO_PANEL_ALIGN_LDRTOL        0.05f               // Default LDR intensity balancing tolerance for panel alignment queries
 #define HELIO_PANEL_ALIGN_LDRMIN        0.20f               // Default LDR intensity minimum needed for panel alignment queries
+#define HELIO_PANEL_EPHEM_STEPMINS      (HAS_LARGE_SRAM ? 5 : 0) // Sampling step, in minutes, of tracking panels' shared daily sun ephemeris caches (~2.3kB/cache at 5), or 0 to disable cache and always calculate sun position directly
+#define HELIO_PANEL_SUNSTEP_SAMPLESECS  60                  // Time span, in seconds, used in sampling sun's angular velocity for predicting tracking panel's next sun-step deadline
+#define HELIO_PANEL_SUNSTEP_LEADDEG     0                   // Default degrees tracking panel's planned sun-step moves lead ahead of sun (facing then held until sun passes by aligned tolerance), or 0 to disable planning and track continuously (e.g. 1.0 to enable)
+#define HELIO_PANEL_SUNSTEP_STARTSECS   1                   // Estimated run-time overhead, in seconds, of each planned sun-step move (motor spin-up/brake release), used in move energy estimates
 
 #define HELIO_POS_SEARCH_FROMBEG        -1                  // Search from beginning to end, 0 up to MAXSIZE-1
 #define HELIO_POS_SEARCH_FROMEND        HELIO_POS_MAXSIZE   // Search from end to beginning, MAXSIZE-1 down to 0
 #define HELIO_POS_EXPORT_BEGFROM        1                   // Whenever exported/user-facing position indexing starts at 1 or 0 (aka display offset)
 
+#define HELIO_PUBLISH_KEYFRAME_ROWS     64                  // Maximum # of rows between full timestamp keyframe rows in binary data files (rows in between store 16-bit time deltas)
+#define HELIO_PUBLISH_INDEX_MAXSIZE     32                  // Maximum # of keyframe entries in a binary data file's time index footer (index thins to every other keyframe once full)
+#define HELIO_PUBLISH_BUFFER_SIZE       (HAS_LARGE_SRAM ? 2048 : 0) // Size, in bytes, of publisher's write-behind data row buffer (flushed to data files by misc loop), or 0 to disable and write rows out directly
+#define HELIO_PUBLISH_FLUSH_BLOCKSIZE   512                 // Block size, in bytes, that write-behind buffer flushes are aligned to in data files (flushes once at least a block is buffered)
+#define HELIO_PUBLISH_FLUSH_MAXAGE      60                  // Maximum age, in seconds, buffered data rows may wait before being flushed regardless of block alignment
+#define HELIO_PUBLISH_ROLLUP_BUFSIZE    (HAS_LARGE_SRAM ? 512 : 0) // Size, in bytes, of publisher's write-behind rollup row buffer per enabled rollup period (flushed to rollup files by misc loop), or 0 to disable and write rollup rows out directly
+#define HELIO_PUBLISH_ROLLUP_MAXAGE     600                 // Maximum age, in seconds, buffered rollup rows may wait before being flushed regardless of block alignment
+#define HELIO_PUBLISH_MQTT_PAYLOAD_SIZE 256                 // Size, in bytes, of publisher's packed MQTT message payload buffer (note: MQTTClient's own buffer, default 128 bytes, must be sized to fit)
+#define HELIO_PUBLISH_MQTT_MAXCOALESCE  8                   // Maximum # of polling frames that may be coalesced into a single packed MQTT message
+#define HELIO_PUBLISH_QUERY_SCANSIZE    256                 // Byte span below which data reader time searches of .csv data files stop bisecting and scan rows forward
+#define HELIO_PUBLISH_QUERY_SKIPDAYS    32                  // Day span of query range above which data reader lists data file directory to skip ahead to first existing data file (rather than probing each day)
+
 #define HELIO_RANGE_TEMP_HALF           5.0f                // How far to go, in either direction, to form a range when Temp is expressed as a single number, in C (note: this also controls auto-balancer ranges)
 
 #define HELIO_RAILS_LINKS_BASESIZE      4                   // Base array size for rail's linkage list
@@ -220,8 +263,11 @@ typedef typeof(LOW)                     ard_pinstatus_t;    // Arduino pin statu
 
 #define HELIO_SCH_BALANCE_MINTIME       30                  // Minimum time, in seconds, that all balancers must register as balanced for until driving is marked as completed
 
-#define HELIO_SENSOR_ANALOGREAD_SAMPLES 5                   // Number of samples to take for any analogRead call inside of a sensor's takeMeasurement call, or 0 to disable sampling (note: bitRes.maxValue * # of samples must fit inside a uint32_t)
-#define HELIO_SENSOR_ANALOGREAD_DELAY   0                   // Delay time between samples, or 0 to disable delay, in milliseconds
+#define HELIO_SENSOR_ANALOGREAD_SAMPLES 5                   // Default number of samples oversampled (then decimated) for any analogRead call inside of a sensor's takeMeasurement call, or 0 to disable sampling (note: bitRes.maxValue * # of samples must fit inside a uint32_t)
+#define HELIO_SENSOR_ANALOGREAD_DELAY   0                   // Delay time between samples, or 0 to disable delay, in milliseconds (note: scheduled instead of blocking when multitasking)
+#define HELIO_SENSOR_MEDIAN_MAXSIZE     7                   // Maximum window size of an analog sensor's sliding median filter stage
+#define HELIO_SENSOR_HISTORY_DEFSIZE    16                  // Default capacity of a sensor's measurement history ring, in # of samples (max 255)
+#define HELIO_SENSOR_POLLING_MAXFRAMES  8                   // Default maximum polling interval an adaptively polled sensor backs off to while its measurement is stable, in # of polling frames
 
 #define HELIO_SYS_AUTOSAVE_INTERVAL     120                 // Default autosave interval, in minutes
 #define HELIO_SYS_I2CEEPROM_BASEADDR    0x50                // Base address of I2C EEPROM (bitwise or'ed with passed address)
@@ -235,6 +281,8 @@ typedef typeof(LOW)                     ard_pinstatus_t;    // Arduino pin statu
 #define HELIO_SYS_FREESPACE_LOWSPACE    256                 // How many kilobytes of disk space remaining will force cleanup of oldest log/data files first
 #define HELIO_SYS_FREESPACE_DAYSBACK    180                 // How many days back log/data files are allowed to be stored up to (any beyond this are deleted during cleanup)
 #define HELIO_SYS_SUNRISESET_CALCITERS  3                   // # of iterations that sunrise/sunset calculations should run (higher # = more accurate but also more costly)
+#define HELIO_SYS_SUNPOS_QUANTUM        1                   // Time quantum, in seconds, that shared sun positions are resolved at (positions are shared by all panels within same quantum)
+#define HELIO_SYS_SUNPOS_BUCKETDEG      0.25                // Lat/long bucket size, in degrees, that shared sun positions are resolved at (panels offset within a bucket use a first-order correction)
 #define HELIO_SYS_LATLONG_DISTSQRDTOL   0.25                // Squared difference in lat/long coords that needs to occur for it to be considered significant enough for system update
 #define HELIO_SYS_ALTITUDE_DISTTOL      0.5                 // Difference in altitude coords that needs to occur for it to be considered significant enough for system update
 #define HELIO_SYS_DELAYFINE_SPINMILLIS  20                  // How many milliseconds away from stop time fine delays can use yield() up to before using a blocking spin-lock (used for fine timing)
@@ -508,6 +556,51 @@ enum Helio_TriggerState : signed char {
     Helio_TriggerState_Undefined = -1                       // Placeholder
 };
 
+// Measurement Statistic
+// Which value of a sensor's measurement history a consumer evaluates in place of the latest measurement.
+enum Helio_MeasurementStat : signed char {
+    Helio_MeasurementStat_Latest,                           // Latest measurement (default, no history required)
+    Helio_MeasurementStat_Mean,                             // Rolling mean over history window
+    Helio_MeasurementStat_Min,                              // Rolling minimum over history window
+    Helio_MeasurementStat_Max,                              // Rolling maximum over history window
+
+    Helio_MeasurementStat_Count,                            // Placeholder
+    Helio_MeasurementStat_Undefined = -1                    // Placeholder
+};
+
+// Polling Policy
+// How often the data loop polls a sensor for new measurements, in # of polling frames.
+enum Helio_PollingPolicy : signed char {
+    Helio_PollingPolicy_Fixed,                              // Polls every set # of frames (default, every frame)
+    Helio_PollingPolicy_Adaptive,                           // Polls every set # of frames while changing, backing off while stable
+    Helio_PollingPolicy_OnDemand,                           // Polls only when a measurement is explicitly requested
+
+    Helio_PollingPolicy_Count,                              // Placeholder
+    Helio_PollingPolicy_Undefined = -1                      // Placeholder
+};
+
+// MQTT Publish Mode
+// How data rows are sent to a MQTT broker, as a message per sensor or packed into one message per frame(s).
+enum Helio_MQTTPublishMode : signed char {
+    Helio_MQTTPublishMode_PerSensor,                        // One text value message per sensor column per frame, on <system>/<sensor> topics (default)
+    Helio_MQTTPublishMode_PackedJSON,                       // One compact JSON message per frame(s), on <system>/data topic
+    Helio_MQTTPublishMode_PackedBinary,                     // One packed binary message per frame(s), on <system>/data topic
+
+    Helio_MQTTPublishMode_Count,                            // Placeholder
+    Helio_MQTTPublishMode_Undefined = -1                    // Placeholder
+};
+
+// Rollup Period
+// Time bucket resolution of data rollups (min/max/mean statistics of published data columns).
+enum Helio_RollupPeriod : signed char {
+    Helio_RollupPeriod_Minute,                              // Minute rollups, to daily .rlm data files / <system>/rlm topic
+    Helio_RollupPeriod_Hour,                                // Hourly rollups, to daily .rlh data files / <system>/rlh topic
+    Helio_RollupPeriod_Day,                                 // Daily rollups (by local day), to yearly .rld data files / <system>/rld topic
+
+    Helio_RollupPeriod_Count,                               // Placeholder
+    Helio_RollupPeriod_Undefined = -1                       // Placeholder
+};
+
 // Driving State
 // Common driving states. Specifies parking ability and speed of travel.
 enum Helio_DrivingState : signed char {
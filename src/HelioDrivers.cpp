@@ -5,12 +5,101 @@
 
 #include "Helioduino.h"
 
+// Creates driver object from passed driver sub data
+HelioDriver *newDriverObjectFromSubData(const HelioDriverSubData *dataIn)
+{
+    if (!dataIn || !isValidType(dataIn->type)) return nullptr;
+    HELIO_SOFT_ASSERT(dataIn && isValidType(dataIn->type), SFP(HStr_Err_InvalidParameter));
+
+    if (dataIn) {
+        switch (dataIn->type) {
+            case (hid_t)HelioDriver::Absolute:
+                return new HelioAbsoluteDriver(dataIn);
+            case (hid_t)HelioDriver::Incremental:
+                return new HelioIncrementalDriver(dataIn);
+            case (hid_t)HelioDriver::PID:
+                return new HelioPIDDriver(dataIn);
+            default: break;
+        }
+    }
+
+    return nullptr;
+}
+
+
+HelioMotionProfile::HelioMotionProfile(Shape shapeIn, float maxVelocity, float maxAccel, float maxJerk, float responseTime)
+    : shape(shapeIn), _maxVelocity(maxVelocity), _maxAccel(maxAccel), _maxJerk(maxJerk), _responseTime(responseTime),
+      _velocity(0), _accel(0)
+{ ; }
+
+float HelioMotionProfile::getStoppingVelocity(float distance) const
+{
+    if (shape == Linear || _maxAccel == FLT_UNDEF) { return _maxVelocity != FLT_UNDEF ? _maxVelocity : __FLT_MAX__; }
+    float stopVelocity;
+
+    if (shape == SCurve && _maxJerk != FLT_UNDEF) {
+        // jerk-limited stop from cruise: d = v*sqrt(v/j) if accel limit never reached (v < a^2/j), else d = v/2*(v/a + a/j)
+        float rampVelocity = (_maxAccel * _maxAccel) / _maxJerk;
+        stopVelocity = powf(distance * sqrtf(_maxJerk), 2.0f / 3.0f);
+        if (stopVelocity >= rampVelocity) {
+            stopVelocity = 0.5f * (-rampVelocity + sqrtf(rampVelocity * rampVelocity + 8.0f * _maxAccel * distance));
+        }
+    } else {
+        stopVelocity = sqrtf(2.0f * _maxAccel * distance);
+    }
+
+    return _maxVelocity != FLT_UNDEF ? min(stopVelocity, _maxVelocity) : stopVelocity;
+}
+
+float HelioMotionProfile::update(float distance, float dt)
+{
+    if (dt <= FLT_EPSILON) { return _velocity; }
+    float direction = distance > 0 ? 1.0f : distance < 0 ? -1.0f : 0.0f;
+    float targetVelocity = direction * getStoppingVelocity(max(0.0f, fabsf(distance) - fabsf(_velocity) * _responseTime));
+
+    // never command more than what would reach target this update
+    if (fabsf(targetVelocity) * dt > fabsf(distance)) { targetVelocity = distance / dt; }
+
+    if (shape == Linear || _maxAccel == FLT_UNDEF) {
+        _velocity = targetVelocity;
+        _accel = 0;
+    } else if (shape == SCurve && _maxJerk != FLT_UNDEF) {
+        // accel tracks velocity error under jerk limit, using same stopping rule one derivative down
+        float velocityError = targetVelocity - _velocity;
+        float targetAccel = (velocityError > 0 ? 1.0f : -1.0f) * min(_maxAccel, sqrtf(2.0f * _maxJerk * fabsf(velocityError)));
+        _accel += constrain(targetAccel - _accel, -_maxJerk * dt, _maxJerk * dt);
+        _velocity += _accel * dt;
+        if ((targetVelocity - _velocity) * velocityError < 0) { // passed target velocity
+            _velocity = targetVelocity;
+            _accel = 0;
+        }
+    } else {
+        _velocity += constrain(targetVelocity - _velocity, -_maxAccel * dt, _maxAccel * dt);
+        _accel = 0;
+    }
+
+    return _velocity;
+}
+
+
 HelioDriver::HelioDriver(float targetSetpoint, float travelRate, int typeIn)
     : type((typeof(type))typeIn), _trackRange(make_pair(__FLT_MAX__,-__FLT_MAX__)),
       _targetSetpoint(targetSetpoint), _travelRate(travelRate),
-      _drivingState(Helio_DrivingState_Undefined), _enabled(false)
+      _drivingState(Helio_DrivingState_Undefined), _enabled(false), _lastUpdate(0)
+{ ; }
+
+HelioDriver::HelioDriver(const HelioDriverSubData *dataIn)
+    : type((typeof(type))(dataIn->type)), _trackRange(make_pair(__FLT_MAX__,-__FLT_MAX__)),
+      _targetSetpoint(FLT_UNDEF), _travelRate(dataIn->travelRate),
+      _drivingState(Helio_DrivingState_Undefined), _enabled(false), _lastUpdate(0)
 { ; }
 
+void HelioDriver::saveToData(HelioDriverSubData *dataOut) const
+{
+    dataOut->type = (int8_t)type;
+    dataOut->travelRate = _travelRate;
+}
+
 HelioDriver::~HelioDriver()
 {
     _enabled = false;
@@ -94,7 +183,11 @@ void HelioDriver::setTargetSetpoint(float targetSetpoint)
 
 void HelioDriver::setEnabled(bool enabled)
 {
-    _enabled = enabled;
+    if (_enabled != enabled) {
+        _enabled = enabled;
+        _lastUpdate = 0;
+        _motionProfile.reset();
+    }
 }
 
 void HelioDriver::setMeasurementUnits(Helio_UnitsType measurementUnits, uint8_t)
@@ -122,21 +215,28 @@ void HelioDriver::disableAllActivations()
     }
 }
 
+float HelioDriver::updateMotionProfile(float distance)
+{
+    millis_t time = nzMillis();
+    if (!_lastUpdate) { _lastUpdate = time; }
+    millis_t delta = time - _lastUpdate;
+    _lastUpdate = time;
+
+    _motionProfile.setMaxVelocity(_travelRate != FLT_UNDEF ? _travelRate / SECS_PER_MIN : FLT_UNDEF);
+    return _motionProfile.update(distance, delta / 1000.0f) * SECS_PER_MIN;
+}
+
 
 HelioAbsoluteDriver::HelioAbsoluteDriver(float travelRate, int typeIn)
-    : HelioDriver(FLT_UNDEF, travelRate, typeIn), _lastUpdate(0)
+    : HelioDriver(FLT_UNDEF, travelRate, typeIn)
 { ; }
 
-HelioAbsoluteDriver::~HelioAbsoluteDriver()
+HelioAbsoluteDriver::HelioAbsoluteDriver(const HelioDriverSubData *dataIn)
+    : HelioDriver(dataIn)
 { ; }
 
-void HelioAbsoluteDriver::setEnabled(bool enabled)
-{
-    if (_enabled != enabled) {
-        HelioDriver::setEnabled(enabled);
-        _lastUpdate = 0;
-    }
-}
+HelioAbsoluteDriver::~HelioAbsoluteDriver()
+{ ; }
 
 void HelioAbsoluteDriver::handleMaxOffset(float maxOffset)
 {
@@ -144,10 +244,8 @@ void HelioAbsoluteDriver::handleMaxOffset(float maxOffset)
     _drivingState = maxOffset > FLT_EPSILON ? Helio_DrivingState_OffTarget : Helio_DrivingState_AlignedTarget;
 
     if (_enabled && _drivingState != Helio_DrivingState_AlignedTarget && _targetSetpoint != FLT_UNDEF) {
-        millis_t time = nzMillis();
-        if (!_lastUpdate) { _lastUpdate = time; }
-        millis_t delta = time - _lastUpdate;
-        _lastUpdate = time;
+        millis_t delta = nzMillis() - (_lastUpdate ?: nzMillis());
+        float travelSpeed = fabsf(updateMotionProfile(fabsf(maxOffset))); // profiled on furthest actuator, applied to all
 
         for (auto attachIter = _actuators.begin(); attachIter != _actuators.end(); ++attachIter) {
             if (isInstantaneous()) {
@@ -156,10 +254,10 @@ void HelioAbsoluteDriver::handleMaxOffset(float maxOffset)
             } else {
                 float position = (*attachIter)->getCalibratedValue();
                 if (position < _targetSetpoint) {
-                    position += _travelRate * delta / secondsToMillis(SECS_PER_MIN);
+                    position += travelSpeed * delta / secondsToMillis(SECS_PER_MIN);
                     if (position > _targetSetpoint) { position = _targetSetpoint; }
                 } else if (position > _targetSetpoint) {
-                    position -= _travelRate * delta / secondsToMillis(SECS_PER_MIN);
+                    position -= travelSpeed * delta / secondsToMillis(SECS_PER_MIN);
                     if (position < _targetSetpoint) { position = _targetSetpoint; }
                 }
                 attachIter->setupActivation(position);
@@ -168,6 +266,8 @@ void HelioAbsoluteDriver::handleMaxOffset(float maxOffset)
         }
     } else {
         disableAllActivations();
+        _lastUpdate = 0;
+        _motionProfile.reset();
     }
 
     if (hadDrivingState != _drivingState && _drivingState != Helio_DrivingState_Undefined) {
@@ -182,12 +282,29 @@ void HelioAbsoluteDriver::handleMaxOffset(float maxOffset)
 
 HelioIncrementalDriver::HelioIncrementalDriver(float nearbyRange, float alignedRange, float maxDifference, float travelRate, int typeIn)
     : HelioDriver(FLT_UNDEF, travelRate, typeIn),
-     _nearbyRange(nearbyRange), _alignedRange(alignedRange), _maxDifference(maxDifference)
+     _nearbyRange(nearbyRange), _alignedRange(alignedRange), _maxDifference(maxDifference),
+     _syncGain(0), _skew(0), _peakSkew(0)
+{ ; }
+
+HelioIncrementalDriver::HelioIncrementalDriver(const HelioDriverSubData *dataIn)
+    : HelioDriver(dataIn),
+      _nearbyRange(dataIn->nearbyRange), _alignedRange(dataIn->alignedRange), _maxDifference(dataIn->maxDifference),
+      _syncGain(dataIn->syncGain), _skew(0), _peakSkew(0)
 { ; }
 
 HelioIncrementalDriver::~HelioIncrementalDriver()
 { ; }
 
+void HelioIncrementalDriver::saveToData(HelioDriverSubData *dataOut) const
+{
+    HelioDriver::saveToData(dataOut);
+
+    dataOut->nearbyRange = _nearbyRange;
+    dataOut->alignedRange = _alignedRange;
+    dataOut->maxDifference = _maxDifference;
+    dataOut->syncGain = _syncGain;
+}
+
 Helio_DrivingState HelioIncrementalDriver::getDrivingState(bool poll)
 {
     if (poll) {
@@ -207,21 +324,38 @@ void HelioIncrementalDriver::handleMaxOffset(float maxOffset) {
 
     if (_enabled && _drivingState != Helio_DrivingState_AlignedTarget && _targetSetpoint != FLT_UNDEF) {
         float offsetLimit = maxOffset - _maxDifference;
+        float travelSpeed = _motionProfile.shape != HelioMotionProfile::Linear ? fabsf(updateMotionProfile(fabsf(maxOffset))) : _travelRate;
+        float commonRateMult = _motionProfile.shape == HelioMotionProfile::Linear && maxOffset <= _nearbyRange + FLT_EPSILON ? HELIO_DRV_FINETRAVEL_RATEMULT : 1.0f;
+        float minPosition = __FLT_MAX__, maxPosition = -__FLT_MAX__;
 
         for (auto attachIter = _actuators.begin(); attachIter != _actuators.end(); ++attachIter) {
             auto position = attachIter->HelioAttachment::get<HelioPositionSensorAttachmentInterface>()->getPositionSensorAttachment().getMeasurement(true).asUnits(getMeasurementUnits());
             float offset = fabsf(_targetSetpoint - position.value);
+            minPosition = min(minPosition, position.value);
+            maxPosition = max(maxPosition, position.value);
 
             if (offset <= _alignedRange + FLT_EPSILON || offset < offsetLimit - FLT_EPSILON) { // aligned or too fast
                 attachIter->disableActivation();
+            } else if (isSynchronized() && (*attachIter)->isAnyVariableClass()) {
+                attachIter->setupActivation(_targetSetpoint > position.value ? travelSpeed : -travelSpeed);
+                attachIter->setRateMultiplier(commonRateMult * getSyncRateMultiplier(maxOffset, offset));
+                attachIter->enableActivation();
+            } else if (_motionProfile.shape != HelioMotionProfile::Linear && (*attachIter)->isAnyVariableClass()) {
+                attachIter->setupActivation(_targetSetpoint > position.value ? travelSpeed : -travelSpeed);
+                attachIter->setRateMultiplier(1.0f);
+                attachIter->enableActivation();
             } else {
                 attachIter->setupActivation(_targetSetpoint > position.value ? _travelRate : -_travelRate);
                 attachIter->setRateMultiplier((offset <= _nearbyRange + FLT_EPSILON ? HELIO_DRV_FINETRAVEL_RATEMULT : 1.0f));
                 attachIter->enableActivation();
             }
         }
+
+        updateSkew(minPosition, maxPosition);
     } else {
         disableAllActivations();
+        _lastUpdate = 0;
+        _motionProfile.reset();
     }
 
     if (hadDrivingState != _drivingState && _drivingState != Helio_DrivingState_Undefined) {
@@ -232,3 +366,191 @@ void HelioIncrementalDriver::handleMaxOffset(float maxOffset) {
         #endif
     }
 }
+
+
+HelioPIDDriver::HelioPIDDriver(float propGain, float intGain, float derivGain, float derivFilter, float outputDeadband, float alignedRange, float maxDifference, float travelRate, int typeIn)
+    : HelioIncrementalDriver(alignedRange, alignedRange, maxDifference, travelRate, typeIn),
+      _gains{propGain,intGain,derivGain}, _derivFilter(derivFilter), _outputDeadband(outputDeadband),
+      _integral(0), _derivative(0), _lastPosition(FLT_UNDEF), _output(0), _actuations(0)
+{ ; }
+
+HelioPIDDriver::HelioPIDDriver(const HelioDriverSubData *dataIn)
+    : HelioIncrementalDriver(dataIn),
+      _gains{dataIn->pidGains[0],dataIn->pidGains[1],dataIn->pidGains[2]},
+      _derivFilter(dataIn->derivFilter), _outputDeadband(dataIn->outputDeadband),
+      _integral(0), _derivative(0), _lastPosition(FLT_UNDEF), _output(0), _actuations(0)
+{ ; }
+
+HelioPIDDriver::~HelioPIDDriver()
+{ ; }
+
+void HelioPIDDriver::saveToData(HelioDriverSubData *dataOut) const
+{
+    HelioIncrementalDriver::saveToData(dataOut);
+
+    dataOut->pidGains[0] = _gains[0];
+    dataOut->pidGains[1] = _gains[1];
+    dataOut->pidGains[2] = _gains[2];
+    dataOut->derivFilter = _derivFilter;
+    dataOut->outputDeadband = _outputDeadband;
+}
+
+void HelioPIDDriver::setEnabled(bool enabled)
+{
+    if (_enabled != enabled) {
+        HelioIncrementalDriver::setEnabled(enabled);
+        resetOutput();
+    }
+}
+
+float HelioPIDDriver::updateOutput(float position, float dt)
+{
+    if (_targetSetpoint == FLT_UNDEF) { return (_output = 0); }
+    float outputLimit = _travelRate != FLT_UNDEF ? fabsf(_travelRate) : 1.0f;
+    float error = _targetSetpoint - position;
+
+    if (_lastPosition != FLT_UNDEF && dt > FLT_EPSILON) {
+        float filterAlpha = _derivFilter > FLT_EPSILON ? dt / (_derivFilter + dt) : 1.0f;
+        _derivative += filterAlpha * (((position - _lastPosition) / dt) - _derivative);
+    } else {
+        _derivative = 0;
+    }
+    _lastPosition = position;
+
+    float propTerm = _gains[0] * error;
+    float derivTerm = -_gains[2] * _derivative; // on measurement, avoids set-point kick
+    float intStep = _gains[1] * error * dt;
+    float unsatOutput = propTerm + _integral + derivTerm;
+
+    // anti-windup: halt integration while saturated in direction integration would push further
+    if (!((unsatOutput >= outputLimit && intStep > 0) || (unsatOutput <= -outputLimit && intStep < 0))) {
+        _integral = constrain(_integral + intStep, -outputLimit, outputLimit);
+    }
+
+    _output = constrain(propTerm + _integral + derivTerm, -outputLimit, outputLimit);
+    if (fabsf(_output) < _outputDeadband) { _output = 0; }
+
+    return _output;
+}
+
+void HelioPIDDriver::resetOutput()
+{
+    _integral = _derivative = _output = 0;
+    _lastPosition = FLT_UNDEF;
+}
+
+void HelioPIDDriver::handleMaxOffset(float maxOffset)
+{
+    auto hadDrivingState = _drivingState;
+    _drivingState = maxOffset > _nearbyRange + FLT_EPSILON  ? Helio_DrivingState_OffTarget :
+                    maxOffset > _alignedRange + FLT_EPSILON ? Helio_DrivingState_NearbyTarget
+                                                            : Helio_DrivingState_AlignedTarget;
+
+    if (_enabled && _targetSetpoint != FLT_UNDEF && _actuators.size()) {
+        millis_t time = nzMillis();
+        if (!_lastUpdate) { _lastUpdate = time; }
+        millis_t delta = time - _lastUpdate;
+        _lastUpdate = time;
+
+        float positions[HELIO_DRV_ACTUATORS_MAXSIZE];
+        float meanPosition = 0, minPosition = __FLT_MAX__, maxPosition = -__FLT_MAX__;
+        int actuatorIndex = 0;
+        for (auto attachIter = _actuators.begin(); attachIter != _actuators.end(); ++attachIter, ++actuatorIndex) {
+            positions[actuatorIndex] = attachIter->HelioAttachment::get<HelioPositionSensorAttachmentInterface>()->getPositionSensorAttachment().getMeasurement(true).asUnits(getMeasurementUnits()).value;
+            meanPosition += positions[actuatorIndex];
+            minPosition = min(minPosition, positions[actuatorIndex]);
+            maxPosition = max(maxPosition, positions[actuatorIndex]);
+        }
+        meanPosition /= actuatorIndex;
+        updateSkew(minPosition, maxPosition);
+
+        float outputWas = _output;
+        float output = updateOutput(meanPosition, delta / 1000.0f);
+        if (_drivingState == Helio_DrivingState_AlignedTarget) {
+            output = _output = _integral = 0;
+        }
+        if ((isFPEqual(outputWas, 0.0f) && !isFPEqual(output, 0.0f)) || outputWas * output < 0) {
+            _actuations++;
+        }
+
+        float offsetLimit = maxOffset - _maxDifference;
+        actuatorIndex = 0;
+        for (auto attachIter = _actuators.begin(); attachIter != _actuators.end(); ++attachIter, ++actuatorIndex) {
+            float offset = fabsf(_targetSetpoint - positions[actuatorIndex]);
+
+            if (isFPEqual(output, 0.0f) || offset < offsetLimit - FLT_EPSILON) { // deadband or too fast
+                attachIter->disableActivation();
+            } else {
+                attachIter->setupActivation((*attachIter)->isAnyVariableClass() ? output : (output > 0 ? _travelRate : -_travelRate));
+                attachIter->setRateMultiplier(isSynchronized() && (*attachIter)->isAnyVariableClass() ? getSyncRateMultiplier(maxOffset, offset) : 1.0f);
+                attachIter->enableActivation();
+            }
+        }
+    } else {
+        disableAllActivations();
+        resetOutput();
+        _lastUpdate = 0;
+    }
+
+    if (hadDrivingState != _drivingState && _drivingState != Helio_DrivingState_Undefined) {
+        #ifdef HELIO_USE_MULTITASKING
+            scheduleSignalFireOnce<Helio_DrivingState>(_drivingSignal, _drivingState);
+        #else
+            _drivingSignal.fire(_drivingState);
+        #endif
+    }
+}
+
+
+HelioDriverSubData::HelioDriverSubData()
+    : HelioSubData(), travelRate(FLT_UNDEF), nearbyRange(0.5f), alignedRange(0.05f), maxDifference(2.5f), syncGain(0),
+      pidGains{HELIO_DRV_PID_PROPGAIN,HELIO_DRV_PID_INTGAIN,HELIO_DRV_PID_DERIVGAIN},
+      derivFilter(HELIO_DRV_PID_DERIVFILTER), outputDeadband(HELIO_DRV_PID_DEADBAND)
+{ ; }
+
+void HelioDriverSubData::toJSONObject(JsonObject &objectOut) const
+{
+    HelioSubData::toJSONObject(objectOut);
+
+    if (travelRate != FLT_UNDEF) { objectOut[SFP(HStr_Key_TravelRate)] = travelRate; }
+    switch (type) {
+        case (hid_t)HelioDriver::Incremental:
+            objectOut[SFP(HStr_Key_NearbyRange)] = nearbyRange;
+            // fall through
+        case (hid_t)HelioDriver::PID:
+            objectOut[SFP(HStr_Key_AlignedRange)] = alignedRange;
+            objectOut[SFP(HStr_Key_MaxDifference)] = maxDifference;
+            if (syncGain > FLT_EPSILON) { objectOut[SFP(HStr_Key_SyncGain)] = syncGain; }
+            if (type == (hid_t)HelioDriver::PID) {
+                objectOut[SFP(HStr_Key_PIDGains)] = commaStringFromArray(pidGains, 3);
+                objectOut[SFP(HStr_Key_DerivativeFilter)] = derivFilter;
+                objectOut[SFP(HStr_Key_OutputDeadband)] = outputDeadband;
+            }
+            break;
+        default: break;
+    }
+}
+
+void HelioDriverSubData::fromJSONObject(JsonObjectConst &objectIn)
+{
+    HelioSubData::fromJSONObject(objectIn);
+
+    travelRate = objectIn[SFP(HStr_Key_TravelRate)] | travelRate;
+    switch (type) {
+        case (hid_t)HelioDriver::Incremental:
+            nearbyRange = objectIn[SFP(HStr_Key_NearbyRange)] | nearbyRange;
+            // fall through
+        case (hid_t)HelioDriver::PID:
+            alignedRange = objectIn[SFP(HStr_Key_AlignedRange)] | alignedRange;
+            maxDifference = objectIn[SFP(HStr_Key_MaxDifference)] | maxDifference;
+            syncGain = objectIn[SFP(HStr_Key_SyncGain)] | syncGain;
+            if (type == (hid_t)HelioDriver::PID) {
+                JsonVariantConst pidGainsVar = objectIn[SFP(HStr_Key_PIDGains)];
+                commaStringToArray(pidGainsVar, pidGains, 3);
+                derivFilter = objectIn[SFP(HStr_Key_DerivativeFilter)] | derivFilter;
+                outputDeadband = objectIn[SFP(HStr_Key_OutputDeadband)] | outputDeadband;
+            }
+            break;
+        default: break;
+    }
+}
@@ -6,14 +6,67 @@
 #ifndef HelioDrivers_H
 #define HelioDrivers_H
 
+class HelioMotionProfile;
 class HelioDriver;
 class HelioAbsoluteDriver;
 class HelioIncrementalDriver;
+class HelioPIDDriver;
+struct HelioDriverSubData;
 
 #include "Helioduino.h"
 #include "HelioObject.h"
 #include "HelioTriggers.h"
 
+// Creates driver object from passed driver sub data (return ownership transfer - user code *must* delete returned object)
+extern HelioDriver *newDriverObjectFromSubData(const HelioDriverSubData *dataIn);
+
+// Motion Profile
+// Online velocity set-point generator used by drivers to move along their track. Each update
+// takes the signed distance remaining to target and the time elapsed since last update, and
+// produces a signed velocity set-point. Linear profiles move at max velocity (prior driver
+// behavior), trapezoidal profiles are acceleration-limited, and S-curve profiles are also
+// jerk-limited. A response time (actuator lag) can be given to begin braking early enough
+// for a lagging actuator to still come to rest at target. Re-entrant to target changes
+// mid-motion. Stateful only in velocity/accel, making it usable on its own (e.g. against a
+// simulated actuator plant).
+class HelioMotionProfile {
+public:
+    enum Shape : signed char { Linear, Trapezoidal, SCurve } shape; // Profile shape
+
+    HelioMotionProfile(Shape shape = Linear,
+                       float maxVelocity = FLT_UNDEF,
+                       float maxAccel = FLT_UNDEF,
+                       float maxJerk = FLT_UNDEF,
+                       float responseTime = 0);
+
+    // Advances profile by dt seconds towards the target that lies distance units away (signed),
+    // returning new signed velocity set-point (distance units / sec).
+    float update(float distance, float dt);
+    // Resets profile to rest (zero velocity/accel)
+    inline void reset() { _velocity = _accel = 0; }
+
+    inline void setMaxVelocity(float maxVelocity) { _maxVelocity = maxVelocity; }
+    inline float getMaxVelocity() const { return _maxVelocity; }
+    inline float getMaxAccel() const { return _maxAccel; }
+    inline float getMaxJerk() const { return _maxJerk; }
+    inline float getResponseTime() const { return _responseTime; }
+    inline float getVelocity() const { return _velocity; }
+    inline float getAccel() const { return _accel; }
+    inline bool isAtRest() const { return isFPEqual(_velocity, 0.0f) && isFPEqual(_accel, 0.0f); }
+
+    // Returns max velocity that can still be brought to rest within passed distance (unsigned)
+    float getStoppingVelocity(float distance) const;
+
+protected:
+    float _maxVelocity;                                     // Max velocity (distance units / sec), else FLT_UNDEF/unlimited
+    float _maxAccel;                                        // Max acceleration (distance units / sec^2), else FLT_UNDEF/unlimited
+    float _maxJerk;                                         // Max jerk (distance units / sec^3), else FLT_UNDEF/unlimited
+    float _responseTime;                                    // Actuator response time/lag compensation (sec)
+    float _velocity;                                        // Current velocity set-point
+    float _accel;                                           // Current acceleration (S-curve only)
+};
+
+
 // Driver Base
 // This is the base class for all driver objects, which are used to modify the external
 // environment via a set of movement actuators along a specified track. Drivers allow for
@@ -23,16 +76,20 @@ class HelioDriver : public HelioSubObject,
                     public HelioDriverObjectInterface,
                     public HelioMeasurementUnitsInterfaceStorageSingle {
 public:
-    const enum : signed char { Absolute, Incremental, Unknown = -1 } type; // Driver type (custom RTTI)
+    const enum : signed char { Absolute, Incremental, PID, Unknown = -1 } type; // Driver type (custom RTTI)
     inline bool isAbsoluteType() const { return type == Absolute; }
     inline bool isIncrementalType() const { return type == Incremental; }
+    inline bool isPIDType() const { return type == PID; }
     inline bool isUnknownType() const { return type <= Unknown; }
 
     HelioDriver(float targetSetpoint,
                 float travelRate,
                 int type = Unknown);
+    HelioDriver(const HelioDriverSubData *dataIn);
     virtual ~HelioDriver();
 
+    virtual void saveToData(HelioDriverSubData *dataOut) const;
+
     virtual void update();
 
     virtual float getMaxTargetOffset(bool poll = false) override;
@@ -48,6 +105,11 @@ public:
     inline bool isInstantaneous() const { return _travelRate == FLT_UNDEF; }
     inline Pair<float,float> getTrackRange() const { return _trackRange; }
 
+    // Sets motion profile used in driving actuators (max velocity is taken from travel rate).
+    // Accel in distance units / sec^2, jerk in distance units / sec^3, response time in sec.
+    inline void setMotionProfile(HelioMotionProfile::Shape shape, float maxAccel = FLT_UNDEF, float maxJerk = FLT_UNDEF, float responseTime = 0) { _motionProfile = HelioMotionProfile(shape, FLT_UNDEF, maxAccel, maxJerk, responseTime); }
+    inline const HelioMotionProfile &getMotionProfile() const { return _motionProfile; }
+
     virtual void setEnabled(bool enabled);
     inline bool isEnabled() const { return _enabled; }
 
@@ -62,10 +124,14 @@ protected:
     float _travelRate;                                      // Travel rate (distance units / min)
     Helio_DrivingState _drivingState;                       // Driving state (last handled)
     bool _enabled;                                          // Enabled flag
+    millis_t _lastUpdate;                                   // Last update millis (for delta-time rate application)
+    HelioMotionProfile _motionProfile;                      // Motion profile (velocity set-point generator)
     Signal<Helio_DrivingState, HELIO_DRIVER_SIGNAL_SLOTS> _drivingSignal; // Driving signal
     Vector<HelioActuatorAttachment, HELIO_DRV_ACTUATORS_MAXSIZE> _actuators; // Actuator attachments
 
     void disableAllActivations();
+    // Advances motion profile towards target lying distance units away, returning signed velocity set-point (distance units / min)
+    float updateMotionProfile(float distance);
 
     virtual void handleMaxOffset(float maxOffset) = 0;
 };
@@ -79,13 +145,10 @@ class HelioAbsoluteDriver : public HelioDriver {
 public:
     HelioAbsoluteDriver(float travelRate = FLT_UNDEF,
                         int type = Absolute);
+    HelioAbsoluteDriver(const HelioDriverSubData *dataIn);
     virtual ~HelioAbsoluteDriver();
 
-    virtual void setEnabled(bool enabled) override;
-
 protected:
-    millis_t _lastUpdate;                                   // Last update millis (for delta-time rate application)
-
     virtual void handleMaxOffset(float maxOffset) override;
 };
 
@@ -96,7 +159,12 @@ protected:
 // nearby range, and will consider itself aligned once within aligned range. Travel rate
 // only relevant for variable speed motors. Will attempt to maintain a maximum difference
 // between leading and trailing actuators. Suitable for driving continuous servos & motors
-// that must stay in sync or risk physical breakage.
+// that must stay in sync or risk physical breakage. Variable speed motors are driven by the
+// motion profile (if non-linear) in place of fine travel rate toggling.
+// When synchronized (sync gain set), variable speed motors instead follow the trailing actuator
+// as a common trajectory: leading actuators are continuously slowed via rate multiplier in
+// proportion to their lead, with fine travel applied to all actuators at once, leaving the max
+// difference cutoff as a safety limit only. Peak inter-actuator skew is tracked regardless.
 // All actuators must have position data (be derived from HelioPositionSensorAttachmentInterface).
 class HelioIncrementalDriver : public HelioDriver {
 public:
@@ -105,16 +173,117 @@ public:
                            float maxDifference = 2.5f,
                            float travelRate = 1.0f,
                            int type = Incremental);
+    HelioIncrementalDriver(const HelioDriverSubData *dataIn);
     virtual ~HelioIncrementalDriver();
 
+    virtual void saveToData(HelioDriverSubData *dataOut) const override;
+
     virtual Helio_DrivingState getDrivingState(bool poll = false) override;
 
+    inline float getNearbyRange() const { return _nearbyRange; }
+    inline float getAlignedRange() const { return _alignedRange; }
+    inline float getMaxDifference() const { return _maxDifference; }
+
+    // Sets synchronized mode lead gain (rate multiplier reduction per distance unit of lead), or 0 to disable
+    inline void setSyncGain(float syncGain = HELIO_DRV_SYNC_LEADGAIN) { _syncGain = syncGain; bumpRevisionIfNeeded(); }
+    inline float getSyncGain() const { return _syncGain; }
+    inline bool isSynchronized() const { return _syncGain > FLT_EPSILON; }
+
+    // Current/peak inter-actuator skew (max - min actuator position), in distance units
+    inline float getSkew() const { return _skew; }
+    inline float getPeakSkew() const { return _peakSkew; }
+    inline void resetPeakSkew() { _peakSkew = _skew; }
+
 protected:
     float _nearbyRange;                                     // Nearby target range (for fine/coarse control)
     float _alignedRange;                                    // Aligned to target range
     float _maxDifference;                                   // Maximum positional difference
+    float _syncGain;                                        // Synchronized mode lead gain, else 0/disabled
+    float _skew;                                            // Current inter-actuator skew
+    float _peakSkew;                                        // Peak inter-actuator skew
+
+    virtual void handleMaxOffset(float maxOffset) override;
+    // Calculates rate multiplier for an actuator at offset from target (synchronized mode)
+    inline float getSyncRateMultiplier(float maxOffset, float offset) const { return constrain(1.0f - _syncGain * (maxOffset - offset), HELIO_DRV_SYNC_MINRATEMULT, 1.0f); }
+    // Updates current/peak skew from passed min/max actuator positions
+    inline void updateSkew(float minPosition, float maxPosition) { _skew = max(0.0f, maxPosition - minPosition); _peakSkew = max(_peakSkew, _skew); }
+};
+
+
+// PID Driver
+// The PID driver manages a direction-based actuator list in closed-loop, driving actuators by
+// the output of a PID controller acting upon the mean position reported by actuators' position
+// sensors. Integration is clamped for anti-windup (halting while output is saturated in same
+// direction), the derivative term acts upon a low-pass filtered measurement (avoiding set-point
+// kick), and outputs within deadband are dropped (halting actuation). Variable speed motors are
+// driven by output directly, while relay motors are run whenever output exceeds deadband.
+// Max difference handling between leading and trailing actuators is as incremental driver.
+// All actuators must have position data (be derived from HelioPositionSensorAttachmentInterface).
+class HelioPIDDriver : public HelioIncrementalDriver {
+public:
+    HelioPIDDriver(float propGain = HELIO_DRV_PID_PROPGAIN,
+                   float intGain = HELIO_DRV_PID_INTGAIN,
+                   float derivGain = HELIO_DRV_PID_DERIVGAIN,
+                   float derivFilter = HELIO_DRV_PID_DERIVFILTER,
+                   float outputDeadband = HELIO_DRV_PID_DEADBAND,
+                   float alignedRange = 0.05f,
+                   float maxDifference = 2.5f,
+                   float travelRate = 1.0f,
+                   int type = PID);
+    HelioPIDDriver(const HelioDriverSubData *dataIn);
+    virtual ~HelioPIDDriver();
+
+    virtual void saveToData(HelioDriverSubData *dataOut) const override;
+
+    virtual void setEnabled(bool enabled) override;
+
+    inline void setGains(float propGain, float intGain, float derivGain) { _gains[0] = propGain; _gains[1] = intGain; _gains[2] = derivGain; bumpRevisionIfNeeded(); }
+    inline const float *getGains() const { return _gains; }
+    inline void setDerivativeFilter(float derivFilter) { _derivFilter = derivFilter; bumpRevisionIfNeeded(); }
+    inline float getDerivativeFilter() const { return _derivFilter; }
+    inline void setOutputDeadband(float outputDeadband) { _outputDeadband = outputDeadband; bumpRevisionIfNeeded(); }
+    inline float getOutputDeadband() const { return _outputDeadband; }
+
+    // Advances controller by dt seconds given measured position, returning saturated output
+    // (+/-travel rate, or 0 if within output deadband). Called by driver each update, but
+    // usable on its own (e.g. against a simulated actuator plant).
+    float updateOutput(float position, float dt);
+    // Resets controller state (integral, derivative filter, last position)
+    void resetOutput();
+
+    inline float getOutput() const { return _output; }
+    inline uint16_t getActuationCount() const { return _actuations; }
+    inline void resetActuationCount() { _actuations = 0; }
+
+protected:
+    float _gains[3];                                        // PID gains (prop, int, deriv)
+    float _derivFilter;                                     // Derivative low-pass filter time constant (sec)
+    float _outputDeadband;                                  // Output deadband (travel rate units)
+    float _integral;                                        // Integral term accumulator (travel rate units)
+    float _derivative;                                      // Filtered derivative of measurement (distance units / sec)
+    float _lastPosition;                                    // Last measured position, else FLT_UNDEF
+    float _output;                                          // Last controller output
+    uint16_t _actuations;                                   // Actuation count (activation starts and reversals)
 
     virtual void handleMaxOffset(float maxOffset) override;
 };
 
+
+// Driver Serialization Sub Data
+// Stored as part of panel data for panel axis drivers.
+struct HelioDriverSubData : public HelioSubData {
+    float travelRate;                                       // Travel rate
+    float nearbyRange;                                      // Nearby target range (incremental/PID)
+    float alignedRange;                                     // Aligned to target range (incremental/PID)
+    float maxDifference;                                    // Maximum positional difference (incremental/PID)
+    float syncGain;                                         // Synchronized mode lead gain, else 0/disabled (incremental/PID)
+    float pidGains[3];                                      // PID gains (prop, int, deriv) (PID)
+    float derivFilter;                                      // Derivative filter time constant (PID)
+    float outputDeadband;                                   // Output deadband (PID)
+
+    HelioDriverSubData();
+    virtual void toJSONObject(JsonObject &objectOut) const;
+    virtual void fromJSONObject(JsonObjectConst &objectIn);
+};
+
 #endif // /ifndef HelioDrivers_H
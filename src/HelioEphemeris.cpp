@@ -0,0 +1,226 @@
+/*  Helioduino: Simple automation controller for solar tracking systems.
+    Copyright (C) 2023 NachtRaveVL          <nachtravevl@gmail.com>
+    Helioduino Ephemeris
+*/
+
+#include "Helioduino.h"
+
+void calcSunPosition(time_t unixTime, double latitude, double longitude, double *sunPositionOut)
+{
+    #ifndef HELIO_ENABLE_FLOAT_SUNPOS
+        JulianDay julianTime((unsigned long)unixTime);
+
+        if (latitude != DBL_UNDEF && longitude != DBL_UNDEF) {
+            calcHorizontalCoordinates(julianTime, latitude, longitude, sunPositionOut[0], sunPositionOut[1]);
+        } else {
+            double radius;
+            calcEquatorialCoordinates(julianTime, sunPositionOut[0], sunPositionOut[1], radius);
+        }
+    #else
+        float sunPosition[2];
+        calcSunPositionFloat(unixTime, latitude != DBL_UNDEF ? (float)latitude : FLT_UNDEF,
+                             longitude != DBL_UNDEF ? (float)longitude : FLT_UNDEF, sunPosition);
+        sunPositionOut[0] = sunPosition[0];
+        sunPositionOut[1] = sunPosition[1];
+    #endif
+}
+
+// Applies a degrees-per-day rate across whole+fractional days, keeping single-precision accuracy by applying the rate's
+// leading 0.9856 deg/day (+ whole turns) in exact integer 1e-4 deg units, with only the small remainder applied in float.
+static inline float sunDailyAngleFloat(int32_t days, float dayFrac, float rateRemainder, float rate)
+{
+    return ((int32_t)((9856L * days) % 3600000L) / 10000.0f) + (rateRemainder * days) + (rate * dayFrac);
+}
+
+void calcSunPositionFloat(time_t unixTime, float latitude, float longitude, float *sunPositionOut)
+{
+    const float degToRad = (float)DEG_TO_RAD, radToDeg = (float)RAD_TO_DEG; // radians()/degrees() would promote to double
+
+    // split time since J2000.0 epoch (2000-01-01 12:00 UTC) into whole & fractional days
+    int32_t secs = (int32_t)(unixTime - 946728000L);
+    int32_t days = secs / (int32_t)SECS_PER_DAY;
+    if (secs < days * (int32_t)SECS_PER_DAY) { --days; }
+    float dayFrac = (secs - (days * (int32_t)SECS_PER_DAY)) / (float)SECS_PER_DAY;
+    float T = (days + dayFrac) / 36525.0f;
+
+    float meanLong = 280.46646f + sunDailyAngleFloat(days, dayFrac, 0.00004736016f, 0.98564736016f) + (0.0003032f * T * T);
+    float meanAnomaly = (357.52911f + sunDailyAngleFloat(days, dayFrac, 0.00000028172f, 0.98560028172f) - (0.0001537f * T * T)) * degToRad;
+    float center = (sinf(meanAnomaly) * (1.914602f - T * (0.004817f + (0.000014f * T)))) +
+                   (sinf(2.0f * meanAnomaly) * (0.019993f - (0.000101f * T))) + (sinf(3.0f * meanAnomaly) * 0.000289f);
+    float omega = (125.04f - (0.05295375770f * (days + dayFrac))) * degToRad;
+    float lambda = (meanLong + center - 0.00569f - (0.00478f * sinf(omega))) * degToRad;
+    float epsilon = (23.0f + ((26.0f + ((21.448f - T * (46.815f + T * (0.00059f - (T * 0.001813f)))) / 60.0f)) / 60.0f) + (0.00256f * cosf(omega))) * degToRad;
+    float rightAscension = atan2f(cosf(epsilon) * sinf(lambda), cosf(lambda)) * radToDeg;
+    float declination = asinf(sinf(epsilon) * sinf(lambda)) * radToDeg;
+
+    if (latitude != FLT_UNDEF && longitude != FLT_UNDEF) {
+        float siderealTime = 280.46061837f + sunDailyAngleFloat(days, dayFrac, 0.00004736629f, 360.98564736629f) + (0.000387933f * T * T);
+        float H = (siderealTime + longitude - rightAscension) * degToRad;
+        float lat = latitude * degToRad, dec = declination * degToRad;
+        float elevation = asinf((sinf(lat) * sinf(dec)) + (cosf(lat) * cosf(dec) * cosf(H))) * radToDeg;
+        float tanEle = tanf(elevation * degToRad);
+        float refraction = elevation > 85.0f ? 0.0f
+                         : elevation > 5.0f ? (58.1f / tanEle) - (0.07f / (tanEle * tanEle * tanEle)) + (0.000086f / (tanEle * tanEle * tanEle * tanEle * tanEle))
+                         : elevation > -0.575f ? 1735.0f + elevation * (-518.2f + elevation * (103.4f + elevation * (-12.79f + (elevation * 0.711f))))
+                         : -20.772f / tanEle;
+
+        sunPositionOut[0] = 180.0f + atan2f(sinf(H), (cosf(H) * sinf(lat)) - (tanf(dec) * cosf(lat))) * radToDeg;
+        sunPositionOut[1] = elevation + (refraction / 3600.0f);
+    } else {
+        sunPositionOut[0] = rightAscension;
+        sunPositionOut[1] = declination;
+    }
+    sunPositionOut[0] -= 360.0f * floorf(sunPositionOut[0] / 360.0f);
+}
+
+
+// Batch kernel helpers, kept branch-free (selects over branches, floor over loops) so that loops stay vectorizable
+
+static inline double sunWrapBy360(double value) { return value - (360.0 * floor(value / 360.0)); }
+
+static inline double sunCenturies(double julianDay) { return (julianDay - 2451545.0) / 36525.0; }
+
+static inline double sunSiderealTime(double julianDay, double centuries)
+{
+    return sunWrapBy360(280.46061837 + (360.98564736629 * (julianDay - 2451545.0)) + (centuries * centuries * (0.000387933 - (centuries / 38710000.0))));
+}
+
+static inline void sunEquatorialCoords(double julianDay, double &rightAscension, double &declination)
+{
+    double T = sunCenturies(julianDay);
+    double meanLong = 280.46646 + T * (36000.76983 + (0.0003032 * T));
+    double meanAnomaly = radians(357.52911 + T * (35999.05029 - (0.0001537 * T)));
+    double center = (sin(meanAnomaly) * (1.914602 - T * (0.004817 + (0.000014 * T)))) +
+                    (sin(2.0 * meanAnomaly) * (0.019993 - (0.000101 * T))) + (sin(3.0 * meanAnomaly) * 0.000289);
+    double omega = radians(125.04 - (1934.136 * T));
+    double lambda = radians(meanLong + center - 0.00569 - (0.00478 * sin(omega)));
+    double epsilon = radians(23.0 + ((26.0 + ((21.448 - T * (46.815 + T * (0.00059 - (T * 0.001813)))) / 60.0)) / 60.0) + (0.00256 * cos(omega)));
+
+    rightAscension = sunWrapBy360(degrees(atan2(cos(epsilon) * sin(lambda), cos(lambda))));
+    declination = degrees(asin(sin(epsilon) * sin(lambda)));
+}
+
+static inline void sunHorizontalCoords(double hourAngle, double latitude, double declination, double &azimuth, double &elevation)
+{
+    double H = radians(hourAngle), lat = radians(latitude), dec = radians(declination);
+
+    azimuth = sunWrapBy360(180.0 + degrees(atan2(sin(H), (cos(H) * sin(lat)) - (tan(dec) * cos(lat)))));
+    elevation = degrees(asin((sin(lat) * sin(dec)) + (cos(lat) * cos(dec) * cos(H))));
+
+    // atmospheric refraction (same piecewise model as scalar path), evaluated as selects
+    double tanEle = tan(radians(elevation));
+    double refraction = elevation > 85.0 ? 0.0
+                      : elevation > 5.0 ? (58.1 / tanEle) - (0.07 / (tanEle * tanEle * tanEle)) + (0.000086 / (tanEle * tanEle * tanEle * tanEle * tanEle))
+                      : elevation > -0.575 ? 1735.0 + elevation * (-518.2 + elevation * (103.4 + elevation * (-12.79 + (elevation * 0.711))))
+                      : -20.772 / tanEle;
+    elevation += refraction / 3600.0;
+}
+
+void calcSunPositions(const double *julianDays, double *rightAscensionsOut, double *declinationsOut, size_t count)
+{
+    for (size_t index = 0; index < count; ++index) {
+        sunEquatorialCoords(julianDays[index], rightAscensionsOut[index], declinationsOut[index]);
+    }
+}
+
+void calcSunPositions(const double *julianDays, const double *latitudes, const double *longitudes, double *azimuthsOut, double *elevationsOut, size_t count)
+{
+    calcSunPositions(julianDays, azimuthsOut, elevationsOut, count);
+
+    for (size_t index = 0; index < count; ++index) {
+        double hourAngle = sunSiderealTime(julianDays[index], sunCenturies(julianDays[index])) + longitudes[index] - azimuthsOut[index];
+        sunHorizontalCoords(hourAngle, latitudes[index], elevationsOut[index], azimuthsOut[index], elevationsOut[index]);
+    }
+}
+
+void calcSunPositions(const double *julianDays, double latitude, double longitude, double *azimuthsOut, double *elevationsOut, size_t count)
+{
+    calcSunPositions(julianDays, azimuthsOut, elevationsOut, count);
+
+    for (size_t index = 0; index < count; ++index) {
+        double hourAngle = sunSiderealTime(julianDays[index], sunCenturies(julianDays[index])) + longitude - azimuthsOut[index];
+        sunHorizontalCoords(hourAngle, latitude, elevationsOut[index], azimuthsOut[index], elevationsOut[index]);
+    }
+}
+
+void calcSunPositions(double julianDay, const double *latitudes, const double *longitudes, double *azimuthsOut, double *elevationsOut, size_t count)
+{
+    double rightAscension, declination;
+    sunEquatorialCoords(julianDay, rightAscension, declination);
+    double siderealTime = sunSiderealTime(julianDay, sunCenturies(julianDay));
+
+    for (size_t index = 0; index < count; ++index) {
+        sunHorizontalCoords(siderealTime + longitudes[index] - rightAscension, latitudes[index], declination, azimuthsOut[index], elevationsOut[index]);
+    }
+}
+
+
+HelioEphemerisCache::HelioEphemerisCache(uint8_t stepMins)
+    : _dayStart(0), _latitude(DBL_UNDEF), _longitude(DBL_UNDEF), _samples(nullptr),
+      _sampleCount(stepMins ? ((MIN_PER_DAY + stepMins - 1) / stepMins) + 3 : 0), _stepMins(stepMins)
+{
+    HELIO_SOFT_ASSERT(stepMins, SFP(HStr_Err_InvalidParameter));
+}
+
+HelioEphemerisCache::~HelioEphemerisCache()
+{
+    clear();
+}
+
+bool HelioEphemerisCache::rebuild(time_t unixTime, double latitude, double longitude)
+{
+    if (!_sampleCount) { return false; }
+    if (!_samples) {
+        _samples = new float[_sampleCount << 1];
+        HELIO_SOFT_ASSERT(_samples, SFP(HStr_Err_AllocationFailure));
+        if (!_samples) { return false; }
+    }
+
+    _dayStart = unixTime - (unixTime % SECS_PER_DAY);
+    _latitude = latitude;
+    _longitude = longitude;
+
+    float *axis1 = &_samples[0];
+    float *axis2 = &_samples[_sampleCount];
+    time_t sampleTime = _dayStart - (_stepMins * SECS_PER_MIN); // 1 leading pad sample for tangents
+    double sunPosition[2];
+
+    for (uint16_t sampleIndex = 0; sampleIndex < _sampleCount; ++sampleIndex, sampleTime += _stepMins * SECS_PER_MIN) {
+        calcSunPosition(sampleTime, latitude, longitude, sunPosition);
+
+        // azi/RA is unwrapped against previous sample so that interpolation doesn't cross the 360->0 seam
+        axis1[sampleIndex] = sampleIndex ? axis1[sampleIndex-1] + wrapBy180Neg180<double>(sunPosition[0] - axis1[sampleIndex-1]) : sunPosition[0];
+        axis2[sampleIndex] = sunPosition[1];
+    }
+
+    return true;
+}
+
+void HelioEphemerisCache::clear()
+{
+    if (_samples) { delete [] _samples; _samples = nullptr; }
+    _dayStart = 0;
+}
+
+bool HelioEphemerisCache::lookup(time_t unixTime, double *sunPositionOut, double latitude, double longitude) const
+{
+    if (containsTime(unixTime) && _latitude == latitude && _longitude == longitude) {
+        time_t stepSecs = _stepMins * SECS_PER_MIN;
+        time_t dayTime = unixTime - _dayStart;
+        uint16_t sampleIndex = dayTime / stepSecs; // p1 is sampleIndex+1 due to leading pad sample
+        float t = (dayTime - (sampleIndex * stepSecs)) / (float)stepSecs;
+        float t2 = t * t, t3 = t2 * t;
+        float h00 = 2*t3 - 3*t2 + 1, h10 = t3 - 2*t2 + t, h01 = -2*t3 + 3*t2, h11 = t3 - t2;
+
+        for (uint8_t axisIndex = 0; axisIndex < 2; ++axisIndex) {
+            const float *p = &_samples[(axisIndex * _sampleCount) + sampleIndex];
+            float m1 = (p[2] - p[0]) * 0.5f; // Catmull-Rom tangents
+            float m2 = (p[3] - p[1]) * 0.5f;
+            sunPositionOut[axisIndex] = (h00 * p[1]) + (h10 * m1) + (h01 * p[2]) + (h11 * m2);
+        }
+        sunPositionOut[0] = wrapBy360(sunPositionOut[0]);
+
+        return true;
+    }
+    return false;
+}
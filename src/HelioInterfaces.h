@@ -68,7 +68,7 @@ struct HelioJSONSerializableInterface {
 
 
 // Object Interface
-class HelioObjInterface {
+class HelioObjInterface : public HelioRefCounted {
 public:
     virtual void unresolveAny(HelioObject *obj) = 0;
 
@@ -4,11 +4,431 @@
 */
 
 #include "Helioduino.h"
+#if defined(__AVR__)
+#include <util/atomic.h>
+#elif defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#endif
+
+#if HELIO_LOG_RING_SIZE && HELIO_LOG_RING_NOINIT
+static HelioLogRingControl _logRingControl NOINIT_ATTR;     // Log ring control block, in no-init RAM
+static uint8_t _logRingData[HELIO_LOG_RING_SIZE] NOINIT_ATTR; // Log ring data, in no-init RAM
+#endif
+
+// Returns log line prefix string for log level
+static inline Helio_String logLevelPrefix(Helio_LogLevel level)
+{
+    return level == Helio_LogLevel_Errors ? HStr_Log_Prefix_Error : level == Helio_LogLevel_Warnings ? HStr_Log_Prefix_Warning : HStr_Log_Prefix_Info;
+}
+
+// Writes value into byteCount # of little-endian bytes, returning position after
+static inline uint8_t *putLogLE(uint8_t *buffer, uint32_t value, uint8_t byteCount)
+{
+    for (uint8_t byteIndex = 0; byteIndex < byteCount; ++byteIndex) { *buffer++ = (uint8_t)(value >> (8 * byteIndex)); }
+    return buffer;
+}
+
+// Reads value from byteCount # of little-endian bytes
+static inline uint32_t getLogLE(const uint8_t *buffer, uint8_t byteCount)
+{
+    uint32_t value = 0;
+    for (uint8_t byteIndex = 0; byteIndex < byteCount; ++byteIndex) { value |= (uint32_t)buffer[byteIndex] << (8 * byteIndex); }
+    return value;
+}
+
+// Loads log ring position shared between contexts (16-bit access isn't atomic on 8-bit AVR)
+static inline uint16_t loadRingPosition(const volatile uint16_t &position)
+{
+    #if defined(__AVR__)
+        uint16_t value;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { value = position; }
+        return value;
+    #else
+        return position;
+    #endif
+}
+
+// Stores log ring position shared between contexts (16-bit access isn't atomic on 8-bit AVR)
+static inline void storeRingPosition(volatile uint16_t &position, uint16_t value)
+{
+    #if defined(__AVR__)
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { position = value; }
+    #else
+        position = value;
+    #endif
+}
+
+// Returns if running from main context, i.e. not from inside an interrupt handler nor with interrupts disabled, where
+// blocking file writes (or anything else that may wait on interrupts) must be avoided
+static inline bool isMainContext()
+{
+    #if defined(__AVR__)
+        return SREG & _BV(SREG_I); // cleared upon ISR entry, as well as inside atomic blocks
+    #elif defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_BASE__) || defined(__ARM_ARCH_8M_MAIN__)
+        uint32_t ipsr, primask;
+        __asm__ volatile ("mrs %0, ipsr" : "=r" (ipsr));
+        __asm__ volatile ("mrs %0, primask" : "=r" (primask));
+        return !ipsr && !(primask & 1); // exception number, else 0 in thread mode
+    #elif defined(ESP32)
+        return !xPortInIsrContext();
+    #else
+        return true;
+    #endif
+}
+
+// Print sink that appends output onto a String, for formatting records into log events
+class HelioLogStringPrint : public Print {
+public:
+    HelioLogStringPrint(String &strIn) : _str(strIn) { ; }
+
+    virtual size_t write(uint8_t data) override { _str.concat((char)data); return 1; }
+
+protected:
+    String &_str;
+};
+
 
 HelioLogEvent::HelioLogEvent(Helio_LogLevel levelIn, const String &prefixIn, const String &msgIn, const String &suffix1In, const String &suffix2In)
     : level(levelIn), timestamp(localNow().timestamp(DateTime::TIMESTAMP_FULL)), prefix(prefixIn), msg(msgIn), suffix1(suffix1In), suffix2(suffix2In)
 { ; }
 
+HelioLogEvent::HelioLogEvent(const HelioLogRecord &record)
+    : level(record.level), timestamp(localTime(record.timestamp).timestamp(DateTime::TIMESTAMP_FULL)), prefix(SFP(logLevelPrefix(record.level))), msg(), suffix1(), suffix2()
+{
+    // object, message, then arguments fill msg, suffix1, and suffix2 in order (remainder all going into suffix2), with
+    // empty text arguments still taking up their field so that suffix positions are kept (see HelioLogger::logMessage)
+    String *fields[3] = { &msg, &suffix1, &suffix2 };
+    uint8_t fieldIndex = 0;
+
+    if (record.objKey != hkey_none) { msg = HelioLogger::getKeyDisplayString(record.objKey); fieldIndex++; }
+    if (record.msgId < HStr_Count) { *fields[fieldIndex++] = SFP(record.msgId); }
+    for (int argIndex = 0; argIndex < record.argCount; ++argIndex) {
+        HelioLogStringPrint fieldOut(*fields[fieldIndex]);
+        record.args[argIndex].printTo(fieldOut);
+        if (fieldIndex < 2) { fieldIndex++; }
+    }
+}
+
+
+void HelioLogArg::printTo(Print &out) const
+{
+    switch (type) {
+        case Helio_LogArgType_Int:
+            out.print((long)intValue);
+            break;
+        case Helio_LogArgType_UInt:
+            out.print((unsigned long)uintValue);
+            break;
+        case Helio_LogArgType_Float:
+            out.print(floatValue);
+            break;
+        case Helio_LogArgType_String:
+            out.print(SFP(stringId));
+            break;
+        case Helio_LogArgType_Key:
+            out.print(HelioLogger::getKeyDisplayString(keyValue));
+            break;
+        case Helio_LogArgType_Text:
+            if (textLength) { out.write((const uint8_t *)text, textLength); }
+            break;
+        default:
+            break;
+    }
+}
+
+
+HelioLogRecord::HelioLogRecord()
+    : level(Helio_LogLevel_Info), timestamp(0), msgId(HStr_Count), objKey(hkey_none), argCount(0), args()
+{ ; }
+
+HelioLogRecord::HelioLogRecord(Helio_LogLevel levelIn, Helio_String msgIdIn, hkey_t objKeyIn,
+                               const HelioLogArg &arg1, const HelioLogArg &arg2, const HelioLogArg &arg3, const HelioLogArg &arg4)
+    : level(levelIn), timestamp(unixNow()), msgId(msgIdIn), objKey(objKeyIn), argCount(0), args()
+{
+    const HelioLogArg *argsIn[4] = { &arg1, &arg2, &arg3, &arg4 };
+    for (int argIndex = 0; argIndex < 4 && argCount < HELIO_LOG_RECORD_MAXARGS; ++argIndex) {
+        if (argsIn[argIndex]->type != Helio_LogArgType_Undefined) { args[argCount++] = *argsIn[argIndex]; }
+    }
+}
+
+uint8_t HelioLogRecord::encode(uint8_t *bufferOut) const
+{
+    uint8_t *bufferPos = bufferOut + 1; // length filled in last
+    *bufferPos++ = (uint8_t)(int8_t)level;
+    bufferPos = putLogLE(bufferPos, (uint32_t)timestamp, 4);
+    bufferPos = putLogLE(bufferPos, msgId < HStr_Count ? (uint16_t)msgId : UINT16_MAX, 2);
+    bufferPos = putLogLE(bufferPos, objKey, 4);
+    uint8_t *argCountPos = bufferPos++;
+    *argCountPos = 0;
+
+    for (int argIndex = 0; argIndex < argCount; ++argIndex) {
+        const HelioLogArg &arg = args[argIndex];
+        uint8_t remaining = HELIO_LOG_RECORD_MAXSIZE - (uint8_t)(bufferPos - bufferOut);
+        if (remaining < (arg.type == Helio_LogArgType_Text ? 2 : arg.type == Helio_LogArgType_String ? 3 : 5)) { break; }
+
+        *bufferPos++ = (uint8_t)arg.type;
+        switch (arg.type) {
+            case Helio_LogArgType_String:
+                bufferPos = putLogLE(bufferPos, (uint16_t)arg.stringId, 2);
+                break;
+            case Helio_LogArgType_Text: {
+                uint8_t textLength = (uint8_t)min(arg.textLength, (uint16_t)(remaining - 2));
+                *bufferPos++ = textLength;
+                if (textLength) { memcpy(bufferPos, arg.text, textLength); bufferPos += textLength; }
+            } break;
+            default: // shared 32-bit value storage
+                bufferPos = putLogLE(bufferPos, arg.uintValue, 4);
+                break;
+        }
+        (*argCountPos)++;
+    }
+
+    bufferOut[0] = (uint8_t)(bufferPos - bufferOut);
+    return bufferOut[0];
+}
+
+uint8_t HelioLogRecord::decode(const uint8_t *buffer, uint8_t length)
+{
+    if (length < 13 || buffer[0] < 13 || buffer[0] > length || buffer[1] == NameRecordType) { return 0; }
+    const uint8_t *bufferEnd = buffer + buffer[0];
+
+    level = (Helio_LogLevel)(int8_t)buffer[1];
+    timestamp = (time_t)getLogLE(buffer + 2, 4);
+    uint16_t msgIdValue = (uint16_t)getLogLE(buffer + 6, 2);
+    msgId = msgIdValue < HStr_Count ? (Helio_String)msgIdValue : HStr_Count;
+    objKey = (hkey_t)getLogLE(buffer + 8, 4);
+    argCount = 0;
+
+    const uint8_t *bufferPos = buffer + 13;
+    for (int argIndex = 0; argIndex < buffer[12] && argIndex < HELIO_LOG_RECORD_MAXARGS; ++argIndex) {
+        if (bufferPos >= bufferEnd) { return 0; }
+        HelioLogArg &arg = args[argCount];
+        arg.type = (Helio_LogArgType)(int8_t)*bufferPos++;
+        arg.textLength = 0;
+
+        switch (arg.type) {
+            case Helio_LogArgType_String:
+                if (bufferPos + 2 > bufferEnd) { return 0; }
+                arg.stringId = (Helio_String)getLogLE(bufferPos, 2);
+                if (arg.stringId >= HStr_Count) { arg.stringId = HStr_Undefined; }
+                bufferPos += 2;
+                break;
+            case Helio_LogArgType_Text:
+                if (bufferPos + 1 > bufferEnd || bufferPos + 1 + *bufferPos > bufferEnd) { return 0; }
+                arg.textLength = *bufferPos++;
+                arg.text = (const char *)bufferPos;
+                bufferPos += arg.textLength;
+                break;
+            case Helio_LogArgType_Int:
+            case Helio_LogArgType_UInt:
+            case Helio_LogArgType_Float:
+            case Helio_LogArgType_Key:
+                if (bufferPos + 4 > bufferEnd) { return 0; }
+                arg.uintValue = getLogLE(bufferPos, 4);
+                bufferPos += 4;
+                break;
+            default:
+                return 0;
+        }
+        argCount++;
+    }
+
+    return buffer[0];
+}
+
+uint16_t HelioLogRecord::getEncodedSize() const
+{
+    uint32_t size = 13;
+    for (int argIndex = 0; argIndex < argCount; ++argIndex) {
+        size += args[argIndex].type == Helio_LogArgType_Text ? 2 + (uint32_t)args[argIndex].textLength : args[argIndex].type == Helio_LogArgType_String ? 3 : 5;
+    }
+    return (uint16_t)min(size, (uint32_t)UINT16_MAX);
+}
+
+void HelioLogRecord::printTo(Print &out) const
+{
+    out.print(SFP(logLevelPrefix(level)));
+    if (objKey != hkey_none) { out.print(HelioLogger::getKeyDisplayString(objKey)); }
+    if (msgId < HStr_Count) { out.print(SFP(msgId)); }
+    for (int argIndex = 0; argIndex < argCount; ++argIndex) { args[argIndex].printTo(out); }
+}
+
+
+HelioLogRing::HelioLogRing(uint16_t capacity)
+    : _control(new HelioLogRingControl()), _data(nullptr), _capacity(capacity), _recovered(0), _dropped(0), _reclaimed(0), _pushing(false), _owned(true)
+{
+    HELIO_SOFT_ASSERT(!(_capacity & (_capacity - 1)), SFP(HStr_Err_InvalidParameter));
+    while (_capacity & (_capacity - 1)) { _capacity &= _capacity - 1; } // round down to power of 2
+    _data = _capacity ? new uint8_t[_capacity] : nullptr;
+    HELIO_SOFT_ASSERT(_control && (_data || !_capacity), SFP(HStr_Err_AllocationFailure));
+    if (!_control || !_data) { _capacity = 0; }
+    if (_control) { clear(); }
+}
+
+HelioLogRing::HelioLogRing(HelioLogRingControl *control, uint8_t *data, uint16_t capacity)
+    : _control(control), _data(data), _capacity(capacity), _recovered(0), _dropped(0), _reclaimed(0), _pushing(false), _owned(false)
+{
+    HELIO_SOFT_ASSERT(!(_capacity & (_capacity - 1)), SFP(HStr_Err_InvalidParameter));
+    while (_capacity & (_capacity - 1)) { _capacity &= _capacity - 1; }
+    _recovered = recover();
+}
+
+HelioLogRing::~HelioLogRing()
+{
+    if (_owned) {
+        if (_data) { delete [] _data; _data = nullptr; }
+        if (_control) { delete _control; _control = nullptr; }
+    }
+}
+
+bool HelioLogRing::push(const uint8_t *record, uint8_t length)
+{
+    if (_pushing || !length || length > HELIO_LOG_RECORD_MAXSIZE || length > _capacity) { _dropped++; return false; }
+    _pushing = true; // interrupting pushes drop instead of interleaving (producers only preempt each other as interrupts do)
+
+    uint16_t head = _control->head;
+    bool pushed = (uint16_t)(head - loadRingPosition(_control->tail)) + length <= _capacity;
+
+    if (pushed) {
+        while ((uint16_t)(head - _control->oldest) + length > _capacity) { // reclaim oldest drained records
+            _control->oldest += _data[_control->oldest & (_capacity - 1)];
+            _control->count--;
+            storeRingPosition(_reclaimed, _reclaimed + 1); // invalidates reads in progress
+        }
+
+        uint16_t offset = head & (_capacity - 1);
+        uint16_t firstLength = min((uint16_t)length, (uint16_t)(_capacity - offset));
+        memcpy(&_data[offset], record, firstLength);
+        if (length > firstLength) { memcpy(&_data[0], &record[firstLength], length - firstLength); }
+
+        __sync_synchronize(); // record in place before head published
+        storeRingPosition(_control->head, head + length);
+        _control->count++;
+    } else {
+        _dropped++;
+    }
+
+    _pushing = false;
+    return pushed;
+}
+
+uint8_t HelioLogRing::drainNext(uint16_t *position, uint8_t *bufferOut) const
+{
+    if (*position == loadRingPosition(_control->head)) { return 0; }
+    __sync_synchronize(); // head read before record
+
+    uint8_t length = _data[*position & (_capacity - 1)];
+    copyOut(*position, length, bufferOut);
+    *position += length;
+    return length;
+}
+
+void HelioLogRing::commitDrain(uint16_t position)
+{
+    __sync_synchronize(); // records read out before tail published
+    storeRingPosition(_control->tail, position);
+}
+
+bool HelioLogRing::hasUndrained() const
+{
+    return _control->tail != loadRingPosition(_control->head);
+}
+
+bool HelioLogRing::hasRoom(uint8_t length) const
+{
+    return (uint16_t)(loadRingPosition(_control->head) - _control->tail) + length <= _capacity;
+}
+
+uint16_t HelioLogRing::dropUndrained(uint8_t length)
+{
+    uint16_t dropped = 0;
+    uint16_t position = _control->tail;
+
+    while (!hasRoom(length) && position != loadRingPosition(_control->head)) {
+        position += _data[position & (_capacity - 1)];
+        storeRingPosition(_control->tail, position);
+        _dropped++; dropped++;
+    }
+
+    return dropped;
+}
+
+uint16_t HelioLogRing::getOldestSequence() const
+{
+    return loadRingPosition(_reclaimed);
+}
+
+uint8_t HelioLogRing::copyRecordSeq(uint16_t sequence, uint8_t *bufferOut) const
+{
+    for (int tries = 0; tries < 3; ++tries) { // retried while interrupting pushes reclaim records mid-read
+        uint16_t reclaimed = loadRingPosition(_reclaimed);
+        uint16_t index = sequence - reclaimed;
+        if (index >= _control->count) { return 0; }
+        uint16_t position = _control->oldest;
+        while (index--) { position += _data[position & (_capacity - 1)]; }
+
+        uint8_t length = _data[position & (_capacity - 1)];
+        if (length && length <= HELIO_LOG_RECORD_MAXSIZE) { copyOut(position, length, bufferOut); }
+
+        __sync_synchronize(); // record read out before reclaims rechecked
+        if (loadRingPosition(_reclaimed) == reclaimed) { return length <= HELIO_LOG_RECORD_MAXSIZE ? length : 0; }
+    }
+    return 0;
+}
+
+bool HelioLogRing::readRecordSeq(uint16_t sequence, HelioLogRecord *recordOut, uint8_t *bufferOut) const
+{
+    uint8_t length = copyRecordSeq(sequence, bufferOut);
+    return length && recordOut && recordOut->decode(bufferOut, length);
+}
+
+void HelioLogRing::clear()
+{
+    _control->signature = Signature ^ _capacity;
+    _control->head = _control->tail = _control->oldest = 0;
+    _control->count = 0;
+}
+
+uint16_t HelioLogRing::recover()
+{
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    HelioLogRecord record;
+    uint16_t head = _control->head, tail = _control->tail, position = _control->oldest;
+    uint16_t count = 0, undrained = 0;
+    bool valid = _capacity && _control->signature == (Signature ^ _capacity) && (uint16_t)(head - position) <= _capacity;
+    bool tailFound = false;
+
+    while (valid && position != head) { // walk retained records, validating each
+        uint8_t length = _data[position & (_capacity - 1)];
+        if (position == tail) { tailFound = true; }
+
+        valid = length && length <= HELIO_LOG_RECORD_MAXSIZE && length <= (uint16_t)(head - position);
+        if (valid) {
+            copyOut(position, length, buffer);
+            valid = record.decode(buffer, length);
+        }
+        if (valid) {
+            position += length;
+            count++;
+            if (tailFound) { undrained++; }
+        }
+    }
+
+    if (!valid || !(tailFound || tail == head) || count != _control->count) { // cold boot (or corrupted), start empty
+        clear();
+        return 0;
+    }
+    return undrained;
+}
+
+void HelioLogRing::copyOut(uint16_t position, uint8_t length, uint8_t *bufferOut) const
+{
+    uint16_t offset = position & (_capacity - 1);
+    uint16_t firstLength = min((uint16_t)length, (uint16_t)(_capacity - offset));
+    memcpy(bufferOut, &_data[offset], firstLength);
+    if (length > firstLength) { memcpy(&bufferOut[firstLength], &_data[0], length - firstLength); }
+}
+
 
 HelioLogger::HelioLogger() :
 #if HELIO_SYS_LEAVE_FILES_OPEN
@@ -17,26 +437,24 @@ HelioLogger::HelioLogger() :
     _logFileWS(nullptr),
 #endif
 #endif
-    _logFilename(), _initTime(0), _lastSpaceCheck(0)
-{ ; }
+    _logFilename(), _initTime(0), _lastSpaceCheck(0), _logRing(nullptr), _namedKeys(), _contextDropped(0), _draining(false), _recoveryLogged(false), _droppedLogged(0)
+{
+    #if HELIO_LOG_RING_SIZE
+        #if HELIO_LOG_RING_NOINIT
+            _logRing = new HelioLogRing(&_logRingControl, _logRingData, HELIO_LOG_RING_SIZE);
+        #else
+            _logRing = new HelioLogRing();
+        #endif
+        HELIO_SOFT_ASSERT(_logRing, SFP(HStr_Err_AllocationFailure));
+        if (_logRing && !_logRing->getCapacity()) { delete _logRing; _logRing = nullptr; }
+    #endif
+}
 
 HelioLogger::~HelioLogger()
 {
     flush();
-
-    #if HELIO_SYS_LEAVE_FILES_OPEN
-        if (_logFileSD) {
-            _logFileSD->close();
-            delete _logFileSD; _logFileSD = nullptr;
-            Helioduino::_activeInstance->endSDCard();
-        }
-        #ifdef HELIO_USE_WIFI_STORAGE
-            if (_logFileWS) {
-                _logFileWS->close();
-                delete _logFileWS; _logFileWS = nullptr;
-            }
-        #endif
-    #endif
+    resetLogFile();
+    if (_logRing) { delete _logRing; _logRing = nullptr; }
 }
 
 bool HelioLogger::beginLoggingToSDCard(String logFilePrefix)
@@ -47,7 +465,7 @@ bool HelioLogger::beginLoggingToSDCard(String logFilePrefix)
         auto sd = Helioduino::_activeInstance->getSDCard();
 
         if (sd) {
-            String logFilename = getYYMMDDFilename(logFilePrefix, SFP(HStr_txt));
+            String logFilename = getYYMMDDFilename(logFilePrefix, getLogFileExtension());
             createDirectoryFor(sd, logFilename);
             #if HELIO_SYS_LEAVE_FILES_OPEN
                 auto &logFile = _logFileSD ? *_logFileSD : *(_logFileSD = new File(sd->open(logFilename.c_str(), FILE_WRITE)));
@@ -85,7 +503,7 @@ bool HelioLogger::beginLoggingToWiFiStorage(String logFilePrefix)
     HELIO_SOFT_ASSERT(hasLoggerData(), SFP(HStr_Err_NotYetInitialized));
 
     if (hasLoggerData() && !loggerData()->logToWiFiStorage) {
-        String logFilename = getYYMMDDFilename(logFilePrefix, SFP(HStr_txt));
+        String logFilename = getYYMMDDFilename(logFilePrefix, getLogFileExtension());
         #if HELIO_SYS_LEAVE_FILES_OPEN
             auto &logFile = _logFileWS ? *_logFileWS : *(_logFileWS = new WiFiStorageFile(WiFiStorage.open(logFilename.c_str())));
         #else
@@ -121,40 +539,111 @@ void HelioLogger::logSystemUptime()
 
 void HelioLogger::logMessage(const String &msg, const String &suffix1, const String &suffix2)
 {
-    if (!hasLoggerData() || (loggerData()->logLevel != Helio_LogLevel_None && loggerData()->logLevel <= Helio_LogLevel_All)) {
-        log(HelioLogEvent(Helio_LogLevel_Info, SFP(HStr_Log_Prefix_Info), msg, suffix1, suffix2));
+    if (isLevelLogged(Helio_LogLevel_Info)) {
+        log(HelioLogRecord(Helio_LogLevel_Info, HStr_Count, hkey_none, HelioLogArg(msg),
+                           suffix1.length() || suffix2.length() ? HelioLogArg(suffix1) : HelioLogArg(), suffix2.length() ? HelioLogArg(suffix2) : HelioLogArg()));
     }
 }
 
 void HelioLogger::logWarning(const String &warn, const String &suffix1, const String &suffix2)
 {
-    if (!hasLoggerData() || (loggerData()->logLevel != Helio_LogLevel_None && loggerData()->logLevel <= Helio_LogLevel_Warnings)) {
-        log(HelioLogEvent(Helio_LogLevel_Warnings, SFP(HStr_Log_Prefix_Warning), warn, suffix1, suffix2));
+    if (isLevelLogged(Helio_LogLevel_Warnings)) {
+        log(HelioLogRecord(Helio_LogLevel_Warnings, HStr_Count, hkey_none, HelioLogArg(warn),
+                           suffix1.length() || suffix2.length() ? HelioLogArg(suffix1) : HelioLogArg(), suffix2.length() ? HelioLogArg(suffix2) : HelioLogArg()));
     }
 }
 
 void HelioLogger::logError(const String &err, const String &suffix1, const String &suffix2)
 {
-    if (!hasLoggerData() || (loggerData()->logLevel != Helio_LogLevel_None && loggerData()->logLevel <= Helio_LogLevel_Errors)) {
-        log(HelioLogEvent(Helio_LogLevel_Errors, SFP(HStr_Log_Prefix_Error), err, suffix1, suffix2));
+    if (isLevelLogged(Helio_LogLevel_Errors)) {
+        log(HelioLogRecord(Helio_LogLevel_Errors, HStr_Count, hkey_none, HelioLogArg(err),
+                           suffix1.length() || suffix2.length() ? HelioLogArg(suffix1) : HelioLogArg(), suffix2.length() ? HelioLogArg(suffix2) : HelioLogArg()));
     }
 }
 
-void HelioLogger::log(const HelioLogEvent &event)
+void HelioLogger::logRecord(Helio_LogLevel level, Helio_String msgId, hkey_t objKey,
+                            const HelioLogArg &arg1, const HelioLogArg &arg2, const HelioLogArg &arg3, const HelioLogArg &arg4)
 {
+    if (isLevelLogged(level)) {
+        log(HelioLogRecord(level, msgId, objKey, arg1, arg2, arg3, arg4));
+    }
+}
+
+void HelioLogger::log(const HelioLogRecord &record)
+{
+    bool mainContext = isMainContext(); // outside of main context, records are only ever queued (never drained or written out)
+
     #ifdef HELIO_ENABLE_DEBUG_OUTPUT
-        if (Serial) {
-            Serial.print(event.timestamp);
+        if (mainContext && Serial) {
+            Serial.print(localTime(record.timestamp).timestamp(DateTime::TIMESTAMP_FULL));
             Serial.print(' ');
-            Serial.print(event.prefix);
-            Serial.print(event.msg);
-            Serial.print(event.suffix1);
-            Serial.println(event.suffix2);
+            record.printTo(Serial);
+            Serial.println();
         }
     #endif
 
+    uint8_t encoded[HELIO_LOG_RECORD_MAXSIZE];
+
+    if (_logRing && (isLoggingBinary() || record.getEncodedSize() <= HELIO_LOG_RECORD_MAXSIZE)) { // queued for misc loop to drain out
+        uint8_t encodedLength = record.encode(encoded);
+
+        if (mainContext && !_logRing->hasRoom(encodedLength) && !_logRing->isPushing() && !_draining && hasLoggerData()) {
+            drainLogRing(); // overflow: drain out synchronously to make room
+            _logRing->dropUndrained(encodedLength); // storage unavailable: oldest records dropped (and counted) in favor of newest
+        }
+        _logRing->push(encoded, encodedLength);
+    } else if (mainContext) { // written out directly (also legacy text too long to queue whole, kept whole for .txt)
+        drainLogRing(); // preceding records first
+        writeOut(record, encoded, isLoggingBinary() ? record.encode(encoded) : 0);
+    } else {
+        _contextDropped++;
+    }
+}
+
+void HelioLogger::drainLogRing()
+{
+    // records are drained only once system data is available, so that any recovered from before reset make it to log files
+    if (!_logRing || _draining || !hasLoggerData() || !_logRing->hasUndrained()) { return; }
+    _draining = true;
+
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    HelioLogRecord record;
+    uint16_t position = _logRing->getDrainPosition();
+    uint16_t written = position; // drain position after last record written out (or skipped as malformed)
+    uint8_t length;
+
+    while ((length = _logRing->drainNext(&position, buffer))) {
+        if (record.decode(buffer, length) && !writeOut(record, buffer, length)) { break; } // kept undrained for next drain
+        written = position;
+    }
+
+    #if HELIO_SYS_LEAVE_FILES_OPEN
+        if (_logFileSD) { _logFileSD->flush(); } // drained records only freed once on card
+    #endif
+    _logRing->commitDrain(written);
+
+    _draining = false;
+}
+
+bool HelioLogger::writeOut(const HelioLogRecord &record, const uint8_t *encoded, uint8_t encodedLength)
+{
+    bool written = true;
+    String objName; // set if .hlb file hasn't yet named object, for naming record to precede record
+
+    if (isLoggingBinary() && (isLoggingToSDCard() || isLoggingToWiFiStorage()) &&
+        record.objKey != hkey_none && _namedKeys.size() < HELIO_SYS_OBJECTS_MAXSIZE) {
+        bool named = false;
+        for (auto keyIter = _namedKeys.begin(); keyIter != _namedKeys.end() && !named; ++keyIter) { named = (*keyIter == record.objKey); }
+
+        if (!named) {
+            objName = getKeyDisplayString(record.objKey);
+            _namedKeys.push_back(record.objKey);
+        }
+    }
+
     if (isLoggingToSDCard()) {
         auto sd = Helioduino::_activeInstance->getSDCard(HELIO_LOFS_BEGIN);
+        bool writtenSD = false;
 
         if (sd) {
             #if HELIO_SYS_LEAVE_FILES_OPEN
@@ -165,12 +654,8 @@ void HelioLogger::log(const HelioLogEvent &event)
             #endif
 
             if (logFile) {
-                logFile.print(event.timestamp);
-                logFile.print(' ');
-                logFile.print(event.prefix);
-                logFile.print(event.msg);
-                logFile.print(event.suffix1);
-                logFile.println(event.suffix2);
+                writeRecord(logFile, logFile.size(), record, encoded, encodedLength, objName);
+                writtenSD = true;
 
                 #if !HELIO_SYS_LEAVE_FILES_OPEN
                     logFile.flush();
@@ -182,6 +667,7 @@ void HelioLogger::log(const HelioLogEvent &event)
                 Helioduino::_activeInstance->endSDCard(sd);
             #endif
         }
+        written = written && writtenSD;
     }
 
 #ifdef HELIO_USE_WIFI_STORAGE
@@ -196,31 +682,78 @@ void HelioLogger::log(const HelioLogEvent &event)
         if (logFile) {
             auto logFileStream = HelioWiFiStorageFileStream(logFile, logFile.size());
 
-            logFileStream.print(event.timestamp);
-            logFileStream.print(' ');
-            logFileStream.print(event.prefix);
-            logFileStream.print(event.msg);
-            logFileStream.print(event.suffix1);
-            logFileStream.println(event.suffix2);
+            writeRecord(logFileStream, logFile.size(), record, encoded, encodedLength, objName);
 
             #if !HELIO_SYS_LEAVE_FILES_OPEN
                 logFileStream.flush();
                 logFile.close();
             #endif
+        } else {
+            written = false;
         }
     }
 
 #endif
 
-    #ifdef HELIO_USE_MULTITASKING
-        scheduleSignalFireOnce<const HelioLogEvent>(_logSignal, event);
-    #else
-        _logSignal.fire(event);
-    #endif
+    if (!written && objName.length()) { _namedKeys.erase(_namedKeys.end() - 1); } // named again upon retry
+    if (written && _logSignal.getSlotCount()) { // log event Strings only built if something is listening (and only once written, not upon each retry)
+        HelioLogEvent event(record);
+
+        #ifdef HELIO_USE_MULTITASKING
+            scheduleSignalFireOnce<const HelioLogEvent>(_logSignal, event);
+        #else
+            _logSignal.fire(event);
+        #endif
+    }
+
+    return written;
+}
+
+void HelioLogger::writeRecord(Print &logFile, size_t logFileSize, const HelioLogRecord &record, const uint8_t *encoded, uint8_t encodedLength, const String &objName)
+{
+    if (isLoggingBinary()) {
+        if (!logFileSize) { // .hlb file header: magic, version, strings count, time zone offset
+            uint8_t header[10] = {'H','L','B',1};
+            putLogLE(putLogLE(&header[4], (uint16_t)HStr_Count, 2), (uint32_t)(int32_t)Helioduino::_activeInstance->getTimeZoneOffset(), 4);
+            logFile.write(header, sizeof(header));
+        }
+        if (objName.length()) { // object naming record: length, type, key, display string
+            uint8_t nameRecord[HELIO_LOG_RECORD_MAXSIZE];
+            uint8_t nameLength = (uint8_t)min(objName.length(), (unsigned int)(HELIO_LOG_RECORD_MAXSIZE - 6));
+            nameRecord[0] = 6 + nameLength;
+            nameRecord[1] = HelioLogRecord::NameRecordType;
+            putLogLE(&nameRecord[2], record.objKey, 4);
+            memcpy(&nameRecord[6], objName.c_str(), nameLength);
+            logFile.write(nameRecord, 6 + nameLength);
+        }
+        logFile.write(encoded, encodedLength);
+    } else {
+        logFile.print(localTime(record.timestamp).timestamp(DateTime::TIMESTAMP_FULL));
+        logFile.print(' ');
+        record.printTo(logFile);
+        logFile.println();
+    }
+}
+
+void HelioLogger::update()
+{
+    if (_logRing && _logRing->getRecordsRecovered() && !_recoveryLogged && hasLoggerData()) {
+        _recoveryLogged = true;
+        logRecord(Helio_LogLevel_Warnings, HStr_Log_RecoveredLogs, hkey_none, HelioLogArg((unsigned int)_logRing->getRecordsRecovered()));
+    }
+
+    drainLogRing();
+
+    uint32_t dropped = getRecordsDropped();
+    if (dropped != _droppedLogged && hasLoggerData() && !(_logRing && _logRing->hasUndrained())) { // noted once caught back up
+        logRecord(Helio_LogLevel_Warnings, HStr_Log_DroppedLogs, hkey_none, HelioLogArg((unsigned long)(dropped - _droppedLogged)));
+        _droppedLogged = dropped;
+    }
 }
 
 void HelioLogger::flush()
 {
+    drainLogRing();
     #ifdef HELIO_ENABLE_DEBUG_OUTPUT
         if (Serial) { Serial.flush(); }
     #endif
@@ -239,6 +772,57 @@ void HelioLogger::setLogLevel(Helio_LogLevel logLevel)
     }
 }
 
+uint16_t HelioLogger::printRecentRecords(Print &out, uint16_t maxCount)
+{
+    uint16_t printed = 0;
+
+    if (_logRing) {
+        uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+        HelioLogRecord record;
+        uint16_t oldestSequence = _logRing->getOldestSequence(); // records read by sequence #, as interrupting pushes may reclaim records while printing
+        uint16_t recordCount = _logRing->getRecordCount();
+
+        for (uint16_t recordIndex = recordCount - min(recordCount, maxCount); recordIndex < recordCount; ++recordIndex) {
+            if (_logRing->readRecordSeq(oldestSequence + recordIndex, &record, buffer)) {
+                out.print(localTime(record.timestamp).timestamp(DateTime::TIMESTAMP_FULL));
+                out.print(' ');
+                record.printTo(out);
+                out.println();
+                printed++;
+            }
+        }
+    }
+
+    return printed;
+}
+
+String HelioLogger::getKeyDisplayString(hkey_t key)
+{
+    auto obj = Helioduino::_activeInstance ? Helioduino::_activeInstance->_objects.find(key) : nullptr;
+    if (obj) { return obj->getId().getDisplayString(); }
+
+    String keyString(F("0x"));
+    keyString.concat(String((unsigned long)key, HEX));
+    return keyString;
+}
+
+void HelioLogger::setLoggingBinary(bool logBinary)
+{
+    HELIO_SOFT_ASSERT(hasLoggerData(), SFP(HStr_Err_NotYetInitialized));
+
+    if (hasLoggerData() && loggerData()->logBinary != logBinary) {
+        loggerData()->logBinary = logBinary;
+
+        if (loggerData()->logToSDCard || loggerData()->logToWiFiStorage) {
+            drainLogRing(); // queued records written out in prior format
+            resetLogFile();
+            _logFilename = getYYMMDDFilename(charsToString(loggerData()->logFilePrefix, 16), getLogFileExtension());
+        }
+
+        Helioduino::_activeInstance->_systemData->bumpRevisionIfNeeded();
+    }
+}
+
 Signal<const HelioLogEvent, HELIO_LOG_SIGNAL_SLOTS> &HelioLogger::getLogSignal()
 {
     return _logSignal;
@@ -247,11 +831,31 @@ Signal<const HelioLogEvent, HELIO_LOG_SIGNAL_SLOTS> &HelioLogger::getLogSignal()
 void HelioLogger::notifyDayChanged()
 {
     if (isLoggingEnabled()) {
-        _logFilename = getYYMMDDFilename(charsToString(loggerData()->logFilePrefix, 16), SFP(HStr_txt));
+        drainLogRing(); // queued records belong to prior day's file
+        resetLogFile();
+        _logFilename = getYYMMDDFilename(charsToString(loggerData()->logFilePrefix, 16), getLogFileExtension());
         cleanupOldestLogs();
     }
 }
 
+void HelioLogger::resetLogFile()
+{
+    #if HELIO_SYS_LEAVE_FILES_OPEN
+        if (_logFileSD) {
+            _logFileSD->close();
+            delete _logFileSD; _logFileSD = nullptr;
+            Helioduino::_activeInstance->endSDCard();
+        }
+        #ifdef HELIO_USE_WIFI_STORAGE
+            if (_logFileWS) {
+                _logFileWS->close();
+                delete _logFileWS; _logFileWS = nullptr;
+            }
+        #endif
+    #endif
+    _namedKeys.clear();
+}
+
 void HelioLogger::cleanupOldestLogs(bool force)
 {
     // TODO: Old data cleanup. #17 in Hydruino.
@@ -259,7 +863,7 @@ void HelioLogger::cleanupOldestLogs(bool force)
 
 
 HelioLoggerSubData::HelioLoggerSubData()
-    : HelioSubData(0), logLevel(Helio_LogLevel_All), logFilePrefix{0}, logToSDCard(false), logToWiFiStorage(false)
+    : HelioSubData(0), logLevel(Helio_LogLevel_All), logFilePrefix{0}, logToSDCard(false), logToWiFiStorage(false), logBinary(false)
 { ; }
 
 void HelioLoggerSubData::toJSONObject(JsonObject &objectOut) const
@@ -270,6 +874,7 @@ void HelioLoggerSubData::toJSONObject(JsonObject &objectOut) const
     if (logFilePrefix[0]) { objectOut[SFP(HStr_Key_LogFilePrefix)] = charsToString(logFilePrefix, 16); }
     if (logToSDCard != false) { objectOut[SFP(HStr_Key_LogToSDCard)] = logToSDCard; }
     if (logToWiFiStorage != false) { objectOut[SFP(HStr_Key_LogToWiFiStorage)] = logToWiFiStorage; }
+    if (logBinary != false) { objectOut[SFP(HStr_Key_LogBinary)] = logBinary; }
 }
 
 void HelioLoggerSubData::fromJSONObject(JsonObjectConst &objectIn)
@@ -281,4 +886,5 @@ void HelioLoggerSubData::fromJSONObject(JsonObjectConst &objectIn)
     if (logFilePrefixStr && logFilePrefixStr[0]) { strncpy(logFilePrefix, logFilePrefixStr, 16); }
     logToSDCard = objectIn[SFP(HStr_Key_LogToSDCard)] | logToSDCard;
     logToWiFiStorage = objectIn[SFP(HStr_Key_LogToWiFiStorage)] | logToWiFiStorage;
+    logBinary = objectIn[SFP(HStr_Key_LogBinary)] | logBinary;
 }
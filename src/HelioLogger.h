@@ -7,6 +7,9 @@
 #define HelioLogger_H
 
 class HelioLogger;
+class HelioLogRing;
+struct HelioLogArg;
+struct HelioLogRecord;
 struct HelioLoggerSubData;
 
 #include "Helioduino.h"
@@ -21,6 +24,20 @@ enum Helio_LogLevel : signed char {
     Helio_LogLevel_Info = Helio_LogLevel_All                // Info alias
 };
 
+// Log Argument Type
+// Value types that binary log record arguments may hold.
+enum Helio_LogArgType : signed char {
+    Helio_LogArgType_Int,                                   // Signed integer (32-bit)
+    Helio_LogArgType_UInt,                                  // Unsigned integer (32-bit)
+    Helio_LogArgType_Float,                                 // Floating point (32-bit)
+    Helio_LogArgType_String,                                // Helio_String id (formatted from strings table)
+    Helio_LogArgType_Key,                                   // Object key (formatted as object's display string)
+    Helio_LogArgType_Text,                                  // Inline text (truncated to fit record)
+
+    Helio_LogArgType_Count,                                 // Placeholder
+    Helio_LogArgType_Undefined = -1                         // Placeholder / no argument
+};
+
 // Logging Events
 // Logging event structure that is used in signaling.
 struct HelioLogEvent {
@@ -36,6 +53,156 @@ struct HelioLogEvent {
                   const String &msgIn,
                   const String &suffix1In = String(),
                   const String &suffix2In = String());
+    HelioLogEvent(const HelioLogRecord &record);
+};
+
+// Log Record Argument
+// Typed argument of a binary log record. Text arguments point at external character data,
+// which must outlive the record (or the buffer it was decoded from), and keep their full
+// length so that records written out directly as .txt aren't truncated (only encoding is).
+struct HelioLogArg {
+    Helio_LogArgType type;                                  // Argument type
+    union {
+        int32_t intValue;                                   // Int value
+        uint32_t uintValue;                                 // UInt value
+        float floatValue;                                   // Float value
+        Helio_String stringId;                              // String id value
+        hkey_t keyValue;                                    // Key value
+        const char *text;                                   // Text value (not owned)
+    };
+    uint16_t textLength;                                    // Text length
+
+    inline HelioLogArg() : type(Helio_LogArgType_Undefined), uintValue(0), textLength(0) { ; }
+    inline HelioLogArg(int value) : type(Helio_LogArgType_Int), intValue(value), textLength(0) { ; }
+    inline HelioLogArg(long value) : type(Helio_LogArgType_Int), intValue((int32_t)value), textLength(0) { ; }
+    inline HelioLogArg(unsigned int value) : type(Helio_LogArgType_UInt), uintValue(value), textLength(0) { ; }
+    inline HelioLogArg(unsigned long value) : type(Helio_LogArgType_UInt), uintValue((uint32_t)value), textLength(0) { ; }
+    inline HelioLogArg(float value) : type(Helio_LogArgType_Float), floatValue(value), textLength(0) { ; }
+    inline HelioLogArg(double value) : type(Helio_LogArgType_Float), floatValue((float)value), textLength(0) { ; }
+    inline HelioLogArg(Helio_String value) : type(Helio_LogArgType_String), stringId(value), textLength(0) { ; }
+    inline HelioLogArg(const char *value) : type(Helio_LogArgType_Text), text(value), textLength(value ? (uint16_t)min(strlen(value), (size_t)UINT16_MAX) : 0) { ; }
+    inline HelioLogArg(const String &value) : type(Helio_LogArgType_Text), text(value.c_str()), textLength((uint16_t)min((size_t)value.length(), (size_t)UINT16_MAX)) { ; }
+    static inline HelioLogArg key(hkey_t value) { HelioLogArg arg; arg.type = Helio_LogArgType_Key; arg.keyValue = value; return arg; }
+
+    // Prints argument's formatted text
+    void printTo(Print &out) const;
+};
+
+// Log Record
+// Compact binary log record of log level, time, message string id, object key, and up to
+// HELIO_LOG_RECORD_MAXARGS typed arguments. Records are what get stored in the log ring and
+// binary .hlb log files, with text formatting deferred until something actually reads them
+// (Serial/UI consumers, log signal slots, .txt log files, or the host-side decoder). String
+// ids index the firmware's strings table, so decoding a stored record requires the matching
+// firmware's strings (the .hlb file header records its strings count as a sanity check).
+// Encoded: length, level, timestamp (u32), string id (u16), object key (u32), argument count,
+// then per argument its type followed by a 4 byte value, 2 byte string id, or length + text.
+struct HelioLogRecord {
+    Helio_LogLevel level;                                   // Log level
+    time_t timestamp;                                       // Time of record (UTC)
+    Helio_String msgId;                                     // Message string id, else HStr_Count if none
+    hkey_t objKey;                                          // Object key, else hkey_none if none
+    uint8_t argCount;                                       // Number of arguments
+    HelioLogArg args[HELIO_LOG_RECORD_MAXARGS];             // Arguments
+
+    HelioLogRecord();
+    HelioLogRecord(Helio_LogLevel levelIn,
+                   Helio_String msgIdIn,
+                   hkey_t objKeyIn = hkey_none,
+                   const HelioLogArg &arg1 = HelioLogArg(),
+                   const HelioLogArg &arg2 = HelioLogArg(),
+                   const HelioLogArg &arg3 = HelioLogArg(),
+                   const HelioLogArg &arg4 = HelioLogArg());
+
+    // Encodes record into bufferOut (of HELIO_LOG_RECORD_MAXSIZE bytes), truncating text arguments to fit. Returns encoded length.
+    uint8_t encode(uint8_t *bufferOut) const;
+    // Decodes record from buffer (text arguments point into buffer). Returns decoded length, or 0 if malformed.
+    uint8_t decode(const uint8_t *buffer, uint8_t length);
+    // Returns encoded size of record before any truncation to fit HELIO_LOG_RECORD_MAXSIZE (saturating at UINT16_MAX)
+    uint16_t getEncodedSize() const;
+
+    // Prints record's formatted text (as a .txt log line, sans timestamp and line ending)
+    void printTo(Print &out) const;
+
+    // Record types: log record (by level), or object naming record (.hlb files only, precedes first use of key in file)
+    static const uint8_t NameRecordType = 0x7F;
+};
+
+// Log Ring Control Block
+// Ring positions are free running (masked by capacity on access), and kept together with ring
+// data so that both may be placed in no-init RAM to survive warm resets (see HelioLogRing).
+struct HelioLogRingControl {
+    uint32_t signature;                                     // Validity signature (ring constant ^ capacity), for recovery
+    volatile uint16_t head;                                 // Write position, after newest record (producer owned)
+    volatile uint16_t tail;                                 // Drain position, of oldest undrained record (consumer owned)
+    uint16_t oldest;                                        // Position of oldest retained record (producer owned)
+    uint16_t count;                                         // Number of retained records (producer owned)
+};
+
+// Log Ring
+// Lock-free single-producer/single-consumer RAM ring buffer of encoded log records. Records are
+// pushed by the logging context (task or interrupt) and drained by the misc loop out to log files,
+// with positions published only after data is in place so that neither side needs to lock. Records
+// already drained are retained until overwritten, which consumers such as Serial or the UI may read
+// back and format on demand, by sequence # so that records reclaimed by interrupting pushes mid-read
+// are detected (and re-read or skipped) rather than torn. Pushing never waits: a push that would overwrite undrained records, or
+// that interrupts another push, is dropped and counted instead. While storage is unavailable, the
+// consumer may instead drop its oldest undrained records to make room. When given external storage (such
+// as no-init RAM), the ring is recovered as-is if valid, so records left undrained by a warm reset
+// are drained out on boot.
+class HelioLogRing {
+public:
+    HelioLogRing(uint16_t capacity = HELIO_LOG_RING_SIZE);
+    HelioLogRing(HelioLogRingControl *control, uint8_t *data, uint16_t capacity);
+    ~HelioLogRing();
+
+    // Pushes encoded record (producer side), reclaiming drained records as needed. Returns success, else record dropped.
+    bool push(const uint8_t *record, uint8_t length);
+
+    // Returns drain position of oldest undrained record (consumer side)
+    inline uint16_t getDrainPosition() const { return _control->tail; }
+    // Copies undrained record at drain position into bufferOut (of HELIO_LOG_RECORD_MAXSIZE bytes), advancing position. Returns its length, or 0 if none left.
+    uint8_t drainNext(uint16_t *position, uint8_t *bufferOut) const;
+    // Marks records up to drain position as drained, freeing them to be overwritten
+    void commitDrain(uint16_t position);
+    bool hasUndrained() const;
+    inline bool isPushing() const { return _pushing; }
+    // Returns if record of length would fit without overwriting undrained records
+    bool hasRoom(uint8_t length) const;
+    // Drops oldest undrained records (consumer side), counting each as dropped, until record of length would fit. Returns # dropped.
+    uint16_t dropUndrained(uint8_t length);
+
+    // Returns sequence # of oldest retained record, with each newer record's sequence # counting up from it (wrapping)
+    uint16_t getOldestSequence() const;
+    // Copies retained record of sequence # into bufferOut (of HELIO_LOG_RECORD_MAXSIZE bytes). Returns its length, or 0 if no longer (or not yet) retained.
+    uint8_t copyRecordSeq(uint16_t sequence, uint8_t *bufferOut) const;
+    // Reads retained record of sequence # into recordOut, with bufferOut (of HELIO_LOG_RECORD_MAXSIZE bytes) backing text arguments. Returns success.
+    bool readRecordSeq(uint16_t sequence, HelioLogRecord *recordOut, uint8_t *bufferOut) const;
+    // Copies retained record at index (0 being oldest) into bufferOut (of HELIO_LOG_RECORD_MAXSIZE bytes). Returns its length, or 0 if out of range.
+    inline uint8_t copyRecord(uint16_t index, uint8_t *bufferOut) const { return copyRecordSeq(getOldestSequence() + index, bufferOut); }
+    // Reads retained record at index (0 being oldest) into recordOut, with bufferOut (of HELIO_LOG_RECORD_MAXSIZE bytes) backing text arguments. Returns success.
+    inline bool readRecord(uint16_t index, HelioLogRecord *recordOut, uint8_t *bufferOut) const { return readRecordSeq(getOldestSequence() + index, recordOut, bufferOut); }
+    void clear();
+
+    inline uint16_t getCapacity() const { return _capacity; }
+    inline uint16_t getRecordCount() const { return _control->count; }
+    inline uint16_t getRecordsRecovered() const { return _recovered; }
+    inline uint32_t getRecordsDropped() const { return _dropped; }
+
+    static const uint32_t Signature = 0x484C5247;           // "HLRG"
+
+protected:
+    HelioLogRingControl *_control;                          // Ring control block (owned if _owned)
+    uint8_t *_data;                                         // Ring data (owned if _owned)
+    uint16_t _capacity;                                     // Ring data capacity, in bytes (power of 2)
+    uint16_t _recovered;                                    // Number of undrained records recovered from before reset
+    volatile uint32_t _dropped;                             // Number of records dropped (lifetime)
+    volatile uint16_t _reclaimed;                           // Number of records reclaimed (wrapping), being sequence # of oldest retained record
+    volatile bool _pushing;                                 // Push in progress flag, for detecting interrupting pushes
+    bool _owned;                                            // If control block and data are owned (heap allocated)
+
+    uint16_t recover();
+    void copyOut(uint16_t position, uint8_t length, uint8_t *bufferOut) const;
 };
 
 // Data Logger
@@ -45,7 +212,14 @@ struct HelioLogEvent {
 // for embedded systems by spreading string data out over multiple call parameters to
 // avoid large string concatenations that can overstress and crash constrained devices.
 // Logging to SD card .txt log files (via SPI card reader) is supported as is logging to
-// WiFiStorage .txt log files (via OS/OTA filesystem / WiFiNINA_Generic only).
+// WiFiStorage .txt log files (via OS/OTA filesystem / WiFiNINA_Generic only). Messages are
+// carried as binary log records (see HelioLogRecord), which may be logged directly by string
+// id and typed arguments to avoid String building on the control path. Records are queued in a
+// lock-free RAM log ring that the misc loop drains out to log files (optionally persisted across
+// warm resets, see HELIO_LOG_RING_NOINIT), and log files may instead be written in compact binary
+// .hlb format, whose text formatting is left to the host-side decoder (see extra/HelioLogToText.cpp).
+// Records logged from outside of main context (e.g. from an ISR) are only ever queued, never written
+// out, and drained records stay queued until they are actually written out to their log files.
 class HelioLogger {
 public:
     HelioLogger();
@@ -70,10 +244,29 @@ public:
     void logMessage(const String &msg, const String &suffix1 = String(), const String &suffix2 = String());
     void logWarning(const String &warn, const String &suffix1 = String(), const String &suffix2 = String());
     void logError(const String &err, const String &suffix1 = String(), const String &suffix2 = String());
+    // Logs binary log record of message string id, for object key (formatted as its display string, which precedes message), with typed arguments (appended after message).
+    void logRecord(Helio_LogLevel level, Helio_String msgId, hkey_t objKey = hkey_none,
+                   const HelioLogArg &arg1 = HelioLogArg(), const HelioLogArg &arg2 = HelioLogArg(),
+                   const HelioLogArg &arg3 = HelioLogArg(), const HelioLogArg &arg4 = HelioLogArg());
+    // Drains log ring's queued records out to log files and log signal (called by misc loop)
+    void update();
     void flush();
 
+    // Prints recent records held in log ring, formatted as .txt log lines, up to maxCount most recent. Returns # of records printed.
+    uint16_t printRecentRecords(Print &out, uint16_t maxCount = UINT16_MAX);
+    inline HelioLogRing *getLogRing() const { return _logRing; }
+    // Returns # of records dropped, either from log ring being full (or storage unavailable) or from being logged outside of main context (e.g. from an ISR) unable to be queued
+    inline uint32_t getRecordsDropped() const { return (_logRing ? _logRing->getRecordsDropped() : 0) + _contextDropped; }
+    // Returns display string of object by key, as used in formatting log records, else key in hex if no such object
+    static String getKeyDisplayString(hkey_t key);
+
     void setLogLevel(Helio_LogLevel logLevel);
     inline Helio_LogLevel getLogLevel() const;
+    inline bool isLevelLogged(Helio_LogLevel level) const;
+
+    void setLoggingBinary(bool logBinary);
+    inline bool isLoggingBinary() const;
+    inline String getLogFileExtension() const;
 
     inline bool isLoggingEnabled() const;
     inline time_t getSystemUptime() const { return unixNow() - (_initTime ?: SECS_YR_2000); }
@@ -92,6 +285,12 @@ protected:
     String _logFilename;                                    // Resolved log file name (based on day)
     time_t _initTime;                                       // Time of init, for uptime (UTC)
     time_t _lastSpaceCheck;                                 // Last time enough space was checked (UTC)
+    HelioLogRing *_logRing;                                 // Log ring of queued/recent records (owned), else nullptr if disabled
+    Vector<hkey_t, HELIO_SYS_OBJECTS_MAXSIZE> _namedKeys;   // Object keys already named in current .hlb log file
+    volatile uint16_t _contextDropped;                      // Number of records dropped for being logged outside of main context while unable to be queued
+    bool _draining;                                         // Log ring drain in progress flag
+    bool _recoveryLogged;                                   // If log ring's recovered records have been noted in log
+    uint32_t _droppedLogged;                                // Number of dropped records already noted in log
 
     Signal<const HelioLogEvent, HELIO_LOG_SIGNAL_SLOTS> _logSignal; // Logging signal
 
@@ -101,7 +300,11 @@ protected:
     inline bool hasLoggerData() const;
 
     inline void updateInitTracking() { _initTime = unixNow(); }
-    void log(const HelioLogEvent &event);
+    void log(const HelioLogRecord &record);
+    void drainLogRing();
+    bool writeOut(const HelioLogRecord &record, const uint8_t *encoded, uint8_t encodedLength);
+    void writeRecord(Print &logFile, size_t logFileSize, const HelioLogRecord &record, const uint8_t *encoded, uint8_t encodedLength, const String &objName);
+    void resetLogFile();
     void cleanupOldestLogs(bool force = false);
 };
 
@@ -112,6 +315,7 @@ struct HelioLoggerSubData : public HelioSubData {
     char logFilePrefix[HELIO_PREFIX_MAXSIZE];               // Base log file name prefix / folder (default: "logs/he")
     bool logToSDCard;                                       // If system logging to SD card is enabled (default: false)
     bool logToWiFiStorage;                                  // If system logging to WiFiStorage is enabled (default: false)
+    bool logBinary;                                         // If logging to binary .hlb log files in place of .txt is enabled (default: false)
 
     HelioLoggerSubData();
     void toJSONObject(JsonObject &objectOut) const;
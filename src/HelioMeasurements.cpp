@@ -241,6 +241,109 @@ void HelioTripleMeasurement::saveToData(HelioMeasurementData *dataOut, uint8_t m
 }
 
 
+HelioMeasurementHistory::HelioMeasurementHistory(uint8_t capacity, uint8_t measurementRow)
+    : _samples(nullptr), _minQueue(nullptr), _maxQueue(nullptr), _capacity(capacity),
+      _count(0), _head(0), _minFront(0), _minCount(0), _maxFront(0), _maxCount(0),
+      _measurementRow(measurementRow), _units(Helio_UnitsType_Undefined),
+      _offset(0.0f), _sum(0.0f), _sumSq(0.0f)
+{
+    if (_capacity) {
+        _samples = new Sample[_capacity];
+        _minQueue = new uint8_t[_capacity];
+        _maxQueue = new uint8_t[_capacity];
+        HELIO_SOFT_ASSERT(_samples && _minQueue && _maxQueue, SFP(HStr_Err_AllocationFailure));
+        if (!_samples || !_minQueue || !_maxQueue) { _capacity = 0; }
+    }
+}
+
+HelioMeasurementHistory::~HelioMeasurementHistory()
+{
+    if (_samples) { delete [] _samples; _samples = nullptr; }
+    if (_minQueue) { delete [] _minQueue; _minQueue = nullptr; }
+    if (_maxQueue) { delete [] _maxQueue; _maxQueue = nullptr; }
+}
+
+void HelioMeasurementHistory::push(float value, millis_t time)
+{
+    if (!_capacity) { return; }
+
+    if (_count == _capacity) { // evict oldest, which lives at head when full
+        float delta = _samples[_head].value - _offset;
+        _sum -= delta;
+        _sumSq -= delta * delta;
+        if (_minCount && _minQueue[_minFront] == _head) { _minFront = queueIndex(_minFront, 1); _minCount--; }
+        if (_maxCount && _maxQueue[_maxFront] == _head) { _maxFront = queueIndex(_maxFront, 1); _maxCount--; }
+    } else {
+        if (!_count) { _offset = value; }
+        _count++;
+    }
+
+    _samples[_head].value = value;
+    _samples[_head].time = time;
+    {   float delta = value - _offset;
+        _sum += delta;
+        _sumSq += delta * delta;
+    }
+
+    while (_minCount && _samples[_minQueue[queueIndex(_minFront, _minCount - 1)]].value >= value) { _minCount--; }
+    _minQueue[queueIndex(_minFront, _minCount++)] = _head;
+    while (_maxCount && _samples[_maxQueue[queueIndex(_maxFront, _maxCount - 1)]].value <= value) { _maxCount--; }
+    _maxQueue[queueIndex(_maxFront, _maxCount++)] = _head;
+
+    _head = (_head + 1) % _capacity;
+    // once per ring revolution, or early once a step change leaves offset outside window (before
+    // cancellation in variance grows), keeps amortized cost O(1)
+    if (!_head || _offset < getMin() || _offset > getMax()) { recenter(); }
+}
+
+void HelioMeasurementHistory::clear()
+{
+    _count = _head = 0;
+    _minFront = _minCount = _maxFront = _maxCount = 0;
+    _offset = _sum = _sumSq = 0.0f;
+}
+
+float HelioMeasurementHistory::getVariance() const
+{
+    if (_count > 1) {
+        float variance = (_sumSq - (_sum * _sum) / _count) / _count;
+        return variance > 0.0f ? variance : 0.0f;
+    }
+    return 0.0f;
+}
+
+float HelioMeasurementHistory::getRateOfChange() const
+{
+    millis_t timeSpan = getTimeSpan();
+    return timeSpan ? (getSample(0) - getSample(_count - 1)) * 1000.0f / timeSpan : 0.0f;
+}
+
+float HelioMeasurementHistory::getStatistic(Helio_MeasurementStat statistic) const
+{
+    switch (statistic) {
+        case Helio_MeasurementStat_Mean:
+            return getMean();
+        case Helio_MeasurementStat_Min:
+            return getMin();
+        case Helio_MeasurementStat_Max:
+            return getMax();
+        default:
+            return getLatest();
+    }
+}
+
+void HelioMeasurementHistory::recenter()
+{
+    _offset = getMean();
+    _sum = _sumSq = 0.0f;
+    for (uint8_t slot = 0; slot < _count; ++slot) {
+        float delta = _samples[slot].value - _offset;
+        _sum += delta;
+        _sumSq += delta * delta;
+    }
+}
+
+
 HelioMeasurementData::HelioMeasurementData()
     : HelioSubData(0), measurementRow(0), value(0.0f), units(Helio_UnitsType_Undefined), timestamp(0)
 { ; }
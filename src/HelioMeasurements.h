@@ -11,6 +11,7 @@ struct HelioSingleMeasurement;
 struct HelioBinaryMeasurement;
 struct HelioDoubleMeasurement;
 struct HelioTripleMeasurement;
+class HelioMeasurementHistory;
 
 struct HelioMeasurementData;
 
@@ -149,6 +150,71 @@ struct HelioTripleMeasurement : public HelioMeasurement {
 };
 
 
+// Measurement History
+// Fixed-capacity ring of timed single-row samples that keeps its rolling statistics current
+// in O(1) per sample: mean and variance from running sums (taken about an offset that is
+// periodically re-centered to bound float drift), min/max from monotonic index deques, and
+// rate-of-change across the span of the window. Values are kept in their recorded units.
+class HelioMeasurementHistory {
+public:
+    HelioMeasurementHistory(uint8_t capacity = HELIO_SENSOR_HISTORY_DEFSIZE, uint8_t measurementRow = 0);
+    ~HelioMeasurementHistory();
+
+    // Records a new sample, evicting the oldest if full
+    void push(float value, millis_t time = nzMillis());
+    // Records a new sample from a single measurement, adopting its units
+    inline void push(const HelioSingleMeasurement &measurement, millis_t time = nzMillis()) { _units = measurement.units; push(measurement.value, time); }
+    // Clears all samples
+    void clear();
+
+    inline uint8_t getCapacity() const { return _capacity; }
+    inline uint8_t getCount() const { return _count; }
+    inline bool isEmpty() const { return !_count; }
+    inline bool isFull() const { return _count == _capacity; }
+    inline uint8_t getMeasurementRow() const { return _measurementRow; }
+    inline Helio_UnitsType getUnits() const { return _units; }
+
+    // Sample value by age, with 0 being the latest sample
+    inline float getSample(uint8_t age = 0) const { return age < _count ? _samples[slotOf(age)].value : 0.0f; }
+    // Sample time by age, with 0 being the latest sample
+    inline millis_t getSampleTime(uint8_t age = 0) const { return age < _count ? _samples[slotOf(age)].time : 0; }
+    // Time spanned by window, in milliseconds
+    inline millis_t getTimeSpan() const { return _count > 1 ? getSampleTime(0) - getSampleTime(_count - 1) : 0; }
+
+    inline float getLatest() const { return getSample(0); }
+    inline float getMean() const { return _count ? _offset + _sum / _count : 0.0f; }
+    inline float getMin() const { return _count ? _samples[_minQueue[_minFront]].value : 0.0f; }
+    inline float getMax() const { return _count ? _samples[_maxQueue[_maxFront]].value : 0.0f; }
+    // Population variance of window
+    float getVariance() const;
+    inline float getStdDeviation() const { return sqrtf(getVariance()); }
+    // Rate-of-change across window, in units per second
+    float getRateOfChange() const;
+    // Value of the specified statistic (latest for undefined)
+    float getStatistic(Helio_MeasurementStat statistic) const;
+
+protected:
+    struct Sample { float value; millis_t time; };
+    Sample *_samples;                                       // Sample ring storage
+    uint8_t *_minQueue;                                     // Monotonic (increasing) min deque storage, of sample slots
+    uint8_t *_maxQueue;                                     // Monotonic (decreasing) max deque storage, of sample slots
+    uint8_t _capacity;                                      // Capacity of ring
+    uint8_t _count;                                         // Number of samples held
+    uint8_t _head;                                          // Next slot to be written
+    uint8_t _minFront, _minCount;                           // Min deque front index and count
+    uint8_t _maxFront, _maxCount;                           // Max deque front index and count
+    uint8_t _measurementRow;                                // Measurement row recorded from
+    Helio_UnitsType _units;                                 // Units of recorded values
+    float _offset;                                          // Offset running sums are taken about
+    float _sum;                                             // Running sum of (value - offset)
+    float _sumSq;                                           // Running sum of (value - offset)^2
+
+    inline uint8_t slotOf(uint8_t age) const { return (uint8_t)((_head + _capacity - 1 - age) % _capacity); }
+    inline uint8_t queueIndex(uint8_t front, uint8_t offset) const { return (uint8_t)((front + offset) % _capacity); }
+    void recenter();
+};
+
+
 // Combined Measurement Serialization Sub Data
 struct HelioMeasurementData : public HelioSubData {
     uint8_t measurementRow;                                 // Source measurement row index that data is from
@@ -62,8 +62,8 @@ bool HelioCalibrations::dropUserCalibrationData(const HelioCalibrationData *cali
 bool HelioObjectRegistration::registerObject(SharedPtr<HelioObject> obj)
 {
     HELIO_SOFT_ASSERT(obj->getId().posIndex >= 0 && obj->getId().posIndex < HELIO_POS_MAXSIZE, SFP(HStr_Err_InvalidParameter));
-    if (obj && _objects.find(obj->getKey()) == _objects.end()) {
-        _objects[obj->getKey()] = obj;
+    if (obj && _objects.insert(obj)) {
+        wakeControlLoop();
 
         if (obj->isActuatorType() || obj->isPanelType()) {
             if (getScheduler()) {
@@ -83,9 +83,8 @@ bool HelioObjectRegistration::registerObject(SharedPtr<HelioObject> obj)
 
 bool HelioObjectRegistration::unregisterObject(SharedPtr<HelioObject> obj)
 {
-    auto iter = _objects.find(obj->getKey());
-    if (iter != _objects.end()) {
-        _objects.erase(iter);
+    if (obj && _objects.erase(obj->getKey())) {
+        wakeControlLoop();
 
         if (obj->isActuatorType() || obj->isPanelType()) {
             if (getScheduler()) {
@@ -107,10 +106,10 @@ SharedPtr<HelioObject> HelioObjectRegistration::objectById(HelioIdentity id) con
 {
     if (id.posIndex == HELIO_POS_SEARCH_FROMBEG) {
         while (++id.posIndex < HELIO_POS_MAXSIZE) {
-            auto iter = _objects.find(id.regenKey());
-            if (iter != _objects.end()) {
-                if (id.keyString == iter->second->getKeyString()) {
-                    return iter->second;
+            auto obj = _objects.find(id.regenKey());
+            if (obj) {
+                if (id.keyString == obj->getKeyString()) {
+                    return obj;
                 } else {
                     objectById_Col(id);
                 }
@@ -118,20 +117,20 @@ SharedPtr<HelioObject> HelioObjectRegistration::objectById(HelioIdentity id) con
         }
     } else if (id.posIndex == HELIO_POS_SEARCH_FROMEND) {
         while (--id.posIndex >= 0) {
-            auto iter = _objects.find(id.regenKey());
-            if (iter != _objects.end()) {
-                if (id.keyString == iter->second->getKeyString()) {
-                    return iter->second;
+            auto obj = _objects.find(id.regenKey());
+            if (obj) {
+                if (id.keyString == obj->getKeyString()) {
+                    return obj;
                 } else {
                     objectById_Col(id);
                 }
             }
         }
     } else {
-        auto iter = _objects.find(id.key);
-        if (iter != _objects.end()) {
-            if (id.keyString == iter->second->getKeyString()) {
-                return iter->second;
+        auto obj = _objects.find(id.key);
+        if (obj) {
+            if (id.keyString == obj->getKeyString()) {
+                return obj;
             } else {
                 objectById_Col(id);
             }
@@ -146,8 +145,8 @@ SharedPtr<HelioObject> HelioObjectRegistration::objectById_Col(const HelioIdenti
     HELIO_SOFT_ASSERT(false, F("Hashing collision")); // exhaustive search must be performed, publishing may miss values
 
     for (auto iter = _objects.begin(); iter != _objects.end(); ++iter) {
-        if (id.keyString == iter->second->getKeyString()) {
-            return iter->second;
+        if (id.keyString == (*iter)->getKeyString()) {
+            return *iter;
         }
     }
 
@@ -159,16 +158,14 @@ hposi_t HelioObjectRegistration::firstPosition(HelioIdentity id, bool taken)
     if (id.posIndex != HELIO_POS_SEARCH_FROMEND) {
         id.posIndex = HELIO_POS_SEARCH_FROMBEG;
         while (++id.posIndex < HELIO_POS_MAXSIZE) {
-            auto iter = _objects.find(id.regenKey());
-            if (taken == (iter != _objects.end())) {
+            if (taken == _objects.contains(id.regenKey())) {
                 return id.posIndex;
             }
         }
     } else {
         id.posIndex = HELIO_POS_SEARCH_FROMEND;
         while (--id.posIndex >= 0) {
-            auto iter = _objects.find(id.regenKey());
-            if (taken == (iter != _objects.end())) {
+            if (taken == _objects.contains(id.regenKey())) {
                 return id.posIndex;
             }
         }
@@ -199,6 +196,24 @@ void HelioPinHandlers::deactivatePinMuxers()
     }
 }
 
+#ifdef HELIO_USE_MULTITASKING
+
+void HelioPinHandlers::updatePinExpanders()
+{
+    for (auto iter = _pinExpanders.begin(); iter != _pinExpanders.end(); ++iter) {
+        if (iter->second) { iter->second->updateChannels(); }
+    }
+}
+
+void HelioPinHandlers::flushPinExpanders()
+{
+    for (auto iter = _pinExpanders.begin(); iter != _pinExpanders.end(); ++iter) {
+        if (iter->second) { iter->second->tryFlushWrites(); }
+    }
+}
+
+#endif // /ifdef HELIO_USE_MULTITASKING
+
 OneWire *HelioPinHandlers::getOneWireForPin(pintype_t pin)
 {
     auto wireIter = _pinOneWire.find(pin);
@@ -226,3 +241,294 @@ void HelioPinHandlers::dropOneWireForPin(pintype_t pin)
         _pinOneWire.erase(wireIter);
     }
 }
+
+
+HelioSunPositions::HelioSunPositions()
+    : _sunPosTime(0), _sunPosEvict(0), _sunPosCalcs(0), _sunPosQueries(0)
+#if HELIO_PANEL_EPHEM_STEPMINS
+      , _sunEphemeris{nullptr,nullptr}
+#endif
+{ ; }
+
+HelioSunPositions::~HelioSunPositions()
+{
+    #if HELIO_PANEL_EPHEM_STEPMINS
+        if (_sunEphemeris[0]) { delete _sunEphemeris[0]; _sunEphemeris[0] = nullptr; }
+        if (_sunEphemeris[1]) { delete _sunEphemeris[1]; _sunEphemeris[1] = nullptr; }
+    #endif
+}
+
+void HelioSunPositions::updateSunPositions(time_t unixTime)
+{
+    time_t sunPosTime = unixTime - (unixTime % HELIO_SYS_SUNPOS_QUANTUM);
+    if (sunPosTime != _sunPosTime) {
+        _sunPosTime = sunPosTime; // prior entries age out through eviction, as lookahead queries may still be using them
+
+        Location location = getController() ? getController()->getSystemLocation() : Location();
+        if (location.hasPosition()) {
+            double sunPosition[2];
+            getSunPosition(unixTime, location.latitude, location.longitude, sunPosition);
+        }
+    }
+}
+
+void HelioSunPositions::invalidateSunPositions()
+{
+    _sunPositions.clear();
+    _sunPosTime = 0;
+    _sunPosEvict = 0;
+    #if HELIO_PANEL_EPHEM_STEPMINS
+        if (_sunEphemeris[0]) { _sunEphemeris[0]->invalidate(); }
+        if (_sunEphemeris[1]) { _sunEphemeris[1]->invalidate(); }
+    #endif
+}
+
+bool HelioSunPositions::getSunPosition(time_t unixTime, double latitude, double longitude, double *sunPositionOut)
+{
+    HELIO_SOFT_ASSERT(sunPositionOut, SFP(HStr_Err_InvalidParameter));
+    if (!sunPositionOut) { return false; }
+    bool isHorzCoords = latitude != DBL_UNDEF && longitude != DBL_UNDEF;
+    time_t sunPosTime = unixTime - (unixTime % HELIO_SYS_SUNPOS_QUANTUM);
+    int16_t bucket[2] = { isHorzCoords ? (int16_t)floor(latitude / HELIO_SYS_SUNPOS_BUCKETDEG) : (int16_t)0,
+                          isHorzCoords ? (int16_t)floor(longitude / HELIO_SYS_SUNPOS_BUCKETDEG) : (int16_t)0 };
+    ++_sunPosQueries;
+
+    SunPositionEntry *entry = nullptr;
+    for (int entryIndex = 0; entryIndex < _sunPositions.size(); ++entryIndex) {
+        if (_sunPositions[entryIndex].time == sunPosTime && (_sunPositions[entryIndex].latitude != DBL_UNDEF) == isHorzCoords &&
+            _sunPositions[entryIndex].bucket[0] == bucket[0] && _sunPositions[entryIndex].bucket[1] == bucket[1]) {
+            entry = &_sunPositions[entryIndex];
+            break;
+        }
+    }
+
+    if (!entry) {
+        SunPositionEntry newEntry;
+        newEntry.time = sunPosTime;
+        newEntry.bucket[0] = bucket[0];
+        newEntry.bucket[1] = bucket[1];
+        newEntry.latitude = newEntry.longitude = DBL_UNDEF;
+        if (isHorzCoords) {
+            // system location is used as base coords if it lies within bucket, else bucket center
+            Location location = getController() ? getController()->getSystemLocation() : Location();
+            if (location.hasPosition() && (int16_t)floor(location.latitude / HELIO_SYS_SUNPOS_BUCKETDEG) == bucket[0] &&
+                                          (int16_t)floor(location.longitude / HELIO_SYS_SUNPOS_BUCKETDEG) == bucket[1]) {
+                newEntry.latitude = location.latitude;
+                newEntry.longitude = location.longitude;
+            } else {
+                newEntry.latitude = (bucket[0] + 0.5) * HELIO_SYS_SUNPOS_BUCKETDEG;
+                newEntry.longitude = (bucket[1] + 0.5) * HELIO_SYS_SUNPOS_BUCKETDEG;
+            }
+        }
+        calcSunPositionEntry(newEntry);
+
+        if (_sunPositions.size() < HELIO_SYS_SUNPOS_MAXSIZE) {
+            _sunPositions.push_back(newEntry);
+            entry = &_sunPositions.back();
+        } else {
+            // out of space, replace oldest entry (entries are inserted in order, so eviction cycles through them)
+            entry = &_sunPositions[_sunPosEvict];
+            *entry = newEntry;
+            _sunPosEvict = (_sunPosEvict + 1) % HELIO_SYS_SUNPOS_MAXSIZE;
+        }
+    }
+
+    sunPositionOut[0] = entry->position[0];
+    sunPositionOut[1] = entry->position[1];
+
+    if (isHorzCoords && (latitude != entry->latitude || longitude != entry->longitude)) {
+        // first-order correction from base coords, using analytic partials of horizontal coords w.r.t. lat/long:
+        // dAzi/dLat = sin(azi)tan(ele), dAzi/dLong = sin(lat) - cos(lat)cos(azi)tan(ele), dEle/dLat = cos(azi), dEle/dLong = cos(lat)sin(azi)
+        double azi = radians(entry->position[0]);
+        double tanEle = tan(radians(constrain(entry->position[1], -89.0, 89.0))); // azimuth degenerates at zenith
+        double lat = radians(entry->latitude);
+        double deltaLat = latitude - entry->latitude;
+        double deltaLong = wrapBy180Neg180<double>(longitude - entry->longitude);
+
+        sunPositionOut[0] = wrapBy360<double>(sunPositionOut[0] + (sin(azi) * tanEle * deltaLat) + ((sin(lat) - cos(lat) * cos(azi) * tanEle) * deltaLong));
+        sunPositionOut[1] = sunPositionOut[1] + (cos(azi) * deltaLat) + (cos(lat) * sin(azi) * deltaLong);
+    }
+
+    return true;
+}
+
+void HelioSunPositions::calcSunPositionEntry(SunPositionEntry &entry)
+{
+    #if HELIO_PANEL_EPHEM_STEPMINS
+    {   // ephemeris caches cover only system location & equatorial, which are the coords most panels share
+        Location location = getController() ? getController()->getSystemLocation() : Location();
+        hposi_t cacheIndex = entry.latitude == DBL_UNDEF ? 1 : entry.latitude == location.latitude && entry.longitude == location.longitude ? 0 : hposi_none;
+
+        if (isValidIndex(cacheIndex)) {
+            if (!_sunEphemeris[cacheIndex]) {
+                _sunEphemeris[cacheIndex] = new HelioEphemerisCache();
+                HELIO_SOFT_ASSERT(_sunEphemeris[cacheIndex], SFP(HStr_Err_AllocationFailure));
+            }
+            if (_sunEphemeris[cacheIndex]) {
+                if (_sunEphemeris[cacheIndex]->lookup(entry.time, entry.position, entry.latitude, entry.longitude)) { return; }
+                if (_sunEphemeris[cacheIndex]->rebuild(entry.time, entry.latitude, entry.longitude)) {
+                    ++_sunPosCalcs;
+                    if (_sunEphemeris[cacheIndex]->lookup(entry.time, entry.position, entry.latitude, entry.longitude)) { return; }
+                }
+            }
+        }
+    }
+    #endif
+
+    calcSunPosition(entry.time, entry.latitude, entry.longitude, entry.position);
+    ++_sunPosCalcs;
+}
+
+
+#ifdef HELIO_USE_MULTITASKING
+
+static void analogSamplerLoop()
+{
+    if (getController()) { getController()->updateAnalogSampler(); }
+}
+
+#endif
+
+HelioAnalogSampler::HelioAnalogSampler()
+    : _rateWindowStart(0)
+#ifdef HELIO_USE_MULTITASKING
+      , _samplerTaskId(TASKMGR_INVALIDID)
+#endif
+{ ; }
+
+bool HelioAnalogSampler::requestAnalogSamples(HelioAnalogSensor *sensor)
+{
+    HELIO_SOFT_ASSERT(sensor, SFP(HStr_Err_InvalidParameter));
+    if (!sensor) { return false; }
+
+    int entryIndex = 0;
+    while (entryIndex < _samplerEntries.size() && _samplerEntries[entryIndex].sensor != sensor) { ++entryIndex; }
+
+    if (entryIndex >= _samplerEntries.size()) {
+        HELIO_SOFT_ASSERT(_samplerEntries.size() < HELIO_SYS_ANALOGSAMPLER_MAXSIZE, SFP(HStr_Err_OperationFailure));
+        if (_samplerEntries.size() >= HELIO_SYS_ANALOGSAMPLER_MAXSIZE) { return false; }
+
+        SamplerEntry newEntry;
+        newEntry.sensor = sensor;
+        newEntry.sequenceKey = batchOrderKeyForPin(sensor->_inputPin);
+        newEntry.pending = false;
+        newEntry.windowSamples = 0;
+        newEntry.sampleRate = 0.0f;
+
+        _samplerEntries.push_back(newEntry);
+        for (entryIndex = _samplerEntries.size() - 1; entryIndex > 0 && _samplerEntries[entryIndex - 1].sequenceKey > newEntry.sequenceKey; --entryIndex) {
+            _samplerEntries[entryIndex] = _samplerEntries[entryIndex - 1];
+        }
+        _samplerEntries[entryIndex] = newEntry;
+        if (!_rateWindowStart) { _rateWindowStart = nzMillis(); }
+    }
+    _samplerEntries[entryIndex].pending = true;
+
+    #ifdef HELIO_USE_MULTITASKING
+        if (!isValidTask(_samplerTaskId)) {
+            _samplerTaskId = taskManager.scheduleOnce(0, analogSamplerLoop);
+            HELIO_SOFT_ASSERT(isValidTask(_samplerTaskId), SFP(HStr_Err_OperationFailure));
+        }
+        return isValidTask(_samplerTaskId);
+    #else
+        bool pending = true;
+        while (pending && sampleAnalogRound()) {
+            for (entryIndex = 0; entryIndex < _samplerEntries.size() && _samplerEntries[entryIndex].sensor != sensor; ++entryIndex) { ; }
+            pending = entryIndex < _samplerEntries.size() && _samplerEntries[entryIndex].pending;
+        }
+        if (pending && entryIndex < _samplerEntries.size()) { _samplerEntries[entryIndex].pending = false; } // pin busy, retried on next poll
+        updateSampleRates();
+        return !pending;
+    #endif
+}
+
+void HelioAnalogSampler::withdrawAnalogSensor(HelioAnalogSensor *sensor)
+{
+    for (int entryIndex = 0; entryIndex < _samplerEntries.size(); ++entryIndex) {
+        if (_samplerEntries[entryIndex].sensor == sensor) {
+            _samplerEntries.erase(_samplerEntries.begin() + entryIndex);
+            break;
+        }
+    }
+}
+
+void HelioAnalogSampler::updateAnalogSampler()
+{
+    #ifdef HELIO_USE_MULTITASKING
+        _samplerTaskId = TASKMGR_INVALIDID;
+    #endif
+
+    sampleAnalogRound();
+    updateSampleRates();
+
+    #ifdef HELIO_USE_MULTITASKING
+        for (int entryIndex = 0; entryIndex < _samplerEntries.size(); ++entryIndex) {
+            if (_samplerEntries[entryIndex].pending) {
+                _samplerTaskId = taskManager.scheduleOnce(HELIO_SENSOR_ANALOGREAD_DELAY, analogSamplerLoop);
+                break;
+            }
+        }
+    #endif
+}
+
+float HelioAnalogSampler::getAnalogSampleRate(const HelioAnalogSensor *sensor) const
+{
+    for (int entryIndex = 0; entryIndex < _samplerEntries.size(); ++entryIndex) {
+        if (_samplerEntries[entryIndex].sensor == sensor) {
+            return _samplerEntries[entryIndex].sampleRate;
+        }
+    }
+    return 0.0f;
+}
+
+uint8_t HelioAnalogSampler::sampleAnalogRound()
+{
+    uint8_t conversions = 0;
+
+    for (int entryIndex = 0; entryIndex < _samplerEntries.size(); ++entryIndex) {
+        if (_samplerEntries[entryIndex].pending) {
+            HelioAnalogSensor *sensor = _samplerEntries[entryIndex].sensor;
+            bool completed = false;
+
+            // finishes sensor's oversample burst before moving on, so shared muxers switch once per sensor
+            while (!completed && getController()->tryGetPinLock(sensor->_inputPin.pin, 5)) {
+                int rawRead = sensor->_inputPin.analogRead_raw();
+                getController()->returnPinLock(sensor->_inputPin.pin);
+                _samplerEntries[entryIndex].windowSamples++;
+                conversions++;
+
+                completed = sensor->handleAnalogSample(rawRead);
+                // measurement signal handlers may have altered sequence
+                if (entryIndex >= _samplerEntries.size() || _samplerEntries[entryIndex].sensor != sensor) { return conversions; }
+                _samplerEntries[entryIndex].pending = !completed;
+
+                #if HELIO_SENSOR_ANALOGREAD_DELAY > 0
+                    #ifdef HELIO_USE_MULTITASKING
+                        if (!completed) { return conversions; } // burst resumes on next round
+                    #else
+                        if (!completed) { delay(HELIO_SENSOR_ANALOGREAD_DELAY); }
+                    #endif
+                #endif
+            }
+
+            if (!completed) { break; } // pin busy, burst resumes on next round
+        }
+    }
+
+    return conversions;
+}
+
+void HelioAnalogSampler::updateSampleRates()
+{
+    millis_t time = nzMillis();
+
+    if (_rateWindowStart && time - _rateWindowStart >= 1000) {
+        float windowSecs = (time - _rateWindowStart) / 1000.0f;
+
+        for (int entryIndex = 0; entryIndex < _samplerEntries.size(); ++entryIndex) {
+            _samplerEntries[entryIndex].sampleRate = _samplerEntries[entryIndex].windowSamples / windowSecs;
+            _samplerEntries[entryIndex].windowSamples = 0;
+        }
+        _rateWindowStart = time;
+    }
+}
@@ -7,8 +7,11 @@
 #define HelioModules_H
 
 class HelioCalibrations;
+template<size_t N> class HelioObjectRegistry;
 class HelioObjectRegistration;
 class HelioPinHandlers;
+class HelioSunPositions;
+class HelioAnalogSampler;
 
 #include "Helioduino.h"
 #include "HelioPins.h"
@@ -35,6 +38,88 @@ protected:
 };
 
 
+// Object Registry
+// Flat object store that partitions objects by identity type into contiguous runs (actuators,
+// sensors, panels, rails) of a single shared array, sized to the max # of objects in system.
+// Run loops walk only the partition(s) they care about, in array order, while iteration over
+// all objects walks the whole array. Inserting shifts later partitions up by one, and erasing
+// moves a partition's last object into the freed slot before shifting later partitions down,
+// so partition order is not stable across removals. Key lookups use an open-addressed key-to-
+// slot index on large SRAM devices, else a linear key scan (as the prior map did). Placement
+// generations back HelioObjectHandle validation (see HelioDLinkObject).
+template<size_t N = HELIO_SYS_OBJECTS_MAXSIZE>
+class HelioObjectRegistry {
+public:
+    typedef const SharedPtr<HelioObject> *iterator;
+
+    // Partition view, over a type's contiguous run of objects in registry
+    class Partition {
+    public:
+        inline Partition(iterator objects, size_t size) : _objects(objects), _size(size) { ; }
+        inline iterator begin() const { return _objects; }
+        inline iterator end() const { return _objects + _size; }
+        inline size_t size() const { return _size; }
+        inline const SharedPtr<HelioObject> &operator[](size_t slot) const { return _objects[slot]; }
+    protected:
+        iterator _objects;
+        size_t _size;
+    };
+
+    HelioObjectRegistry();
+
+    // Inserts object into its type's partition, returning success (fails if key taken or full)
+    bool insert(SharedPtr<HelioObject> obj);
+    // Erases object by key, returning success
+    bool erase(hkey_t key);
+    // Erases all objects
+    void clear();
+
+    // Returns object by key, else nullptr
+    inline SharedPtr<HelioObject> find(hkey_t key) const { int position = positionOf(key); return position >= 0 ? _objects[position] : nullptr; }
+    // Returns if object by key is present
+    inline bool contains(hkey_t key) const { return positionOf(key) >= 0; }
+
+    // Returns slot handle of object by key, else unset handle
+    HelioObjectHandle handleOf(hkey_t key) const;
+    // Returns if handle still refers to the same occupant of its slot
+    inline bool isCurrent(const HelioObjectHandle &handle) const { return handle.isSet() && _starts[handle.type] + handle.slot < _starts[handle.type + 1] && _generations[_starts[handle.type] + handle.slot] == handle.generation; }
+    // Returns object by handle (no refcount traffic), else nullptr if handle is stale
+    inline HelioObject *objectAt(const HelioObjectHandle &handle) const { return isCurrent(handle) ? _objects[_starts[handle.type] + handle.slot].get() : nullptr; }
+
+    inline Partition getPartition(int8_t type) const { return Partition(&_objects[_starts[type]], _starts[type + 1] - _starts[type]); }
+    inline Partition getActuators() const { return getPartition(HelioIdentity::Actuator); }
+    inline Partition getSensors() const { return getPartition(HelioIdentity::Sensor); }
+    inline Partition getPanels() const { return getPartition(HelioIdentity::Panel); }
+    inline Partition getRails() const { return getPartition(HelioIdentity::Rail); }
+
+    inline iterator begin() const { return &_objects[0]; }
+    inline iterator end() const { return &_objects[size()]; }
+    inline size_t size() const { return _starts[HelioIdentity::Rail + 1]; }
+
+protected:
+    SharedPtr<HelioObject> _objects[N];                     // Object store, partitions laid out contiguously in type order
+    uint16_t _generations[N];                               // Object placement generations, parallel to object store
+    uint16_t _starts[HelioIdentity::Rail + 2];              // Partition start positions, with last being total size
+    uint16_t _nextGeneration;                               // Next placement generation
+#if HAS_LARGE_SRAM
+    struct IndexEntry {
+        hkey_t key;                                         // Object key
+        int8_t type;                                        // Partition type, else -1/empty
+        uint16_t slot;                                      // Partition slot
+    };
+    IndexEntry _index[N * 2];                               // Key-to-slot index (linear probing, <= 50% load)
+
+    // Returns index entry position for key, else -1
+    int indexOf(hkey_t key) const;
+#endif
+
+    // Returns object store position for key, else -1
+    int positionOf(hkey_t key) const;
+    // Moves object store entry from one position to another, keeping its generation
+    inline void move(size_t from, size_t to) { _objects[to] = _objects[from]; _generations[to] = _generations[from]; }
+};
+
+
 // Object Registration Storage
 // Stores objects in main system store, which is used for SharedPtr<> lookups as well as
 // notifying appropriate modules upon entry-to/exit-from the system.
@@ -56,7 +141,7 @@ public:
     inline hposi_t firstPositionOpen(HelioIdentity id) { return firstPosition(id, false); }
 
 protected:
-    Map<hkey_t, SharedPtr<HelioObject>, HELIO_SYS_OBJECTS_MAXSIZE> _objects; // Shared object collection, key'ed by HelioIdentity
+    HelioObjectRegistry<> _objects;                         // Shared object collection, partitioned by type and key'ed by HelioIdentity
 
     SharedPtr<HelioObject> objectById_Col(const HelioIdentity &id) const;
 };
@@ -89,6 +174,11 @@ public:
     inline void setPinExpander(hposi_t index, SharedPtr<HelioPinExpander> pinExpander) { _pinExpanders[index] = pinExpander; }
     // Returns expander for index.
     inline SharedPtr<HelioPinExpander> getPinExpander(hposi_t index) { return _pinExpanders[index]; }
+    // Flushes pending pin expander writes and expires pin expander port images. Called once
+    // per control tick (see HELIO_EXPANDERS_SHADOW_IO).
+    void updatePinExpanders();
+    // Flushes pending pin expander writes.
+    void flushPinExpanders();
 
 #endif // /ifdef HELIO_USE_MULTITASKING
 
@@ -106,4 +196,99 @@ protected:
 #endif
 };
 
+
+// Sun Positions Service
+// Shares sun position calculations across all tracking panels, key'ed by time quantum and
+// lat/long bucket, so that panels sharing the system location (or near enough to it) do not
+// each recalculate the same position every control loop tick. Positions are resolved once
+// per bucket per quantum (through a shared daily ephemeris cache if enabled), and panels
+// offset from their bucket's base coords receive a cheap first-order correction instead.
+// Entries for other quanta (e.g. lookahead queries) are kept alongside, evicting the oldest.
+class HelioSunPositions {
+public:
+    HelioSunPositions();
+    ~HelioSunPositions();
+
+    // Advances time quantum and pre-resolves system location's sun position. Called once per control loop tick.
+    void updateSunPositions(time_t unixTime = unixNow());
+    // Invalidates shared sun positions and ephemeris caches, forcing recalculation (e.g. upon day/location change)
+    void invalidateSunPositions();
+
+    // Resolves sun position at passed unix/UTC time, in horizontal (azi,ele) coords if lat/long are given, else in
+    // equatorial (RA,dec) coords if left DBL_UNDEF, into sunPositionOut. Returns success flag.
+    bool getSunPosition(time_t unixTime, double latitude, double longitude, double *sunPositionOut);
+    // Resolves equatorial (RA,dec) sun position at passed unix/UTC time into sunPositionOut. Returns success flag.
+    inline bool getSunPosition(time_t unixTime, double *sunPositionOut) { return getSunPosition(unixTime, DBL_UNDEF, DBL_UNDEF, sunPositionOut); }
+
+    // Number of full sun position calculations/rebuilds performed (for performance monitoring)
+    inline uint32_t getSunPositionCalcCount() const { return _sunPosCalcs; }
+    // Number of sun position queries served (for performance monitoring)
+    inline uint32_t getSunPositionQueryCount() const { return _sunPosQueries; }
+
+protected:
+    struct SunPositionEntry {
+        time_t time;                                        // Time quantum start (unix/UTC)
+        int16_t bucket[2];                                  // Lat/long bucket indicies
+        double latitude;                                    // Base latitude, else DBL_UNDEF (equatorial)
+        double longitude;                                   // Base longitude, else DBL_UNDEF (equatorial)
+        double position[2];                                 // Sun position at base coords (azi,ele or RA,dec)
+    };
+    time_t _sunPosTime;                                     // Current time quantum start (unix/UTC), else 0/none
+    Vector<SunPositionEntry, HELIO_SYS_SUNPOS_MAXSIZE> _sunPositions; // Resolved sun positions, in insertion order
+    uint8_t _sunPosEvict;                                   // Next entry index to evict (oldest) when full
+#if HELIO_PANEL_EPHEM_STEPMINS
+    HelioEphemerisCache *_sunEphemeris[2];                  // Daily ephemeris caches (owned, lazy, system location horizontal & equatorial)
+#endif
+    uint32_t _sunPosCalcs;                                  // Full calculation count
+    uint32_t _sunPosQueries;                                // Query count
+
+    void calcSunPositionEntry(SunPositionEntry &entry);
+};
+
+
+// Analog Sampler Service
+// Owns the ADC on behalf of all analog sensors, running conversions in a fixed round-robin
+// sequence in batch access order (see batchOrderKeyForPin), so that sensors sharing a muxer
+// are read back-to-back. Sensors request samples rather than reading on their own, and each
+// round runs each requesting sensor's full oversample burst in turn, delivering raw reads into
+// that sensor's filter until its measurement completes, so a muxer only switches channels once
+// per sensor. When multitasking, rounds run from a task (with bursts spread across task runs
+// spaced HELIO_SENSOR_ANALOGREAD_DELAY apart), else requests are serviced inline. A busy pin
+// ends the round early, resuming that sensor's burst on the next round.
+class HelioAnalogSampler {
+public:
+    HelioAnalogSampler();
+
+    // Requests a new measurement's worth of samples for sensor, enrolling it into the sequence if needed. Returns success.
+    bool requestAnalogSamples(HelioAnalogSensor *sensor);
+    // Withdraws sensor from the sequence (e.g. upon sensor destruction)
+    void withdrawAnalogSensor(HelioAnalogSensor *sensor);
+    // Runs one round over the sequence and reschedules itself if any requests remain. Called by sampler task.
+    void updateAnalogSampler();
+
+    // Achieved samples per second for sensor's channel, over last completed rate window, else 0 if not enrolled
+    float getAnalogSampleRate(const HelioAnalogSensor *sensor) const;
+    // Number of sensors enrolled in the sequence
+    inline uint8_t getAnalogSensorCount() const { return _samplerEntries.size(); }
+
+protected:
+    struct SamplerEntry {
+        HelioAnalogSensor *sensor;                          // Sampled sensor (not owned)
+        int16_t sequenceKey;                                // Sequence ordering key (batch access order of input pin)
+        bool pending;                                       // Samples requested flag
+        uint16_t windowSamples;                             // Conversions in current rate window
+        float sampleRate;                                   // Samples per second over last rate window
+    };
+    Vector<SamplerEntry, HELIO_SYS_ANALOGSAMPLER_MAXSIZE> _samplerEntries; // Round-robin sequence, sorted by sequence key
+    millis_t _rateWindowStart;                              // Rate window start millis
+#ifdef HELIO_USE_MULTITASKING
+    taskid_t _samplerTaskId;                                // Sampler task Id if scheduled, else TASKMGR_INVALIDID
+#endif
+
+    // Runs oversample burst for each pending sensor, in sequence order, returning # of conversions made
+    uint8_t sampleAnalogRound();
+    // Rolls rate window over once elapsed
+    void updateSampleRates();
+};
+
 #endif // /ifndef HelioModules_H
@@ -0,0 +1,133 @@
+/*  Helioduino: Simple automation controller for solar tracking systems.
+    Copyright (C) 2023 NachtRaveVL          <nachtravevl@gmail.com>
+    Helioduino Modules
+*/
+
+#include "Helioduino.h"
+
+template<size_t N>
+HelioObjectRegistry<N>::HelioObjectRegistry()
+    : _nextGeneration(1)
+{
+    memset(_generations, 0, sizeof(_generations));
+    memset(_starts, 0, sizeof(_starts));
+    #if HAS_LARGE_SRAM
+        for (size_t index = 0; index < N * 2; ++index) { _index[index].type = -1; }
+    #endif
+}
+
+template<size_t N>
+bool HelioObjectRegistry<N>::insert(SharedPtr<HelioObject> obj)
+{
+    HELIO_SOFT_ASSERT(obj && !obj->isUnknownType(), SFP(HStr_Err_InvalidParameter));
+    if (obj && !obj->isUnknownType() && size() < N && !contains(obj->getKey())) {
+        int8_t type = obj->getId().type;
+        size_t position = _starts[type + 1];
+
+        for (size_t from = size(); from > position; --from) { move(from - 1, from); }
+        _objects[position] = obj;
+        _generations[position] = _nextGeneration++;
+        for (int8_t nextType = type + 1; nextType <= HelioIdentity::Rail + 1; ++nextType) { _starts[nextType]++; }
+
+        #if HAS_LARGE_SRAM
+            hkey_t key = obj->getKey();
+            size_t index = key % (N * 2);
+            while (_index[index].type != -1) { index = (index + 1) % (N * 2); }
+            _index[index].key = key;
+            _index[index].type = type;
+            _index[index].slot = position - _starts[type];
+        #endif
+
+        return true;
+    }
+    return false;
+}
+
+template<size_t N>
+bool HelioObjectRegistry<N>::erase(hkey_t key)
+{
+    int position = positionOf(key);
+    if (position >= 0) {
+        int8_t type = _objects[position]->getId().type;
+        size_t last = _starts[type + 1] - 1;
+
+        if ((size_t)position < last) { // move last into freed slot, as new occupant
+            _objects[position] = _objects[last];
+            _generations[position] = _nextGeneration++;
+            #if HAS_LARGE_SRAM
+                _index[indexOf(_objects[position]->getKey())].slot = position - _starts[type];
+            #endif
+        }
+        for (size_t to = last; to + 1 < size(); ++to) { move(to + 1, to); }
+        _objects[size() - 1] = nullptr;
+        for (int8_t nextType = type + 1; nextType <= HelioIdentity::Rail + 1; ++nextType) { _starts[nextType]--; }
+
+        #if HAS_LARGE_SRAM
+            // backward shift deletion, keeps probe chains intact without tombstones
+            size_t hole = indexOf(key);
+            for (size_t next = (hole + 1) % (N * 2); _index[next].type != -1; next = (next + 1) % (N * 2)) {
+                size_t home = _index[next].key % (N * 2);
+                if (hole < next ? (home <= hole || home > next) : (home <= hole && home > next)) {
+                    _index[hole] = _index[next];
+                    hole = next;
+                }
+            }
+            _index[hole].type = -1;
+        #endif
+
+        return true;
+    }
+    return false;
+}
+
+template<size_t N>
+void HelioObjectRegistry<N>::clear()
+{
+    for (size_t position = 0; position < size(); ++position) { _objects[position] = nullptr; }
+    memset(_starts, 0, sizeof(_starts));
+    #if HAS_LARGE_SRAM
+        for (size_t index = 0; index < N * 2; ++index) { _index[index].type = -1; }
+    #endif
+}
+
+template<size_t N>
+HelioObjectHandle HelioObjectRegistry<N>::handleOf(hkey_t key) const
+{
+    int position = positionOf(key);
+    if (position >= 0) {
+        int8_t type = _objects[position]->getId().type;
+        return HelioObjectHandle(type, position - _starts[type], _generations[position]);
+    }
+    return HelioObjectHandle();
+}
+
+template<size_t N>
+int HelioObjectRegistry<N>::positionOf(hkey_t key) const
+{
+    #if HAS_LARGE_SRAM
+        int index = indexOf(key);
+        return index >= 0 ? _starts[_index[index].type] + _index[index].slot : -1;
+    #else
+        for (size_t position = 0; position < size(); ++position) {
+            if (_objects[position]->getKey() == key) { return position; }
+        }
+        return -1;
+    #endif
+}
+
+#if HAS_LARGE_SRAM
+
+template<size_t N>
+int HelioObjectRegistry<N>::indexOf(hkey_t key) const
+{
+    size_t index = key % (N * 2);
+
+    while (_index[index].type != -1) {
+        if (_index[index].key == key) { return index; }
+        index = (index + 1) % (N * 2);
+    }
+
+    return -1;
+}
+
+#endif
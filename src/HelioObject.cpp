@@ -74,6 +74,11 @@ HelioObject::~HelioObject()
 void HelioObject::update()
 { ; }
 
+millis_t HelioObject::getWakeDelay()
+{
+    return 0;
+}
+
 void HelioObject::handleLowMemory()
 {
     if (_links && !_links[_linksSize >> 1].first) { allocateLinkages(_linksSize >> 1); } // shrink /2 if too big
@@ -7,6 +7,7 @@
 #define HelioObject_H
 
 struct HelioIdentity;
+struct HelioObjectHandle;
 class HelioObject;
 class HelioSubObject;
 
@@ -83,6 +84,22 @@ struct HelioIdentity {
 };
 
 
+// Object Handle
+// Slot index plus generation counter of a registered object in the system object registry,
+// allowing O(1) validated lookups. Registry bumps a slot's generation whenever its occupant
+// changes, so a stale handle (object moved or unregistered) is detected upon comparison.
+struct HelioObjectHandle {
+    int8_t type;                                            // Partition type (HelioIdentity type), else -1/unset
+    uint16_t slot;                                          // Partition slot
+    uint16_t generation;                                    // Slot generation at time of handle creation
+
+    inline HelioObjectHandle() : type(-1), slot(0), generation(0) { ; }
+    inline HelioObjectHandle(int8_t typeIn, uint16_t slotIn, uint16_t generationIn) : type(typeIn), slot(slotIn), generation(generationIn) { ; }
+
+    inline bool isSet() const { return type >= 0; }
+};
+
+
 // Object Base
 // A simple base class for referring to objects in the Helio system.
 class HelioObject : public HelioObjInterface {
@@ -99,6 +116,8 @@ public:
 
     // Called over intervals of time by runloop
     virtual void update();
+    // Returns maximum delay, in milliseconds, until update() next needs called by runloop (default: 0/next tick)
+    virtual millis_t getWakeDelay();
     // Called upon low memory condition to try and free memory up
     virtual void handleLowMemory();
 
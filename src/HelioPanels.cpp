@@ -33,7 +33,7 @@ HelioPanel::HelioPanel(Helio_PanelType panelType, hposi_t panelIndex, float alig
       _homePosition{0}, _axisOffset{0}, _inDaytimeMode(false),
       _isHorzCoords(!getIsEquatorialCoordsFromType(panelType)),
       _drivesHorz(getDrivesHorizontalAxis(panelType)), _drivesVert(getDrivesVerticalAxis(panelType)),
-      _powerProd(this), _axisDriver{HelioDriverAttachment(this,0),HelioDriverAttachment(this,1)}
+      _powerProd(this), _axisDriver{HelioDriverAttachment(this,0),HelioDriverAttachment(this,1)}, _userAxisDriver{false,false}
 {
     allocateLinkages(HELIO_PANEL_LINKS_BASESIZE);
     _powerProd.setMeasurementUnits(getPowerUnits());
@@ -49,11 +49,17 @@ HelioPanel::HelioPanel(const HelioPanelData *dataIn)
       _isHorzCoords(!getIsEquatorialCoordsFromType((Helio_PanelType)dataIn->id.object.objType)),
       _drivesHorz(getDrivesHorizontalAxis((Helio_PanelType)dataIn->id.object.objType)),
       _drivesVert(getDrivesVerticalAxis((Helio_PanelType)dataIn->id.object.objType)),
-      _powerProd(this), _axisDriver{HelioDriverAttachment(this,0),HelioDriverAttachment(this,1)}
+      _powerProd(this), _axisDriver{HelioDriverAttachment(this,0),HelioDriverAttachment(this,1)}, _userAxisDriver{false,false}
 {
     allocateLinkages(HELIO_PANEL_LINKS_BASESIZE);
     _powerProd.setMeasurementUnits(getPowerUnits());
     _powerProd.initObject(dataIn->powerProdSensor);
+    for (hposi_t axisIndex = 0; axisIndex < 2; ++axisIndex) {
+        if (dataIn->axisDriver[axisIndex].isSet()) {
+            _axisDriver[axisIndex].initObject(SharedPtr<HelioDriver>(newDriverObjectFromSubData(&dataIn->axisDriver[axisIndex])));
+            _userAxisDriver[axisIndex] = true;
+        }
+    }
 }
 
 HelioPanel::~HelioPanel()
@@ -75,6 +81,11 @@ void HelioPanel::update()
     }
 }
 
+millis_t HelioPanel::getWakeDelay()
+{
+    return _panelState != (isDaylight() ? Helio_PanelState_AlignedToSun : Helio_PanelState_AlignedToHome) ? 0 : HELIO_CONTROL_LOOP_MAXSLEEP;
+}
+
 SharedPtr<HelioObjInterface> HelioPanel::getSharedPtrFor(const HelioObjInterface *obj) const
 {
     return obj->getKey() == _axisDriver[0].getKey() ? _axisDriver[0].getSharedPtrFor(obj) :
@@ -147,6 +158,11 @@ void HelioPanel::saveToData(HelioData *dataOut)
     if (_powerProd.isSet()) {
         strncpy(((HelioPanelData *)dataOut)->powerProdSensor, _powerProd.getKeyString().c_str(), HELIO_NAME_MAXSIZE);
     }
+    for (hposi_t axisIndex = 0; axisIndex < 2; ++axisIndex) {
+        if (_axisDriver[axisIndex].isResolved() && (_userAxisDriver[axisIndex] || _axisDriver[axisIndex]->isPIDType())) { // scheduler defaults aren't persisted
+            _axisDriver[axisIndex]->saveToData(&((HelioPanelData *)dataOut)->axisDriver[axisIndex]);
+        }
+    }
 }
 
 
@@ -180,6 +196,11 @@ void HelioBalancingPanel::update()
     HelioPanel::update();
 }
 
+millis_t HelioBalancingPanel::getWakeDelay()
+{
+    return isDaylight() ? 0 : HelioPanel::getWakeDelay(); // LDR balance can only be known by polling
+}
+
 bool HelioBalancingPanel::isAligned(bool poll)
 {
     if (poll) {
@@ -299,6 +320,7 @@ HelioTrackingPanel::HelioTrackingPanel(Helio_PanelType panelType, hposi_t panelI
       HelioTemperatureUnitsInterfaceStorage(defaultTemperatureUnits()),
       HelioDistanceUnitsInterfaceStorage(defaultDistanceUnits()),
       _lastAlignedTime(0), _locationOffset{0}, _sunPosition{0}, _facingPosition{0},
+      _sunStepLead(HELIO_PANEL_SUNSTEP_LEADDEG), _sunStepTime(0), _plannedMoves(0), _plannedTravel{0},
       _powerUsage(this), _axisAngle{HelioSensorAttachment(this,0),HelioSensorAttachment(this,1)},
       _temperature(this), _windSpeed(this), _heatingTrigger(this), _stormingTrigger(this)
 {
@@ -316,6 +338,7 @@ HelioTrackingPanel::HelioTrackingPanel(const HelioTrackingPanelData *dataIn)
       _lastAlignedTime(dataIn->lastAlignedTime), _sunPosition{0},
       _locationOffset{dataIn->locationOffset[0], dataIn->locationOffset[1]},
       _facingPosition{dataIn->axisPosition[0], dataIn->axisPosition[1]},
+      _sunStepLead(HELIO_PANEL_SUNSTEP_LEADDEG), _sunStepTime(0), _plannedMoves(0), _plannedTravel{0},
       _powerUsage(this), _axisAngle{HelioSensorAttachment(this,0),HelioSensorAttachment(this,1)},
       _temperature(this), _windSpeed(this), _heatingTrigger(this), _stormingTrigger(this)
 {
@@ -354,6 +377,48 @@ void HelioTrackingPanel::update()
     HelioPanel::update();
 }
 
+millis_t HelioTrackingPanel::getWakeDelay()
+{
+    millis_t wakeDelay = HelioPanel::getWakeDelay();
+
+    if (wakeDelay && _panelState == Helio_PanelState_AlignedToSun && isPlanningSunSteps() && _sunStepTime) {
+        // sleep until next planned sun-step move
+        time_t time = unixNow();
+        if (_sunStepTime <= time) {
+            wakeDelay = 0;
+        } else if (_sunStepTime - time <= (time_t)(wakeDelay / 1000)) {
+            wakeDelay = (millis_t)(_sunStepTime - time) * 1000;
+        }
+    } else if (wakeDelay && _panelState == Helio_PanelState_AlignedToSun) {
+        // sleep until facing target has moved by alignment tolerance, as estimated by a short forward difference
+        double sunPositionNext[2];
+        if (calcSunPositionAt(unixNow() + HELIO_PANEL_SUNSTEP_SAMPLESECS, sunPositionNext)) {
+            float target[2], targetNext[2];
+            calcFacingTarget(_sunPosition, target);
+            calcFacingTarget(sunPositionNext, targetNext);
+            float targetStep = 0;
+            if (drivesHorizontalAxis()) { targetStep = max(targetStep, fabsf(wrapBy180Neg180(targetNext[0] - target[0]))); }
+            if (drivesVerticalAxis()) { targetStep = max(targetStep, fabsf(wrapBy180Neg180(targetNext[1] - target[1]))); }
+            if (targetStep > FLT_EPSILON) {
+                float stepMillis = (_alignedTolerance * (HELIO_PANEL_SUNSTEP_SAMPLESECS * 1000.0f)) / targetStep;
+                if (stepMillis < wakeDelay) { wakeDelay = (millis_t)stepMillis; }
+            }
+        } else {
+            wakeDelay = 0;
+        }
+    }
+    if (wakeDelay && _heatingTrigger.isResolved()) {
+        millis_t detriggerLeft = _heatingTrigger->getDetriggerDelayLeft();
+        if (detriggerLeft) { wakeDelay = min(wakeDelay, detriggerLeft); }
+    }
+    if (wakeDelay && _stormingTrigger.isResolved()) {
+        millis_t detriggerLeft = _stormingTrigger->getDetriggerDelayLeft();
+        if (detriggerLeft) { wakeDelay = min(wakeDelay, detriggerLeft); }
+    }
+
+    return wakeDelay;
+}
+
 SharedPtr<HelioObjInterface> HelioTrackingPanel::getSharedPtrFor(const HelioObjInterface *obj) const
 {
     return obj->getKey() == _heatingTrigger.getKey() ? _heatingTrigger.getSharedPtrFor(obj) :
@@ -404,27 +469,51 @@ bool HelioTrackingPanel::isAligned(bool poll)
 
 void HelioTrackingPanel::recalcSunPosition()
 {
-    time_t time = unixNow();
-    JulianDay julianTime(time);
+    calcSunPositionAt(unixNow(), _sunPosition);
+}
+
+bool HelioTrackingPanel::calcSunPositionAt(time_t time, double *sunPositionOut)
+{
+    double latitude = DBL_UNDEF, longitude = DBL_UNDEF;
 
     if (isHorizontalCoords()) {
         Location location = getController() ? getController()->getSystemLocation() : Location();
-        if (location.hasPosition()) {
-            calcHorizontalCoordinates(julianTime, location.latitude + _locationOffset[0], location.longitude + _locationOffset[1], _sunPosition[0], _sunPosition[1]);
-        }
-    } else if (isEquatorialCoords()) {
-        double radius;
-        calcEquatorialCoordinates(julianTime, _sunPosition[0], _sunPosition[1], radius);
-    } else {
+        if (!location.hasPosition()) { return false; }
+        latitude = location.latitude + _locationOffset[0];
+        longitude = location.longitude + _locationOffset[1];
+    } else if (!isEquatorialCoords()) {
         HELIO_SOFT_ASSERT(false, SFP(HStr_Err_UnsupportedOperation));
+        return false;
+    }
+
+    if (!getController() || !getController()->getSunPosition(time, latitude, longitude, sunPositionOut)) {
+        calcSunPosition(time, latitude, longitude, sunPositionOut);
     }
+    return true;
 }
 
 void HelioTrackingPanel::recalcFacingPosition()
 {
+    if (isDaylight() && isPlanningSunSteps()) {
+        time_t time = unixNow();
+        if (!_sunStepTime || time >= _sunStepTime) {
+            planSunStep(time);
+        }
+        if (_sunStepTime) { // facing position held until next planned move
+            if (drivesHorizontalAxis() && _axisDriver[0].resolve()) { _axisDriver[0]->setTargetSetpoint(_facingPosition[0]); }
+            if (drivesVerticalAxis() && _axisDriver[1].resolve()) { _axisDriver[1]->setTargetSetpoint(_facingPosition[1]); }
+            return;
+        }
+    } else {
+        _sunStepTime = 0;
+    }
+
+    float target[2] = { _facingPosition[0], _facingPosition[1] };
+    if (isDaylight()) { calcFacingTarget(_sunPosition, target); }
+
     if (drivesHorizontalAxis()) {
         if (isDaylight()) {
-            _facingPosition[0] = wrapBy360(_sunPosition[0] + _axisOffset[0]);
+            _facingPosition[0] = target[0];
         } else {
             _facingPosition[0] = wrapBy360(_homePosition[0] + _axisOffset[0]);
         }
@@ -432,7 +521,7 @@ void HelioTrackingPanel::recalcFacingPosition()
     }
     if (drivesVerticalAxis()) {
         if (isDaylight()) {
-            _facingPosition[1] = wrapBy180Neg180(_sunPosition[1] + _axisOffset[1]);
+            _facingPosition[1] = target[1];
         } else {
             _facingPosition[1] = wrapBy180Neg180(_homePosition[1] + _axisOffset[1]);
         }
@@ -440,6 +529,78 @@ void HelioTrackingPanel::recalcFacingPosition()
     }
 }
 
+void HelioTrackingPanel::calcFacingTarget(const double *sunPosition, float *facingPositionOut) const
+{
+    facingPositionOut[0] = wrapBy360(sunPosition[0] + _axisOffset[0]);
+    facingPositionOut[1] = wrapBy180Neg180(sunPosition[1] + _axisOffset[1]);
+}
+
+void HelioTrackingPanel::planSunStep(time_t time)
+{
+    // facing target's angular velocity from a short forward difference, taking fastest driven axis
+    double sunPositionNext[2];
+    if (!calcSunPositionAt(time + HELIO_PANEL_SUNSTEP_SAMPLESECS, sunPositionNext)) { _sunStepTime = 0; return; }
+    float target[2], targetNext[2];
+    calcFacingTarget(_sunPosition, target);
+    calcFacingTarget(sunPositionNext, targetNext);
+    float targetRate = 0; // deg/sec
+    if (drivesHorizontalAxis()) { targetRate = max(targetRate, fabsf(wrapBy180Neg180(targetNext[0] - target[0])) / HELIO_PANEL_SUNSTEP_SAMPLESECS); }
+    if (drivesVerticalAxis()) { targetRate = max(targetRate, fabsf(wrapBy180Neg180(targetNext[1] - target[1])) / HELIO_PANEL_SUNSTEP_SAMPLESECS); }
+
+    // facing leads target by lead degrees, then is held until target passes it by aligned tolerance
+    time_t leadSecs = 0, holdSecs = HELIO_CONTROL_LOOP_MAXSLEEP / 1000;
+    if (targetRate > FLT_EPSILON) {
+        leadSecs = (time_t)(_sunStepLead / targetRate);
+        holdSecs = (time_t)((_sunStepLead + _alignedTolerance) / targetRate);
+    }
+    double sunPositionLead[2] = { _sunPosition[0], _sunPosition[1] };
+    if (leadSecs > 0) { calcSunPositionAt(time + leadSecs, sunPositionLead); }
+    float targetLead[2];
+    calcFacingTarget(sunPositionLead, targetLead);
+
+    float facingPosition[2] = { _facingPosition[0], _facingPosition[1] };
+    if (drivesHorizontalAxis()) {
+        facingPosition[0] = targetLead[0];
+        _plannedTravel[0] += fabsf(wrapBy180Neg180(facingPosition[0] - _facingPosition[0]));
+    }
+    if (drivesVerticalAxis()) {
+        facingPosition[1] = targetLead[1];
+        _plannedTravel[1] += fabsf(facingPosition[1] - _facingPosition[1]);
+    }
+    _facingPosition[0] = facingPosition[0];
+    _facingPosition[1] = facingPosition[1];
+    _sunStepTime = time + max(holdSecs, (time_t)1);
+    _plannedMoves++;
+}
+
+float HelioTrackingPanel::getPlannedMoveEnergy()
+{
+    float energy = 0; // Wh
+
+    for (hposi_t axisIndex = 0; axisIndex < 2; ++axisIndex) {
+        if ((axisIndex == 0 ? drivesHorizontalAxis() : drivesVerticalAxis()) && _axisDriver[axisIndex].resolve()) {
+            float runSecs = _plannedMoves * HELIO_PANEL_SUNSTEP_STARTSECS;
+            if (!_axisDriver[axisIndex]->isInstantaneous() && _axisDriver[axisIndex]->getTravelRate() > FLT_EPSILON) {
+                runSecs += (_plannedTravel[axisIndex] / _axisDriver[axisIndex]->getTravelRate()) * SECS_PER_MIN;
+            }
+
+            auto &actuators = _axisDriver[axisIndex]->getActuators();
+            for (auto attachIter = actuators.begin(); attachIter != actuators.end(); ++attachIter) {
+                auto actuator = ((HelioActuatorAttachment &)(*attachIter)).getObject();
+                if (actuator) {
+                    auto rail = actuator->getParentRail();
+                    auto powerUsage = actuator->getContinuousPowerUsage().asUnits(Helio_UnitsType_Power_Wattage, rail ? rail->getRailVoltage() : FLT_UNDEF);
+                    if (powerUsage.units == Helio_UnitsType_Power_Wattage) {
+                        energy += powerUsage.value * (runSecs / SECS_PER_HOUR);
+                    }
+                }
+            }
+        }
+    }
+
+    return energy;
+}
+
 void HelioTrackingPanel::setPowerUnits(Helio_UnitsType powerUnits)
 {
     if (_powerUnits != powerUnits) {
@@ -560,24 +721,11 @@ void HelioReflectingPanel::saveToData(HelioData *dataOut)
     ((HelioReflectingPanelData *)dataOut)->reflectPosition[1] = _reflectPosition[1];
 }
 
-void HelioReflectingPanel::recalcFacingPosition()
+void HelioReflectingPanel::calcFacingTarget(const double *sunPosition, float *facingPositionOut) const
 {
-    if (drivesHorizontalAxis()) {
-        if (isDaylight()) {
-            _facingPosition[0] = wrapBy360((_sunPosition[0] + ((wrapBy180Neg180(_reflectPosition[0]) - wrapBy180Neg180(_sunPosition[0])) * 0.5f)) + _axisOffset[0]);
-        } else {
-            _facingPosition[0] = wrapBy360(_homePosition[0] + _axisOffset[0]);
-        }
-        if (_axisDriver[0].resolve()) { _axisDriver[0]->setTargetSetpoint(_facingPosition[0]); }
-    }
-    if (drivesVerticalAxis()) {
-        if (isDaylight()) {
-            _facingPosition[1] = wrapBy180Neg180((_sunPosition[1] + ((wrapBy180Neg180(_reflectPosition[1]) - wrapBy180Neg180(_sunPosition[1])) * 0.5f)) + _axisOffset[1]);
-        } else {
-            _facingPosition[1] = wrapBy180Neg180(_homePosition[1] + _axisOffset[1]);
-        }
-        if (_axisDriver[1].resolve()) { _axisDriver[1]->setTargetSetpoint(_facingPosition[1]); }
-    }
+    // bisector between sun and reflect position, so that sun is reflected towards reflect position
+    facingPositionOut[0] = wrapBy360((sunPosition[0] + ((wrapBy180Neg180(_reflectPosition[0]) - wrapBy180Neg180(sunPosition[0])) * 0.5f)) + _axisOffset[0]);
+    facingPositionOut[1] = wrapBy180Neg180((sunPosition[1] + ((wrapBy180Neg180(_reflectPosition[1]) - wrapBy180Neg180(sunPosition[1])) * 0.5f)) + _axisOffset[1]);
 }
 
 
@@ -585,6 +733,7 @@ HelioPanelData::HelioPanelData()
     : HelioObjectData(), powerUnits(Helio_UnitsType_Undefined), alignedTolerance(FLT_UNDEF), homePosition{0}, axisOffset{0}, powerProdSensor{0}
 {
     _size = sizeof(*this);
+    _version = 2; // v2: axis driver and trigger measurement stat fields
 }
 
 void HelioPanelData::toJSONObject(JsonObject &objectOut) const
@@ -595,6 +744,14 @@ void HelioPanelData::toJSONObject(JsonObject &objectOut) const
     if (!(isFPEqual(homePosition[0],0) && isFPEqual(homePosition[1],0))) { objectOut[SFP(HStr_Key_HomePosition)] = commaStringFromArray(homePosition, 2); }
     if (!(isFPEqual(axisOffset[0],0) && isFPEqual(axisOffset[1],0))) { objectOut[SFP(HStr_Key_AxisOffset)] = commaStringFromArray(axisOffset, 2); }
     if (powerProdSensor[0]) { objectOut[SFP(HStr_Key_PowerProductionSensor)] = charsToString(powerProdSensor, HELIO_NAME_MAXSIZE); }
+    if (axisDriver[0].isSet()) {
+        JsonObject axisDriverHorzObj = objectOut.createNestedObject(SFP(HStr_Key_AxisDriverHorz));
+        axisDriver[0].toJSONObject(axisDriverHorzObj);
+    }
+    if (axisDriver[1].isSet()) {
+        JsonObject axisDriverVertObj = objectOut.createNestedObject(SFP(HStr_Key_AxisDriverVert));
+        axisDriver[1].toJSONObject(axisDriverVertObj);
+    }
 }
 
 void HelioPanelData::fromJSONObject(JsonObjectConst &objectIn)
@@ -609,6 +766,10 @@ void HelioPanelData::fromJSONObject(JsonObjectConst &objectIn)
     commaStringToArray(axisOffsetVar, axisOffset, 2);
     const char *powerProdSensorStr = objectIn[SFP(HStr_Key_PowerProductionSensor)];
     if (powerProdSensorStr && powerProdSensorStr[0]) { strncpy(powerProdSensor, powerProdSensorStr, HELIO_NAME_MAXSIZE); }
+    JsonObjectConst axisDriverHorzObj = objectIn[SFP(HStr_Key_AxisDriverHorz)];
+    if (!axisDriverHorzObj.isNull()) { axisDriver[0].fromJSONObject(axisDriverHorzObj); }
+    JsonObjectConst axisDriverVertObj = objectIn[SFP(HStr_Key_AxisDriverVert)];
+    if (!axisDriverVertObj.isNull()) { axisDriver[1].fromJSONObject(axisDriverVertObj); }
 }
 
 HelioBalancingPanelData::HelioBalancingPanelData()
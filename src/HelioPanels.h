@@ -47,6 +47,7 @@ public:
     virtual ~HelioPanel();
 
     virtual void update() override;
+    virtual millis_t getWakeDelay() override;
     virtual SharedPtr<HelioObjInterface> getSharedPtrFor(const HelioObjInterface *obj) const override;
 
     virtual bool canActivate(HelioActuator *actuator) override;
@@ -57,7 +58,7 @@ public:
     inline const float *getHomePosition() const { return _homePosition; }
     inline const float *getAxisOffset() const { return _axisOffset; }
 
-    inline void setInDaytimeMode(bool inDaytimeMode) { _inDaytimeMode = inDaytimeMode; }
+    inline void setInDaytimeMode(bool inDaytimeMode) { if (_inDaytimeMode != inDaytimeMode) { _inDaytimeMode = inDaytimeMode; wakeControlLoop(); } }
     inline bool getInDaytimeMode() const { return _inDaytimeMode; }
 
     inline hposi_t getAxisCount() const { return getPanelAxisCountFromType(getPanelType()); }
@@ -66,9 +67,11 @@ public:
     inline bool drivesHorizontalAxis() const { return _drivesHorz; }
     inline bool drivesVerticalAxis() const { return _drivesVert; }
 
-    template<typename T> inline void setAxisDriver(T axisDriver, hposi_t axisIndex) { _axisDriver[axisIndex].setObject(axisDriver); }
+    // Sets axis driver, which is persisted in panel data if user assigned (or PID, whose gains always persist)
+    template<typename T> inline void setAxisDriver(T axisDriver, hposi_t axisIndex, bool userAssigned = true) { _axisDriver[axisIndex].setObject(axisDriver); _userAxisDriver[axisIndex] = userAssigned; }
     inline SharedPtr<HelioDriver> getAxisDriver(hposi_t axisIndex) { return _axisDriver[axisIndex].getObject(); }
     inline HelioDriverAttachment &getAxisDriverAttachment(hposi_t axisIndex) { return _axisDriver[axisIndex]; }
+    inline bool isAxisDriverUserAssigned(hposi_t axisIndex) const { return _userAxisDriver[axisIndex]; }
 
     template<typename T> inline void setPanelCoverDriver(T coverDriver) { _coverDriver.setObject(coverDriver); }
     inline SharedPtr<HelioDriver> getPanelCoverDriver() { return _coverDriver.getObject(); }
@@ -94,7 +97,8 @@ protected:
     bool _drivesHorz;                                       // Cached result of getDrivesHorizontalAxis()
     bool _drivesVert;                                       // Cached result of getDrivesVerticalAxis()
     HelioSensorAttachment _powerProd;                       // Power production sensor attachment
-    HelioDriverAttachment _axisDriver[2];                   // Axis driver attachments (assigned by scheduler)
+    HelioDriverAttachment _axisDriver[2];                   // Axis driver attachments (assigned by scheduler, unless user assigned)
+    bool _userAxisDriver[2];                                // Axis driver user assigned flags (persisted)
     HelioDriverAttachment _coverDriver;                     // Panel cover driver (assigned by scheduler)
     Signal<Helio_PanelState, HELIO_PANEL_SIGNAL_SLOTS> _stateSignal; // Panel state signal
 
@@ -119,6 +123,7 @@ public:
     virtual ~HelioBalancingPanel();
 
     virtual void update() override;
+    virtual millis_t getWakeDelay() override;
 
     virtual bool isAligned(bool poll = false) override;
 
@@ -155,13 +160,27 @@ public:
     virtual ~HelioTrackingPanel();
 
     virtual void update() override;
+    virtual millis_t getWakeDelay() override;
     virtual SharedPtr<HelioObjInterface> getSharedPtrFor(const HelioObjInterface *obj) const override;
 
     virtual bool canActivate(HelioActuator *actuator) override;
     virtual bool isDaylight(bool poll = false) override;
     virtual bool isAligned(bool poll = false) override;
 
-    inline void setLocationOffset(const double *locationOffset) { _locationOffset[0] = locationOffset[0]; _locationOffset[1] = locationOffset[1]; }
+    inline void setLocationOffset(const double *locationOffset) { _locationOffset[0] = locationOffset[0]; _locationOffset[1] = locationOffset[1]; _sunStepTime = 0; }
+
+    // Sets degrees that planned sun-step moves lead ahead of sun, or 0 to disable planning (continuous tracking)
+    inline void setSunStepLead(float sunStepLead) { _sunStepLead = sunStepLead; _sunStepTime = 0; }
+    inline float getSunStepLead() const { return _sunStepLead; }
+    inline bool isPlanningSunSteps() const { return _sunStepLead > FLT_EPSILON; }
+    // Time facing position is next planned to move (unix/UTC), else 0/unplanned
+    inline time_t getNextSunStepTime() const { return _sunStepTime; }
+    inline uint16_t getPlannedMoveCount() const { return _plannedMoves; }
+    inline float getPlannedTravel(hposi_t axisIndex) const { return _plannedTravel[axisIndex]; }
+    // Estimates energy used by axis actuators for planned moves since last reset, in Wh, from actuators' continuous
+    // power usage, drivers' travel rates, and a fixed per-move start overhead (HELIO_PANEL_SUNSTEP_STARTSECS).
+    float getPlannedMoveEnergy();
+    inline void resetPlannedMoves() { _plannedMoves = 0; _plannedTravel[0] = _plannedTravel[1] = 0; }
 
     template<typename T> inline void setAxisAngleSensor(T angleSensor, hposi_t axisIndex) { _axisAngle[axisIndex].setObject(angleSensor); }
     inline SharedPtr<HelioSensor> getAxisAngleSensor(hposi_t axisIndex, bool poll = false) { _axisAngle[axisIndex].updateIfNeeded(poll); return _axisAngle[axisIndex].getObject(poll); }
@@ -188,12 +207,12 @@ public:
     virtual HelioSensorAttachment &getWindSpeedSensorAttachment() override;
 
     inline DateTime getLastAlignmentChangeTime() const { return localTime(_lastAlignedTime); }
-    inline void notifyAlignmentChanged(const float *actualFacingPosition) { _axisOffset[0] = actualFacingPosition[0] - _facingPosition[0]; _axisOffset[1] = actualFacingPosition[1] - _facingPosition[1]; _lastAlignedTime = unixTime(localDayStart()); }
+    inline void notifyAlignmentChanged(const float *actualFacingPosition) { _axisOffset[0] = actualFacingPosition[0] - _facingPosition[0]; _axisOffset[1] = actualFacingPosition[1] - _facingPosition[1]; _lastAlignedTime = unixTime(localDayStart()); _sunStepTime = 0; }
 
     inline DateTime getLastPanelCleaningTime() const { return localTime(_lastCleanedTime); }
     inline void notifyPanelCleaned() { _lastCleanedTime = unixTime(localDayStart()); }
 
-    inline void notifyDayChanged() { recalcSunPosition(); recalcFacingPosition(); }
+    inline void notifyDayChanged() { _sunStepTime = 0; recalcSunPosition(); recalcFacingPosition(); }
 
 protected:
     time_t _lastAlignedTime;                                // Last panel alignment/maintenance date (UTC)
@@ -201,6 +220,10 @@ protected:
     double _locationOffset[2];                              // Panel location offset (lat in deg,long in fp mins)
     double _sunPosition[2];                                 // Calculated sun position (azi,ele or RA,dec)
     float _facingPosition[2];                               // Resolved facing position (azi,ele or RA,dec)
+    float _sunStepLead;                                     // Planned sun-step lead ahead of sun, in degrees, else 0/disabled
+    time_t _sunStepTime;                                    // Next planned sun-step move time (unix/UTC), else 0/unplanned
+    uint16_t _plannedMoves;                                 // Planned sun-step move count (since last reset)
+    float _plannedTravel[2];                                // Planned sun-step axis travel, in degrees (since last reset)
     HelioSensorAttachment _powerUsage;                      // Power usage sensor attachment
     HelioSensorAttachment _axisAngle[2];                    // Axis angle sensor attachments
     HelioSensorAttachment _temperature;                     // Temperature sensor attachment
@@ -213,6 +236,9 @@ protected:
     virtual void handleState(Helio_PanelState panelState) override;
 
     void recalcSunPosition();
+    bool calcSunPositionAt(time_t time, double *sunPositionOut);
+    void planSunStep(time_t time);
+    virtual void calcFacingTarget(const double *sunPosition, float *facingPositionOut) const;
     virtual void recalcFacingPosition();
 };
 
@@ -237,7 +263,7 @@ protected:
 
     virtual void saveToData(HelioData *dataOut) override;
 
-    virtual void recalcFacingPosition() override;
+    virtual void calcFacingTarget(const double *sunPosition, float *facingPositionOut) const override;
 };
 
 
@@ -248,8 +274,10 @@ struct HelioPanelData : public HelioObjectData {
     float homePosition[2];                                  // Home/return position (azi,ele or RA,dec)
     float axisOffset[2];                                    // Axis position calibration offset (azi,ele or RA,dec)
     char powerProdSensor[HELIO_NAME_MAXSIZE];               // Power production sensor
+    HelioDriverSubData axisDriver[2];                       // Axis drivers (horz,vert), if user assigned or PID
 
     HelioPanelData();
+    inline bool hasAxisDriverData() const { return axisDriver[0].isSet() || axisDriver[1].isSet(); }
     virtual void toJSONObject(JsonObject &objectOut) const override;
     virtual void fromJSONObject(JsonObjectConst &objectIn) override;
 };
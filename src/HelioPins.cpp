@@ -24,6 +24,50 @@ HelioPin *newPinObjectFromSubData(const HelioPinData *dataIn)
     return nullptr;
 }
 
+template<class T>
+static uint8_t sortPinsForBatchAccess_impl(T *pins[], uint8_t pinCount)
+{
+    for (uint8_t pinIndex = 1; pinIndex < pinCount; ++pinIndex) { // insertion sort, batches are small
+        T *pin = pins[pinIndex];
+        int16_t orderKey = batchOrderKeyForPin(*pin);
+        uint8_t place = pinIndex;
+        for (; place > 0 && batchOrderKeyForPin(*pins[place - 1]) > orderKey; --place) { pins[place] = pins[place - 1]; }
+        pins[place] = pin;
+    }
+
+    uint8_t switches = 0;
+    for (uint8_t pinIndex = 0; pinIndex < pinCount; ++pinIndex) {
+        if (pins[pinIndex]->isMuxed() && (!pinIndex || pins[pinIndex - 1]->pin != pins[pinIndex]->pin ||
+                                                       pins[pinIndex - 1]->channel != pins[pinIndex]->channel)) {
+            switches++;
+        }
+    }
+    return switches;
+}
+
+uint8_t sortPinsForBatchAccess(HelioPin *pins[], uint8_t pinCount)
+{
+    return sortPinsForBatchAccess_impl<HelioPin>(pins, pinCount);
+}
+
+uint8_t sortPinsForBatchAccess(HelioAnalogPin *pins[], uint8_t pinCount)
+{
+    return sortPinsForBatchAccess_impl<HelioAnalogPin>(pins, pinCount);
+}
+
+uint8_t analogReadBatch_raw(HelioAnalogPin *pins[], int rawReadsOut[], uint8_t pinCount)
+{
+    HELIO_SOFT_ASSERT(pins && rawReadsOut, SFP(HStr_Err_InvalidParameter));
+    if (!pins || !rawReadsOut) { return 0; }
+    uint8_t switches = sortPinsForBatchAccess(pins, pinCount);
+
+    for (uint8_t pinIndex = 0; pinIndex < pinCount; ++pinIndex) {
+        rawReadsOut[pinIndex] = pins[pinIndex]->analogRead_raw(); // channel select is skipped when unchanged
+    }
+    return switches;
+}
+
+
 HelioPin::HelioPin()
     : type(Unknown), pin(hpin_none), mode(Helio_PinMode_Undefined), channel(hpinchnl_none)
 { ; }
@@ -147,7 +191,19 @@ bool HelioPin::enablePin(int step)
             } else if (isExpanded() || isVirtual()) {
                 #ifdef HELIO_USE_MULTITASKING
                     auto expander = getController() ? getController()->getPinExpander(isValidChannel(channel) ? expanderPosForPinChannel(channel) : expanderPosForPinNumber(pin)) : nullptr;
-                    return expander && expander->trySyncChannel();
+                    #if HELIO_EXPANDERS_SHADOW_IO
+                        if (expander) {
+                            switch (step) {
+                                case 0: return expander->trySyncForRead();
+                                case 1: return true;
+                                case 2: return expander->tryMarkWritten();
+                                default: return false;
+                            }
+                        }
+                        return false;
+                    #else
+                        return expander && expander->trySyncChannel();
+                    #endif
                 #else
                     HELIO_HARD_ASSERT(false, SFP(HStr_Err_NotConfiguredProperly));
                 #endif
@@ -540,22 +596,22 @@ void HelioPinMuxer::selectChannel(uint8_t channelNumber)
             if (getController()) { getController()->deactivatePinMuxers(); }
         #endif
 
-        if (isValidPin(_channelPins[0])) {
-            ::digitalWrite(_channelPins[0], (channelNumber >> 0) & 1 ? HIGH : LOW);
-
-            if (isValidPin(_channelPins[1])) {
-                ::digitalWrite(_channelPins[1], (channelNumber >> 1) & 1 ? HIGH : LOW);
-
-                if (isValidPin(_channelPins[2])) {
-                    ::digitalWrite(_channelPins[2], (channelNumber >> 2) & 1 ? HIGH : LOW);
-
-                    if (isValidPin(_channelPins[3])) {
-                        ::digitalWrite(_channelPins[3], (channelNumber >> 3) & 1 ? HIGH : LOW);
-                    }
-                }
+        #if !HELIO_MUXERS_SHARED_ADDR_BUS
+            // only address lines that differ from current selection are written, all of them if unselected
+            uint8_t toggledBits = _channelSelect < 16 ? _channelSelect ^ channelNumber : 0x0F;
+        #else
+            uint8_t toggledBits = 0x0F; // other muxers may have since moved shared address lines
+        #endif
+        for (uint8_t bitIndex = 0; bitIndex < 4 && isValidPin(_channelPins[bitIndex]); ++bitIndex) {
+            if ((toggledBits >> bitIndex) & 1) {
+                ::digitalWrite(_channelPins[bitIndex], (channelNumber >> bitIndex) & 1 ? HIGH : LOW);
             }
         }
         _channelSelect = channelNumber;
+
+        #if HELIO_MUXERS_SETTLE_MICROS > 0
+            delayMicroseconds(HELIO_MUXERS_SETTLE_MICROS);
+        #endif
     }
 }
 
@@ -572,12 +628,18 @@ void HelioPinMuxer::setIsActive(bool isActive)
 
 #ifdef HELIO_USE_MULTITASKING
 
+#if HELIO_EXPANDERS_SHADOW_IO
+static bool _flushQueued = false;                           // Deferred expander flush task queued flag
+#endif
+
 HelioPinExpander::HelioPinExpander()
-    : _expander(0), _channelBits(0), _ioRef(nullptr), _interrupt(), _usingISR(false)
+    : _expander(0), _channelBits(0), _ioRef(nullptr), _interrupt(), _usingISR(false),
+      _writePending(false), _readStale(true), _syncCount(0)
 { ; }
 
 HelioPinExpander::HelioPinExpander(hposi_t expanderPos, uint8_t channelBits, IoAbstractionRef ioRef, HelioDigitalPin interruptPin)
-    : _expander(expanderPos), _channelBits(channelBits), _ioRef(ioRef), _interrupt(interruptPin), _usingISR(false)
+    : _expander(expanderPos), _channelBits(channelBits), _ioRef(ioRef), _interrupt(interruptPin), _usingISR(false),
+      _writePending(false), _readStale(true), _syncCount(0)
 { ; }
 
 bool HelioPinExpander::tryRegisterISR(bool anyChange)
@@ -593,7 +655,52 @@ bool HelioPinExpander::tryRegisterISR(bool anyChange)
 
 bool HelioPinExpander::trySyncChannel()
 {
-    return _ioRef->sync();
+    if (_ioRef) {
+        _syncCount++;
+        if (_ioRef->sync()) {
+            _writePending = _readStale = false;
+            return true;
+        } // else flags kept, so that writes are re-flushed and reads re-synced upon retry
+    }
+    return false;
+}
+
+bool HelioPinExpander::trySyncForRead()
+{
+    #if HELIO_EXPANDERS_SHADOW_IO
+        return !_readStale || trySyncChannel();
+    #else
+        return trySyncChannel();
+    #endif
+}
+
+bool HelioPinExpander::tryMarkWritten()
+{
+    #if HELIO_EXPANDERS_SHADOW_IO
+        if (!_writePending) {
+            _writePending = true;
+            // writes made outside of a control tick (e.g. from other tasks) get flushed after the current task
+            if (!_flushQueued) {
+                _flushQueued = true;
+                taskManager.scheduleOnce(0, []{
+                    _flushQueued = false;
+                    if (getController()) { getController()->flushPinExpanders(); }
+                });
+            }
+        }
+        return true;
+    #else
+        _writePending = true; // kept on failed sync, for retry at end of tick
+        return trySyncChannel();
+    #endif
+}
+
+void HelioPinExpander::updateChannels()
+{
+    tryFlushWrites();
+    if (!_usingISR) {
+        _readStale = true;
+    }
 }
 
 #endif // /ifdef HELIO_USE_MULTITASKING
@@ -37,6 +37,8 @@ inline uint8_t muxerChannelForPinChannel(int8_t pinChannel) { return isValidChan
 inline int8_t pinChannelForMuxerChannel(uint8_t muxChannel) { return muxChannel != (uint8_t)-1 && muxChannel != (uint8_t)hpinchnl_none ? -(int8_t)(1 + constrain(muxChannel,0,125)) : hpinchnl_none; }
 // Returns expanded pin channel # [+0,16*Max) to use for a given expander channel # [0,16*Max), else -127/none
 inline int8_t pinChannelForExpanderChannel(uint8_t expChannel) { return expChannel != (uint8_t)-1 && expChannel != (uint8_t)hpinchnl_none ? (int8_t)constrain(expChannel,0,127) : hpinchnl_none; }
+// Returns position of muxer channel # [0,16) along the 4-bit Gray code sequence (0,1,3,2,6,7,5,4,...), in which each next channel differs by a single address bit
+inline uint8_t grayRankForMuxerChannel(uint8_t muxChannel) { muxChannel ^= muxChannel >> 1; muxChannel ^= muxChannel >> 2; return muxChannel & 0x0F; }
 
 
 // Pin Base
@@ -66,7 +68,7 @@ struct HelioPin {
 
     // Attempts to both select the pin muxer (set address/ready pin state) for the pin on
     // its channel number and activate it (toggle chip enable). For pin expanders, attempts
-    // pin expander device I/O sync.
+    // pin expander device I/O sync (if port image is stale, see HELIO_EXPANDERS_SHADOW_IO).
     // Typically called pre-read. Returns success boolean. May return early.
     inline bool selectAndActivatePin() { return enablePin(0); }
     // Attempts to select the pin muxer (set address/ready pin state) for the pin on
@@ -74,7 +76,7 @@ struct HelioPin {
     // Typically called pre-write. Returns success boolean. May return early.
     inline bool selectPin() { return enablePin(1); }
     // Attempts to activate the pin muxer (toggle chip enable). For pin expanders, attempts
-    // pin expander device I/O sync.
+    // pin expander device I/O sync (or defers it to end of tick, see HELIO_EXPANDERS_SHADOW_IO).
     // Typically called post-write. Returns success boolean. May return early.
     inline bool activatePin() { return enablePin(2); }
 
@@ -178,6 +180,16 @@ struct HelioAnalogPin : public HelioPin, public HelioAnalogInputPinInterface, pu
     virtual void analogWrite_raw(int amount) override;
 };
 
+// Returns sort key that orders pins for batch access: by signal pin # (grouping each muxer's channels together), and then
+// by Gray code rank of muxer channel (so that successive channel switches toggle as few address select lines as possible).
+inline int16_t batchOrderKeyForPin(const HelioPin &pin) { return (int16_t)((pin.pin << 5) | (pin.isMuxed() ? 1 + grayRankForMuxerChannel(muxerChannelForPinChannel(pin.channel)) : 0)); }
+// Sorts (in-place, stable) passed pins into batch access order. Returns # of muxer channel switches that order takes, assuming no channels were pre-selected.
+extern uint8_t sortPinsForBatchAccess(HelioPin *pins[], uint8_t pinCount);
+extern uint8_t sortPinsForBatchAccess(HelioAnalogPin *pins[], uint8_t pinCount);
+// Reads passed analog pins in one sweep, with each muxer channel selected (and settled) only once. Pins array is first sorted
+// in-place into batch access order, with raw reads written into rawReadsOut at the same (sorted) index. Returns # of channel switches.
+extern uint8_t analogReadBatch_raw(HelioAnalogPin *pins[], int rawReadsOut[], uint8_t pinCount);
+
 // Combined Pin Serialization Sub Data
 struct HelioPinData : public HelioSubData
 {
@@ -219,7 +231,7 @@ struct HelioPinData : public HelioSubData
 // Note: Muxers are referenced in controller by signal pin #, with a pin's channel # defined
 //       as a negative integer starting from -1 to indicate muxer channel # (e.g. -1 =
 //       muxer[signalPin] channel 0, -16 = muxer[signalPin] channel 15, etc.).
-class HelioPinMuxer {
+class HelioPinMuxer : public HelioRefCounted {
 public:
     HelioPinMuxer();
     HelioPinMuxer(HelioPin signalPin,
@@ -273,7 +285,7 @@ public: // consider protected
 // Note: Virtual pins should always have a pin # >= hpin_virtual (100), and are separated
 //       into groups of 16 per indexed expander (e.g. pins # 100-115 = expander[0], pins #
 //       116-131 = expander[1], etc.).
-class HelioPinExpander {
+class HelioPinExpander : public HelioRefCounted {
 public:
     HelioPinExpander();
     HelioPinExpander(hposi_t expanderPos, uint8_t channelBits, IoAbstractionRef ioRef,
@@ -288,13 +300,34 @@ public:
     // Once registered, the ISR cannot be unregistered/changed. It is advised to use a lowered numbered pin # if able ([1-15,18]).
     bool tryRegisterISR(bool anyChange = false);
 
-    // Synchronizes I/O with expander, returning success flag.
+    // Synchronizes I/O with expander (whole-port write-out & read-in), returning success flag.
+    // Pending writes and stale reads stay flagged upon failure, to be retried on next sync.
     bool trySyncChannel();
 
+    // Ensures the port image is fresh for reading, syncing only if it has gone stale since
+    // the last sync (or always if not using shadow I/O). Called pre-read. Returns success flag.
+    bool trySyncForRead();
+    // Marks the port image as written, deferring flush until end of control tick or current
+    // task (or syncing immediately if not using shadow I/O, with failed syncs re-flushed at end
+    // of control tick). Called post-write. Returns success flag.
+    bool tryMarkWritten();
+    // Flushes any pending writes to expander, returning success flag.
+    inline bool tryFlushWrites() { return !_writePending || trySyncChannel(); }
+    // Flushes any pending writes and marks the port image as stale for the next tick's reads.
+    // Without an ISR, reads are refreshed at most once per control tick, otherwise only
+    // upon interrupt (which syncs directly). Called at the end of each control tick.
+    void updateChannels();
+
     inline hposi_t getExpanderPos() const { return _expander; }
     inline uint8_t getChannelBits() const { return _channelBits; }
     inline IoAbstractionRef getIoAbstraction() { return _ioRef; }
     inline const HelioDigitalPin &getInterruptPin() const { return _interrupt; }
+    inline bool isUsingISR() const { return _usingISR; }
+    inline bool hasPendingWrites() const { return _writePending; }
+
+    // Total number of I/O syncs (bus transactions) performed on the expander
+    inline uint32_t getTransactionCount() const { return _syncCount; }
+    inline void resetTransactionCount() { _syncCount = 0; }
 
 protected:
     const hposi_t _expander;                                // Expander #/index (for virtual pin #)
@@ -302,6 +335,9 @@ protected:
     IoAbstractionRef _ioRef;                                // IoAbstraction instance
     HelioDigitalPin _interrupt;                             // Expander interrupt pin (optional)
     bool _usingISR;                                         // Using ISR flag
+    bool _writePending;                                     // Port image has unflushed writes flag
+    bool _readStale;                                        // Port image needs refresh before read flag
+    uint32_t _syncCount;                                    // I/O sync (transaction) counter
 };
 
 #endif // /ifdef HELIO_USE_MULTITASKING
@@ -6,7 +6,7 @@
 #include "Helioduino.h"
 
 HelioPublisher::HelioPublisher()
-    : _dataFilename(), _needsTabulation(false), _pollingFrame(0), _dataColumns(nullptr), _columnSize(0)
+    : _dataFilename(), _needsTabulation(false), _pollingFrame(0), _dataColumns(nullptr), _columnSize(0), _binaryWriter(nullptr), _publishBuffer(nullptr), _dataFileSize((uint32_t)-1), _rollups(), _rollupBuffers(), _rollupBufferStarts(), _rollupBufferHeaded()
 #if HELIO_SYS_LEAVE_FILES_OPEN
       , _dataFileSD(nullptr)
 #ifdef HELIO_USE_WIFI_STORAGE
@@ -14,13 +14,19 @@ HelioPublisher::HelioPublisher()
 #endif
 #endif
 #ifdef HELIO_USE_MQTT
-    , _mqttClient(nullptr)
+    , _mqttClient(nullptr), _mqttPayload(nullptr), _mqttTopic(), _mqttNeedsColumns(true)
 #endif
 { ; }
 
 HelioPublisher::~HelioPublisher()
 {
     if (_dataColumns) { delete [] _dataColumns; _dataColumns = nullptr; }
+    if (_binaryWriter) { delete _binaryWriter; _binaryWriter = nullptr; }
+    if (_publishBuffer) { delete _publishBuffer; _publishBuffer = nullptr; }
+    for (int periodIndex = 0; periodIndex < Helio_RollupPeriod_Count; ++periodIndex) {
+        if (_rollups[periodIndex]) { delete _rollups[periodIndex]; _rollups[periodIndex] = nullptr; }
+        if (_rollupBuffers[periodIndex]) { delete _rollupBuffers[periodIndex]; _rollupBuffers[periodIndex] = nullptr; }
+    }
     #if HELIO_SYS_LEAVE_FILES_OPEN
         if (_dataFileSD) { _dataFileSD->flush(); _dataFileSD->close(); delete _dataFileSD; _dataFileSD = nullptr; }
         #ifdef HELIO_USE_WIFI_STORAGE
@@ -32,6 +38,7 @@ HelioPublisher::~HelioPublisher()
             if (_mqttClient->connected()) { _mqttClient->disconnect(); }
             delete _mqttClient; _mqttClient = nullptr;
         }
+        if (_mqttPayload) { delete _mqttPayload; _mqttPayload = nullptr; }
     #endif
 }
 
@@ -41,6 +48,11 @@ void HelioPublisher::update()
         if (_needsTabulation) { performTabulation(); }
 
         publishIfNeeded();
+
+        flushDataFile();
+        for (int periodIndex = 0; periodIndex < Helio_RollupPeriod_Count; ++periodIndex) {
+            flushRollupFile((Helio_RollupPeriod)periodIndex);
+        }
     }
 }
 
@@ -52,7 +64,7 @@ bool HelioPublisher::beginPublishingToSDCard(String dataFilePrefix)
         auto sd = Helioduino::_activeInstance->getSDCard();
 
         if (sd) {
-            String dataFilename = getYYMMDDFilename(dataFilePrefix, SFP(HStr_csv));
+            String dataFilename = getYYMMDDFilename(dataFilePrefix, getDataFileExtension());
             createDirectoryFor(sd, dataFilename);
             #if HELIO_SYS_LEAVE_FILES_OPEN
                 auto &dataFile = _dataFileSD ? *_dataFileSD : *(_dataFileSD = new File(sd->open(dataFilename.c_str(), FILE_WRITE)));
@@ -69,6 +81,7 @@ bool HelioPublisher::beginPublishingToSDCard(String dataFilePrefix)
                 strncpy(publisherData()->dataFilePrefix, dataFilePrefix.c_str(), 16);
                 publisherData()->pubToSDCard = true;
                 _dataFilename = dataFilename;
+                _dataFileSize = (uint32_t)-1;
                 
                 setNeedsTabulation();
                 Helioduino::_activeInstance->_systemData->bumpRevisionIfNeeded();
@@ -92,7 +105,7 @@ bool HelioPublisher::beginPublishingToWiFiStorage(String dataFilePrefix)
     HELIO_SOFT_ASSERT(hasPublisherData(), SFP(HStr_Err_NotYetInitialized));
 
     if (hasPublisherData() && !publisherData()->pubToWiFiStorage) {
-        String dataFilename = getYYMMDDFilename(dataFilePrefix, SFP(HStr_csv));
+        String dataFilename = getYYMMDDFilename(dataFilePrefix, getDataFileExtension());
         #if HELIO_SYS_LEAVE_FILES_OPEN
             auto &dataFile = _dataFileWS ? *_dataFileWS : *(_dataFileWS = new WiFiStorageFile(WiFiStorage.open(dataFilename.c_str())));
         #else
@@ -107,6 +120,7 @@ bool HelioPublisher::beginPublishingToWiFiStorage(String dataFilePrefix)
             strncpy(publisherData()->dataFilePrefix, dataFilePrefix.c_str(), 16);
             publisherData()->pubToWiFiStorage = true;
             _dataFilename = dataFilename;
+            _dataFileSize = (uint32_t)-1;
 
             setNeedsTabulation();
             Helioduino::_activeInstance->_systemData->bumpRevisionIfNeeded();
@@ -138,6 +152,12 @@ bool HelioPublisher::beginPublishingToMQTTClient(MQTTClient &client)
             _mqttClient->connect(Helioduino::_activeInstance->getSystemName().c_str(),
                                  unPw.c_str(), unPw.c_str());
         }
+        if (getMQTTPublishMode() != Helio_MQTTPublishMode_PerSensor && !_mqttPayload) {
+            _mqttPayload = new HelioMQTTPayloadWriter();
+            HELIO_SOFT_ASSERT(_mqttPayload, SFP(HStr_Err_AllocationFailure));
+            if (_mqttPayload) { _mqttPayload->setPublishMode(getMQTTPublishMode()); }
+        }
+        _mqttNeedsColumns = true;
 
         setNeedsTabulation();
 
@@ -147,8 +167,81 @@ bool HelioPublisher::beginPublishingToMQTTClient(MQTTClient &client)
     return false;
 }
 
+void HelioPublisher::setMQTTPublishMode(Helio_MQTTPublishMode publishMode, uint8_t coalesceFrames)
+{
+    HELIO_SOFT_ASSERT(hasPublisherData(), SFP(HStr_Err_NotYetInitialized));
+    HELIO_SOFT_ASSERT(publishMode >= Helio_MQTTPublishMode_PerSensor && publishMode < Helio_MQTTPublishMode_Count, SFP(HStr_Err_InvalidParameter));
+    coalesceFrames = publishMode != Helio_MQTTPublishMode_PerSensor ? constrain(coalesceFrames, 1, HELIO_PUBLISH_MQTT_MAXCOALESCE) : 1;
+
+    if (hasPublisherData() && publishMode >= Helio_MQTTPublishMode_PerSensor && publishMode < Helio_MQTTPublishMode_Count &&
+        (publisherData()->mqttMode != publishMode || publisherData()->mqttCoalesce != coalesceFrames)) {
+        sendMQTTPayload(); // frames already packed go out in prior mode
+
+        publisherData()->mqttMode = publishMode;
+        publisherData()->mqttCoalesce = coalesceFrames;
+
+        if (publishMode == Helio_MQTTPublishMode_PerSensor) {
+            if (_mqttPayload) { delete _mqttPayload; _mqttPayload = nullptr; }
+        } else if (_mqttClient) {
+            if (!_mqttPayload) {
+                _mqttPayload = new HelioMQTTPayloadWriter();
+                HELIO_SOFT_ASSERT(_mqttPayload, SFP(HStr_Err_AllocationFailure));
+            }
+            if (_mqttPayload) { _mqttPayload->setPublishMode(publishMode); }
+        }
+        _mqttNeedsColumns = true;
+
+        Helioduino::_activeInstance->_systemData->bumpRevisionIfNeeded();
+    }
+}
+
 #endif
 
+void HelioPublisher::setPublishingBinary(bool publishBinary)
+{
+    HELIO_SOFT_ASSERT(hasPublisherData(), SFP(HStr_Err_NotYetInitialized));
+
+    if (hasPublisherData() && publisherData()->pubBinary != publishBinary) {
+        flushDataFile(true);
+        publisherData()->pubBinary = publishBinary;
+
+        if (publisherData()->pubToSDCard || publisherData()->pubToWiFiStorage) {
+            _dataFilename = getYYMMDDFilename(charsToString(publisherData()->dataFilePrefix, 16), getDataFileExtension());
+            resetDataFile();
+        }
+
+        Helioduino::_activeInstance->_systemData->bumpRevisionIfNeeded();
+    }
+}
+
+void HelioPublisher::setRollupEnabled(Helio_RollupPeriod period, bool enabled)
+{
+    HELIO_SOFT_ASSERT(hasPublisherData(), SFP(HStr_Err_NotYetInitialized));
+    HELIO_SOFT_ASSERT(period >= Helio_RollupPeriod_Minute && period < Helio_RollupPeriod_Count, SFP(HStr_Err_InvalidParameter));
+
+    if (hasPublisherData() && period >= Helio_RollupPeriod_Minute && period < Helio_RollupPeriod_Count && isRollupEnabled(period) != enabled) {
+        if (enabled) {
+            publisherData()->rollupPeriods |= (1 << period);
+        } else {
+            publisherData()->rollupPeriods &= ~(1 << period);
+
+            if (_rollups[period]) {
+                emitRollup(_rollups[period]); // partial bucket
+                delete _rollups[period]; _rollups[period] = nullptr;
+            }
+            if (_rollupBuffers[period]) {
+                flushRollupFile(period, true);
+                delete _rollupBuffers[period]; _rollupBuffers[period] = nullptr;
+            }
+        }
+        #ifdef HELIO_USE_MQTT
+            _mqttNeedsColumns = true;
+        #endif
+
+        Helioduino::_activeInstance->_systemData->bumpRevisionIfNeeded();
+    }
+}
+
 void HelioPublisher::publishData(hposi_t columnIndex, HelioSingleMeasurement measurement)
 {
     HELIO_SOFT_ASSERT(hasPublisherData() && _dataColumns && _columnSize, SFP(HStr_Err_NotYetInitialized));
@@ -179,7 +272,20 @@ Signal<Pair<uint8_t, const HelioDataColumn *>, HELIO_PUBLISH_SIGNAL_SLOTS> &Heli
 void HelioPublisher::notifyDayChanged()
 {
     if (isPublishingEnabled()) {
-        _dataFilename = getYYMMDDFilename(charsToString(publisherData()->dataFilePrefix, 16), SFP(HStr_csv));
+        String dataFilename = getYYMMDDFilename(charsToString(publisherData()->dataFilePrefix, 16), getDataFileExtension());
+
+        flushDataFile(true);
+        for (int periodIndex = 0; periodIndex < Helio_RollupPeriod_Count; ++periodIndex) {
+            flushRollupFile((Helio_RollupPeriod)periodIndex, true);
+        }
+        if (isPublishingBinary() && _dataFilename.length() && _dataFilename != dataFilename) {
+            finalizeDataFile();
+            _dataFilename = dataFilename;
+            resetDataFile(); // new day's file needs its own header
+        } else if (_dataFilename != dataFilename) {
+            _dataFilename = dataFilename;
+            _dataFileSize = (uint32_t)-1;
+        }
         cleanupOldestData();
     }
 }
@@ -215,8 +321,12 @@ void HelioPublisher::publishIfNeeded()
 
         for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
             if (Helioduino::_activeInstance->isPollingFrameOld(_dataColumns[columnIndex].measurement.frame)) {
-                allCurrent = false;
-                break;
+                // sensors not due this frame (per their polling policy) have their existing value recycled
+                auto sensor = (HelioSensor *)(Helioduino::_activeInstance->_objects.find(_dataColumns[columnIndex].sensorKey).get());
+                if (!sensor || sensor->isPollingDue()) {
+                    allCurrent = false;
+                    break;
+                }
             }
         }
 
@@ -237,7 +347,26 @@ void HelioPublisher::publishIfNeeded()
 
 void HelioPublisher::publish(time_t timestamp)
 {
-    if (isPublishingToSDCard()) {
+    bool publishBinary = isPublishingBinary();
+    const uint8_t *binaryRow = nullptr;
+    uint16_t binaryLength = 0;
+
+    if (publishBinary && _binaryWriter && (publisherData()->pubToSDCard || publisherData()->pubToWiFiStorage)) {
+        binaryRow = _binaryWriter->encodeRow(timestamp, _dataColumns, _columnSize, &binaryLength);
+    }
+
+    if (_publishBuffer && (publisherData()->pubToSDCard || publisherData()->pubToWiFiStorage)) {
+        if (!queueDataRow(timestamp, binaryRow, binaryLength)) {
+            flushDataFile(true); // overflow: flush out synchronously to make room
+
+            if (!queueDataRow(timestamp, binaryRow, binaryLength)) {
+                _publishBuffer->recordDroppedRow();
+                if (binaryRow) { _binaryWriter->dropLastRow(binaryLength); }
+            }
+        }
+    }
+
+    if (!_publishBuffer && isPublishingToSDCard()) {
         auto sd = Helioduino::_activeInstance->getSDCard(HELIO_LOFS_BEGIN);
 
         if (sd) {
@@ -249,14 +378,18 @@ void HelioPublisher::publish(time_t timestamp)
             #endif
 
             if (dataFile) {
-                dataFile.print(timestamp);
+                if (publishBinary) {
+                    if (binaryRow) { dataFile.write(binaryRow, binaryLength); }
+                } else {
+                    dataFile.print(timestamp);
 
-                for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
-                    dataFile.print(',');
-                    dataFile.print(_dataColumns[columnIndex].measurement.value);
-                }
+                    for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+                        dataFile.print(',');
+                        dataFile.print(_dataColumns[columnIndex].measurement.value);
+                    }
 
-                dataFile.println();
+                    dataFile.println();
+                }
 
                 #if !HELIO_SYS_LEAVE_FILES_OPEN
                     dataFile.flush();
@@ -272,7 +405,7 @@ void HelioPublisher::publish(time_t timestamp)
 
 #ifdef HELIO_USE_WIFI_STORAGE
 
-    if (isPublishingToWiFiStorage()) {
+    if (!_publishBuffer && isPublishingToWiFiStorage()) {
         #if HELIO_SYS_LEAVE_FILES_OPEN
             auto &dataFile = _dataFileWS ? *_dataFileWS : *(_dataFileWS = new WiFiStorageFile(WiFiStorage.open(_dataFilename.c_str())));
         #else
@@ -281,14 +414,18 @@ void HelioPublisher::publish(time_t timestamp)
 
         if (dataFile) {
             auto dataFileStream = HelioWiFiStorageFileStream(dataFile, dataFile.size());
-            dataFileStream.print(timestamp);
+            if (publishBinary) {
+                if (binaryRow) { dataFileStream.write(binaryRow, binaryLength); }
+            } else {
+                dataFileStream.print(timestamp);
 
-            for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
-                dataFileStream.print(',');
-                dataFileStream.print(_dataColumns[columnIndex].measurement.value);
-            }
+                for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+                    dataFileStream.print(',');
+                    dataFileStream.print(_dataColumns[columnIndex].measurement.value);
+                }
 
-            dataFileStream.println();
+                dataFileStream.println();
+            }
             #if !HELIO_SYS_LEAVE_FILES_OPEN
                 dataFile.close();
             #endif
@@ -299,22 +436,15 @@ void HelioPublisher::publish(time_t timestamp)
 #ifdef HELIO_USE_MQTT
 
     if (isPublishingToMQTTClient()) {
-        String systemName = Helioduino::_activeInstance->getSystemName();
-        for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
-            auto sensor = (HelioSensor *)(Helioduino::_activeInstance->_objects[_dataColumns[columnIndex].sensorKey].get());
-            if (sensor) {
-                String topic; topic.reserve(systemName.length() + 1 + sensor->getKeyString().length() + 1);
-                topic.concat(systemName);
-                topic.concat('/');
-                topic.concat(sensor->getKeyString());
-                String payload = String(_dataColumns[columnIndex].measurement.value, 6); // skipping units/rounding/etc to allow MQTT broker full value data
-                _mqttClient->publish(topic.c_str(), payload.c_str());
-            }
-        }
+        publishMQTT(timestamp);
     }
 
 #endif
 
+    if (publisherData()->rollupPeriods) {
+        updateRollups(timestamp);
+    }
+
     #ifdef HELIO_USE_MULTITASKING
         scheduleSignalFireOnce<Pair<uint8_t, const HelioDataColumn *>>(_publishSignal, make_pair(_columnSize, (const HelioDataColumn *)_dataColumns));
     #else
@@ -322,75 +452,38 @@ void HelioPublisher::publish(time_t timestamp)
     #endif
 }
 
-void HelioPublisher::performTabulation()
+bool HelioPublisher::queueDataRow(time_t timestamp, const uint8_t *binaryRow, uint16_t binaryLength)
 {
-    HELIO_SOFT_ASSERT(hasPublisherData(), SFP(HStr_Err_NotYetInitialized));
-
-    bool sameOrder = _dataColumns && _columnSize ? true : false;
-    int columnSize = 0;
-
-    for (auto iter = Helioduino::_activeInstance->_objects.begin(); iter != Helioduino::_activeInstance->_objects.end(); ++iter) {
-        if (iter->second->isSensorType()) {
-            auto sensor = static_pointer_cast<HelioSensor>(iter->second);
-            auto rowCount = getMeasurementRowCount(sensor->getMeasurement());
-
-            for (int rowIndex = 0; sameOrder && rowIndex < rowCount; ++rowIndex) {
-                sameOrder = sameOrder && (columnSize + rowIndex + 1 <= _columnSize) &&
-                            (_dataColumns[columnSize + rowIndex].sensorKey == sensor->getKey());
-            }
-
-            columnSize += rowCount;
-        }
-    }
-    sameOrder = sameOrder && (columnSize == _columnSize);
-
-    if (!sameOrder) {
-        if (_dataColumns && _columnSize != columnSize) { delete [] _dataColumns; _dataColumns = nullptr; }
-        _columnSize = columnSize;
+    _publishBuffer->beginRow();
 
-        if (_columnSize) {
-            if (!_dataColumns) {
-                _dataColumns = new HelioDataColumn[_columnSize];
-                HELIO_SOFT_ASSERT(_dataColumns, SFP(HStr_Err_AllocationFailure));
-            }
-            if (_dataColumns) {
-                int columnIndex = 0;
+    if (isPublishingBinary()) {
+        if (binaryRow) { _publishBuffer->write(binaryRow, binaryLength); }
+    } else {
+        _publishBuffer->print(timestamp);
 
-                for (auto iter = Helioduino::_activeInstance->_objects.begin(); iter != Helioduino::_activeInstance->_objects.end(); ++iter) {
-                    if (iter->second->isSensorType()) {
-                        auto sensor = static_pointer_cast<HelioSensor>(iter->second);
-                        auto measurement = sensor->getMeasurement();
-                        auto rowCount = getMeasurementRowCount(measurement);
-
-                        for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
-                            HELIO_HARD_ASSERT(columnIndex < _columnSize, SFP(HStr_Err_OperationFailure));
-                            _dataColumns[columnIndex].measurement = getAsSingleMeasurement(measurement, rowIndex);
-                            _dataColumns[columnIndex].sensorKey = sensor->getKey();
-                            columnIndex++;
-                        }
-                    }
-                }
-            }
+        for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+            _publishBuffer->print(',');
+            _publishBuffer->print(_dataColumns[columnIndex].measurement.value);
         }
 
-        resetDataFile();
+        _publishBuffer->println();
     }
 
-    _needsTabulation = false;
+    return _publishBuffer->endRow();
 }
 
-void HelioPublisher::resetDataFile()
+void HelioPublisher::flushDataFile(bool force)
 {
+    if (!_publishBuffer || !_publishBuffer->getDepth()) { return; }
+    if (_dataFileSize != (uint32_t)-1 && !_publishBuffer->getFlushLength(_dataFileSize, force)) { return; } // nothing due, skip file access
+    uint32_t start = micros();
+    uint16_t length = 0;
+    bool flushed = false;
+
     if (isPublishingToSDCard()) {
         auto sd = Helioduino::_activeInstance->getSDCard(HELIO_LOFS_BEGIN);
 
         if (sd) {
-            #if HELIO_SYS_LEAVE_FILES_OPEN
-                if (_dataFileSD) { _dataFileSD->flush(); _dataFileSD->close(); delete _dataFileSD; _dataFileSD = nullptr; }
-            #endif
-            if (sd->exists(_dataFilename.c_str())) {
-                sd->remove(_dataFilename.c_str());
-            }
             #if HELIO_SYS_LEAVE_FILES_OPEN
                 auto &dataFile = _dataFileSD ? *_dataFileSD : *(_dataFileSD = new File(sd->open(_dataFilename.c_str(), FILE_WRITE)));
             #else
@@ -399,34 +492,15 @@ void HelioPublisher::resetDataFile()
             #endif
 
             if (dataFile) {
-                HelioSensor *lastSensor = nullptr;
-                uint8_t measurementRow = 0;
-
-                dataFile.print(SFP(HStr_Key_Timestamp));
-
-                for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
-                    dataFile.print(',');
-
-                    auto sensor = (HelioSensor *)(Helioduino::_activeInstance->_objects[_dataColumns[columnIndex].sensorKey].get());
-                    if (sensor && sensor == lastSensor) { ++measurementRow; }
-                    else { measurementRow = 0; lastSensor = sensor; }
-
-                    if (sensor) {
-                        dataFile.print(sensor->getKeyString());
-                        dataFile.print('_');
-                        dataFile.print(unitsCategoryToString(defaultCategoryForSensor(sensor->getSensorType(), measurementRow)));
-                        dataFile.print('_');
-                        dataFile.print(unitsTypeToSymbol(getMeasurementUnits(sensor->getMeasurement(), measurementRow)));
-                    } else {
-                        HELIO_SOFT_ASSERT(false, SFP(HStr_Err_OperationFailure));
-                        dataFile.print(SFP(HStr_Undefined));
-                    }
+                _dataFileSize = dataFile.size();
+                length = _publishBuffer->getFlushLength(_dataFileSize, force);
+                if (length) {
+                    _publishBuffer->writeOut(dataFile, length);
+                    dataFile.flush();
+                    flushed = true;
                 }
 
-                dataFile.println();
-
                 #if !HELIO_SYS_LEAVE_FILES_OPEN
-                    dataFile.flush();
                     dataFile.close();
                 #endif
             }
@@ -439,13 +513,7 @@ void HelioPublisher::resetDataFile()
 
 #ifdef HELIO_USE_WIFI_STORAGE
 
-    if (isPublishingToWiFiStorage()) {
-        #if HELIO_SYS_LEAVE_FILES_OPEN
-            if (_dataFileWS) { _dataFileWS->close(); delete _dataFileWS; _dataFileWS = nullptr; }
-        #endif
-        if (WiFiStorage.exists(_dataFilename.c_str())) {
-            WiFiStorage.remove(_dataFilename.c_str());
-        }
+    if (isPublishingToWiFiStorage() && (flushed || !isPublishingToSDCard())) {
         #if HELIO_SYS_LEAVE_FILES_OPEN
             auto &dataFile = _dataFileWS ? *_dataFileWS : *(_dataFileWS = new WiFiStorageFile(WiFiStorage.open(_dataFilename.c_str())));
         #else
@@ -453,46 +521,1430 @@ void HelioPublisher::resetDataFile()
         #endif
 
         if (dataFile) {
-            auto dataFileStream = HelioWiFiStorageFileStream(dataFile);
-            HelioSensor *lastSensor = nullptr;
-            uint8_t measurementRow = 0;
+            if (!flushed) { _dataFileSize = dataFile.size(); length = _publishBuffer->getFlushLength(_dataFileSize, force); }
+            if (length) {
+                auto dataFileStream = HelioWiFiStorageFileStream(dataFile, dataFile.size());
+                _publishBuffer->writeOut(dataFileStream, length);
+                dataFileStream.flush();
+                flushed = true;
+            }
 
-            dataFileStream.print(SFP(HStr_Key_Timestamp));
+            #if !HELIO_SYS_LEAVE_FILES_OPEN
+                dataFile.close();
+            #endif
+        }
+    }
 
-            for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
-                dataFileStream.print(',');
+#endif
 
-                auto sensor = (HelioSensor *)(Helioduino::_activeInstance->_objects[_dataColumns[columnIndex].sensorKey].get());
-                if (sensor && sensor == lastSensor) { ++measurementRow; }
-                else { measurementRow = 0; lastSensor = sensor; }
+    if (flushed) {
+        _publishBuffer->consume(length, micros() - start);
+        _dataFileSize += length;
+    }
+}
 
-                if (sensor) {
-                    dataFileStream.print(sensor->getKeyString());
-                    dataFileStream.print('_');
-                    dataFileStream.print(unitsCategoryToString(defaultCategoryForSensor(sensor->getSensorType(), measurementRow)));
-                    dataFileStream.print('_');
-                    dataFileStream.print(unitsTypeToSymbol(getMeasurementUnits(sensor->getMeasurement(), measurementRow)));
-                } else {
-                    HELIO_SOFT_ASSERT(false, SFP(HStr_Err_OperationFailure));
-                    dataFileStream.print(SFP(HStr_Undefined));
+#ifdef HELIO_USE_MQTT
+
+void HelioPublisher::publishMQTT(time_t timestamp)
+{
+    if (_mqttNeedsColumns) { sendMQTTColumns(); }
+
+    if (_mqttPayload) {
+        if (!_mqttPayload->addFrame(timestamp, _dataColumns, _columnSize)) {
+            sendMQTTPayload();
+
+            if (!_mqttPayload->addFrame(timestamp, _dataColumns, _columnSize)) {
+                HELIO_SOFT_ASSERT(false, SFP(HStr_Err_OperationFailure)); // single frame exceeds payload buffer
+                return;
+            }
+        }
+        if (_mqttPayload->getFrameCount() >= getMQTTCoalesceFrames()) {
+            sendMQTTPayload();
+        }
+    } else {
+        for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+            auto sensor = (HelioSensor *)(Helioduino::_activeInstance->_objects.find(_dataColumns[columnIndex].sensorKey).get());
+            if (sensor) {
+                String payload = String(_dataColumns[columnIndex].measurement.value, 6); // skipping units/rounding/etc to allow MQTT broker full value data
+                _mqttClient->publish(getMQTTTopic(sensor->getKeyString()), payload.c_str());
+            }
+        }
+    }
+}
+
+void HelioPublisher::sendMQTTPayload()
+{
+    if (_mqttClient && _mqttPayload && _mqttPayload->getFrameCount()) {
+        uint16_t length = 0;
+        auto payload = _mqttPayload->finish(&length);
+
+        if (payload) {
+            _mqttClient->publish(getMQTTTopic(SFP(HStr_Key_Data)), (const char *)payload, (int)length);
+        }
+    }
+    if (_mqttPayload) { _mqttPayload->clear(); }
+}
+
+void HelioPublisher::sendMQTTColumns()
+{
+    _mqttTopic = Helioduino::_activeInstance->getSystemName(); // picks up any system name change
+    _mqttTopic.reserve(_mqttTopic.length() + 1 + HELIO_NAME_MAXSIZE);
+    _mqttTopic.concat('/');
+
+    if (_mqttPayload || publisherData()->rollupPeriods) { // column map, retained so late subscribers can decode packed frames/rollups
+        String columns; columns.reserve(2 + _columnSize * (HELIO_NAME_MAXSIZE + 3));
+
+        columns.concat('[');
+        for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+            if (columnIndex) { columns.concat(','); }
+            columns.concat('"');
+            columns.concat(getColumnTitle(columnIndex));
+            columns.concat('"');
+        }
+        columns.concat(']');
+
+        _mqttClient->publish(getMQTTTopic(SFP(HStr_Key_Columns)), columns.c_str(), (int)columns.length(), true, 0);
+    }
+
+    _mqttNeedsColumns = false;
+}
+
+const char *HelioPublisher::getMQTTTopic(const String &suffix)
+{
+    _mqttTopic.remove(_mqttTopic.lastIndexOf('/') + 1);
+    _mqttTopic.concat(suffix);
+    return _mqttTopic.c_str();
+}
+
+#endif
+
+void HelioPublisher::updateRollups(time_t timestamp)
+{
+    for (int periodIndex = 0; periodIndex < Helio_RollupPeriod_Count; ++periodIndex) {
+        if (isRollupEnabled((Helio_RollupPeriod)periodIndex)) {
+            if (!_rollups[periodIndex]) {
+                _rollups[periodIndex] = new HelioDataRollup((Helio_RollupPeriod)periodIndex);
+                HELIO_SOFT_ASSERT(_rollups[periodIndex], SFP(HStr_Err_AllocationFailure));
+            }
+            if (_rollups[periodIndex]) {
+                if (_rollups[periodIndex]->isBucketClosed(timestamp)) {
+                    emitRollup(_rollups[periodIndex]);
                 }
+                _rollups[periodIndex]->addRow(timestamp, _dataColumns, _columnSize);
             }
+        }
+    }
+}
 
-            dataFileStream.println();
+// Returns rollup file extension (and MQTT topic suffix) for period
+static inline Helio_String rollupExtension(Helio_RollupPeriod period)
+{
+    return period == Helio_RollupPeriod_Day ? HStr_rld : period == Helio_RollupPeriod_Hour ? HStr_rlh : HStr_rlm;
+}
+
+void HelioPublisher::emitRollup(HelioDataRollup *rollup)
+{
+    if (!rollup->getRowCount()) { return; }
+    Helio_RollupPeriod period = rollup->getPeriod();
+    String row = rollup->getRowString();
+
+    #if HELIO_PUBLISH_ROLLUP_BUFSIZE
+        if (!_rollupBuffers[period] && (publisherData()->pubToSDCard || publisherData()->pubToWiFiStorage)) {
+            _rollupBuffers[period] = new HelioPublishBuffer(HELIO_PUBLISH_ROLLUP_BUFSIZE, HELIO_PUBLISH_ROLLUP_MAXAGE);
+            HELIO_SOFT_ASSERT(_rollupBuffers[period], SFP(HStr_Err_AllocationFailure));
+        }
+    #endif
+
+    if (_rollupBuffers[period] && (publisherData()->pubToSDCard || publisherData()->pubToWiFiStorage)) {
+        if (_rollupBuffers[period]->getDepth() &&
+            getRollupFilename(period, _rollupBufferStarts[period]) != getRollupFilename(period, rollup->getBucketStart())) {
+            flushRollupFile(period, true); // buffered rows belong to prior rollup file
+        }
+        if (!queueRollupRow(rollup, row)) {
+            flushRollupFile(period, true); // overflow: flush out synchronously to make room
+
+            if (!queueRollupRow(rollup, row)) {
+                _rollupBuffers[period]->recordDroppedRow();
+            }
+        }
+    }
+
+    if (!_rollupBuffers[period] && (publisherData()->pubToSDCard || publisherData()->pubToWiFiStorage)) {
+        String rollupFilename = getRollupFilename(period, rollup->getBucketStart());
+        bool headerWritten = false;
+
+        if (isPublishingToSDCard()) {
+            auto sd = Helioduino::_activeInstance->getSDCard();
+
+            if (sd) {
+                createDirectoryFor(sd, rollupFilename);
+                auto rollupFile = sd->open(rollupFilename.c_str(), FILE_WRITE);
+
+                if (rollupFile) {
+                    if (rollup->needsHeader() || !rollupFile.size()) {
+                        rollupFile.println(getRollupHeader());
+                        headerWritten = true;
+                    }
+                    rollupFile.println(row);
+
+                    rollupFile.flush();
+                    rollupFile.close();
+                }
+
+                Helioduino::_activeInstance->endSDCard(sd);
+            }
+        }
+
+    #ifdef HELIO_USE_WIFI_STORAGE
+
+        if (isPublishingToWiFiStorage()) {
+            auto rollupFile = WiFiStorage.open(rollupFilename.c_str());
+
+            if (rollupFile) {
+                auto rollupFileStream = HelioWiFiStorageFileStream(rollupFile, rollupFile.size());
+
+                if (rollup->needsHeader() || !rollupFile.size()) {
+                    rollupFileStream.println(getRollupHeader());
+                    headerWritten = true;
+                }
+                rollupFileStream.println(row);
+
+                rollupFileStream.flush();
+                rollupFile.close();
+            }
         }
+
+    #endif
+
+        if (headerWritten) { rollup->setNeedsHeader(false); }
+    }
+
+#ifdef HELIO_USE_MQTT
+
+    if (isPublishingToMQTTClient()) {
+        if (_mqttNeedsColumns) { sendMQTTColumns(); }
+        _mqttClient->publish(getMQTTTopic(SFP(rollupExtension(period))), row.c_str(), (int)row.length());
     }
 
 #endif
+
+    rollup->clear();
 }
 
-void HelioPublisher::cleanupOldestData(bool force)
+bool HelioPublisher::queueRollupRow(HelioDataRollup *rollup, const String &row)
 {
-    // TODO: Old data cleanup. #17 in Hydruino.
+    Helio_RollupPeriod period = rollup->getPeriod();
+    auto rollupBuffer = _rollupBuffers[period];
+    bool queuedHeader = rollup->needsHeader(); // columns changed mid-file, else header is written upon file creation
+
+    rollupBuffer->beginRow();
+    if (queuedHeader) { rollupBuffer->println(getRollupHeader()); }
+    rollupBuffer->println(row);
+
+    bool wasEmpty = !rollupBuffer->getDepth();
+    if (rollupBuffer->endRow()) {
+        if (wasEmpty) {
+            _rollupBufferStarts[period] = rollup->getBucketStart();
+            _rollupBufferHeaded[period] = queuedHeader;
+        }
+        rollup->setNeedsHeader(false);
+        return true;
+    }
+    return false;
+}
+
+void HelioPublisher::flushRollupFile(Helio_RollupPeriod period, bool force)
+{
+    auto rollupBuffer = _rollupBuffers[period];
+    if (!rollupBuffer || !rollupBuffer->getDepth()) { return; }
+    uint32_t start = micros();
+    String rollupFilename = getRollupFilename(period, _rollupBufferStarts[period]);
+    uint16_t length = 0;
+    bool flushed = false;
+
+    if (isPublishingToSDCard()) {
+        auto sd = Helioduino::_activeInstance->getSDCard();
+
+        if (sd) {
+            createDirectoryFor(sd, rollupFilename);
+            auto rollupFile = sd->open(rollupFilename.c_str(), FILE_WRITE);
+
+            if (rollupFile) {
+                length = rollupBuffer->getFlushLength(rollupFile.size(), force);
+                if (length) {
+                    if (!rollupFile.size() && !_rollupBufferHeaded[period]) { rollupFile.println(getRollupHeader()); }
+                    rollupBuffer->writeOut(rollupFile, length);
+                    rollupFile.flush();
+                    flushed = true;
+                }
+
+                rollupFile.close();
+            }
+
+            Helioduino::_activeInstance->endSDCard(sd);
+        }
+    }
+
+#ifdef HELIO_USE_WIFI_STORAGE
+
+    if (isPublishingToWiFiStorage() && (flushed || !isPublishingToSDCard())) {
+        auto rollupFile = WiFiStorage.open(rollupFilename.c_str());
+
+        if (rollupFile) {
+            if (!flushed) { length = rollupBuffer->getFlushLength(rollupFile.size(), force); }
+            if (length) {
+                auto rollupFileStream = HelioWiFiStorageFileStream(rollupFile, rollupFile.size());
+                if (!rollupFile.size() && !_rollupBufferHeaded[period]) { rollupFileStream.println(getRollupHeader()); }
+                rollupBuffer->writeOut(rollupFileStream, length);
+                rollupFileStream.flush();
+                flushed = true;
+            }
+
+            rollupFile.close();
+        }
+    }
+
+#endif
+
+    if (flushed) {
+        rollupBuffer->consume(length, micros() - start);
+        _rollupBufferHeaded[period] = false; // any remainder starts mid-file
+    }
+}
+
+String HelioPublisher::getRollupFilename(Helio_RollupPeriod period, time_t bucketStart) const
+{
+    String dataFilePrefix = charsToString(publisherData()->dataFilePrefix, 16);
+    DateTime bucketDate = localTime(bucketStart); // by bucket's own date, not by when it closed
+
+    if (period == Helio_RollupPeriod_Day) {
+        return getNNFilename(dataFilePrefix, bucketDate.year() % 100, SFP(rollupExtension(period)));
+    }
+    return getYYMMDDFilename(dataFilePrefix, SFP(rollupExtension(period)), bucketDate);
+}
+
+String HelioPublisher::getRollupHeader() const
+{
+    String header; header.reserve(16 + _columnSize * 3 * (HELIO_NAME_MAXSIZE + 5));
+
+    header.concat(SFP(HStr_Key_Timestamp));
+    header.concat(F(",count"));
+
+    for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+        String title = getColumnTitle(columnIndex);
+        header.concat(','); header.concat(title); header.concat(F("_min"));
+        header.concat(','); header.concat(title); header.concat(F("_max"));
+        header.concat(','); header.concat(title); header.concat(F("_avg"));
+    }
+
+    return header;
+}
+
+String HelioPublisher::getColumnTitle(uint8_t columnIndex) const
+{
+    auto sensor = (HelioSensor *)(Helioduino::_activeInstance->_objects.find(_dataColumns[columnIndex].sensorKey).get());
+
+    if (sensor) { // same column title as .csv header
+        uint8_t measurementRow = 0;
+        while (measurementRow < columnIndex && _dataColumns[columnIndex - measurementRow - 1].sensorKey == _dataColumns[columnIndex].sensorKey) {
+            ++measurementRow;
+        }
+
+        String title; title.reserve(HELIO_NAME_MAXSIZE + 8);
+        title.concat(sensor->getKeyString());
+        title.concat('_');
+        title.concat(unitsCategoryToString(defaultCategoryForSensor(sensor->getSensorType(), measurementRow)));
+        title.concat('_');
+        title.concat(unitsTypeToSymbol(getMeasurementUnits(sensor->getMeasurement(), measurementRow)));
+        return title;
+    }
+
+    return SFP(HStr_Undefined);
+}
+
+void HelioPublisher::performTabulation()
+{
+    HELIO_SOFT_ASSERT(hasPublisherData(), SFP(HStr_Err_NotYetInitialized));
+
+    bool sameOrder = _dataColumns && _columnSize ? true : false;
+    int columnSize = 0;
+
+    auto sensors = Helioduino::_activeInstance->_objects.getSensors();
+    for (auto iter = sensors.begin(); iter != sensors.end(); ++iter) {
+        auto sensor = static_pointer_cast<HelioSensor>(*iter);
+        auto rowCount = getMeasurementRowCount(sensor->getMeasurement());
+
+        for (int rowIndex = 0; sameOrder && rowIndex < rowCount; ++rowIndex) {
+            sameOrder = sameOrder && (columnSize + rowIndex + 1 <= _columnSize) &&
+                        (_dataColumns[columnSize + rowIndex].sensorKey == sensor->getKey());
+        }
+
+        columnSize += rowCount;
+    }
+    sameOrder = sameOrder && (columnSize == _columnSize);
+
+    if (!sameOrder) {
+        for (int periodIndex = 0; periodIndex < Helio_RollupPeriod_Count; ++periodIndex) {
+            if (_rollups[periodIndex]) { // partial buckets go out under prior columns
+                emitRollup(_rollups[periodIndex]);
+                flushRollupFile((Helio_RollupPeriod)periodIndex, true);
+                _rollups[periodIndex]->setNeedsHeader();
+            }
+        }
+        #ifdef HELIO_USE_MQTT
+            sendMQTTPayload(); // frames already packed go out under prior column map
+            _mqttNeedsColumns = true;
+        #endif
+        if (_dataColumns && _columnSize != columnSize) { delete [] _dataColumns; _dataColumns = nullptr; }
+        _columnSize = columnSize;
+
+        if (_columnSize) {
+            if (!_dataColumns) {
+                _dataColumns = new HelioDataColumn[_columnSize];
+                HELIO_SOFT_ASSERT(_dataColumns, SFP(HStr_Err_AllocationFailure));
+            }
+            if (_dataColumns) {
+                int columnIndex = 0;
+
+                for (auto iter = sensors.begin(); iter != sensors.end(); ++iter) {
+                    auto sensor = static_pointer_cast<HelioSensor>(*iter);
+                    auto measurement = sensor->getMeasurement();
+                    auto rowCount = getMeasurementRowCount(measurement);
+
+                    for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
+                        HELIO_HARD_ASSERT(columnIndex < _columnSize, SFP(HStr_Err_OperationFailure));
+                        _dataColumns[columnIndex].measurement = getAsSingleMeasurement(measurement, rowIndex);
+                        _dataColumns[columnIndex].sensorKey = sensor->getKey();
+                        columnIndex++;
+                    }
+                }
+            }
+        }
+
+        resetDataFile();
+    }
+
+    _needsTabulation = false;
+}
+
+void HelioPublisher::resetDataFile()
+{
+    if (isPublishingBinary() && !_binaryWriter) {
+        _binaryWriter = new HelioBinaryDataWriter();
+        HELIO_SOFT_ASSERT(_binaryWriter, SFP(HStr_Err_AllocationFailure));
+    }
+    #if HELIO_PUBLISH_BUFFER_SIZE
+        if (!_publishBuffer && (publisherData()->pubToSDCard || publisherData()->pubToWiFiStorage)) {
+            _publishBuffer = new HelioPublishBuffer();
+            HELIO_SOFT_ASSERT(_publishBuffer, SFP(HStr_Err_AllocationFailure));
+        }
+    #endif
+    if (_publishBuffer) { _publishBuffer->clear(); } // queued rows belong to reset file
+    _dataFileSize = (uint32_t)-1; // header written below, re-read size on next flush
+
+    if (isPublishingToSDCard()) {
+        auto sd = Helioduino::_activeInstance->getSDCard(HELIO_LOFS_BEGIN);
+
+        if (sd) {
+            #if HELIO_SYS_LEAVE_FILES_OPEN
+                if (_dataFileSD) { _dataFileSD->flush(); _dataFileSD->close(); delete _dataFileSD; _dataFileSD = nullptr; }
+            #endif
+            if (sd->exists(_dataFilename.c_str())) {
+                sd->remove(_dataFilename.c_str());
+            }
+            #if HELIO_SYS_LEAVE_FILES_OPEN
+                auto &dataFile = _dataFileSD ? *_dataFileSD : *(_dataFileSD = new File(sd->open(_dataFilename.c_str(), FILE_WRITE)));
+            #else
+                createDirectoryFor(sd, _dataFilename);
+                auto dataFile = sd->open(_dataFilename.c_str(), FILE_WRITE);
+            #endif
+
+            if (dataFile && isPublishingBinary()) {
+                if (_binaryWriter) { _binaryWriter->writeHeader(dataFile, _dataColumns, _columnSize); }
+
+                #if !HELIO_SYS_LEAVE_FILES_OPEN
+                    dataFile.flush();
+                    dataFile.close();
+                #endif
+            } else if (dataFile) {
+                HelioSensor *lastSensor = nullptr;
+                uint8_t measurementRow = 0;
+
+                dataFile.print(SFP(HStr_Key_Timestamp));
+
+                for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+                    dataFile.print(',');
+
+                    auto sensor = (HelioSensor *)(Helioduino::_activeInstance->_objects.find(_dataColumns[columnIndex].sensorKey).get());
+                    if (sensor && sensor == lastSensor) { ++measurementRow; }
+                    else { measurementRow = 0; lastSensor = sensor; }
+
+                    if (sensor) {
+                        dataFile.print(sensor->getKeyString());
+                        dataFile.print('_');
+                        dataFile.print(unitsCategoryToString(defaultCategoryForSensor(sensor->getSensorType(), measurementRow)));
+                        dataFile.print('_');
+                        dataFile.print(unitsTypeToSymbol(getMeasurementUnits(sensor->getMeasurement(), measurementRow)));
+                    } else {
+                        HELIO_SOFT_ASSERT(false, SFP(HStr_Err_OperationFailure));
+                        dataFile.print(SFP(HStr_Undefined));
+                    }
+                }
+
+                dataFile.println();
+
+                #if !HELIO_SYS_LEAVE_FILES_OPEN
+                    dataFile.flush();
+                    dataFile.close();
+                #endif
+            }
+
+            #if !HELIO_SYS_LEAVE_FILES_OPEN
+                Helioduino::_activeInstance->endSDCard(sd);
+            #endif
+        }
+    }
+
+#ifdef HELIO_USE_WIFI_STORAGE
+
+    if (isPublishingToWiFiStorage()) {
+        #if HELIO_SYS_LEAVE_FILES_OPEN
+            if (_dataFileWS) { _dataFileWS->close(); delete _dataFileWS; _dataFileWS = nullptr; }
+        #endif
+        if (WiFiStorage.exists(_dataFilename.c_str())) {
+            WiFiStorage.remove(_dataFilename.c_str());
+        }
+        #if HELIO_SYS_LEAVE_FILES_OPEN
+            auto &dataFile = _dataFileWS ? *_dataFileWS : *(_dataFileWS = new WiFiStorageFile(WiFiStorage.open(_dataFilename.c_str())));
+        #else
+            auto dataFile = WiFiStorage.open(_dataFilename.c_str());
+        #endif
+
+        if (dataFile && isPublishingBinary()) {
+            auto dataFileStream = HelioWiFiStorageFileStream(dataFile);
+            if (_binaryWriter) { _binaryWriter->writeHeader(dataFileStream, _dataColumns, _columnSize); }
+        } else if (dataFile) {
+            auto dataFileStream = HelioWiFiStorageFileStream(dataFile);
+            HelioSensor *lastSensor = nullptr;
+            uint8_t measurementRow = 0;
+
+            dataFileStream.print(SFP(HStr_Key_Timestamp));
+
+            for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+                dataFileStream.print(',');
+
+                auto sensor = (HelioSensor *)(Helioduino::_activeInstance->_objects.find(_dataColumns[columnIndex].sensorKey).get());
+                if (sensor && sensor == lastSensor) { ++measurementRow; }
+                else { measurementRow = 0; lastSensor = sensor; }
+
+                if (sensor) {
+                    dataFileStream.print(sensor->getKeyString());
+                    dataFileStream.print('_');
+                    dataFileStream.print(unitsCategoryToString(defaultCategoryForSensor(sensor->getSensorType(), measurementRow)));
+                    dataFileStream.print('_');
+                    dataFileStream.print(unitsTypeToSymbol(getMeasurementUnits(sensor->getMeasurement(), measurementRow)));
+                } else {
+                    HELIO_SOFT_ASSERT(false, SFP(HStr_Err_OperationFailure));
+                    dataFileStream.print(SFP(HStr_Undefined));
+                }
+            }
+
+            dataFileStream.println();
+        }
+    }
+
+#endif
+}
+
+void HelioPublisher::finalizeDataFile()
+{
+    if (!_binaryWriter || !_binaryWriter->getIndexSize()) { return; }
+    _dataFileSize = (uint32_t)-1;
+
+    if (isPublishingToSDCard()) {
+        auto sd = Helioduino::_activeInstance->getSDCard(HELIO_LOFS_BEGIN);
+
+        if (sd) {
+            #if HELIO_SYS_LEAVE_FILES_OPEN
+                auto &dataFile = _dataFileSD ? *_dataFileSD : *(_dataFileSD = new File(sd->open(_dataFilename.c_str(), FILE_WRITE)));
+            #else
+                auto dataFile = sd->open(_dataFilename.c_str(), FILE_WRITE);
+            #endif
+
+            if (dataFile) {
+                _binaryWriter->writeFooter(dataFile);
+
+                #if !HELIO_SYS_LEAVE_FILES_OPEN
+                    dataFile.flush();
+                    dataFile.close();
+                #endif
+            }
+
+            #if !HELIO_SYS_LEAVE_FILES_OPEN
+                Helioduino::_activeInstance->endSDCard(sd);
+            #endif
+        }
+    }
+
+#ifdef HELIO_USE_WIFI_STORAGE
+
+    if (isPublishingToWiFiStorage()) {
+        #if HELIO_SYS_LEAVE_FILES_OPEN
+            auto &dataFile = _dataFileWS ? *_dataFileWS : *(_dataFileWS = new WiFiStorageFile(WiFiStorage.open(_dataFilename.c_str())));
+        #else
+            auto dataFile = WiFiStorage.open(_dataFilename.c_str());
+        #endif
+
+        if (dataFile) {
+            auto dataFileStream = HelioWiFiStorageFileStream(dataFile, dataFile.size());
+            _binaryWriter->writeFooter(dataFileStream);
+
+            #if !HELIO_SYS_LEAVE_FILES_OPEN
+                dataFile.close();
+            #endif
+        }
+    }
+
+#endif
+}
+
+void HelioPublisher::cleanupOldestData(bool force)
+{
+    // TODO: Old data cleanup. #17 in Hydruino.
+}
+
+
+// Writes value as byteCount # of little-endian bytes, returning buffer past written bytes
+static inline uint8_t *putLE(uint8_t *buffer, uint32_t value, uint8_t byteCount)
+{
+    for (uint8_t byteIndex = 0; byteIndex < byteCount; ++byteIndex) { *buffer++ = (uint8_t)(value >> (8 * byteIndex)); }
+    return buffer;
+}
+
+static inline uint8_t *putFloatLE(uint8_t *buffer, float value)
+{
+    uint32_t bits; memcpy(&bits, &value, sizeof(bits));
+    return putLE(buffer, bits, 4);
+}
+
+// Reads value from byteCount # of little-endian bytes
+static inline uint32_t getLE(const uint8_t *buffer, uint8_t byteCount)
+{
+    uint32_t value = 0;
+    for (uint8_t byteIndex = 0; byteIndex < byteCount; ++byteIndex) { value |= (uint32_t)buffer[byteIndex] << (8 * byteIndex); }
+    return value;
+}
+
+HelioBinaryDataWriter::HelioBinaryDataWriter()
+    : _rowBuffer(nullptr), _columnSize(0), _fileOffset(0), _lastTimestamp(0), _rowsSinceKeyframe(0),
+      _keyframeCount(0), _indexStride(1), _indexSize(0)
+{ ; }
+
+HelioBinaryDataWriter::~HelioBinaryDataWriter()
+{
+    if (_rowBuffer) { delete [] _rowBuffer; _rowBuffer = nullptr; }
+}
+
+size_t HelioBinaryDataWriter::writeHeader(Print &out, const HelioDataColumn *dataColumns, uint8_t columnSize)
+{
+    if (_rowBuffer && _columnSize != columnSize) { delete [] _rowBuffer; _rowBuffer = nullptr; }
+    _columnSize = columnSize;
+    if (!_rowBuffer) {
+        _rowBuffer = new uint8_t[5 + 4 * (size_t)_columnSize];
+        HELIO_SOFT_ASSERT(_rowBuffer, SFP(HStr_Err_AllocationFailure));
+    }
+    _lastTimestamp = 0;
+    _rowsSinceKeyframe = _keyframeCount = _indexSize = 0;
+    _indexStride = 1;
+
+    uint8_t buffer[8] = {'H','D','B',Version,_columnSize};
+    size_t written = out.write(buffer, 5);
+    HelioSensor *lastSensor = nullptr;
+    uint8_t measurementRow = 0;
+
+    for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+        auto sensor = (HelioSensor *)(Helioduino::_activeInstance->_objects.find(dataColumns[columnIndex].sensorKey).get());
+        if (sensor && sensor == lastSensor) { ++measurementRow; }
+        else { measurementRow = 0; lastSensor = sensor; }
+
+        Helio_UnitsType units = sensor ? getMeasurementUnits(sensor->getMeasurement(), measurementRow) : dataColumns[columnIndex].measurement.units;
+        String title; // same column title as .csv header
+        if (sensor) {
+            title.concat(sensor->getKeyString());
+            title.concat('_');
+            title.concat(unitsCategoryToString(defaultCategoryForSensor(sensor->getSensorType(), measurementRow)));
+            title.concat('_');
+            title.concat(unitsTypeToSymbol(units));
+        } else {
+            title = SFP(HStr_Undefined);
+        }
+        uint8_t titleLength = (uint8_t)min((unsigned int)UINT8_MAX, title.length());
+        uint8_t *bufferPos = putLE(buffer, dataColumns[columnIndex].sensorKey, 4);
+
+        *bufferPos++ = measurementRow;
+        *bufferPos++ = (uint8_t)(int8_t)units;
+        *bufferPos++ = titleLength;
+        written += out.write(buffer, bufferPos - buffer);
+        written += out.write((const uint8_t *)title.c_str(), titleLength);
+    }
+
+    _fileOffset = written;
+    return written;
+}
+
+const uint8_t *HelioBinaryDataWriter::encodeRow(time_t timestamp, const HelioDataColumn *dataColumns, uint8_t columnSize, uint16_t *lengthOut)
+{
+    HELIO_SOFT_ASSERT(_rowBuffer && columnSize == _columnSize, SFP(HStr_Err_NotYetInitialized));
+    if (!_rowBuffer || columnSize != _columnSize) { return nullptr; }
+
+    bool keyframe = !_lastTimestamp || timestamp < _lastTimestamp || timestamp - _lastTimestamp > (time_t)UINT16_MAX ||
+                    _rowsSinceKeyframe >= HELIO_PUBLISH_KEYFRAME_ROWS;
+    uint8_t *bufferPos = _rowBuffer;
+
+    if (keyframe) {
+        addIndexEntry(timestamp, _fileOffset);
+        *bufferPos++ = 'K';
+        bufferPos = putLE(bufferPos, (uint32_t)timestamp, 4);
+        _rowsSinceKeyframe = 0;
+    } else {
+        *bufferPos++ = 'D';
+        bufferPos = putLE(bufferPos, (uint32_t)(timestamp - _lastTimestamp), 2);
+    }
+    for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+        bufferPos = putFloatLE(bufferPos, dataColumns[columnIndex].measurement.value);
+    }
+
+    _lastTimestamp = timestamp;
+    _rowsSinceKeyframe++;
+    _fileOffset += bufferPos - _rowBuffer;
+    if (lengthOut) { *lengthOut = bufferPos - _rowBuffer; }
+    return _rowBuffer;
+}
+
+size_t HelioBinaryDataWriter::writeFooter(Print &out) const
+{
+    uint8_t buffer[8] = {'X',_indexSize};
+    size_t written = out.write(buffer, 2);
+
+    for (int indexIndex = 0; indexIndex < _indexSize; ++indexIndex) {
+        putLE(putLE(buffer, _indexTimestamps[indexIndex], 4), _indexOffsets[indexIndex], 4);
+        written += out.write(buffer, 8);
+    }
+
+    uint8_t *bufferPos = putLE(buffer, _fileOffset, 4);
+    *bufferPos++ = 'H'; *bufferPos++ = 'D'; *bufferPos++ = 'B'; *bufferPos++ = 'X';
+    written += out.write(buffer, 8);
+
+    return written;
+}
+
+void HelioBinaryDataWriter::addIndexEntry(time_t timestamp, uint32_t fileOffset)
+{
+    if (_keyframeCount % _indexStride == 0) {
+        if (_indexSize >= HELIO_PUBLISH_INDEX_MAXSIZE) { // thin index to every other entry
+            for (int indexIndex = 0; indexIndex < HELIO_PUBLISH_INDEX_MAXSIZE / 2; ++indexIndex) {
+                _indexTimestamps[indexIndex] = _indexTimestamps[indexIndex * 2];
+                _indexOffsets[indexIndex] = _indexOffsets[indexIndex * 2];
+            }
+            _indexSize = HELIO_PUBLISH_INDEX_MAXSIZE / 2;
+            _indexStride *= 2;
+        }
+        if (_keyframeCount % _indexStride == 0) {
+            _indexTimestamps[_indexSize] = (uint32_t)timestamp;
+            _indexOffsets[_indexSize] = fileOffset;
+            _indexSize++;
+        }
+    }
+    _keyframeCount++;
+}
+
+
+HelioPublishBuffer::HelioPublishBuffer(uint16_t capacity, uint16_t maxAge)
+    : _buffer(nullptr), _capacity(capacity), _maxAge(maxAge), _head(0), _committed(0), _rowLength(0), _rowOverflow(false),
+      _peakDepth(0), _oldestMillis(0), _rowMarks(nullptr), _markCapacity(0), _markHead(0), _markCount(0), _rowsQueued(0), _rowsDropped(0), _flushCount(0), _lastFlushMicros(0), _maxFlushMicros(0)
+{
+    _buffer = _capacity ? new uint8_t[_capacity] : nullptr;
+    HELIO_SOFT_ASSERT(_buffer || !_capacity, SFP(HStr_Err_AllocationFailure));
+    if (!_buffer) { _capacity = 0; }
+    _markCapacity = _capacity ? (uint8_t)min(_capacity / 64 + 1, (int)UINT8_MAX) : 0; // ~1 mark per 64 bytes
+    _rowMarks = _markCapacity ? new RowMark[_markCapacity] : nullptr;
+    HELIO_SOFT_ASSERT(_rowMarks || !_markCapacity, SFP(HStr_Err_AllocationFailure));
+    if (!_rowMarks) { _markCapacity = 0; }
+}
+
+HelioPublishBuffer::~HelioPublishBuffer()
+{
+    if (_buffer) { delete [] _buffer; _buffer = nullptr; }
+    if (_rowMarks) { delete [] _rowMarks; _rowMarks = nullptr; }
+}
+
+bool HelioPublishBuffer::endRow()
+{
+    if (_rowOverflow) {
+        _rowLength = 0;
+        return false;
+    }
+    if (_rowLength) {
+        millis_t time = millis();
+        if (!_committed) { _oldestMillis = time; }
+        if (_markCount < _markCapacity) {
+            auto &mark = _rowMarks[(_markHead + _markCount++) % _markCapacity];
+            mark.length = _rowLength;
+            mark.millis = time;
+        } else if (_markCount) { // out of marks: row ages with newest mark (flushes no later than due)
+            _rowMarks[(_markHead + _markCount - 1) % _markCapacity].length += _rowLength;
+        }
+        _committed += _rowLength;
+        _rowLength = 0;
+        _rowsQueued++;
+        _peakDepth = max(_peakDepth, _committed);
+    }
+    return true;
+}
+
+size_t HelioPublishBuffer::write(const uint8_t *data, size_t size)
+{
+    if (_rowOverflow || (size_t)_committed + _rowLength + size > _capacity) {
+        _rowOverflow = true;
+        return 0;
+    }
+
+    uint16_t position = (_head + _committed + _rowLength) % _capacity;
+    uint16_t firstLength = (uint16_t)min(size, (size_t)(_capacity - position));
+    memcpy(&_buffer[position], data, firstLength);
+    if (size > firstLength) { memcpy(&_buffer[0], &data[firstLength], size - firstLength); }
+    _rowLength += size;
+
+    return size;
+}
+
+uint16_t HelioPublishBuffer::getFlushLength(uint32_t fileSize, bool force) const
+{
+    if (!_committed) { return 0; }
+    if (force || millis() - _oldestMillis >= (millis_t)_maxAge * 1000) { return _committed; }
+    uint32_t flushEnd = ((fileSize + _committed) / HELIO_PUBLISH_FLUSH_BLOCKSIZE) * HELIO_PUBLISH_FLUSH_BLOCKSIZE;
+    return flushEnd > fileSize ? (uint16_t)(flushEnd - fileSize) : 0;
+}
+
+uint16_t HelioPublishBuffer::peek(uint16_t offset, const uint8_t **dataOut) const
+{
+    if (offset >= _committed) { return 0; }
+    uint16_t position = (_head + offset) % _capacity;
+    if (dataOut) { *dataOut = &_buffer[position]; }
+    return min((uint16_t)(_committed - offset), (uint16_t)(_capacity - position));
+}
+
+size_t HelioPublishBuffer::writeOut(Print &out, uint16_t length) const
+{
+    size_t written = 0;
+    const uint8_t *data = nullptr;
+
+    for (uint16_t runLength = peek(0, &data); written < length && runLength; runLength = peek(written, &data)) {
+        written += out.write(data, min(runLength, (uint16_t)(length - written)));
+    }
+    return written;
+}
+
+void HelioPublishBuffer::consume(uint16_t length, uint32_t flushMicros)
+{
+    length = min(length, _committed);
+    _head = (_head + length) % _capacity;
+    _committed -= length;
+    while (length && _markCount) {
+        auto &mark = _rowMarks[_markHead];
+        if (mark.length > length) { mark.length -= length; break; } // partially flushed row keeps its age
+        length -= mark.length;
+        _markHead = (_markHead + 1) % _markCapacity; --_markCount;
+    }
+    if (_committed) { if (_markCount) { _oldestMillis = _rowMarks[_markHead].millis; } } // remainder ages from its oldest row
+    else { _head = 0; _markHead = _markCount = 0; }
+
+    _flushCount++;
+    _lastFlushMicros = flushMicros;
+    _maxFlushMicros = max(_maxFlushMicros, flushMicros);
+}
+
+
+HelioMQTTPayloadWriter::HelioMQTTPayloadWriter(uint16_t capacity)
+    : _buffer(nullptr), _capacity(capacity), _length(0), _frameCount(0), _columnSize(0),
+      _publishMode(Helio_MQTTPublishMode_PackedJSON), _overflow(false)
+{
+    _buffer = _capacity ? new uint8_t[_capacity] : nullptr;
+    HELIO_SOFT_ASSERT(_buffer || !_capacity, SFP(HStr_Err_AllocationFailure));
+    if (!_buffer) { _capacity = 0; }
+}
+
+HelioMQTTPayloadWriter::~HelioMQTTPayloadWriter()
+{
+    if (_buffer) { delete [] _buffer; _buffer = nullptr; }
+}
+
+void HelioMQTTPayloadWriter::setPublishMode(Helio_MQTTPublishMode publishMode)
+{
+    HELIO_SOFT_ASSERT(publishMode == Helio_MQTTPublishMode_PackedJSON || publishMode == Helio_MQTTPublishMode_PackedBinary, SFP(HStr_Err_InvalidParameter));
+    _publishMode = publishMode;
+    clear();
+}
+
+bool HelioMQTTPayloadWriter::addFrame(time_t timestamp, const HelioDataColumn *dataColumns, uint8_t columnSize)
+{
+    if (_frameCount && columnSize != _columnSize) { return false; }
+    if (_frameCount == UINT8_MAX) { return false; }
+    uint16_t startLength = _length;
+    _overflow = false;
+
+    if (_publishMode == Helio_MQTTPublishMode_PackedBinary) {
+        uint8_t buffer[HeaderSize] = {'H','M','P',0,columnSize};
+        if (!_frameCount) { write(buffer, HeaderSize); }
+        putLE(buffer, (uint32_t)timestamp, 4);
+        write(buffer, 4);
+
+        for (int columnIndex = 0; columnIndex < columnSize; ++columnIndex) {
+            putFloatLE(buffer, dataColumns[columnIndex].measurement.value);
+            write(buffer, 4);
+        }
+    } else {
+        write(_frameCount ? ',' : '[');
+        write('[');
+        print(timestamp);
+
+        for (int columnIndex = 0; columnIndex < columnSize; ++columnIndex) {
+            write(',');
+            printValue(dataColumns[columnIndex].measurement.value);
+        }
+
+        write(']');
+        if (_length >= _capacity) { _overflow = true; } // reserves closing bracket
+    }
+
+    if (_overflow) {
+        _length = startLength;
+        return false;
+    }
+    _columnSize = columnSize;
+    _frameCount++;
+    return true;
+}
+
+const uint8_t *HelioMQTTPayloadWriter::finish(uint16_t *lengthOut)
+{
+    if (!_frameCount) { return nullptr; }
+
+    uint16_t length = _length;
+    if (_publishMode == Helio_MQTTPublishMode_PackedBinary) {
+        _buffer[3] = _frameCount;
+    } else {
+        _buffer[length++] = ']'; // room reserved by addFrame
+    }
+
+    if (lengthOut) { *lengthOut = length; }
+    return _buffer;
+}
+
+size_t HelioMQTTPayloadWriter::write(const uint8_t *data, size_t size)
+{
+    if (_overflow || (size_t)_length + size > _capacity) {
+        _overflow = true;
+        return 0;
+    }
+    memcpy(&_buffer[_length], data, size);
+    _length += size;
+    return size;
+}
+
+void HelioMQTTPayloadWriter::printValue(float value)
+{
+    if (isnan(value) || isinf(value) || fabsf(value) > 4294967040.0f) { // Print outputs nan/inf/ovf for these, which aren't valid JSON
+        print(SFP(HStr_null));
+        return;
+    }
+    uint16_t startLength = _length;
+    print(value, 6);
+
+    if (!_overflow) { // trim trailing zeros (and decimal point) for shortest form
+        uint16_t dotIndex = startLength;
+        while (dotIndex < _length && _buffer[dotIndex] != '.') { ++dotIndex; }
+        if (dotIndex < _length) {
+            while (_length > dotIndex + 1 && _buffer[_length - 1] == '0') { --_length; }
+            if (_length == dotIndex + 1) { --_length; }
+        }
+    }
+}
+
+
+HelioDataRollup::HelioDataRollup(Helio_RollupPeriod period)
+    : _period(period), _columnSize(0), _rowCount(0), _bucketStart(0), _stats(nullptr), _counts(nullptr), _needsHeader(false)
+{ ; }
+
+HelioDataRollup::~HelioDataRollup()
+{
+    if (_stats) { delete [] _stats; _stats = nullptr; }
+    if (_counts) { delete [] _counts; _counts = nullptr; }
+}
+
+time_t HelioDataRollup::getBucketStart(Helio_RollupPeriod period, time_t timestamp)
+{
+    switch (period) {
+        case Helio_RollupPeriod_Minute:
+            return timestamp - (timestamp % SECS_PER_MIN);
+        case Helio_RollupPeriod_Hour:
+            return timestamp - (timestamp % SECS_PER_HOUR);
+        case Helio_RollupPeriod_Day:
+            return unixTime(localDayStart(timestamp));
+        default:
+            return timestamp;
+    }
+}
+
+void HelioDataRollup::addRow(time_t timestamp, const HelioDataColumn *dataColumns, uint8_t columnSize)
+{
+    if (_columnSize != columnSize || (columnSize && !_stats)) {
+        if (_stats) { delete [] _stats; _stats = nullptr; }
+        if (_counts) { delete [] _counts; _counts = nullptr; }
+        if (_columnSize && _columnSize != columnSize) { _needsHeader = true; } // new files get their header upon creation
+        _columnSize = columnSize;
+        _rowCount = 0;
+
+        if (_columnSize) {
+            _stats = new float[3 * (size_t)_columnSize];
+            _counts = new uint16_t[_columnSize];
+            HELIO_SOFT_ASSERT(_stats && _counts, SFP(HStr_Err_AllocationFailure));
+        }
+    }
+    if (!_stats || !_counts) { return; }
+
+    if (!_rowCount) {
+        _bucketStart = getBucketStart(_period, timestamp);
+        memset(_counts, 0, sizeof(uint16_t) * _columnSize);
+    }
+
+    for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+        float value = dataColumns[columnIndex].measurement.value;
+        if (isnan(value) || isFPEqual(value, FLT_UNDEF)) { continue; }
+        float *stats = &_stats[columnIndex * 3];
+
+        if (!_counts[columnIndex]) {
+            stats[0] = stats[1] = stats[2] = value;
+        } else {
+            stats[0] = min(stats[0], value);
+            stats[1] = max(stats[1], value);
+            stats[2] += (value - stats[2]) / (_counts[columnIndex] + 1); // running mean, avoids large sums
+        }
+        if (_counts[columnIndex] < UINT16_MAX) { _counts[columnIndex]++; }
+    }
+
+    if (_rowCount < UINT16_MAX) { _rowCount++; }
+}
+
+String HelioDataRollup::getRowString() const
+{
+    String row; row.reserve(16 + _columnSize * 3 * 10);
+
+    row.concat((unsigned long)_bucketStart);
+    row.concat(',');
+    row.concat((unsigned int)_rowCount);
+
+    for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+        if (_counts && _counts[columnIndex]) {
+            row.concat(','); row.concat(getMin(columnIndex));
+            row.concat(','); row.concat(getMax(columnIndex));
+            row.concat(','); row.concat(getMean(columnIndex));
+        } else {
+            row.concat(F(",,,"));
+        }
+    }
+
+    return row;
+}
+
+
+HelioDataReader::HelioDataReader(String dataFilePrefix)
+    : _dataFilePrefix(dataFilePrefix), _sd(nullptr), _dataFile(), _sensorKey(hkey_none), _measurementRow(0), _startTime(0), _endTime(0), _dayStart(0), _daysEnd(0),
+      _daysExhausted(true), _binary(false), _columnSize(0), _columnIndex(0), _units(Helio_UnitsType_Undefined), _dataEnd(0), _lastTimestamp(0),
+      _filesOpened(0), _rowsScanned(0), _seekCount(0)
+{ ; }
+
+HelioDataReader::~HelioDataReader()
+{
+    endQuery();
+}
+
+bool HelioDataReader::beginQuery(hkey_t sensorKey, time_t startTime, time_t endTime, uint8_t measurementRow)
+{
+    HELIO_SOFT_ASSERT(startTime <= endTime, SFP(HStr_Err_InvalidParameter));
+    if (_sd) { endQuery(); }
+    if (startTime > endTime) { return false; }
+
+    auto publisher = getPublisher();
+    if (publisher && publisher->hasPublisherData()) {
+        if (!_dataFilePrefix.length()) {
+            _dataFilePrefix = charsToString(publisher->publisherData()->dataFilePrefix, 16);
+        }
+        if (endTime >= unixTime(localDayStart())) {
+            publisher->flushDataFile(true); // today's rows still queued
+        }
+    }
+    HELIO_SOFT_ASSERT(_dataFilePrefix.length(), SFP(HStr_Err_NotYetInitialized));
+    if (!_dataFilePrefix.length()) { return false; }
+
+    _sd = getController() ? getController()->getSDCard() : nullptr;
+    if (!_sd) { return false; }
+
+    _sensorKey = sensorKey;
+    _measurementRow = measurementRow;
+    _startTime = startTime;
+    _endTime = endTime;
+    _dayStart = unixTime(localDayStart(startTime));
+    _daysEnd = endTime;
+    _daysExhausted = false;
+    _filesOpened = _seekCount = 0;
+    _rowsScanned = 0;
+
+    if ((_endTime - _dayStart) / SECS_PER_DAY > HELIO_PUBLISH_QUERY_SKIPDAYS) {
+        seekDataFileRange();
+    }
+
+    return true;
+}
+
+bool HelioDataReader::readNext(HelioSingleMeasurement *measurementOut)
+{
+    while (_sd && (_dataFile || openNextDataFile())) {
+        time_t timestamp;
+        float value;
+
+        while (_binary ? readBinaryRow(&timestamp, &value) : readCSVRow(&timestamp, &value)) {
+            _rowsScanned++;
+
+            if (timestamp > _endTime) { // later rows & days are all past range
+                _dataFile.close();
+                _daysExhausted = true;
+                return false;
+            }
+            if (timestamp >= _startTime) {
+                if (measurementOut) { *measurementOut = HelioSingleMeasurement(value, _units, timestamp); }
+                return true;
+            }
+        }
+
+        _dataFile.close();
+    }
+
+    return false;
+}
+
+void HelioDataReader::endQuery()
+{
+    if (_dataFile) { _dataFile.close(); }
+    if (_sd) { getController()->endSDCard(_sd); _sd = nullptr; }
+}
+
+uint16_t HelioDataReader::replay(hkey_t sensorKey, time_t startTime, time_t endTime, void (*callback)(const HelioSingleMeasurement &), uint8_t measurementRow)
+{
+    uint16_t replayed = 0;
+
+    if (callback && beginQuery(sensorKey, startTime, endTime, measurementRow)) {
+        HelioSingleMeasurement measurement;
+
+        while (replayed < UINT16_MAX && readNext(&measurement)) {
+            callback(measurement);
+            replayed++;
+        }
+
+        endQuery();
+    }
+
+    return replayed;
+}
+
+void HelioDataReader::seekDataFileRange()
+{
+    auto slashIndex = _dataFilePrefix.lastIndexOf(HELIO_FSPATH_SEPARATOR);
+    String directory = slashIndex != -1 ? _dataFilePrefix.substring(0, slashIndex + 1) : String(HELIO_FSPATH_SEPARATOR);
+    String namePrefix = slashIndex != -1 ? _dataFilePrefix.substring(slashIndex + 1) : _dataFilePrefix;
+    time_t firstDayStart = 0, lastDayStart = 0;
+    bool found = false;
+
+    auto dataDir = _sd->open(directory.c_str(), FILE_READ);
+    if (!dataDir) { return; } // fall back to probing each day
+    _seekCount++;
+
+    for (auto entry = dataDir.openNextFile(); entry; entry = dataDir.openNextFile()) {
+        String entryName(entry.name());
+        bool isDirectory = entry.isDirectory();
+        entry.close();
+
+        // {prefix}YYMMDD.{dat|csv}, compared case-insensitively for 8.3 filesystems
+        if (isDirectory || entryName.length() != namePrefix.length() + 10) { continue; }
+        if (!entryName.substring(0, namePrefix.length()).equalsIgnoreCase(namePrefix)) { continue; }
+        String extension = entryName.substring(namePrefix.length() + 7);
+        if (!extension.equalsIgnoreCase(SFP(HStr_dat)) && !extension.equalsIgnoreCase(SFP(HStr_csv))) { continue; }
+        String yymmdd = entryName.substring(namePrefix.length(), namePrefix.length() + 6);
+        bool isDated = true;
+        for (int charIndex = 0; charIndex < 6; ++charIndex) { isDated = isDated && isDigit(yymmdd[charIndex]); }
+        if (!isDated) { continue; }
+        int yy = yymmdd.substring(0, 2).toInt(), mm = yymmdd.substring(2, 4).toInt(), dd = yymmdd.substring(4, 6).toInt();
+        if (!mm || mm > 12 || !dd || dd > 31) { continue; }
+
+        time_t fileDayStart = unixTime(DateTime((uint16_t)(2000 + yy), (uint8_t)mm, (uint8_t)dd));
+        if (fileDayStart >= _dayStart && fileDayStart <= _daysEnd) {
+            if (!found || fileDayStart < firstDayStart) { firstDayStart = fileDayStart; }
+            if (!found || fileDayStart > lastDayStart) { lastDayStart = fileDayStart; }
+            found = true;
+        }
+    }
+    dataDir.close();
+
+    if (found) { _dayStart = firstDayStart; _daysEnd = lastDayStart; }
+    else { _daysExhausted = true; }
+}
+
+bool HelioDataReader::openNextDataFile()
+{
+    while (!_daysExhausted) {
+        DateTime dayDate = localTime(_dayStart);
+        if (_daysEnd - _dayStart < SECS_PER_DAY) { _daysExhausted = true; } // last day in range, also avoids wrap past max time
+        else { _dayStart += SECS_PER_DAY; }
+
+        String dataFilename = getYYMMDDFilename(_dataFilePrefix, SFP(HStr_dat), dayDate);
+        if (_sd->exists(dataFilename.c_str()) && openDataFile(dataFilename, true)) { return true; }
+        dataFilename = getYYMMDDFilename(_dataFilePrefix, SFP(HStr_csv), dayDate);
+        if (_sd->exists(dataFilename.c_str()) && openDataFile(dataFilename, false)) { return true; }
+    }
+
+    return false;
+}
+
+bool HelioDataReader::openDataFile(const String &dataFilename, bool binary)
+{
+    _dataFile = _sd->open(dataFilename.c_str(), FILE_READ);
+
+    if (_dataFile) {
+        _filesOpened++;
+        _binary = binary;
+        _dataEnd = _dataFile.size();
+        _lastTimestamp = 0;
+
+        if (binary ? readBinaryHeader() : readCSVHeader()) {
+            if (binary) { seekBinary(dataFilename); }
+            else { seekCSV(_dataFile.position()); }
+            return true;
+        }
+
+        _dataFile.close();
+    }
+
+    return false;
+}
+
+bool HelioDataReader::readBinaryHeader()
+{
+    uint8_t buffer[8];
+    if (_dataFile.read(buffer, 5) != 5 || memcmp(buffer, "HDB", 3) != 0 || buffer[3] != HelioBinaryDataWriter::Version) { return false; }
+    bool found = false;
+
+    _columnSize = buffer[4];
+    for (int columnIndex = 0; columnIndex < _columnSize; ++columnIndex) {
+        if (_dataFile.read(buffer, 7) != 7) { return false; }
+
+        if (!found && (hkey_t)getLE(buffer, 4) == _sensorKey && buffer[4] == _measurementRow) {
+            _columnIndex = columnIndex;
+            _units = (Helio_UnitsType)(int8_t)buffer[5];
+            found = true;
+        }
+        if (buffer[6]) { _dataFile.seek(_dataFile.position() + buffer[6]); } // title
+    }
+
+    return found;
+}
+
+bool HelioDataReader::readCSVHeader()
+{
+    // column titles are <sensor key string>_<category>_<units>, so sensor key is matched by hashing
+    // (same as stringHash) each title's prefix up to every '_', as key strings may contain '_' also
+    uint8_t fieldIndex = 0, matchCount = 0;
+    hkey_t hash = 5381;
+    bool titleMatched = false, found = false;
+    char unitsSymbol[16];
+    uint8_t unitsLength = 0;
+    int ch = 0;
+
+    while (ch != '\n') {
+        ch = _dataFile.read();
+        if (ch == '\r') { continue; }
+
+        if (ch == ',' || ch == '\n' || ch < 0) {
+            if (titleMatched && !found && matchCount++ == _measurementRow) {
+                unitsSymbol[unitsLength] = '\0';
+                _columnIndex = fieldIndex;
+                _units = unitsTypeFromSymbol(String(unitsSymbol));
+                found = true;
+            }
+            if (ch < 0) { return false; } // header only partially written
+            fieldIndex++;
+            hash = 5381;
+            titleMatched = false;
+            unitsLength = 0;
+        } else {
+            if (ch == '_') {
+                titleMatched = titleMatched || (fieldIndex && (hash != hkey_none ? hash : 5381) == _sensorKey);
+                unitsLength = 0;
+            } else if (unitsLength < sizeof(unitsSymbol) - 1) {
+                unitsSymbol[unitsLength++] = (char)ch;
+            }
+            hash = ((hash << 5) + hash) + (hkey_t)(char)ch;
+        }
+    }
+    _columnSize = fieldIndex ? fieldIndex - 1 : 0;
+
+    return found;
+}
+
+void HelioDataReader::seekBinary(const String &dataFilename)
+{
+    uint32_t dataStart = _dataFile.position();
+    uint32_t seekOffset = dataStart;
+    uint8_t buffer[8];
+
+    if (_dataEnd >= dataStart + 10 && _dataFile.seek(_dataEnd - 8) && _dataFile.read(buffer, 8) == 8 && memcmp(buffer + 4, "HDBX", 4) == 0) {
+        uint32_t footerOffset = getLE(buffer, 4);
+        _seekCount++;
+
+        if (footerOffset >= dataStart && footerOffset < _dataEnd && _dataFile.seek(footerOffset) && _dataFile.read(buffer, 2) == 2 && buffer[0] == 'X') {
+            uint8_t indexSize = buffer[1];
+            _dataEnd = footerOffset;
+
+            for (int indexIndex = 0; indexIndex < indexSize && _dataFile.read(buffer, 8) == 8; ++indexIndex) {
+                if (getLE(buffer, 4) > (uint32_t)_startTime) { break; }
+                uint32_t offset = getLE(buffer + 4, 4);
+                if (offset >= dataStart && offset < _dataEnd) { seekOffset = offset; }
+            }
+        }
+    } else { // today's unfinalized file uses publisher's in-memory index
+        auto publisher = getPublisher();
+        if (publisher && publisher->_binaryWriter && publisher->isPublishingBinary() && publisher->_dataFilename == dataFilename) {
+            auto binaryWriter = publisher->_binaryWriter;
+
+            for (int indexIndex = 0; indexIndex < binaryWriter->getIndexSize(); ++indexIndex) {
+                if (binaryWriter->getIndexTimestamp(indexIndex) > (uint32_t)_startTime) { break; }
+                uint32_t offset = binaryWriter->getIndexOffset(indexIndex);
+                if (offset >= dataStart && offset < _dataEnd) { seekOffset = offset; }
+            }
+        }
+    }
+
+    _dataFile.seek(seekOffset);
+    _seekCount++;
+}
+
+void HelioDataReader::seekCSV(uint32_t dataStart)
+{
+    uint32_t low = dataStart, high = _dataEnd;
+    time_t timestamp;
+
+    while (high - low > HELIO_PUBLISH_QUERY_SCANSIZE) {
+        uint32_t middle = low + (high - low) / 2;
+        _dataFile.seek(middle);
+        _seekCount++;
+        skipCSVLine();
+
+        if (_dataFile.position() < high && readCSVTimestamp(&timestamp) && timestamp < _startTime) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    _dataFile.seek(low);
+    if (low != dataStart) { skipCSVLine(); } // row containing low is before range
+}
+
+bool HelioDataReader::readBinaryRow(time_t *timestampOut, float *valueOut)
+{
+    uint8_t buffer[4];
+    int tag;
+
+    while ((tag = _dataFile.read()) == 'X') { // mid-file index footer from prior finalize, skip over
+        if (_dataFile.position() >= _dataEnd || (tag = _dataFile.read()) < 0) { return false; }
+        _dataFile.seek(_dataFile.position() + 8 * (uint32_t)tag + 8);
+    }
+    if (_dataFile.position() > _dataEnd) { return false; }
+
+    switch (tag) {
+        case 'K':
+            if (_dataFile.read(buffer, 4) != 4) { return false; }
+            _lastTimestamp = (time_t)getLE(buffer, 4);
+            break;
+        case 'D':
+            if (!_lastTimestamp || _dataFile.read(buffer, 2) != 2) { return false; }
+            _lastTimestamp += (time_t)getLE(buffer, 2);
+            break;
+        default: // footer, or corrupt
+            return false;
+    }
+
+    uint32_t rowEnd = _dataFile.position() + 4 * (uint32_t)_columnSize;
+    if (rowEnd > _dataEnd) { return false; } // partial row still being written
+
+    if (_columnIndex) { _dataFile.seek(_dataFile.position() + 4 * (uint32_t)_columnIndex); }
+    if (_dataFile.read(buffer, 4) != 4) { return false; }
+    uint32_t bits = getLE(buffer, 4);
+    memcpy(valueOut, &bits, sizeof(float));
+    _dataFile.seek(rowEnd);
+
+    *timestampOut = _lastTimestamp;
+    return true;
+}
+
+bool HelioDataReader::readCSVRow(time_t *timestampOut, float *valueOut)
+{
+    if (!readCSVTimestamp(timestampOut)) { return false; }
+    uint8_t fieldIndex = 1;
+    int ch = 0;
+
+    while (fieldIndex < _columnIndex && (ch = _dataFile.read()) >= 0 && ch != '\n') {
+        if (ch == ',') { fieldIndex++; }
+    }
+    if (fieldIndex != _columnIndex) { return false; }
+
+    char valueStr[24];
+    uint8_t valueLength = 0;
+    while ((ch = _dataFile.read()) >= 0 && ch != ',' && ch != '\r' && ch != '\n') {
+        if (valueLength < sizeof(valueStr) - 1) { valueStr[valueLength++] = (char)ch; }
+    }
+    if (ch < 0) { return false; } // partial row still being written
+    if (ch != '\n') { skipCSVLine(); }
+    valueStr[valueLength] = '\0';
+
+    *valueOut = valueLength ? (float)atof(valueStr) : FLT_UNDEF;
+    return true;
+}
+
+bool HelioDataReader::readCSVTimestamp(time_t *timestampOut)
+{
+    uint32_t timestamp = 0;
+    bool hasDigits = false;
+    int ch;
+
+    while ((ch = _dataFile.read()) >= '0' && ch <= '9') {
+        timestamp = (timestamp * 10) + (uint32_t)(ch - '0');
+        hasDigits = true;
+    }
+
+    *timestampOut = (time_t)timestamp;
+    return hasDigits && ch == ',';
+}
+
+void HelioDataReader::skipCSVLine()
+{
+    int ch;
+    while ((ch = _dataFile.read()) >= 0 && ch != '\n') { ; }
 }
 
 
 HelioPublisherSubData::HelioPublisherSubData()
-    : HelioSubData(0), dataFilePrefix{0}, pubToSDCard(false), pubToWiFiStorage(false)
+    : HelioSubData(0), dataFilePrefix{0}, pubToSDCard(false), pubToWiFiStorage(false), pubBinary(false),
+      mqttMode(Helio_MQTTPublishMode_PerSensor), mqttCoalesce(1), rollupPeriods(0)
 { ; }
 
 void HelioPublisherSubData::toJSONObject(JsonObject &objectOut) const
@@ -502,6 +1954,10 @@ void HelioPublisherSubData::toJSONObject(JsonObject &objectOut) const
     if (dataFilePrefix[0]) { objectOut[SFP(HStr_Key_DataFilePrefix)] = charsToString(dataFilePrefix, 16); }
     if (pubToSDCard != false) { objectOut[SFP(HStr_Key_PublishToSDCard)] = pubToSDCard; }
     if (pubToWiFiStorage != false) { objectOut[SFP(HStr_Key_PublishToWiFiStorage)] = pubToWiFiStorage; }
+    if (pubBinary != false) { objectOut[SFP(HStr_Key_PublishBinary)] = pubBinary; }
+    if (mqttMode != Helio_MQTTPublishMode_PerSensor) { objectOut[SFP(HStr_Key_MQTTPublishMode)] = (int8_t)mqttMode; }
+    if (mqttCoalesce != 1) { objectOut[SFP(HStr_Key_MQTTCoalesceFrames)] = mqttCoalesce; }
+    if (rollupPeriods) { objectOut[SFP(HStr_Key_RollupPeriods)] = rollupPeriods; }
 }
 
 void HelioPublisherSubData::fromJSONObject(JsonObjectConst &objectIn)
@@ -512,4 +1968,8 @@ void HelioPublisherSubData::fromJSONObject(JsonObjectConst &objectIn)
     if (dataFilePrefixStr && dataFilePrefixStr[0]) { strncpy(dataFilePrefix, dataFilePrefixStr, 16); }
     pubToSDCard = objectIn[SFP(HStr_Key_PublishToSDCard)] | pubToSDCard;
     pubToWiFiStorage = objectIn[SFP(HStr_Key_PublishToWiFiStorage)] | pubToWiFiStorage;
+    pubBinary = objectIn[SFP(HStr_Key_PublishBinary)] | pubBinary;
+    mqttMode = (Helio_MQTTPublishMode)(objectIn[SFP(HStr_Key_MQTTPublishMode)] | (int8_t)mqttMode);
+    mqttCoalesce = objectIn[SFP(HStr_Key_MQTTCoalesceFrames)] | mqttCoalesce;
+    rollupPeriods = objectIn[SFP(HStr_Key_RollupPeriods)] | rollupPeriods;
 }
@@ -8,6 +8,11 @@
 #define HelioPublisher_H
 
 class HelioPublisher;
+class HelioBinaryDataWriter;
+class HelioPublishBuffer;
+class HelioMQTTPayloadWriter;
+class HelioDataRollup;
+class HelioDataReader;
 struct HelioPublisherSubData;
 struct HelioDataColumn;
 
@@ -19,12 +24,18 @@ struct HelioDataColumn;
 // is based on a simple table of time and measured value. Each time segment, called a
 // polling frame (and controlled by the polling rate interval), collects data from all
 // sensors into a data row, with the appropriate total number of columns. At time of
-// either all sensors having reported in for their frame #, or the frame # proceeding
-// to advance (in which case the existing value is recycled), the table's row is
-// submitted to configured publishing services.
+// either all sensors due that frame (see HelioSensor::setPollingPolicy) having reported
+// in for their frame #, or the frame # proceeding to advance (in which case the existing
+// value is recycled), the table's row is submitted to configured publishing services.
 // Publishing to SD card .csv data files (via SPI card reader) is supported as is logging to
 // WiFiStorage .csv data files (via OS/OTA filesystem / WiFiNINA_Generic only). MQTT is also
-// supported but requires additional setup.
+// supported but requires additional setup, and may send data rows either as a message per
+// sensor or packed into one message per frame(s) (see HelioMQTTPayloadWriter). Data files may
+// instead be published in a compact binary .dat format (see HelioBinaryDataWriter). Unless
+// disabled, data file rows are queued into a write-behind buffer that is flushed out by misc
+// loop (see HelioPublishBuffer). Rollups of published data at minute, hour, and day resolutions
+// may also be enabled, which are published alongside the raw data rows (see HelioDataRollup).
+// Stored data files may be queried back by sensor and time range (see HelioDataReader).
 class HelioPublisher {
 public:
     HelioPublisher();
@@ -43,8 +54,23 @@ public:
 #ifdef HELIO_USE_MQTT
     bool beginPublishingToMQTTClient(MQTTClient &client);
     inline bool isPublishingToMQTTClient() const;
+
+    // Sets how data rows are sent to MQTT broker, and for packed modes how many polling frames to coalesce into each message (sent once full).
+    void setMQTTPublishMode(Helio_MQTTPublishMode publishMode, uint8_t coalesceFrames = 1);
+    inline Helio_MQTTPublishMode getMQTTPublishMode() const;
+    inline uint8_t getMQTTCoalesceFrames() const;
 #endif
 
+    // Sets data files to be published in binary .dat format (true), or .csv format (false, default). Restarts current data file.
+    void setPublishingBinary(bool publishBinary);
+    inline bool isPublishingBinary() const;
+
+    // Sets rollups of published data at passed period resolution to be enabled/disabled (default: all disabled). Disabling emits any partial bucket.
+    void setRollupEnabled(Helio_RollupPeriod period, bool enabled = true);
+    inline bool isRollupEnabled(Helio_RollupPeriod period) const;
+    // Data rollup at passed period resolution (for current bucket), else nullptr if disabled or not yet started
+    inline const HelioDataRollup *getRollup(Helio_RollupPeriod period) const { return period >= 0 && period < Helio_RollupPeriod_Count ? _rollups[period] : nullptr; }
+
     void publishData(hposi_t columnIndex, HelioSingleMeasurement measurement);
 
     inline void setNeedsTabulation();
@@ -55,6 +81,9 @@ public:
 
     Signal<Pair<uint8_t, const HelioDataColumn *>, HELIO_PUBLISH_SIGNAL_SLOTS> &getPublishSignal();
 
+    // Write-behind data row buffer (for queue metrics), else nullptr if disabled
+    inline const HelioPublishBuffer *getPublishBuffer() const { return _publishBuffer; }
+
     void notifyDayChanged();
 
 protected:
@@ -66,16 +95,27 @@ protected:
 #endif
 #ifdef HELIO_USE_MQTT
     MQTTClient *_mqttClient;                                // MQTT client object (strong)
+    HelioMQTTPayloadWriter *_mqttPayload;                   // Packed MQTT payload writer (owned), else nullptr if publishing per sensor
+    String _mqttTopic;                                      // MQTT topic buffer, as system name prefix + reused suffix
+    bool _mqttNeedsColumns;                                 // Needs column map message sent flag
 #endif
     String _dataFilename;                                   // Resolved data file name (based on day)
     hframe_t _pollingFrame;                                 // Polling frame that publishing is caught up to
     bool _needsTabulation;                                  // Needs tabulation tracking flag
     uint8_t _columnSize;                                    // Number of data columns
     HelioDataColumn *_dataColumns;                          // Data columns array (owned)
+    HelioBinaryDataWriter *_binaryWriter;                   // Binary data file writer (owned, lazily created)
+    HelioPublishBuffer *_publishBuffer;                     // Write-behind data row buffer (owned), else nullptr if disabled
+    uint32_t _dataFileSize;                                 // Data file size as of last flush (spares reopening file when no flush is due), else -1 if unknown
+    HelioDataRollup *_rollups[Helio_RollupPeriod_Count];    // Data rollups per period (owned, lazily created), else nullptr if disabled
+    HelioPublishBuffer *_rollupBuffers[Helio_RollupPeriod_Count]; // Write-behind rollup row buffers per period (owned, lazily created), else nullptr if disabled
+    time_t _rollupBufferStarts[Helio_RollupPeriod_Count];   // Bucket start of oldest buffered rollup row per period (locates its rollup file)
+    bool _rollupBufferHeaded[Helio_RollupPeriod_Count];     // Buffered rollup rows begin with a header flags
 
     Signal<Pair<uint8_t, const HelioDataColumn *>, HELIO_PUBLISH_SIGNAL_SLOTS> _publishSignal; // Data publishing signal
 
     friend class Helioduino;
+    friend class HelioDataReader;
 
     inline HelioPublisherSubData *publisherData() const;
     inline bool hasPublisherData() const;
@@ -85,11 +125,29 @@ protected:
 
     void publishIfNeeded();
     void publish(time_t timestamp);
+    bool queueDataRow(time_t timestamp, const uint8_t *binaryRow, uint16_t binaryLength);
+    void flushDataFile(bool force = false);
+    void updateRollups(time_t timestamp);
+    void emitRollup(HelioDataRollup *rollup);
+    bool queueRollupRow(HelioDataRollup *rollup, const String &row);
+    void flushRollupFile(Helio_RollupPeriod period, bool force = false);
+    String getRollupFilename(Helio_RollupPeriod period, time_t bucketStart) const;
+    String getRollupHeader() const;
+#ifdef HELIO_USE_MQTT
+    void publishMQTT(time_t timestamp);
+    void sendMQTTPayload();
+    void sendMQTTColumns();
+    const char *getMQTTTopic(const String &suffix);
+#endif
 
     void performTabulation();
 
     void resetDataFile();
+    void finalizeDataFile();
     void cleanupOldestData(bool force = false);
+
+    inline String getDataFileExtension() const;
+    String getColumnTitle(uint8_t columnIndex) const;
 };
 
 // Publisher Data Column
@@ -99,6 +157,282 @@ struct HelioDataColumn {
     HelioSingleMeasurement measurement;                     // Storage polling frame measurement
 };
 
+// Binary Data File Writer
+// Encodes publisher data into the binary .dat file format, which is about a quarter the size of
+// .csv and needs no float formatting. A header lists each column's sensor key, measurement row,
+// units, and .csv column title. Fixed-width rows follow, each a tag and timestamp then one float
+// per column: keyframe rows store the full timestamp, while the rows in between store a 16-bit
+// delta from the prior row. Upon finalizing (day change) a time index of keyframe offsets is
+// appended as a footer, letting readers seek by time (or else fall back to scanning keyframes).
+// Multi-byte fields are little-endian. See extra/HelioDataToCSV.cpp for a host-side reader.
+//  Header: 'H' 'D' 'B' version:u8 columns:u8 { sensorKey:u32 row:u8 units:i8 titleLen:u8 title:char[titleLen] }[columns]
+//  Rows:   'K' timestamp:u32 value:f32[columns] | 'D' deltaSecs:u16 value:f32[columns]
+//  Footer: 'X' entries:u8 { timestamp:u32 offset:u32 }[entries] footerOffset:u32 'H' 'D' 'B' 'X'
+class HelioBinaryDataWriter {
+public:
+    HelioBinaryDataWriter();
+    ~HelioBinaryDataWriter();
+
+    // Writes file header for data columns, resetting row encoding state. Returns # of bytes written.
+    size_t writeHeader(Print &out, const HelioDataColumn *dataColumns, uint8_t columnSize);
+    // Encodes data row into internal row buffer, returning buffer (and length via lengthOut), or nullptr if header not yet written.
+    const uint8_t *encodeRow(time_t timestamp, const HelioDataColumn *dataColumns, uint8_t columnSize, uint16_t *lengthOut);
+    // Writes time index footer. Returns # of bytes written.
+    size_t writeFooter(Print &out) const;
+
+    // Backs out last encoded row from file offset after it failed to be written, forcing next row to be a keyframe
+    inline void dropLastRow(uint16_t length) { _fileOffset -= length; _lastTimestamp = 0; }
+
+    inline uint32_t getFileOffset() const { return _fileOffset; }
+    inline uint8_t getIndexSize() const { return _indexSize; }
+    inline uint32_t getIndexTimestamp(uint8_t indexIndex) const { return _indexTimestamps[indexIndex]; }
+    inline uint32_t getIndexOffset(uint8_t indexIndex) const { return _indexOffsets[indexIndex]; }
+
+    static const uint8_t Version = 1;                       // Binary data file format version
+
+protected:
+    uint8_t *_rowBuffer;                                    // Row encoding buffer (owned)
+    uint8_t _columnSize;                                    // Number of data columns (in row buffer)
+    uint32_t _fileOffset;                                   // Bytes encoded into file so far (header + rows)
+    time_t _lastTimestamp;                                  // Timestamp of prior row, else 0
+    uint16_t _rowsSinceKeyframe;                            // Rows encoded since last keyframe
+    uint16_t _keyframeCount;                                // Keyframes encoded so far
+    uint16_t _indexStride;                                  // Keyframes per index entry (doubles as index thins)
+    uint8_t _indexSize;                                     // Number of index entries
+    uint32_t _indexTimestamps[HELIO_PUBLISH_INDEX_MAXSIZE]; // Index keyframe timestamps
+    uint32_t _indexOffsets[HELIO_PUBLISH_INDEX_MAXSIZE];    // Index keyframe file offsets
+
+    void addIndexEntry(time_t timestamp, uint32_t fileOffset);
+};
+
+
+
+// Publisher Write-Behind Buffer
+// RAM ring buffer that data file rows are printed into, in place of being written out to storage
+// each polling frame, which the publisher then drains in large block-aligned chunks from misc loop.
+// Rows are committed whole: a row that does not fit is rolled back rather than partially queued.
+// Committed rows are marked with the time they were queued, so that partial flushes leave the age of
+// the oldest remaining row intact (rows beyond mark capacity share the newest mark's older time).
+// Also tracks queue depth, flush latency, and dropped row metrics.
+class HelioPublishBuffer : public Print {
+public:
+    HelioPublishBuffer(uint16_t capacity = HELIO_PUBLISH_BUFFER_SIZE, uint16_t maxAge = HELIO_PUBLISH_FLUSH_MAXAGE);
+    virtual ~HelioPublishBuffer();
+
+    // Begins new row. Subsequent writes are staged until row is ended.
+    inline void beginRow() { _rowLength = 0; _rowOverflow = false; }
+    // Ends row, committing it if it entirely fit, else rolling it back. Returns commit success.
+    bool endRow();
+    virtual size_t write(uint8_t data) override { return write(&data, 1); }
+    virtual size_t write(const uint8_t *data, size_t size) override;
+
+    // Returns # of committed bytes to flush now for a file of fileSize bytes, which is either all of
+    // them if forced or aged past max age, else as many as end on a block boundary, else 0 if none due.
+    uint16_t getFlushLength(uint32_t fileSize, bool force = false) const;
+    // Returns contiguous run of committed bytes starting offset bytes from front (may be less than remaining due to wrap)
+    uint16_t peek(uint16_t offset, const uint8_t **dataOut) const;
+    // Writes length # of committed bytes from front out to passed output, without removing them. Returns # of bytes written.
+    size_t writeOut(Print &out, uint16_t length) const;
+    // Removes length # of bytes from front once flushed, recording flush latency
+    void consume(uint16_t length, uint32_t flushMicros = 0);
+    // Drops all committed bytes (e.g. upon data file being reset)
+    inline void clear() { _head = _committed = _rowLength = 0; _markHead = _markCount = 0; }
+
+    inline void recordDroppedRow() { ++_rowsDropped; }
+    inline void resetMetrics() { _peakDepth = _committed; _rowsQueued = _rowsDropped = _flushCount = 0; _lastFlushMicros = _maxFlushMicros = 0; }
+
+    inline uint16_t getCapacity() const { return _capacity; }
+    inline uint16_t getDepth() const { return _committed; }
+    inline uint16_t getPeakDepth() const { return _peakDepth; }
+    inline millis_t getOldestMillis() const { return _oldestMillis; }
+    inline uint32_t getRowsQueued() const { return _rowsQueued; }
+    inline uint32_t getRowsDropped() const { return _rowsDropped; }
+    inline uint32_t getFlushCount() const { return _flushCount; }
+    inline uint32_t getLastFlushMicros() const { return _lastFlushMicros; }
+    inline uint32_t getMaxFlushMicros() const { return _maxFlushMicros; }
+
+protected:
+    uint8_t *_buffer;                                       // Ring buffer storage (owned)
+    uint16_t _capacity;                                     // Ring buffer capacity, in bytes
+    uint16_t _maxAge;                                       // Max age of committed bytes before flush is due regardless of block alignment, in seconds
+    uint16_t _head;                                         // Index of oldest committed byte
+    uint16_t _committed;                                    // # of committed bytes (queue depth)
+    uint16_t _rowLength;                                    // # of staged bytes in current row
+    bool _rowOverflow;                                      // Current row overflowed flag
+    uint16_t _peakDepth;                                    // Peak queue depth, in bytes
+    millis_t _oldestMillis;                                 // Time oldest committed bytes were queued
+    struct RowMark {
+        uint16_t length;                                    // # of committed bytes in marked row(s) still to be flushed
+        millis_t millis;                                    // Time marked row(s) were queued
+    } *_rowMarks;                                           // Row marks ring storage (owned)
+    uint8_t _markCapacity;                                  // Row marks ring capacity
+    uint8_t _markHead;                                      // Index of oldest row mark
+    uint8_t _markCount;                                     // # of row marks
+    uint32_t _rowsQueued;                                   // # of rows committed
+    uint32_t _rowsDropped;                                  // # of rows dropped due to overflow
+    uint32_t _flushCount;                                   // # of flushes performed
+    uint32_t _lastFlushMicros;                              // Latency of last flush, in microseconds
+    uint32_t _maxFlushMicros;                               // Latency of slowest flush, in microseconds
+};
+
+
+// MQTT Packed Payload Writer
+// Packs one or more polling frames' worth of data rows into a single MQTT message payload, in
+// place of sending a message per sensor per frame. Columns are identified by a separate column
+// map message (see HelioPublisher) listing each column's .csv column title, in column order.
+// Frames are added whole: a frame that does not fit signals the payload needs sent out first.
+// Multi-byte binary fields are little-endian, and JSON values are printed in shortest form.
+//  JSON:   [[timestamp,value,...],...]
+//  Binary: 'H' 'M' 'P' frames:u8 columns:u8 { timestamp:u32 value:f32[columns] }[frames]
+class HelioMQTTPayloadWriter : public Print {
+public:
+    HelioMQTTPayloadWriter(uint16_t capacity = HELIO_PUBLISH_MQTT_PAYLOAD_SIZE);
+    virtual ~HelioMQTTPayloadWriter();
+
+    // Sets payload encoding (packed modes only), clearing any added frames
+    void setPublishMode(Helio_MQTTPublishMode publishMode);
+    // Adds data row as frame. Returns false if frame does not fit or column count differs from prior frames.
+    bool addFrame(time_t timestamp, const HelioDataColumn *dataColumns, uint8_t columnSize);
+    // Finishes payload, returning buffer (and length via lengthOut), or nullptr if no frames added. Payload stays valid until next clear.
+    const uint8_t *finish(uint16_t *lengthOut);
+    // Clears added frames (e.g. once payload sent)
+    inline void clear() { _length = 0; _frameCount = 0; _columnSize = 0; }
+
+    virtual size_t write(uint8_t data) override { return write(&data, 1); }
+    virtual size_t write(const uint8_t *data, size_t size) override;
+
+    inline Helio_MQTTPublishMode getPublishMode() const { return _publishMode; }
+    inline uint16_t getCapacity() const { return _capacity; }
+    inline uint16_t getLength() const { return _length; }
+    inline uint8_t getFrameCount() const { return _frameCount; }
+
+    static const uint8_t HeaderSize = 5;                    // Binary payload header size, in bytes
+
+protected:
+    uint8_t *_buffer;                                       // Payload buffer (owned)
+    uint16_t _capacity;                                     // Payload buffer capacity, in bytes
+    uint16_t _length;                                       // # of payload bytes written
+    uint8_t _frameCount;                                    // # of frames added
+    uint8_t _columnSize;                                    // # of columns per frame
+    Helio_MQTTPublishMode _publishMode;                     // Payload encoding
+    bool _overflow;                                         // Frame overflowed flag
+
+    void printValue(float value);
+};
+
+
+// Data Rollup
+// Incremental min/max/mean statistics of every data column over fixed time buckets (aligned to
+// the minute, hour, or local day), which publisher emits as a rollup row once a bucket closes.
+// Rollup rows are .csv, listing bucket start time and # of rows, then each column's min, max,
+// and mean (left empty for columns with no defined values that bucket). Rollup files get a
+// header once when created, and again whenever columns change.
+//  Header: timestamp,count,{title_min,title_max,title_avg}[columns]
+//  Rows:   bucketStart,rowCount,{min,max,mean}[columns]
+class HelioDataRollup {
+public:
+    HelioDataRollup(Helio_RollupPeriod period);
+    ~HelioDataRollup();
+
+    // Returns if timestamp falls outside of current bucket, which then needs emitted and cleared before next row is added
+    inline bool isBucketClosed(time_t timestamp) const { return _rowCount && getBucketStart(_period, timestamp) != _bucketStart; }
+    // Adds data row into current bucket, beginning a new bucket if empty. Changing column count clears bucket and flags header needed (if previously set).
+    void addRow(time_t timestamp, const HelioDataColumn *dataColumns, uint8_t columnSize);
+    // Returns current bucket as rollup row
+    String getRowString() const;
+    // Clears current bucket
+    inline void clear() { _rowCount = 0; }
+
+    inline void setNeedsHeader(bool needsHeader = true) { _needsHeader = needsHeader; }
+    inline bool needsHeader() const { return _needsHeader; }
+
+    inline Helio_RollupPeriod getPeriod() const { return _period; }
+    inline time_t getBucketStart() const { return _bucketStart; }
+    inline uint16_t getRowCount() const { return _rowCount; }
+    inline uint8_t getColumnSize() const { return _columnSize; }
+    inline uint16_t getValueCount(uint8_t columnIndex) const { return _counts[columnIndex]; }
+    inline float getMin(uint8_t columnIndex) const { return _stats[columnIndex * 3]; }
+    inline float getMax(uint8_t columnIndex) const { return _stats[columnIndex * 3 + 1]; }
+    inline float getMean(uint8_t columnIndex) const { return _stats[columnIndex * 3 + 2]; }
+
+    // Returns start of bucket that timestamp falls into for passed period
+    static time_t getBucketStart(Helio_RollupPeriod period, time_t timestamp);
+
+protected:
+    Helio_RollupPeriod _period;                             // Bucket period
+    uint8_t _columnSize;                                    // Number of data columns
+    uint16_t _rowCount;                                     // # of rows added to bucket
+    time_t _bucketStart;                                    // Bucket start time
+    float *_stats;                                          // Min, max, and running mean per column (owned)
+    uint16_t *_counts;                                      // # of defined values per column (owned)
+    bool _needsHeader;                                      // Needs header written flag
+};
+
+
+// Data Reader
+// Queries stored data files (SD card only) for a sensor's measurements over a time range, and
+// streams them back one at a time. Day files are located directly by date, and inside of each
+// the first row in range is found without scanning the whole file: .dat files seek to nearest
+// prior keyframe via their time index (the footer, or for today's unfinalized file the
+// publisher's in-memory index), while .csv files are bisected by row timestamp (rows are in
+// time order). Long ranges (e.g. from epoch) are narrowed to the first and last existing data
+// files by listing their directory. Columns are matched by sensor key against the file header. When the range
+// covers today, rows still queued in publisher's write-behind buffer are flushed out first.
+class HelioDataReader {
+public:
+    // Constructor, reading from data files of passed prefix, else from publisher's data files if empty
+    HelioDataReader(String dataFilePrefix = String());
+    ~HelioDataReader();
+
+    // Begins query of sensor's measurement row over the time range [startTime, endTime]. Returns success.
+    bool beginQuery(hkey_t sensorKey, time_t startTime, time_t endTime, uint8_t measurementRow = 0);
+    // Reads next measurement in range into measurementOut. Returns false once query is exhausted.
+    bool readNext(HelioSingleMeasurement *measurementOut);
+    // Ends query, closing any open data file and returning SD card
+    void endQuery();
+
+    // Replays sensor's measurements over the time range to callback, in time order. Returns # of measurements replayed.
+    uint16_t replay(hkey_t sensorKey, time_t startTime, time_t endTime, void (*callback)(const HelioSingleMeasurement &), uint8_t measurementRow = 0);
+
+    inline bool isQuerying() const { return _sd; }
+    inline uint16_t getFilesOpened() const { return _filesOpened; }
+    inline uint32_t getRowsScanned() const { return _rowsScanned; }
+    inline uint16_t getSeekCount() const { return _seekCount; }
+
+protected:
+    String _dataFilePrefix;                                 // Data file prefix
+    SDClass *_sd;                                           // SD card instance (strong), else nullptr if not querying
+    File _dataFile;                                         // Current day's data file
+    hkey_t _sensorKey;                                      // Queried sensor key
+    uint8_t _measurementRow;                                // Queried measurement row
+    time_t _startTime;                                      // Query range start time
+    time_t _endTime;                                        // Query range end time
+    time_t _dayStart;                                       // Start time of next day's data file to open
+    time_t _daysEnd;                                        // End time of day's data files to open (query end, else last existing data file's day)
+    bool _daysExhausted;                                    // No further day's data files in range flag
+    bool _binary;                                           // If current data file is .dat
+    uint8_t _columnSize;                                    // Number of data columns in current data file
+    uint8_t _columnIndex;                                   // Queried column index in current data file
+    Helio_UnitsType _units;                                 // Queried column units
+    uint32_t _dataEnd;                                      // End offset of row data in current data file
+    time_t _lastTimestamp;                                  // Timestamp of prior .dat row
+    uint16_t _filesOpened;                                  // # of data files opened (query cost metric)
+    uint32_t _rowsScanned;                                  // # of rows read (query cost metric)
+    uint16_t _seekCount;                                    // # of search seeks (query cost metric)
+
+    void seekDataFileRange();
+    bool openNextDataFile();
+    bool openDataFile(const String &dataFilename, bool binary);
+    bool readBinaryHeader();
+    bool readCSVHeader();
+    void seekBinary(const String &dataFilename);
+    void seekCSV(uint32_t dataStart);
+    bool readBinaryRow(time_t *timestampOut, float *valueOut);
+    bool readCSVRow(time_t *timestampOut, float *valueOut);
+    bool readCSVTimestamp(time_t *timestampOut);
+    void skipCSVLine();
+};
+
 
 // Publisher Serialization Sub Data
 // A part of HSYS system data.
@@ -106,6 +440,10 @@ struct HelioPublisherSubData : public HelioSubData {
     char dataFilePrefix[HELIO_PREFIX_MAXSIZE];              // Base data file name prefix / folder (default: "data/he")
     bool pubToSDCard;                                       // If publishing sensor data to SD card is enabled (default: false)
     bool pubToWiFiStorage;                                  // If publishing sensor data to WiFiStorage is enabled (default: false)
+    bool pubBinary;                                         // If publishing data files in binary .dat format is enabled (default: false)
+    Helio_MQTTPublishMode mqttMode;                         // How data rows are sent to MQTT broker (default: PerSensor)
+    uint8_t mqttCoalesce;                                   // # of polling frames coalesced into each packed MQTT message (default: 1)
+    uint8_t rollupPeriods;                                  // Bitmask of enabled rollup periods, as 1 << Helio_RollupPeriod (default: 0)
 
     HelioPublisherSubData();
     void toJSONObject(JsonObject &objectOut) const;
@@ -55,6 +55,11 @@ void HelioRail::update()
     handleLimit(triggerStateFromBool(getCapacity(true) >= 1.0f - FLT_EPSILON));
 }
 
+millis_t HelioRail::getWakeDelay()
+{
+    return HELIO_CONTROL_LOOP_MAXSLEEP; // capacity changes are signaled through actuator activations
+}
+
 bool HelioRail::addLinkage(HelioObject *object)
 {
     if (HelioObject::addLinkage(object)) {
@@ -212,6 +217,13 @@ void HelioRegulatedRail::update()
     _limitTrigger.updateIfNeeded();
 }
 
+millis_t HelioRegulatedRail::getWakeDelay()
+{
+    if (_powerUsage.needsResolved() || _limitTrigger.needsResolved()) { return 0; }
+    millis_t detriggerLeft = _limitTrigger.isResolved() ? _limitTrigger->getDetriggerDelayLeft() : 0;
+    return detriggerLeft ? min(detriggerLeft, HelioRail::getWakeDelay()) : HelioRail::getWakeDelay();
+}
+
 SharedPtr<HelioObjInterface> HelioRegulatedRail::getSharedPtrFor(const HelioObjInterface *obj) const
 {
     return obj->getKey() == _limitTrigger.getKey() ? _limitTrigger.getSharedPtrFor(obj) :
@@ -351,6 +363,7 @@ HelioRegulatedRailData::HelioRegulatedRailData()
     : HelioRailData(), maxPower(0), powerUsageSensor{0}, limitTrigger()
 {
     _size = sizeof(*this);
+    _version = 2; // v2: trigger measurement stat field
 }
 
 void HelioRegulatedRailData::toJSONObject(JsonObject &objectOut) const
@@ -39,6 +39,7 @@ public:
     virtual ~HelioRail();
 
     virtual void update() override;
+    virtual millis_t getWakeDelay() override;
 
     virtual bool addLinkage(HelioObject *obj) override;
     virtual bool removeLinkage(HelioObject *obj) override;
@@ -104,6 +105,7 @@ public:
     HelioRegulatedRail(const HelioRegulatedRailData *dataIn);
 
     virtual void update() override;
+    virtual millis_t getWakeDelay() override;
     virtual SharedPtr<HelioObjInterface> getSharedPtrFor(const HelioObjInterface *obj) const override;
 
     virtual bool canActivate(HelioActuator *actuator) override;
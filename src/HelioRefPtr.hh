@@ -0,0 +1,86 @@
+/*  Helioduino: Simple automation controller for solar tracking systems.
+    Copyright (C) 2023 NachtRaveVL          <nachtravevl@gmail.com>
+    Helioduino Intrusive Reference Counting
+*/
+
+#ifndef HelioRefPtr_H
+#define HelioRefPtr_H
+
+class HelioRefCounted;
+template<class T> class HelioRefPtr;
+
+// Reference Counted Base
+// Base class holding the reference count used by HelioRefPtr, inherited by HelioObjInterface
+// and other shared types. Empty (zero-sized base) unless HELIO_ENABLE_INTRUSIVE_PTR is defined.
+// Copying an object does not copy its reference count.
+class HelioRefCounted {
+#ifdef HELIO_ENABLE_INTRUSIVE_PTR
+public:
+    inline HelioRefCounted() : _refCount(0) { ; }
+    inline HelioRefCounted(const HelioRefCounted &) : _refCount(0) { ; }
+    virtual ~HelioRefCounted() { ; }
+    inline HelioRefCounted &operator=(const HelioRefCounted &) { return *this; }
+
+    inline void retainRef() { ++_refCount; }
+    inline bool releaseRef() { return --_refCount == 0; }
+    inline uint16_t getRefCount() const { return _refCount; }
+
+protected:
+    uint16_t _refCount;                                     // Reference count (# of HelioRefPtr instances)
+#endif
+};
+
+// Intrusive Reference Counted Pointer
+// Drop-in stand-in for shared_ptr (as SharedPtr) that stores its count inside the pointed-to
+// object rather than in a separately allocated control block. Non-atomic, as is arx's own.
+// Keeps the counted base pointer alongside the typed pointer so that it also survives being
+// reinterpret cast to interfaces that do not themselves derive from HelioRefCounted.
+template<class T>
+class HelioRefPtr {
+public:
+    typedef T element_type;
+
+    inline HelioRefPtr() : _ptr(nullptr), _ref(nullptr) { ; }
+    inline HelioRefPtr(nullptr_t) : _ptr(nullptr), _ref(nullptr) { ; }
+    template<class U> inline explicit HelioRefPtr(U *ptr) : _ptr(ptr), _ref(ptr) { retain(); }
+    inline HelioRefPtr(T *ptr, HelioRefCounted *ref) : _ptr(ptr), _ref(ptr ? ref : nullptr) { retain(); }
+    inline HelioRefPtr(const HelioRefPtr<T> &ptr) : _ptr(ptr._ptr), _ref(ptr._ref) { retain(); }
+    template<class U> inline HelioRefPtr(const HelioRefPtr<U> &ptr) : _ptr(ptr._ptr), _ref(ptr._ref) { retain(); }
+    inline HelioRefPtr(HelioRefPtr<T> &&ptr) : _ptr(ptr._ptr), _ref(ptr._ref) { ptr._ptr = nullptr; ptr._ref = nullptr; }
+    inline ~HelioRefPtr() { release(); }
+
+    inline HelioRefPtr<T> &operator=(const HelioRefPtr<T> &rhs) { if (_ref != rhs._ref) { HelioRefCounted *ref = rhs._ref; if (ref) { ref->retainRef(); } release(); _ref = ref; } _ptr = rhs._ptr; return *this; }
+    template<class U> inline HelioRefPtr<T> &operator=(const HelioRefPtr<U> &rhs) { return operator=(HelioRefPtr<T>(rhs)); }
+    inline HelioRefPtr<T> &operator=(HelioRefPtr<T> &&rhs) { if (this != &rhs) { release(); _ptr = rhs._ptr; _ref = rhs._ref; rhs._ptr = nullptr; rhs._ref = nullptr; } return *this; }
+    inline HelioRefPtr<T> &operator=(nullptr_t) { reset(); return *this; }
+
+    inline void reset() { release(); _ptr = nullptr; _ref = nullptr; }
+    inline T *get() const { return _ptr; }
+    inline HelioRefCounted *getCounted() const { return _ref; }
+    inline long use_count() const { return _ref ? _ref->getRefCount() : 0; }
+
+    inline T &operator*() const { return *_ptr; }
+    inline T *operator->() const { return _ptr; }
+    inline explicit operator bool() const { return _ptr != nullptr; }
+
+    template<class U> inline bool operator==(const HelioRefPtr<U> &rhs) const { return _ptr == rhs.get(); }
+    template<class U> inline bool operator!=(const HelioRefPtr<U> &rhs) const { return _ptr != rhs.get(); }
+    inline bool operator==(nullptr_t) const { return _ptr == nullptr; }
+    inline bool operator!=(nullptr_t) const { return _ptr != nullptr; }
+    template<class U> inline bool operator<(const HelioRefPtr<U> &rhs) const { return _ptr < rhs.get(); }
+
+protected:
+    T *_ptr;                                                // Typed pointer
+    HelioRefCounted *_ref;                                  // Counted base pointer
+
+    inline void retain() { if (_ref) { _ref->retainRef(); } }
+    inline void release() { if (_ref && _ref->releaseRef()) { delete _ref; } }
+
+    template<class U> friend class HelioRefPtr;
+};
+
+template<class T, class U> inline HelioRefPtr<T> static_pointer_cast(const HelioRefPtr<U> &ptr) { return HelioRefPtr<T>(static_cast<T *>(ptr.get()), ptr.getCounted()); }
+template<class T, class U> inline HelioRefPtr<T> reinterpret_pointer_cast(const HelioRefPtr<U> &ptr) { return HelioRefPtr<T>(reinterpret_cast<T *>(ptr.get()), ptr.getCounted()); }
+template<class T, class U> inline HelioRefPtr<T> const_pointer_cast(const HelioRefPtr<U> &ptr) { return HelioRefPtr<T>(const_cast<T *>(ptr.get()), ptr.getCounted()); }
+
+#endif // /ifndef HelioRefPtr_H
@@ -58,6 +58,31 @@ void HelioScheduler::update()
     }
 }
 
+// Shortens wake delay to reach passed unix/UTC deadline, if deadline is upcoming
+static inline millis_t wakeDelayUntil(time_t deadline, time_t time, millis_t wakeDelay)
+{
+    return deadline > time && deadline - time <= (time_t)(wakeDelay / 1000) ? (millis_t)(deadline - time) * 1000 : wakeDelay;
+}
+
+millis_t HelioScheduler::getWakeDelay()
+{
+    if (!hasSchedulerData()) { return HELIO_CONTROL_LOOP_MAXSLEEP; }
+    if (needsScheduling()) { return 0; }
+
+    time_t time = unixNow();
+    millis_t wakeDelay = HELIO_CONTROL_LOOP_MAXSLEEP;
+
+    wakeDelay = wakeDelayUntil(unixTime(localDayStart(time)) + SECS_PER_DAY, time, wakeDelay);
+    wakeDelay = wakeDelayUntil(_dailyTwilight.getSunriseUnixTime(), time, wakeDelay);
+    wakeDelay = wakeDelayUntil(_dailyTwilight.getSunsetUnixTime(), time, wakeDelay);
+
+    for (auto trackingIter = _trackings.begin(); wakeDelay && trackingIter != _trackings.end(); ++trackingIter) {
+        wakeDelay = min(wakeDelay, trackingIter->second->getWakeDelay(time));
+    }
+
+    return wakeDelay;
+}
+
 void HelioScheduler::setCleaningIntervalDays(unsigned int cleaningIntDays)
 {
     HELIO_SOFT_ASSERT(hasSchedulerData(), SFP(HStr_Err_NotYetInitialized));
@@ -155,34 +180,33 @@ void HelioScheduler::performScheduling()
 {
     HELIO_HARD_ASSERT(hasSchedulerData(), SFP(HStr_Err_NotYetInitialized));
 
-    for (auto iter = Helioduino::_activeInstance->_objects.begin(); iter != Helioduino::_activeInstance->_objects.end(); ++iter) {
-        if (iter->second->isPanelType()) {
-            auto panel = static_pointer_cast<HelioPanel>(iter->second);
+    auto panels = Helioduino::_activeInstance->_objects.getPanels();
+    for (auto iter = panels.begin(); iter != panels.end(); ++iter) {
+        auto panel = static_pointer_cast<HelioPanel>(*iter);
 
-            {   auto trackingIter = _trackings.find(panel->getKey());
+        {   auto trackingIter = _trackings.find(panel->getKey());
 
-                if (linksCountTravelActuators(panel->getLinkages())) {
-                    if (trackingIter != _trackings.end()) {
-                        if (trackingIter->second) {
-                            trackingIter->second->setupStaging();
-                        }
-                    } else {
-                        #ifdef HELIO_USE_VERBOSE_OUTPUT
-                            Serial.print(F("Scheduler::performScheduling Travel actuator linkages found for: ")); Serial.print(iter->second->getId().getDisplayString());
-                            Serial.print(':'); Serial.print(' '); Serial.println(linksCountTravelActuators(panel->getLinkages())); flushYield();
-                        #endif
-
-                        HelioTracking *tracking = new HelioTracking(panel);
-                        HELIO_SOFT_ASSERT(tracking, SFP(HStr_Err_AllocationFailure));
-                        if (tracking) { _trackings[panel->getKey()] = tracking; }
+            if (linksCountTravelActuators(panel->getLinkages())) {
+                if (trackingIter != _trackings.end()) {
+                    if (trackingIter->second) {
+                        trackingIter->second->setupStaging();
                     }
-                } else if (trackingIter != _trackings.end()) { // No travel actuators to warrant process -> delete if exists
+                } else {
                     #ifdef HELIO_USE_VERBOSE_OUTPUT
-                        Serial.print(F("Scheduler::performScheduling NO travel actuator linkages found for: ")); Serial.println(iter->second->getId().getDisplayString()); flushYield();
+                        Serial.print(F("Scheduler::performScheduling Travel actuator linkages found for: ")); Serial.print(panel->getId().getDisplayString());
+                        Serial.print(':'); Serial.print(' '); Serial.println(linksCountTravelActuators(panel->getLinkages())); flushYield();
                     #endif
-                    if (trackingIter->second) { delete trackingIter->second; }
-                    _trackings.erase(trackingIter);
+
+                    HelioTracking *tracking = new HelioTracking(panel);
+                    HELIO_SOFT_ASSERT(tracking, SFP(HStr_Err_AllocationFailure));
+                    if (tracking) { _trackings[panel->getKey()] = tracking; }
                 }
+            } else if (trackingIter != _trackings.end()) { // No travel actuators to warrant process -> delete if exists
+                #ifdef HELIO_USE_VERBOSE_OUTPUT
+                    Serial.print(F("Scheduler::performScheduling NO travel actuator linkages found for: ")); Serial.println(panel->getId().getDisplayString()); flushYield();
+                #endif
+                if (trackingIter->second) { delete trackingIter->second; }
+                _trackings.erase(trackingIter);
             }
         }
     }
@@ -292,12 +316,12 @@ void HelioTracking::setupStaging()
         if (!anyMotors) { axisHorz = linksFilterTravelActuatorsByPanelAxisAndMotor<HELIO_DRV_ACTUATORS_MAXSIZE>(panel->getLinkages(), panel.get(), 0, false); }
         if (axisHorz.size()) {
             auto horzDriver = panel->getAxisDriver(0);
-            if (!horzDriver || horzDriver->isIncrementalType() != anyMotors) {
+            if (!horzDriver || horzDriver->isAbsoluteType() == anyMotors) {
                 if (anyMotors) { horzDriver = SharedPtr<HelioIncrementalDriver>(new HelioIncrementalDriver()); }
                 else { horzDriver = SharedPtr<HelioAbsoluteDriver>(new HelioAbsoluteDriver()); }
                 HELIO_SOFT_ASSERT(horzDriver, SFP(HStr_Err_AllocationFailure));
                 horzDriver->setEnabled(true);
-                panel->setAxisDriver(horzDriver, 0);
+                panel->setAxisDriver(horzDriver, 0, false);
             }
             Vector<HelioActuatorAttachment,HELIO_DRV_ACTUATORS_MAXSIZE> horzActivations;
             linksResolveActuatorsToAttachments<HELIO_DRV_ACTUATORS_MAXSIZE>(axisHorz, panel.get(), 0, horzActivations);
@@ -314,12 +338,12 @@ void HelioTracking::setupStaging()
         if (!anyMotors) { axisVert = linksFilterTravelActuatorsByPanelAxisAndMotor<HELIO_DRV_ACTUATORS_MAXSIZE>(panel->getLinkages(), panel.get(), 1, false); }
         if (axisVert.size()) {
             auto vertDriver = panel->getAxisDriver(1);
-            if (!vertDriver || vertDriver->isIncrementalType() != anyMotors) {
+            if (!vertDriver || vertDriver->isAbsoluteType() == anyMotors) {
                 if (anyMotors) { vertDriver = SharedPtr<HelioIncrementalDriver>(new HelioIncrementalDriver()); }
                 else { vertDriver = SharedPtr<HelioAbsoluteDriver>(new HelioAbsoluteDriver()); }
                 HELIO_SOFT_ASSERT(vertDriver, SFP(HStr_Err_AllocationFailure));
                 vertDriver->setEnabled(true);
-                panel->setAxisDriver(vertDriver, 1);
+                panel->setAxisDriver(vertDriver, 1, false);
             }
             Vector<HelioActuatorAttachment,HELIO_DRV_ACTUATORS_MAXSIZE> vertActivations;
             linksResolveActuatorsToAttachments<HELIO_DRV_ACTUATORS_MAXSIZE>(axisVert, panel.get(), 1, vertActivations);
@@ -335,7 +359,7 @@ void HelioTracking::setupStaging()
             bool hasMotor = false;
             for (auto obj : panelCovers) { if (((HelioActuator *)obj)->isMotorType()) { hasMotor = true; break; } }
             auto coverDriver = panel->getPanelCoverDriver();
-            if (!coverDriver || coverDriver->isIncrementalType() != hasMotor) {
+            if (!coverDriver || coverDriver->isAbsoluteType() == hasMotor) {
                 if (hasMotor) { coverDriver = SharedPtr<HelioIncrementalDriver>(new HelioIncrementalDriver()); }
                 else { coverDriver = SharedPtr<HelioAbsoluteDriver>(new HelioAbsoluteDriver()); }
                 HELIO_SOFT_ASSERT(coverDriver, SFP(HStr_Err_AllocationFailure));
@@ -399,6 +423,35 @@ void HelioTracking::setupStaging()
     #endif
 }
 
+millis_t HelioTracking::getWakeDelay(time_t time)
+{
+    millis_t wakeDelay = HELIO_CONTROL_LOOP_MAXSLEEP;
+    auto schedulerData = getScheduler()->schedulerData();
+
+    switch (stage) {
+        case Init:
+        case Uncover:
+            return 0;
+        case Cover:
+            if (panel->getPanelCoverDriver() && !panel->getPanelCoverDriver()->isAligned()) { return 0; }
+            break;
+        case Clean:
+            wakeDelay = wakeDelayUntil(stageStart + (schedulerData->preDawnCleaningMins * SECS_PER_MIN), time, wakeDelay);
+            break;
+        default:
+            break;
+    }
+
+    if (canProcessAfter) { wakeDelay = wakeDelayUntil(canProcessAfter, time, wakeDelay); }
+    if (lastEnvReport && schedulerData->reportInterval > 0) { wakeDelay = wakeDelayUntil(lastEnvReport + schedulerData->reportInterval, time, wakeDelay); }
+
+    time_t sunrise = getScheduler()->getDailyTwilight().getSunriseUnixTime();
+    wakeDelay = wakeDelayUntil(sunrise - (schedulerData->preDawnCleaningMins * SECS_PER_MIN), time, wakeDelay);
+    wakeDelay = wakeDelayUntil(sunrise - (schedulerData->preDawnHeatingMins * SECS_PER_MIN), time, wakeDelay);
+
+    return wakeDelay;
+}
+
 void HelioTracking::update()
 {
     #ifdef HELIO_USE_VERBOSE_OUTPUT
@@ -27,8 +27,10 @@ public:
     ~HelioScheduler();
 
     void update();
+    // Returns time until next scheduling deadline (day change, twilight, tracking stage timers), in milliseconds.
+    millis_t getWakeDelay();
 
-    inline void setNeedsScheduling() { _needsScheduling = hasSchedulerData(); }
+    inline void setNeedsScheduling() { _needsScheduling = hasSchedulerData(); wakeControlLoop(); }
     inline bool needsScheduling() { return _needsScheduling; }
     inline bool inDaytimeMode() const { return _inDaytimeMode; }
 
@@ -94,6 +96,8 @@ struct HelioTracking : public HelioProcess {
 
     void setupStaging();
     void update();
+    // Returns time until next stage timer/deadline for passed unix/UTC time, in milliseconds.
+    millis_t getWakeDelay(time_t time);
 
 private:
     void reset();
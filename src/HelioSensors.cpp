@@ -80,22 +80,28 @@ Helio_UnitsCategory defaultCategoryForSensor(Helio_SensorType sensorType, uint8_
 
 HelioSensor::HelioSensor(Helio_SensorType sensorType, hposi_t sensorIndex, int classTypeIn)
     : HelioObject(HelioIdentity(sensorType, sensorIndex)), classType((typeof(classType))classTypeIn),
-      _isTakingMeasure(false), _parentPanel(this), _calibrationData(nullptr)
+      _isTakingMeasure(false), _parentPanel(this), _calibrationData(nullptr), _history(nullptr),
+      _pollPolicy(Helio_PollingPolicy_Fixed), _pollFrames(1), _pollMinFrames(1), _pollMaxFrames(1), _pollThreshold(0.0f), _pollRefValue(FLT_UNDEF)
 {
     _calibrationData = getController() ? getController()->getUserCalibrationData(_id.key) : nullptr;
 }
 
 HelioSensor::HelioSensor(const HelioSensorData *dataIn)
     : HelioObject(dataIn), classType((typeof(classType))(dataIn->id.object.classType)),
-      _isTakingMeasure(false), _parentPanel(this), _calibrationData(nullptr)
+      _isTakingMeasure(false), _parentPanel(this), _calibrationData(nullptr), _history(nullptr),
+      _pollPolicy(dataIn->pollingPolicy), _pollFrames(max((uint8_t)1, dataIn->pollingFrames)), _pollMinFrames(_pollFrames),
+      _pollMaxFrames(dataIn->pollingPolicy == Helio_PollingPolicy_Adaptive ? max(_pollFrames, dataIn->pollingMaxFrames) : _pollFrames),
+      _pollThreshold(dataIn->pollingThreshold), _pollRefValue(FLT_UNDEF)
 {
     _calibrationData = getController() ? getController()->getUserCalibrationData(_id.key) : nullptr;
     _parentPanel.initObject(dataIn->panelName);
+    if (dataIn->historySize) { setMeasurementHistory(dataIn->historySize, dataIn->historyRow); }
 }
 
 HelioSensor::~HelioSensor()
 {
     _isTakingMeasure = false;
+    if (_history) { delete _history; _history = nullptr; }
 }
 
 void HelioSensor::update()
@@ -105,6 +111,11 @@ void HelioSensor::update()
     _parentPanel.resolve();
 }
 
+millis_t HelioSensor::getWakeDelay()
+{
+    return _parentPanel.needsResolved() ? 0 : HELIO_CONTROL_LOOP_MAXSLEEP; // measurements are polled by data loop
+}
+
 bool HelioSensor::isTakingMeasurement() const
 {
     return _isTakingMeasure;
@@ -145,6 +156,46 @@ HelioData *HelioSensor::allocateData() const
     return _allocateDataForObjType((int8_t)_id.type, (int8_t)classType);
 }
 
+void HelioSensor::setMeasurementHistory(uint8_t capacity, uint8_t measurementRow)
+{
+    if (_history && (!capacity || _history->getCapacity() != capacity || _history->getMeasurementRow() != measurementRow)) {
+        delete _history; _history = nullptr;
+    }
+    if (capacity && !_history) {
+        _history = new HelioMeasurementHistory(capacity, measurementRow);
+        HELIO_SOFT_ASSERT(_history, SFP(HStr_Err_AllocationFailure));
+    }
+}
+
+void HelioSensor::setPollingPolicy(Helio_PollingPolicy pollingPolicy, uint8_t intervalFrames, uint8_t maxFrames, float changeThreshold)
+{
+    HELIO_SOFT_ASSERT(pollingPolicy >= Helio_PollingPolicy_Fixed && pollingPolicy < Helio_PollingPolicy_Count, SFP(HStr_Err_InvalidParameter));
+    intervalFrames = max((uint8_t)1, intervalFrames);
+    maxFrames = pollingPolicy == Helio_PollingPolicy_Adaptive ? max(intervalFrames, maxFrames) : intervalFrames;
+
+    if (_pollPolicy != pollingPolicy || _pollMinFrames != intervalFrames || _pollMaxFrames != maxFrames || _pollThreshold != changeThreshold) {
+        _pollPolicy = pollingPolicy;
+        _pollFrames = _pollMinFrames = intervalFrames;
+        _pollMaxFrames = maxFrames;
+        _pollThreshold = changeThreshold;
+        _pollRefValue = FLT_UNDEF;
+
+        bumpRevisionIfNeeded();
+    }
+}
+
+void HelioSensor::adaptPollingFrames(const HelioMeasurement *measurement)
+{
+    float value = getAsSingleMeasurement(measurement).value;
+
+    if (_pollRefValue == FLT_UNDEF || fabsf(value - _pollRefValue) > _pollThreshold) {
+        _pollRefValue = value;
+        _pollFrames = _pollMinFrames;
+    } else if (_pollFrames < _pollMaxFrames) {
+        _pollFrames = (uint8_t)min((int)_pollMaxFrames, _pollFrames * 2);
+    }
+}
+
 void HelioSensor::saveToData(HelioData *dataOut)
 {
     HelioObject::saveToData(dataOut);
@@ -153,6 +204,14 @@ void HelioSensor::saveToData(HelioData *dataOut)
     if (_parentPanel.isSet()) {
         strncpy(((HelioSensorData *)dataOut)->panelName, _parentPanel.getKeyString().c_str(), HELIO_NAME_MAXSIZE);
     }
+    if (_history) {
+        ((HelioSensorData *)dataOut)->historySize = _history->getCapacity();
+        ((HelioSensorData *)dataOut)->historyRow = _history->getMeasurementRow();
+    }
+    ((HelioSensorData *)dataOut)->pollingPolicy = _pollPolicy;
+    ((HelioSensorData *)dataOut)->pollingFrames = _pollMinFrames;
+    ((HelioSensorData *)dataOut)->pollingMaxFrames = _pollMaxFrames;
+    ((HelioSensorData *)dataOut)->pollingThreshold = _pollThreshold;
 }
 
 
@@ -193,6 +252,7 @@ bool HelioBinarySensor::takeMeasurement(bool force)
         _lastMeasurement = HelioBinaryMeasurement(state, timestamp);
         getController()->returnPinLock(_inputPin.pin);
         _isTakingMeasure = false;
+        recordMeasurement(&_lastMeasurement);
 
         #ifdef HELIO_USE_MULTITASKING
             scheduleSignalFireOnce<const HelioMeasurement *>(getSharedPtr(), _measureSignal, &_lastMeasurement);
@@ -216,7 +276,7 @@ bool HelioBinarySensor::takeMeasurement(bool force)
 
 const HelioMeasurement *HelioBinarySensor::getMeasurement(bool poll)
 {
-    if (poll || needsPolling()) { takeMeasurement(true); }
+    if (poll || isPollingDue() || !_lastMeasurement.frame) { takeMeasurement(true); } // poll forces read, else as per polling policy
     return &_lastMeasurement;
 }
 
@@ -261,10 +321,66 @@ void HelioBinarySensor::saveToData(HelioData *dataOut)
 }
 
 
+HelioAnalogFilter::HelioAnalogFilter(uint8_t oversample, uint8_t medianSize, float emaAlpha)
+    : _oversample(1), _medianSize(1), _emaAlpha(1.0f)
+{
+    setFilter(oversample, medianSize, emaAlpha);
+}
+
+void HelioAnalogFilter::setFilter(uint8_t oversample, uint8_t medianSize, float emaAlpha)
+{
+    HELIO_SOFT_ASSERT(medianSize <= HELIO_SENSOR_MEDIAN_MAXSIZE, SFP(HStr_Err_InvalidParameter));
+    HELIO_SOFT_ASSERT(emaAlpha > 0.0f && emaAlpha <= 1.0f, SFP(HStr_Err_InvalidParameter));
+    _oversample = max((uint8_t)1, oversample);
+    _medianSize = constrain(medianSize, (uint8_t)1, (uint8_t)HELIO_SENSOR_MEDIAN_MAXSIZE) | 1; // odd-sized
+    if (_medianSize > HELIO_SENSOR_MEDIAN_MAXSIZE) { _medianSize -= 2; }
+    _emaAlpha = emaAlpha > FLT_EPSILON ? min(emaAlpha, 1.0f) : 1.0f;
+    reset();
+}
+
+void HelioAnalogFilter::reset()
+{
+    _accum = 0;
+    _accumCount = 0;
+    _medianHead = _medianCount = 0;
+    _emaValue = FLT_UNDEF;
+}
+
+float HelioAnalogFilter::filter()
+{
+    float value = _accumCount ? _accum / (float)_accumCount : 0.0f;
+    _accum = 0;
+    _accumCount = 0;
+
+    if (_medianSize > 1) {
+        _medianWindow[_medianHead] = value;
+        _medianHead = (_medianHead + 1) % _medianSize;
+        if (_medianCount < _medianSize) { _medianCount++; }
+
+        float sorted[HELIO_SENSOR_MEDIAN_MAXSIZE];
+        for (uint8_t index = 0; index < _medianCount; ++index) { // insertion sort, window is small
+            float entry = _medianWindow[index];
+            uint8_t place = index;
+            for (; place > 0 && sorted[place - 1] > entry; --place) { sorted[place] = sorted[place - 1]; }
+            sorted[place] = entry;
+        }
+        value = _medianCount & 1 ? sorted[_medianCount >> 1]
+                                 : (sorted[(_medianCount >> 1) - 1] + sorted[_medianCount >> 1]) * 0.5f;
+    }
+
+    if (_emaAlpha < 1.0f) {
+        _emaValue = _emaValue == FLT_UNDEF ? value : _emaValue + (value - _emaValue) * _emaAlpha;
+        value = _emaValue;
+    }
+
+    return value;
+}
+
+
 HelioAnalogSensor::HelioAnalogSensor(Helio_SensorType sensorType, hposi_t sensorIndex, HelioAnalogPin inputPin, bool inputInversion, int classType)
     : HelioSensor(sensorType, sensorIndex, classType),
       HelioMeasurementUnitsInterfaceStorageSingle(defaultUnitsForSensor(sensorType)),
-      _inputPin(inputPin), _inputInversion(inputInversion)
+      _inputPin(inputPin), _inputInversion(inputInversion), _filter()
 {
     HELIO_HARD_ASSERT(_inputPin.isValid(), SFP(HStr_Err_InvalidPinOrType));
     _inputPin.init();
@@ -273,81 +389,71 @@ HelioAnalogSensor::HelioAnalogSensor(Helio_SensorType sensorType, hposi_t sensor
 HelioAnalogSensor::HelioAnalogSensor(const HelioAnalogSensorData *dataIn)
     : HelioSensor(dataIn),
       HelioMeasurementUnitsInterfaceStorageSingle(definedUnitsElse(dataIn->measurementUnits, defaultUnitsForSensor((Helio_SensorType)(dataIn->id.object.objType)))),
-      _inputPin(&dataIn->inputPin), _inputInversion(dataIn->inputInversion)
+      _inputPin(&dataIn->inputPin), _inputInversion(dataIn->inputInversion),
+      _filter(dataIn->oversample, dataIn->medianSize, dataIn->emaAlpha)
 {
     HELIO_HARD_ASSERT(_inputPin.isValid(), SFP(HStr_Err_InvalidPinOrType));
     _inputPin.init();
 }
 
+HelioAnalogSensor::~HelioAnalogSensor()
+{
+    if (getController()) { getController()->withdrawAnalogSensor(this); }
+}
+
 bool HelioAnalogSensor::takeMeasurement(bool force)
 {
-    if (_inputPin.isValid() && (force || needsPolling()) && !_isTakingMeasure) {
+    if (_inputPin.isValid() && (force || needsPolling()) && !_isTakingMeasure && getController()) {
         _isTakingMeasure = true;
 
-        #ifdef HELIO_USE_MULTITASKING
-            if (isValidTask(scheduleObjectMethodCallWithTaskIdOnce(::getSharedPtr<HelioAnalogSensor>(this), &HelioAnalogSensor::_takeMeasurement))) {
+        if (getController()->requestAnalogSamples(this)) {
+            #ifdef HELIO_USE_MULTITASKING
                 return true;
-            } else {
-                HELIO_SOFT_ASSERT(false, SFP(HStr_Err_OperationFailure));
-                _isTakingMeasure = false;
-            }
-        #else
-            _takeMeasurement(0xffffU);
-        #endif
+            #endif
+        } else { // sampler asserts on actual failures, while a busy pin is simply retried on next poll
+            _filter.reset();
+            _isTakingMeasure = false;
+        }
     }
     return false;
 }
 
-void HelioAnalogSensor::_takeMeasurement(unsigned int taskId)
+bool HelioAnalogSensor::handleAnalogSample(int rawRead)
 {
-    if (_isTakingMeasure && _inputPin.isValid()) {
-        if (getController()->tryGetPinLock(_inputPin.pin, 5)) {
-            Helio_UnitsType outUnits = definedUnitsElse(getMeasurementUnits(),
-                                                        _calibrationData ? _calibrationData->calibrationUnits : Helio_UnitsType_Undefined,
-                                                        defaultUnitsForSensor(_id.objTypeAs.sensorType));
-
-            unsigned int rawRead = 0;
-            #if HELIO_SENSOR_ANALOGREAD_SAMPLES > 1
-                for (int sampleIndex = 0; sampleIndex < HELIO_SENSOR_ANALOGREAD_SAMPLES; ++sampleIndex) {
-                    #if HELIO_SENSOR_ANALOGREAD_DELAY > 0
-                        if (sampleIndex) { delay(HELIO_SENSOR_ANALOGREAD_DELAY); }
-                    #endif
-                    rawRead += _inputPin.analogRead_raw();
-                }
-                rawRead /= HELIO_SENSOR_ANALOGREAD_SAMPLES;
-            #else
-                rawRead = _inputPin.analogRead_raw();
-            #endif // /if HELIO_SENSOR_ANALOGREAD_SAMPLES > 1
-            if (_inputInversion) { rawRead = _inputPin.bitRes.maxVal - rawRead; }
-            auto timestamp = unixNow();
+    if (!_isTakingMeasure) { return true; }
+    if (_inputInversion) { rawRead = _inputPin.bitRes.maxVal - rawRead; }
+    if (!_filter.feed(rawRead)) { return false; }
 
-            HelioSingleMeasurement newMeasurement(
-                _inputPin.bitRes.transform(rawRead),
-                Helio_UnitsType_Raw_1,
-                timestamp
-            );
+    Helio_UnitsType outUnits = definedUnitsElse(getMeasurementUnits(),
+                                                _calibrationData ? _calibrationData->calibrationUnits : Helio_UnitsType_Undefined,
+                                                defaultUnitsForSensor(_id.objTypeAs.sensorType));
+    auto timestamp = unixNow();
 
-            calibrationTransform(&newMeasurement);
-            convertUnits(&newMeasurement, outUnits);
+    HelioSingleMeasurement newMeasurement(
+        constrain(_filter.filter() / (float)_inputPin.bitRes.maxVal, 0.0f, 1.0f),
+        Helio_UnitsType_Raw_1,
+        timestamp
+    );
 
-            _lastMeasurement = newMeasurement;
-            getController()->returnPinLock(_inputPin.pin);
-            _isTakingMeasure = false;
+    calibrationTransform(&newMeasurement);
+    convertUnits(&newMeasurement, outUnits);
 
-            #ifdef HELIO_USE_MULTITASKING
-                scheduleSignalFireOnce<const HelioMeasurement *>(getSharedPtr(), _measureSignal, &_lastMeasurement);
-            #else
-                _measureSignal.fire(&_lastMeasurement);
-            #endif
-        } else {
-            _isTakingMeasure = false;
-        }
-    }
+    _lastMeasurement = newMeasurement;
+    _isTakingMeasure = false;
+    recordMeasurement(&_lastMeasurement);
+
+    #ifdef HELIO_USE_MULTITASKING
+        scheduleSignalFireOnce<const HelioMeasurement *>(getSharedPtr(), _measureSignal, &_lastMeasurement);
+    #else
+        _measureSignal.fire(&_lastMeasurement);
+    #endif
+
+    return true;
 }
 
 const HelioMeasurement *HelioAnalogSensor::getMeasurement(bool poll)
 {
-    if (poll || needsPolling()) { takeMeasurement(true); }
+    if (poll || isPollingDue() || !_lastMeasurement.frame) { takeMeasurement(true); } // poll forces read, else as per polling policy
     return &_lastMeasurement;
 }
 
@@ -364,6 +470,7 @@ void HelioAnalogSensor::setMeasurementUnits(Helio_UnitsType measurementUnits, ui
         if (_lastMeasurement.isSet()) {
             convertUnits(&_lastMeasurement, _measurementUnits[0]);
         }
+        if (_history) { _history->clear(); } // prior samples are in prior units
         bumpRevisionIfNeeded();
     }
 }
@@ -380,6 +487,9 @@ void HelioAnalogSensor::saveToData(HelioData *dataOut)
     _inputPin.saveToData(&((HelioAnalogSensorData *)dataOut)->inputPin);
     ((HelioAnalogSensorData *)dataOut)->inputInversion = _inputInversion;
     ((HelioAnalogSensorData *)dataOut)->measurementUnits = getMeasurementUnits();
+    ((HelioAnalogSensorData *)dataOut)->oversample = _filter.getOversample();
+    ((HelioAnalogSensorData *)dataOut)->medianSize = _filter.getMedianSize();
+    ((HelioAnalogSensorData *)dataOut)->emaAlpha = _filter.getEMAAlpha();
 }
 
 
@@ -580,6 +690,7 @@ void HelioDHTTempHumiditySensor::_takeMeasurement(unsigned int taskId)
             _lastMeasurement = newMeasurement;
             getController()->returnPinLock(_inputPin.pin);
             _isTakingMeasure = false;
+            recordMeasurement(&_lastMeasurement);
 
             #ifdef HELIO_USE_MULTITASKING
                 scheduleSignalFireOnce<const HelioMeasurement *>(getSharedPtr(), _measureSignal, &_lastMeasurement);
@@ -594,7 +705,7 @@ void HelioDHTTempHumiditySensor::_takeMeasurement(unsigned int taskId)
 
 const HelioMeasurement *HelioDHTTempHumiditySensor::getMeasurement(bool poll)
 {
-    if (poll || needsPolling()) { takeMeasurement(true); }
+    if (poll || isPollingDue() || !_lastMeasurement.frame) { takeMeasurement(true); } // poll forces read, else as per polling policy
     return &_lastMeasurement;
 }
 
@@ -611,6 +722,7 @@ void HelioDHTTempHumiditySensor::setMeasurementUnits(Helio_UnitsType measurement
         if (_lastMeasurement.isSet()) {
             convertUnits(&_lastMeasurement.value[measurementRow], &_lastMeasurement.units[measurementRow], _measurementUnits[measurementRow]);
         }
+        if (hasMeasurementHistory(measurementRow)) { _history->clear(); } // prior samples are in prior units
         bumpRevisionIfNeeded();
     }
 }
@@ -658,9 +770,11 @@ void HelioDHTTempHumiditySensor::saveToData(HelioData *dataOut)
 
 
 HelioSensorData::HelioSensorData()
-    : HelioObjectData(), inputPin(), panelName{0}
+    : HelioObjectData(), inputPin(), panelName{0}, historySize(0), historyRow(0),
+      pollingPolicy(Helio_PollingPolicy_Fixed), pollingFrames(1), pollingMaxFrames(1), pollingThreshold(0.0f)
 {
     _size = sizeof(*this);
+    _version = 2; // v2: measurement history, polling policy, and analog filter fields
 }
 
 void HelioSensorData::toJSONObject(JsonObject &objectOut) const
@@ -672,6 +786,16 @@ void HelioSensorData::toJSONObject(JsonObject &objectOut) const
         inputPin.toJSONObject(inputPinObj);
     }
     if (panelName[0]) { objectOut[SFP(HStr_Key_PanelName)] = charsToString(panelName, HELIO_NAME_MAXSIZE); }
+    if (historySize) {
+        objectOut[SFP(HStr_Key_HistorySize)] = historySize;
+        if (historyRow > 0) { objectOut[SFP(HStr_Key_HistoryRow)] = historyRow; }
+    }
+    if (pollingPolicy > Helio_PollingPolicy_Fixed) { objectOut[SFP(HStr_Key_PollingPolicy)] = (int8_t)pollingPolicy; }
+    if (pollingFrames > 1) { objectOut[SFP(HStr_Key_PollingFrames)] = pollingFrames; }
+    if (pollingPolicy == Helio_PollingPolicy_Adaptive) {
+        objectOut[SFP(HStr_Key_PollingMaxFrames)] = pollingMaxFrames;
+        if (pollingThreshold > FLT_EPSILON) { objectOut[SFP(HStr_Key_PollingThreshold)] = pollingThreshold; }
+    }
 }
 
 void HelioSensorData::fromJSONObject(JsonObjectConst &objectIn)
@@ -682,6 +806,12 @@ void HelioSensorData::fromJSONObject(JsonObjectConst &objectIn)
     if (!inputPinObj.isNull()) { inputPin.fromJSONObject(inputPinObj); }
     const char *panelNameStr = objectIn[SFP(HStr_Key_PanelName)];
     if (panelNameStr && panelNameStr[0]) { strncpy(panelName, panelNameStr, HELIO_NAME_MAXSIZE); }
+    historySize = objectIn[SFP(HStr_Key_HistorySize)] | historySize;
+    historyRow = objectIn[SFP(HStr_Key_HistoryRow)] | historyRow;
+    pollingPolicy = (Helio_PollingPolicy)(objectIn[SFP(HStr_Key_PollingPolicy)] | (int8_t)pollingPolicy);
+    pollingFrames = objectIn[SFP(HStr_Key_PollingFrames)] | pollingFrames;
+    pollingMaxFrames = objectIn[SFP(HStr_Key_PollingMaxFrames)] | pollingMaxFrames;
+    pollingThreshold = objectIn[SFP(HStr_Key_PollingThreshold)] | pollingThreshold;
 }
 
 HelioBinarySensorData::HelioBinarySensorData()
@@ -705,7 +835,8 @@ void HelioBinarySensorData::fromJSONObject(JsonObjectConst &objectIn)
 }
 
 HelioAnalogSensorData::HelioAnalogSensorData()
-    : HelioSensorData(), inputInversion(false), measurementUnits(Helio_UnitsType_Undefined)
+    : HelioSensorData(), inputInversion(false), measurementUnits(Helio_UnitsType_Undefined),
+      oversample(HELIO_SENSOR_ANALOGREAD_SAMPLES > 1 ? HELIO_SENSOR_ANALOGREAD_SAMPLES : 1), medianSize(1), emaAlpha(1.0f)
 {
     _size = sizeof(*this);
 }
@@ -716,6 +847,9 @@ void HelioAnalogSensorData::toJSONObject(JsonObject &objectOut) const
 
     if (inputInversion != false) { objectOut[SFP(HStr_Key_InputInversion)] = inputInversion; }
     if (measurementUnits != Helio_UnitsType_Undefined) { objectOut[SFP(HStr_Key_MeasurementUnits)] = unitsTypeToSymbol(measurementUnits); }
+    if (oversample != (HELIO_SENSOR_ANALOGREAD_SAMPLES > 1 ? HELIO_SENSOR_ANALOGREAD_SAMPLES : 1)) { objectOut[SFP(HStr_Key_Oversample)] = oversample; }
+    if (medianSize > 1) { objectOut[SFP(HStr_Key_MedianSize)] = medianSize; }
+    if (emaAlpha < 1.0f) { objectOut[SFP(HStr_Key_EMAAlpha)] = emaAlpha; }
 }
 
 void HelioAnalogSensorData::fromJSONObject(JsonObjectConst &objectIn)
@@ -724,6 +858,9 @@ void HelioAnalogSensorData::fromJSONObject(JsonObjectConst &objectIn)
 
     inputInversion = objectIn[SFP(HStr_Key_InputInversion)] | inputInversion;
     measurementUnits = unitsTypeFromSymbol(objectIn[SFP(HStr_Key_MeasurementUnits)]);
+    oversample = objectIn[SFP(HStr_Key_Oversample)] | oversample;
+    medianSize = objectIn[SFP(HStr_Key_MedianSize)] | medianSize;
+    emaAlpha = objectIn[SFP(HStr_Key_EMAAlpha)] | emaAlpha;
 }
 
 
@@ -52,6 +52,7 @@ public:
     virtual ~HelioSensor();
 
     virtual void update() override;
+    virtual millis_t getWakeDelay() override;
 
     virtual bool isTakingMeasurement() const override;
 
@@ -77,16 +78,46 @@ public:
     inline Helio_SensorType getSensorType() const { return _id.objTypeAs.sensorType; }
     inline hposi_t getSensorIndex() const { return _id.posIndex; }
 
+    // Enables a rolling history of the last capacity # of measurements taken on measurementRow, or disables history if capacity is 0.
+    // Consumers, such as triggers, may then evaluate smoothed statistics of the sensor rather than its latest raw measurement.
+    void setMeasurementHistory(uint8_t capacity = HELIO_SENSOR_HISTORY_DEFSIZE, uint8_t measurementRow = 0);
+    inline const HelioMeasurementHistory *getMeasurementHistory() const { return _history; }
+    inline bool hasMeasurementHistory(uint8_t measurementRow = 0) const { return _history && _history->getMeasurementRow() == measurementRow; }
+
+    // Sets how often the data loop polls sensor, in # of polling frames. Fixed polls every intervalFrames. Adaptive polls
+    // every intervalFrames while measurement moves by more than changeThreshold (in measurement units), doubling its interval
+    // up to maxFrames while stable. OnDemand is never polled by the data loop or attachments, only when a measurement is
+    // explicitly requested (forced measurement, polled getMeasurement, or attachment flagged as needing measurement).
+    void setPollingPolicy(Helio_PollingPolicy pollingPolicy, uint8_t intervalFrames = 1, uint8_t maxFrames = HELIO_SENSOR_POLLING_MAXFRAMES, float changeThreshold = 0.0f);
+    inline Helio_PollingPolicy getPollingPolicy() const { return _pollPolicy; }
+    // Current polling interval, in # of polling frames
+    inline uint8_t getPollingFrames() const { return _pollFrames; }
+    // Returns if data loop should poll sensor this polling frame, as per polling policy
+    inline bool isPollingDue() const { return _pollPolicy != Helio_PollingPolicy_OnDemand && needsPolling(_pollFrames - 1); }
+
     Signal<const HelioMeasurement *, HELIO_SENSOR_SIGNAL_SLOTS> &getMeasurementSignal();
 
 protected:
     bool _isTakingMeasure;                                  // Taking measurement flag
     HelioAttachment _parentPanel;                           // Parent solar panel attachment
     const HelioCalibrationData *_calibrationData;           // Calibration data
+    HelioMeasurementHistory *_history;                      // Measurement history (owned), else nullptr
+    Helio_PollingPolicy _pollPolicy;                        // Polling policy
+    uint8_t _pollFrames;                                    // Current polling interval, in frames
+    uint8_t _pollMinFrames;                                 // Polling interval while changing (fixed interval if not adaptive), in frames
+    uint8_t _pollMaxFrames;                                 // Polling interval while stable, in frames
+    float _pollThreshold;                                   // Adaptive polling change threshold, in measurement units
+    float _pollRefValue;                                    // Adaptive polling reference value, else FLT_UNDEF
     Signal<const HelioMeasurement *, HELIO_SENSOR_SIGNAL_SLOTS> _measureSignal; // New measurement signal
 
     virtual HelioData *allocateData() const override;
     virtual void saveToData(HelioData *dataOut) override;
+
+    // Records new measurement into history and adapts polling interval, to be called prior to firing measurement signal
+    inline void recordMeasurement(const HelioMeasurement *measurement) { if (_history) { _history->push(getAsSingleMeasurement(measurement, _history->getMeasurementRow())); }
+                                                                         if (_pollPolicy == Helio_PollingPolicy_Adaptive) { adaptPollingFrames(measurement); } }
+    // Resets polling interval to its minimum upon measurement moving past change threshold from reference value, else backs off
+    void adaptPollingFrames(const HelioMeasurement *measurement);
 };
 
 
@@ -132,6 +163,45 @@ protected:
 };
 
 
+// Analog Sensor Filter
+// Incremental digital filter chain for raw analog reads, whose stages run in order:
+// oversample-and-decimate (averages oversample # of raw reads into one value), sliding
+// median (rejects spikes across the last medianSize decimated values), and then an EMA
+// low-pass (weighs in each new value by emaAlpha). Each stage is bypassed at 1.
+class HelioAnalogFilter {
+public:
+    HelioAnalogFilter(uint8_t oversample = (HELIO_SENSOR_ANALOGREAD_SAMPLES > 1 ? HELIO_SENSOR_ANALOGREAD_SAMPLES : 1),
+                      uint8_t medianSize = 1,
+                      float emaAlpha = 1.0f);
+
+    // Sets filter stages, resetting filter state
+    void setFilter(uint8_t oversample, uint8_t medianSize = 1, float emaAlpha = 1.0f);
+    // Resets filter state (accumulated reads and stage memory)
+    void reset();
+
+    // Feeds raw read into decimator, returning true once enough reads have been accumulated to filter
+    inline bool feed(int rawRead) { _accum += (uint32_t)max(0, rawRead); return ++_accumCount >= _oversample; }
+    // Decimates accumulated reads and passes result through median and EMA stages, returning filtered raw value
+    float filter();
+
+    inline uint8_t getOversample() const { return _oversample; }
+    inline uint8_t getMedianSize() const { return _medianSize; }
+    inline float getEMAAlpha() const { return _emaAlpha; }
+    inline uint8_t getAccumCount() const { return _accumCount; }
+
+protected:
+    uint8_t _oversample;                                    // Raw reads per decimated value
+    uint8_t _medianSize;                                    // Sliding median window size (odd)
+    float _emaAlpha;                                        // EMA weight of new value
+    uint32_t _accum;                                        // Decimator accumulator
+    uint8_t _accumCount;                                    // Decimator accumulated count
+    uint8_t _medianHead;                                    // Median window next write index
+    uint8_t _medianCount;                                   // Median window fill count
+    float _medianWindow[HELIO_SENSOR_MEDIAN_MAXSIZE];       // Median window storage
+    float _emaValue;                                        // EMA filtered value, or FLT_UNDEF if unset
+};
+
+
 // Standard Analog Sensor
 // The ever reliant master of the analogRead(), this class manages polling an analog input
 // signal and converting it into the proper figures for use. Examples include everything
@@ -145,6 +215,7 @@ public:
                       bool inputInversion = false,
                       int classType = Analog);
     HelioAnalogSensor(const HelioAnalogSensorData *dataIn);
+    virtual ~HelioAnalogSensor();
 
     virtual bool takeMeasurement(bool force = false) override;
     virtual const HelioMeasurement *getMeasurement(bool poll = false) override;
@@ -156,14 +227,22 @@ public:
     inline const HelioAnalogPin &getInputPin() const { return _inputPin; }
     inline bool getInputInversion() const { return _inputInversion; }
 
+    // Sets analog filter stages applied to raw reads (see HelioAnalogFilter)
+    inline void setFilter(uint8_t oversample, uint8_t medianSize = 1, float emaAlpha = 1.0f) { _filter.setFilter(oversample, medianSize, emaAlpha); bumpRevisionIfNeeded(); }
+    inline const HelioAnalogFilter &getFilter() const { return _filter; }
+
 protected:
     HelioAnalogPin _inputPin;                               // Analog input pin
     bool _inputInversion;                                   // Analog input inversion
+    HelioAnalogFilter _filter;                              // Analog read filter chain
     HelioSingleMeasurement _lastMeasurement;                // Latest successful measurement
 
-    void _takeMeasurement(unsigned int taskId);
+    // Feeds a raw read from analog sampler into filter, completing measurement once decimated. Returns true when no more reads are needed.
+    bool handleAnalogSample(int rawRead);
 
     virtual void saveToData(HelioData *dataOut) override;
+
+    friend class HelioAnalogSampler;
 };
 
 
@@ -249,6 +328,12 @@ protected:
 struct HelioSensorData : public HelioObjectData {
     HelioPinData inputPin;                                  // Input pin
     char panelName[HELIO_NAME_MAXSIZE];                     // Parent panel
+    uint8_t historySize;                                    // Measurement history capacity, else 0 for disabled
+    uint8_t historyRow;                                     // Measurement history row
+    Helio_PollingPolicy pollingPolicy;                      // Polling policy
+    uint8_t pollingFrames;                                  // Polling interval (while changing if adaptive), in frames
+    uint8_t pollingMaxFrames;                               // Adaptive polling interval while stable, in frames
+    float pollingThreshold;                                 // Adaptive polling change threshold, in measurement units
 
     HelioSensorData();
     virtual void toJSONObject(JsonObject &objectOut) const override;
@@ -268,6 +353,9 @@ struct HelioBinarySensorData : public HelioSensorData {
 struct HelioAnalogSensorData : public HelioSensorData {
     bool inputInversion;                                    // Input inversion flag
     Helio_UnitsType measurementUnits;                       // Measurement units
+    uint8_t oversample;                                     // Filter oversample count
+    uint8_t medianSize;                                     // Filter median window size
+    float emaAlpha;                                         // Filter EMA alpha
 
     HelioAnalogSensorData();
     virtual void toJSONObject(JsonObject &objectOut) const override;
@@ -169,10 +169,26 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Disabled[] PROGMEM = {"Disabled"};
             return flashStr_Disabled;
         } break;
+        case HStr_hlb: {
+            static const char flashStr_hlb[] PROGMEM = {"hlb"};
+            return flashStr_hlb;
+        } break;
         case HStr_raw: {
             static const char flashStr_raw[] PROGMEM = {"raw"};
             return flashStr_raw;
         } break;
+        case HStr_rld: {
+            static const char flashStr_rld[] PROGMEM = {"rld"};
+            return flashStr_rld;
+        } break;
+        case HStr_rlh: {
+            static const char flashStr_rlh[] PROGMEM = {"rlh"};
+            return flashStr_rlh;
+        } break;
+        case HStr_rlm: {
+            static const char flashStr_rlm[] PROGMEM = {"rlm"};
+            return flashStr_rlm;
+        } break;
         case HStr_txt: {
             static const char flashStr_txt[] PROGMEM = {"txt"};
             return flashStr_txt;
@@ -264,6 +280,10 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Log_CoverSequence[] PROGMEM = {" cover sequence"};
             return flashStr_Log_CoverSequence;
         } break;
+        case HStr_Log_DroppedLogs: {
+            static const char flashStr_Log_DroppedLogs[] PROGMEM = {"Dropped log records (log full or storage unavailable): "};
+            return flashStr_Log_DroppedLogs;
+        } break;
         case HStr_Log_EnvReport: {
             static const char flashStr_Log_EnvReport[] PROGMEM = {" environment report:"};
             return flashStr_Log_EnvReport;
@@ -300,6 +320,10 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Log_PreDawnWarmup[] PROGMEM = {" pre-dawn warm-up"};
             return flashStr_Log_PreDawnWarmup;
         } break;
+        case HStr_Log_RecoveredLogs: {
+            static const char flashStr_Log_RecoveredLogs[] PROGMEM = {"Recovered log records from before reset: "};
+            return flashStr_Log_RecoveredLogs;
+        } break;
         case HStr_Log_RTCBatteryFailure: {
             static const char flashStr_Log_RTCBatteryFailure[] PROGMEM = {"RTC battery failure, time needs reset."};
             return flashStr_Log_RTCBatteryFailure;
@@ -395,6 +419,10 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_ActiveLow[] PROGMEM = {"activeLow"};
             return flashStr_Key_ActiveLow;
         } break;
+        case HStr_Key_AlignedRange: {
+            static const char flashStr_Key_AlignedRange[] PROGMEM = {"alignedRange"};
+            return flashStr_Key_AlignedRange;
+        } break;
         case HStr_Key_AlignedTolerance: {
             static const char flashStr_Key_AlignedTolerance[] PROGMEM = {"alignedTolerance"};
             return flashStr_Key_AlignedTolerance;
@@ -411,6 +439,14 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_AutosaveInterval[] PROGMEM = {"autosaveInterval"};
             return flashStr_Key_AutosaveInterval;
         } break;
+        case HStr_Key_AxisDriverHorz: {
+            static const char flashStr_Key_AxisDriverHorz[] PROGMEM = {"axisDriverHorz"};
+            return flashStr_Key_AxisDriverHorz;
+        } break;
+        case HStr_Key_AxisDriverVert: {
+            static const char flashStr_Key_AxisDriverVert[] PROGMEM = {"axisDriverVert"};
+            return flashStr_Key_AxisDriverVert;
+        } break;
         case HStr_Key_AxisOffset: {
             static const char flashStr_Key_AxisOffset[] PROGMEM = {"axisOffset"};
             return flashStr_Key_AxisOffset;
@@ -443,6 +479,10 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_CleaningIntervalDays[] PROGMEM = {"cleaningIntervalDays"};
             return flashStr_Key_CleaningIntervalDays;
         } break;
+        case HStr_Key_Columns: {
+            static const char flashStr_Key_Columns[] PROGMEM = {"columns"};
+            return flashStr_Key_Columns;
+        } break;
         case HStr_Key_ComputeHeatIndex: {
             static const char flashStr_Key_ComputeHeatIndex[] PROGMEM = {"computeHeatIndex"};
             return flashStr_Key_ComputeHeatIndex;
@@ -463,10 +503,18 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_DailyLightHours[] PROGMEM = {"dailyLightHours"};
             return flashStr_Key_DailyLightHours;
         } break;
+        case HStr_Key_Data: {
+            static const char flashStr_Key_Data[] PROGMEM = {"data"};
+            return flashStr_Key_Data;
+        } break;
         case HStr_Key_DataFilePrefix: {
             static const char flashStr_Key_DataFilePrefix[] PROGMEM = {"dataFilePrefix"};
             return flashStr_Key_DataFilePrefix;
         } break;
+        case HStr_Key_DerivativeFilter: {
+            static const char flashStr_Key_DerivativeFilter[] PROGMEM = {"derivativeFilter"};
+            return flashStr_Key_DerivativeFilter;
+        } break;
         case HStr_Key_DetriggerDelay: {
             static const char flashStr_Key_DetriggerDelay[] PROGMEM = {"detriggerDelay"};
             return flashStr_Key_DetriggerDelay;
@@ -495,6 +543,10 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_EnableMode[] PROGMEM = {"enableMode"};
             return flashStr_Key_EnableMode;
         } break;
+        case HStr_Key_EMAAlpha: {
+            static const char flashStr_Key_EMAAlpha[] PROGMEM = {"emaAlpha"};
+            return flashStr_Key_EMAAlpha;
+        } break;
         case HStr_Key_Flags: {
             static const char flashStr_Key_Flags[] PROGMEM = {"flags"};
             return flashStr_Key_Flags;
@@ -503,6 +555,14 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_HeatingTrigger[] PROGMEM = {"heatingTrigger"};
             return flashStr_Key_HeatingTrigger;
         } break;
+        case HStr_Key_HistoryRow: {
+            static const char flashStr_Key_HistoryRow[] PROGMEM = {"historyRow"};
+            return flashStr_Key_HistoryRow;
+        } break;
+        case HStr_Key_HistorySize: {
+            static const char flashStr_Key_HistorySize[] PROGMEM = {"historySize"};
+            return flashStr_Key_HistorySize;
+        } break;
         case HStr_Key_HomePosition: {
             static const char flashStr_Key_HomePosition[] PROGMEM = {"homePosition"};
             return flashStr_Key_HomePosition;
@@ -559,6 +619,10 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_LocationOffset[] PROGMEM = {"locationOffset"};
             return flashStr_Key_LocationOffset;
         } break;
+        case HStr_Key_LogBinary: {
+            static const char flashStr_Key_LogBinary[] PROGMEM = {"logBinary"};
+            return flashStr_Key_LogBinary;
+        } break;
         case HStr_Key_LogFilePrefix: {
             static const char flashStr_Key_LogFilePrefix[] PROGMEM = {"logFilePrefix"};
             return flashStr_Key_LogFilePrefix;
@@ -587,6 +651,10 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_MaxActiveAtOnce[] PROGMEM = {"maxActiveAtOnce"};
             return flashStr_Key_MaxActiveAtOnce;
         } break;
+        case HStr_Key_MaxDifference: {
+            static const char flashStr_Key_MaxDifference[] PROGMEM = {"maxDifference"};
+            return flashStr_Key_MaxDifference;
+        } break;
         case HStr_Key_MaxPower: {
             static const char flashStr_Key_MaxPower[] PROGMEM = {"maxPower"};
             return flashStr_Key_MaxPower;
@@ -603,6 +671,10 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_MeasurementUnits[] PROGMEM = {"measurementUnits"};
             return flashStr_Key_MeasurementUnits;
         } break;
+        case HStr_Key_MedianSize: {
+            static const char flashStr_Key_MedianSize[] PROGMEM = {"medianSize"};
+            return flashStr_Key_MedianSize;
+        } break;
         case HStr_Key_MinIntensity: {
             static const char flashStr_Key_MinIntensity[] PROGMEM = {"minIntensity"};
             return flashStr_Key_MinIntensity;
@@ -611,14 +683,30 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_Mode[] PROGMEM = {"mode"};
             return flashStr_Key_Mode;
         } break;
+        case HStr_Key_MQTTCoalesceFrames: {
+            static const char flashStr_Key_MQTTCoalesceFrames[] PROGMEM = {"mqttCoalesceFrames"};
+            return flashStr_Key_MQTTCoalesceFrames;
+        } break;
+        case HStr_Key_MQTTPublishMode: {
+            static const char flashStr_Key_MQTTPublishMode[] PROGMEM = {"mqttPublishMode"};
+            return flashStr_Key_MQTTPublishMode;
+        } break;
         case HStr_Key_Multiplier: {
             static const char flashStr_Key_Multiplier[] PROGMEM = {"multiplier"};
             return flashStr_Key_Multiplier;
         } break;
+        case HStr_Key_NearbyRange: {
+            static const char flashStr_Key_NearbyRange[] PROGMEM = {"nearbyRange"};
+            return flashStr_Key_NearbyRange;
+        } break;
         case HStr_Key_Offset: {
             static const char flashStr_Key_Offset[] PROGMEM = {"offset"};
             return flashStr_Key_Offset;
         } break;
+        case HStr_Key_OutputDeadband: {
+            static const char flashStr_Key_OutputDeadband[] PROGMEM = {"outputDeadband"};
+            return flashStr_Key_OutputDeadband;
+        } break;
         case HStr_Key_OutputPin: {
             static const char flashStr_Key_OutputPin[] PROGMEM = {"outputPin"};
             return flashStr_Key_OutputPin;
@@ -627,18 +715,42 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_OutputPin2[] PROGMEM = {"outputPin2"};
             return flashStr_Key_OutputPin2;
         } break;
+        case HStr_Key_Oversample: {
+            static const char flashStr_Key_Oversample[] PROGMEM = {"oversample"};
+            return flashStr_Key_Oversample;
+        } break;
         case HStr_Key_PanelName: {
             static const char flashStr_Key_PanelName[] PROGMEM = {"panelName"};
             return flashStr_Key_PanelName;
         } break;
+        case HStr_Key_PIDGains: {
+            static const char flashStr_Key_PIDGains[] PROGMEM = {"pidGains"};
+            return flashStr_Key_PIDGains;
+        } break;
         case HStr_Key_Pin: {
             static const char flashStr_Key_Pin[] PROGMEM = {"pin"};
             return flashStr_Key_Pin;
         } break;
+        case HStr_Key_PollingFrames: {
+            static const char flashStr_Key_PollingFrames[] PROGMEM = {"pollingFrames"};
+            return flashStr_Key_PollingFrames;
+        } break;
         case HStr_Key_PollingInterval: {
             static const char flashStr_Key_PollingInterval[] PROGMEM = {"pollingInterval"};
             return flashStr_Key_PollingInterval;
         } break;
+        case HStr_Key_PollingMaxFrames: {
+            static const char flashStr_Key_PollingMaxFrames[] PROGMEM = {"pollingMaxFrames"};
+            return flashStr_Key_PollingMaxFrames;
+        } break;
+        case HStr_Key_PollingPolicy: {
+            static const char flashStr_Key_PollingPolicy[] PROGMEM = {"pollingPolicy"};
+            return flashStr_Key_PollingPolicy;
+        } break;
+        case HStr_Key_PollingThreshold: {
+            static const char flashStr_Key_PollingThreshold[] PROGMEM = {"pollingThreshold"};
+            return flashStr_Key_PollingThreshold;
+        } break;
         case HStr_Key_PositionSensor: {
             static const char flashStr_Key_PositionSensor[] PROGMEM = {"positionSensor"};
             return flashStr_Key_PositionSensor;
@@ -663,6 +775,10 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_PreDawnHeatingMins[] PROGMEM = {"preDawnHeatingMins"};
             return flashStr_Key_PreDawnHeatingMins;
         } break;
+        case HStr_Key_PublishBinary: {
+            static const char flashStr_Key_PublishBinary[] PROGMEM = {"publishBinary"};
+            return flashStr_Key_PublishBinary;
+        } break;
         case HStr_Key_PublishToSDCard: {
             static const char flashStr_Key_PublishToSDCard[] PROGMEM = {"pubToSDCard"};
             return flashStr_Key_PublishToSDCard;
@@ -699,6 +815,10 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_Revision[] PROGMEM = {"revision"};
             return flashStr_Key_Revision;
         } break;
+        case HStr_Key_RollupPeriods: {
+            static const char flashStr_Key_RollupPeriods[] PROGMEM = {"rollupPeriods"};
+            return flashStr_Key_RollupPeriods;
+        } break;
         case HStr_Key_Scheduler: {
             static const char flashStr_Key_Scheduler[] PROGMEM = {"scheduler"};
             return flashStr_Key_Scheduler;
@@ -715,10 +835,18 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_State[] PROGMEM = {"state"};
             return flashStr_Key_State;
         } break;
+        case HStr_Key_Statistic: {
+            static const char flashStr_Key_Statistic[] PROGMEM = {"statistic"};
+            return flashStr_Key_Statistic;
+        } break;
         case HStr_Key_StormingTrigger: {
             static const char flashStr_Key_StormingTrigger[] PROGMEM = {"stormingTrigger"};
             return flashStr_Key_StormingTrigger;
         } break;
+        case HStr_Key_SyncGain: {
+            static const char flashStr_Key_SyncGain[] PROGMEM = {"syncGain"};
+            return flashStr_Key_SyncGain;
+        } break;
         case HStr_Key_SystemMode: {
             static const char flashStr_Key_SystemMode[] PROGMEM = {"systemMode"};
             return flashStr_Key_SystemMode;
@@ -755,6 +883,10 @@ const char *pgmAddrForStr(Helio_String strNum)
             static const char flashStr_Key_ToleranceLow[] PROGMEM = {"toleranceLow"};
             return flashStr_Key_ToleranceLow;
         } break;
+        case HStr_Key_TravelRate: {
+            static const char flashStr_Key_TravelRate[] PROGMEM = {"travelRate"};
+            return flashStr_Key_TravelRate;
+        } break;
         case HStr_Key_TriggerBelow: {
             static const char flashStr_Key_TriggerBelow[] PROGMEM = {"triggerBelow"};
             return flashStr_Key_TriggerBelow;
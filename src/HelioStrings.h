@@ -13,7 +13,11 @@ enum Helio_String : unsigned short {
     HStr_csv,
     HStr_dat,
     HStr_Disabled,
+    HStr_hlb,
     HStr_raw,
+    HStr_rld,
+    HStr_rlh,
+    HStr_rlm,
     HStr_txt,
     HStr_Undefined,
     HStr_null,
@@ -39,6 +43,7 @@ enum Helio_String : unsigned short {
 
     HStr_Log_CalculatedTravel,
     HStr_Log_CoverSequence,
+    HStr_Log_DroppedLogs,
     HStr_Log_EnvReport,
     HStr_Log_HasBegan,
     HStr_Log_HasDisabled,
@@ -48,6 +53,7 @@ enum Helio_String : unsigned short {
     HStr_Log_NightSequence,
     HStr_Log_PreDawnCleaning,
     HStr_Log_PreDawnWarmup,
+    HStr_Log_RecoveredLogs,
     HStr_Log_RTCBatteryFailure,
     HStr_Log_StormingSequence,
     HStr_Log_SystemDataSaved,
@@ -74,10 +80,13 @@ enum Helio_String : unsigned short {
     HStr_Log_Field_WindSpeed_Measured,
 
     HStr_Key_ActiveLow,
+    HStr_Key_AlignedRange,
     HStr_Key_AlignedTolerance,
     HStr_Key_AutosaveEnabled,
     HStr_Key_AutosaveFallback,
     HStr_Key_AutosaveInterval,
+    HStr_Key_AxisDriverHorz,
+    HStr_Key_AxisDriverVert,
     HStr_Key_AxisOffset,
     HStr_Key_AxisPosition,
     HStr_Key_AxisSensorHorz,
@@ -86,12 +95,15 @@ enum Helio_String : unsigned short {
     HStr_Key_CalibrationUnits,
     HStr_Key_Channel,
     HStr_Key_CleaningIntervalDays,
+    HStr_Key_Columns,
     HStr_Key_ComputeHeatIndex,
     HStr_Key_ContinuousPowerUsage,
     HStr_Key_ContinuousSpeed,
     HStr_Key_CtrlInMode,
     HStr_Key_DailyLightHours,
+    HStr_Key_Data,
     HStr_Key_DataFilePrefix,
+    HStr_Key_DerivativeFilter,
     HStr_Key_DetriggerDelay,
     HStr_Key_DetriggerTol,
     HStr_Key_DHTType,
@@ -99,8 +111,11 @@ enum Helio_String : unsigned short {
     HStr_Key_DispOutMode,
     HStr_Key_DistanceUnits,
     HStr_Key_EnableMode,
+    HStr_Key_EMAAlpha,
     HStr_Key_Flags,
     HStr_Key_HeatingTrigger,
+    HStr_Key_HistoryRow,
+    HStr_Key_HistorySize,
     HStr_Key_HomePosition,
     HStr_Key_Id,
     HStr_Key_InputInversion,
@@ -115,6 +130,7 @@ enum Helio_String : unsigned short {
     HStr_Key_LimitTrigger,
     HStr_Key_Location,
     HStr_Key_LocationOffset,
+    HStr_Key_LogBinary,
     HStr_Key_LogFilePrefix,
     HStr_Key_LogLevel,
     HStr_Key_LogToSDCard,
@@ -122,25 +138,38 @@ enum Helio_String : unsigned short {
     HStr_Key_Logger,
     HStr_Key_MACAddress,
     HStr_Key_MaxActiveAtOnce,
+    HStr_Key_MaxDifference,
     HStr_Key_MaxPower,
     HStr_Key_MeasureMode,
     HStr_Key_MeasurementRow,
     HStr_Key_MeasurementUnits,
+    HStr_Key_MedianSize,
     HStr_Key_MinIntensity,
     HStr_Key_Mode,
+    HStr_Key_MQTTCoalesceFrames,
+    HStr_Key_MQTTPublishMode,
     HStr_Key_Multiplier,
+    HStr_Key_NearbyRange,
     HStr_Key_Offset,
+    HStr_Key_OutputDeadband,
     HStr_Key_OutputPin,
     HStr_Key_OutputPin2,
+    HStr_Key_Oversample,
     HStr_Key_PanelName,
+    HStr_Key_PIDGains,
     HStr_Key_Pin,
+    HStr_Key_PollingFrames,
     HStr_Key_PollingInterval,
+    HStr_Key_PollingMaxFrames,
+    HStr_Key_PollingPolicy,
+    HStr_Key_PollingThreshold,
     HStr_Key_PositionSensor,
     HStr_Key_PowerProductionSensor,
     HStr_Key_PowerUsageSensor,
     HStr_Key_PowerUnits,
     HStr_Key_PreDawnCleaningMins,
     HStr_Key_PreDawnHeatingMins,
+    HStr_Key_PublishBinary,
     HStr_Key_PublishToSDCard,
     HStr_Key_PublishToWiFiStorage,
     HStr_Key_Publisher,
@@ -150,11 +179,14 @@ enum Helio_String : unsigned short {
     HStr_Key_ReflectPosition,
     HStr_Key_ReportInterval,
     HStr_Key_Revision,
+    HStr_Key_RollupPeriods,
     HStr_Key_Scheduler,
     HStr_Key_SensorName,
     HStr_Key_SpeedSensor,
     HStr_Key_State,
+    HStr_Key_Statistic,
     HStr_Key_StormingTrigger,
+    HStr_Key_SyncGain,
     HStr_Key_SystemMode,
     HStr_Key_SystemName,
     HStr_Key_TemperatureUnits,
@@ -164,6 +196,7 @@ enum Helio_String : unsigned short {
     HStr_Key_Tolerance,
     HStr_Key_ToleranceHigh,
     HStr_Key_ToleranceLow,
+    HStr_Key_TravelRate,
     HStr_Key_TriggerBelow,
     HStr_Key_TriggerOutside,
     HStr_Key_Type,
@@ -27,7 +27,7 @@ HelioTrigger *newTriggerObjectFromSubData(const HelioTriggerSubData *dataIn)
 
 HelioTrigger::HelioTrigger(HelioIdentity sensorId, uint8_t measurementRow, float detriggerTol, millis_t detriggerDelay, int typeIn)
     : type((typeof(type))typeIn), _sensor(this), _detriggerTol(detriggerTol), _detriggerDelay(detriggerDelay),
-      _lastTrigger(0), _triggerState(Helio_TriggerState_Disabled)
+      _lastTrigger(0), _triggerState(Helio_TriggerState_Disabled), _measureStat(Helio_MeasurementStat_Latest)
 {
     _sensor.setMeasurementRow(measurementRow);
     _sensor.initObject(sensorId);
@@ -35,7 +35,7 @@ HelioTrigger::HelioTrigger(HelioIdentity sensorId, uint8_t measurementRow, float
 
 HelioTrigger::HelioTrigger(SharedPtr<HelioSensor> sensor, uint8_t measurementRow, float detriggerTol, millis_t detriggerDelay, int typeIn)
     : type((typeof(type))typeIn), _sensor(this), _detriggerTol(detriggerTol), _detriggerDelay(detriggerDelay),
-      _lastTrigger(0), _triggerState(Helio_TriggerState_Disabled)
+      _lastTrigger(0), _triggerState(Helio_TriggerState_Disabled), _measureStat(Helio_MeasurementStat_Latest)
 {
     _sensor.setMeasurementRow(measurementRow);
     _sensor.initObject(sensor);
@@ -43,7 +43,7 @@ HelioTrigger::HelioTrigger(SharedPtr<HelioSensor> sensor, uint8_t measurementRow
 
 HelioTrigger::HelioTrigger(const HelioTriggerSubData *dataIn)
     : type((typeof(type))(dataIn->type)), _sensor(this), _lastTrigger(0), _triggerState(Helio_TriggerState_Disabled),
-      _detriggerTol(dataIn->detriggerTol), _detriggerDelay(dataIn->detriggerDelay)
+      _detriggerTol(dataIn->detriggerTol), _detriggerDelay(dataIn->detriggerDelay), _measureStat(dataIn->measurementStat)
 {
     _sensor.setMeasurementRow(dataIn->measurementRow);
     _sensor.setMeasurementUnits(dataIn->measurementUnits);
@@ -60,6 +60,19 @@ void HelioTrigger::saveToData(HelioTriggerSubData *dataOut) const
     ((HelioTriggerSubData *)dataOut)->measurementUnits = getMeasurementUnits();
     ((HelioTriggerSubData *)dataOut)->detriggerTol = _detriggerTol;
     ((HelioTriggerSubData *)dataOut)->detriggerDelay = _detriggerDelay;
+    ((HelioTriggerSubData *)dataOut)->measurementStat = _measureStat;
+}
+
+HelioSingleMeasurement HelioTrigger::getAsStatMeasurement(const HelioMeasurement *measurement)
+{
+    auto measure = getAsSingleMeasurement(measurement, getMeasurementRow());
+    if (_measureStat > Helio_MeasurementStat_Latest) {
+        auto sensor = _sensor.get();
+        if (sensor && sensor->hasMeasurementHistory(getMeasurementRow())) {
+            measure.value = sensor->getMeasurementHistory()->getStatistic(_measureStat);
+        }
+    }
+    return measure;
 }
 
 void HelioTrigger::update()
@@ -146,7 +159,7 @@ void HelioMeasurementValueTrigger::handleMeasurement(const HelioMeasurement *mea
             nextState = ((HelioBinaryMeasurement *)measurement)->state != _triggerBelow;
             _sensor.setMeasurement(getAsSingleMeasurement(measurement, getMeasurementRow()));
         } else {
-            auto measure = getAsSingleMeasurement(measurement, getMeasurementRow());
+            auto measure = getAsStatMeasurement(measurement);
             convertUnits(&measure, getMeasurementUnits(), getMeasurementConvertParam());
             _sensor.setMeasurement(measure);
 
@@ -169,6 +182,7 @@ void HelioMeasurementValueTrigger::handleMeasurement(const HelioMeasurement *mea
             #else
                 _triggerSignal.fire(_triggerState);
             #endif
+            wakeControlLoop();
         }
     }
 }
@@ -225,7 +239,7 @@ void HelioMeasurementRangeTrigger::handleMeasurement(const HelioMeasurement *mea
         bool wasState = triggerStateToBool(_triggerState);
         bool nextState = wasState;
 
-        auto measure = getAsSingleMeasurement(measurement, getMeasurementRow());
+        auto measure = getAsStatMeasurement(measurement);
         convertUnits(&measure, getMeasurementUnits(), getMeasurementConvertParam());
         _sensor.setMeasurement(measure);
 
@@ -253,6 +267,7 @@ void HelioMeasurementRangeTrigger::handleMeasurement(const HelioMeasurement *mea
             #else
                 _triggerSignal.fire(_triggerState);
             #endif
+            wakeControlLoop();
         }
     }
 }
@@ -260,7 +275,7 @@ void HelioMeasurementRangeTrigger::handleMeasurement(const HelioMeasurement *mea
 
 HelioTriggerSubData::HelioTriggerSubData()
     : HelioSubData(), sensorName{0}, measurementRow(0), dataAs{.measureRange={0.0f,0.0f,false}},
-      detriggerTol(0), detriggerDelay(0), measurementUnits(Helio_UnitsType_Undefined)
+      detriggerTol(0), detriggerDelay(0), measurementStat(Helio_MeasurementStat_Latest), measurementUnits(Helio_UnitsType_Undefined)
 { ; }
 
 void HelioTriggerSubData::toJSONObject(JsonObject &objectOut) const
@@ -283,6 +298,7 @@ void HelioTriggerSubData::toJSONObject(JsonObject &objectOut) const
     }
     if (detriggerTol > FLT_EPSILON) { objectOut[SFP(HStr_Key_DetriggerTol)] = detriggerTol; }
     if (detriggerDelay > 0) { objectOut[SFP(HStr_Key_DetriggerDelay)] = detriggerDelay; }
+    if (measurementStat > Helio_MeasurementStat_Latest) { objectOut[SFP(HStr_Key_Statistic)] = (int8_t)measurementStat; }
     if (measurementUnits != Helio_UnitsType_Undefined) { objectOut[SFP(HStr_Key_MeasurementUnits)] = unitsTypeToSymbol(measurementUnits); }
 }
 
@@ -307,5 +323,6 @@ void HelioTriggerSubData::fromJSONObject(JsonObjectConst &objectIn)
     }
     detriggerTol = objectIn[SFP(HStr_Key_DetriggerTol)] | detriggerTol;
     detriggerDelay = objectIn[SFP(HStr_Key_DetriggerDelay)] | detriggerDelay;
+    measurementStat = (Helio_MeasurementStat)(objectIn[SFP(HStr_Key_Statistic)] | (int8_t)measurementStat);
     measurementUnits = unitsTypeFromSymbol(objectIn[SFP(HStr_Key_MeasurementUnits)]);
 }
@@ -57,9 +57,16 @@ public:
     inline uint8_t getMeasurementRow() const { return _sensor.getMeasurementRow(); }
     inline float getMeasurementConvertParam() const { return _sensor.getMeasurementConvertParam(); }
 
+    // Sets which statistic of the sensor's measurement history is compared in place of the latest measurement.
+    // Requires the sensor to have measurement history enabled on the same measurement row, else uses latest.
+    inline void setMeasurementStat(Helio_MeasurementStat measurementStat) { if (_measureStat != measurementStat) { _measureStat = measurementStat; bumpRevisionIfNeeded(); } }
+    inline Helio_MeasurementStat getMeasurementStat() const { return _measureStat; }
+
     inline float getDetriggerTolerance() const { return _detriggerTol; }
     inline millis_t getDetriggerDelay() const { return _detriggerDelay; }
     inline bool isDetriggerDelayActive() const { return _lastTrigger; }
+    // Time left, in milliseconds, until de-trigger delay is met, else 0 if inactive/met
+    inline millis_t getDetriggerDelayLeft(millis_t time = nzMillis()) const { return isDetriggerDelayActive() && time - _lastTrigger < _detriggerDelay ? _detriggerDelay - (time - _lastTrigger) : 0; }
 
     virtual HelioSensorAttachment &getSensorAttachment() override;
 
@@ -71,9 +78,13 @@ protected:
     millis_t _detriggerDelay;                               // De-trigger timing delay, in milliseconds
     millis_t _lastTrigger;                                  // Last trigger millis, set to 0 when de-trigger delay met
     Helio_TriggerState _triggerState;                       // Trigger state (last handled)
+    Helio_MeasurementStat _measureStat;                     // Measurement history statistic compared
     Signal<Helio_TriggerState, HELIO_TRIGGER_SIGNAL_SLOTS> _triggerSignal; // Trigger signal
 
     virtual void handleMeasurement(const HelioMeasurement *measurement) = 0;
+
+    // Gets single measurement from measurement, with its value replaced by measurement stat of sensor's history when available
+    HelioSingleMeasurement getAsStatMeasurement(const HelioMeasurement *measurement);
 };
 
 
@@ -177,6 +188,7 @@ struct HelioTriggerSubData : public HelioSubData {
     } dataAs;                                               // Data type union
     float detriggerTol;                                     // De-trigger tolerance
     millis_t detriggerDelay;                                // De-trigger delay millis
+    Helio_MeasurementStat measurementStat;                  // Measurement history statistic
     Helio_UnitsType measurementUnits;                       // Measurement units
 
     HelioTriggerSubData();
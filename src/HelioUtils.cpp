@@ -140,10 +140,14 @@ bool _setUnixTime(DateTime unixTime)
 
 String getYYMMDDFilename(String prefix, String ext)
 {
-    DateTime currTime = localNow();
-    uint8_t yy = currTime.year() % 100;
-    uint8_t mm = currTime.month();
-    uint8_t dd = currTime.day();
+    return getYYMMDDFilename(prefix, ext, localNow());
+}
+
+String getYYMMDDFilename(String prefix, String ext, DateTime localDate)
+{
+    uint8_t yy = localDate.year() % 100;
+    uint8_t mm = localDate.month();
+    uint8_t dd = localDate.day();
 
     String retVal; retVal.reserve(prefix.length() + 10 + 1);
 
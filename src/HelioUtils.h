@@ -152,6 +152,9 @@ inline HelioScheduler *getScheduler();
 inline HelioLogger *getLogger();
 // Returns the active publisher instance. Not guaranteed to be non-null.
 inline HelioPublisher *getPublisher();
+// Wakes main control loop from any sleep, forcing object updates upon next control loop tick.
+// Called by event sources whose changes may shorten object wake deadlines (see HelioObject::getWakeDelay()).
+inline void wakeControlLoop();
 #ifdef HELIO_USE_GUI
 // Returns the active UI instance. Not guaranteed to be non-null.
 inline HelioUIInterface *getUI();
@@ -177,6 +180,8 @@ inline bool setLocalTime(DateTime localTime);
 
 // Returns a proper filename for a storage monitoring file (log, data, etc) that uses YYMMDD as filename.
 extern String getYYMMDDFilename(String prefix, String ext);
+// Returns a proper filename for a storage monitoring file (log, data, etc) that uses YYMMDD of passed local date as filename.
+extern String getYYMMDDFilename(String prefix, String ext, DateTime localDate);
 // Returns a proper filename for a storage library data file that uses ## as filename.
 extern String getNNFilename(String prefix, unsigned int value, String ext);
 
@@ -325,6 +325,11 @@ inline Helioduino *getController()
     return Helioduino::_activeInstance;
 }
 
+inline void wakeControlLoop()
+{
+    if (Helioduino::_activeInstance) { Helioduino::_activeInstance->_controlWakeDelay = 0; }
+}
+
 inline HelioScheduler *getScheduler()
 {
     return Helioduino::_activeInstance ? &Helioduino::_activeInstance->scheduler : nullptr;
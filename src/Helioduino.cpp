@@ -14,13 +14,12 @@ time_t rtcNow() {
 void handleInterrupt(pintype_t pin)
 {
     if (Helioduino::_activeInstance) {
-        for (auto iter = Helioduino::_activeInstance->_objects.begin(); iter != Helioduino::_activeInstance->_objects.end(); ++iter) {
-            if (iter->second->isSensorType()) {
-                auto sensor = static_pointer_cast<HelioSensor>(iter->second);
-                if (sensor->isBinaryClass()) {
-                    auto binarySensor = static_pointer_cast<HelioBinarySensor>(sensor);
-                    if (binarySensor && binarySensor->getInputPin().pin == pin) { binarySensor->notifyISRTriggered(); }
-                }
+        auto sensors = Helioduino::_activeInstance->_objects.getSensors();
+        for (auto iter = sensors.begin(); iter != sensors.end(); ++iter) {
+            auto sensor = static_pointer_cast<HelioSensor>(*iter);
+            if (sensor->isBinaryClass()) {
+                auto binarySensor = static_pointer_cast<HelioBinarySensor>(sensor);
+                if (binarySensor && binarySensor->getInputPin().pin == pin) { binarySensor->notifyISRTriggered(); }
             }
         }
 
@@ -73,7 +72,7 @@ Helioduino::Helioduino(pintype_t piezoBuzzerPin,
 #ifdef HELIO_USE_MULTITASKING
       _controlTaskId(TASKMGR_INVALIDID), _dataTaskId(TASKMGR_INVALIDID), _miscTaskId(TASKMGR_INVALIDID),
 #endif
-      _systemData(nullptr), _suspend(true), _pollingFrame(0), _lastSpaceCheck(0), _lastAutosave(0),
+      _systemData(nullptr), _suspend(true), _controlWakeStart(0), _controlWakeDelay(0), _pollingFrame(0), _lastSpaceCheck(0), _lastAutosave(0),
       _sysConfigFilename(SFP(HStr_Default_ConfigFilename)), _sysDataAddress(-1)
 {
     _activeInstance = this;
@@ -87,7 +86,7 @@ Helioduino::~Helioduino()
     if (_uiData) { delete _uiData; _uiData = nullptr; }
 #endif
     deactivatePinMuxers();
-    while (_objects.size()) { _objects.erase(_objects.begin()); }
+    _objects.clear();
     while (_pinOneWire.size()) { dropOneWireForPin(_pinOneWire.begin()->first); }
     while (_pinMuxers.size()) { _pinMuxers.erase(_pinMuxers.begin()); }
 #ifdef HELIO_USE_MULTITASKING
@@ -398,7 +397,7 @@ bool Helioduino::initFromJSONStream(Stream *streamIn)
 
         if (_systemData) {
             while (streamIn->available()) {
-                StaticJsonDocument<HELIO_JSON_DOC_DEFSIZE> doc;
+                StaticJsonDocument<HELIO_JSON_DOC_DRVSIZE> doc; // object data may embed driver data
                 deserializeJson(doc, *streamIn);
                 JsonObjectConst dataObj = doc.as<JsonObjectConst>();
                 HelioData *data = newDataFromJSONObject(dataObj);
@@ -417,7 +416,7 @@ bool Helioduino::initFromJSONStream(Stream *streamIn)
                     delete data; data = nullptr;
 
                     if (obj && !obj->isUnknownType()) {
-                        _objects[obj->getKey()] = SharedPtr<HelioObject>(obj);
+                        _objects.insert(SharedPtr<HelioObject>(obj));
                     } else {
                         HELIO_SOFT_ASSERT(false, SFP(HStr_Err_ImportFailure));
                         if (obj) { delete obj; }
@@ -440,6 +439,18 @@ bool Helioduino::initFromJSONStream(Stream *streamIn)
     return false;
 }
 
+// Serializes object data into a JSON document sized to docSize, returning success
+template<size_t docSize>
+static bool serializeObjectData(const HelioData *data, Stream *streamOut, bool compact)
+{
+    StaticJsonDocument<docSize> doc;
+
+    JsonObject objectDataObj = doc.to<JsonObject>();
+    data->toJSONObject(objectDataObj);
+
+    return compact ? serializeJson(doc, *streamOut) : serializeJsonPretty(doc, *streamOut);
+}
+
 bool Helioduino::saveToJSONStream(Stream *streamOut, bool compact)
 {
     HELIO_HARD_ASSERT(_systemData, SFP(HStr_Err_NotYetInitialized));
@@ -485,17 +496,16 @@ bool Helioduino::saveToJSONStream(Stream *streamOut, bool compact)
 
         if (_objects.size()) {
             for (auto iter = _objects.begin(); iter != _objects.end(); ++iter) {
-                HelioData *data = iter->second->newSaveData();
+                HelioData *data = (*iter)->newSaveData();
 
                 HELIO_SOFT_ASSERT(data && data->isObjectData(), SFP(HStr_Err_AllocationFailure));
                 if (data && data->isObjectData()) {
-                    StaticJsonDocument<HELIO_JSON_DOC_DEFSIZE> doc;
-
-                    JsonObject objectDataObj = doc.to<JsonObject>();
-                    data->toJSONObject(objectDataObj);
+                    bool serialized = data->id.object.idType == (hid_t)HelioIdentity::Panel && ((HelioPanelData *)data)->hasAxisDriverData()
+                                      ? serializeObjectData<HELIO_JSON_DOC_DRVSIZE>(data, streamOut, compact)
+                                      : serializeObjectData<HELIO_JSON_DOC_DEFSIZE>(data, streamOut, compact);
                     delete data; data = nullptr;
 
-                    if (!(compact ? serializeJson(doc, *streamOut) : serializeJsonPretty(doc, *streamOut))) {
+                    if (!serialized) {
                         HELIO_SOFT_ASSERT(false, SFP(HStr_Err_ExportFailure));
                         return false;
                     }
@@ -549,7 +559,7 @@ bool Helioduino::initFromBinaryStream(Stream *streamIn)
                     delete data; data = nullptr;
 
                     if (obj && !obj->isUnknownType()) {
-                        _objects[obj->getKey()] = SharedPtr<HelioObject>(obj);
+                        _objects.insert(SharedPtr<HelioObject>(obj));
                     } else {
                         HELIO_SOFT_ASSERT(false, SFP(HStr_Err_ImportFailure));
                         if (obj) { delete obj; }
@@ -604,7 +614,7 @@ bool Helioduino::saveToBinaryStream(Stream *streamOut)
 
         if (_objects.size()) {
             for (auto iter = _objects.begin(); iter != _objects.end(); ++iter) {
-                HelioData *data = iter->second->newSaveData();
+                HelioData *data = (*iter)->newSaveData();
 
                 HELIO_SOFT_ASSERT(data && data->isObjectData(), SFP(HStr_Err_AllocationFailure));
                 if (data && data->isObjectData()) {
@@ -816,7 +826,7 @@ void Helioduino::commonPostSave()
     }
 
     for (auto iter = _objects.begin(); iter != _objects.end(); ++iter) {
-        iter->second->unsetModified();
+        (*iter)->unsetModified();
     }
 }
 
@@ -852,25 +862,44 @@ inline void yieldIfNeeded(millis_t &lastYield)
 
 void controlLoop()
 {
-    if (Helioduino::_activeInstance && !Helioduino::_activeInstance->_suspend) {
+    if (Helioduino::_activeInstance && !Helioduino::_activeInstance->_suspend &&
+        (!Helioduino::_activeInstance->_controlWakeDelay ||
+         nzMillis() - Helioduino::_activeInstance->_controlWakeStart >= Helioduino::_activeInstance->_controlWakeDelay)) {
         #ifdef HELIO_USE_VERBOSE_OUTPUT
             Serial.println(F("controlLoop")); flushYield();
         #endif
         millis_t lastYield = millis();
 
+        Helioduino::_activeInstance->updateSunPositions();
+
         for (auto iter = Helioduino::_activeInstance->_objects.begin(); iter != Helioduino::_activeInstance->_objects.end(); ++iter) {
-            iter->second->update();
+            (*iter)->update();
 
             yieldIfNeeded(lastYield);
         }
 
         Helioduino::_activeInstance->scheduler.update();
 
+        // sleep object updates until earliest reported deadline (any 0 delay -> next tick)
+        millis_t wakeDelay = min((millis_t)HELIO_CONTROL_LOOP_MAXSLEEP, Helioduino::_activeInstance->scheduler.getWakeDelay());
+        for (auto iter = Helioduino::_activeInstance->_objects.begin(); wakeDelay && iter != Helioduino::_activeInstance->_objects.end(); ++iter) {
+            wakeDelay = min(wakeDelay, (*iter)->getWakeDelay());
+        }
+        Helioduino::_activeInstance->_controlWakeStart = nzMillis();
+        Helioduino::_activeInstance->_controlWakeDelay = wakeDelay;
+
         #ifdef HELIO_USE_VERBOSE_OUTPUT
-            Serial.println(F("~controlLoop")); flushYield();
+            Serial.print(F("~controlLoop wakeDelay: ")); Serial.println(wakeDelay); flushYield();
         #endif
     }
 
+    #ifdef HELIO_USE_MULTITASKING
+        // expander port images must stay fresh regardless of object sleep
+        if (Helioduino::_activeInstance && !Helioduino::_activeInstance->_suspend) {
+            Helioduino::_activeInstance->updatePinExpanders();
+        }
+    #endif
+
     tightUpdates();
 }
 
@@ -884,12 +913,11 @@ void dataLoop()
 
         Helioduino::_activeInstance->publisher.advancePollingFrame();
 
-        for (auto iter = Helioduino::_activeInstance->_objects.begin(); iter != Helioduino::_activeInstance->_objects.end(); ++iter) {
-            if (iter->second->isSensorType()) {
-                auto sensor = static_pointer_cast<HelioSensor>(iter->second);
-                if (sensor->needsPolling()) {
-                    sensor->takeMeasurement(); // no force if already current for this frame #, we're just ensuring data for publisher
-                }
+        auto sensors = Helioduino::_activeInstance->_objects.getSensors();
+        for (auto iter = sensors.begin(); iter != sensors.end(); ++iter) {
+            auto sensor = static_pointer_cast<HelioSensor>(*iter);
+            if (sensor->isPollingDue()) {
+                sensor->takeMeasurement(); // no force if already current for this frame #, we're just ensuring data for publisher
             }
 
             yieldIfNeeded(lastYield);
@@ -933,6 +961,10 @@ void miscLoop()
 
         Helioduino::_activeInstance->publisher.update();
 
+        yieldIfNeeded(lastYield);
+
+        Helioduino::_activeInstance->logger.update();
+
         #ifdef HELIO_USE_GPS
             yieldIfNeeded(lastYield);
 
@@ -959,6 +991,7 @@ void Helioduino::launch()
 
     // Create/enable main runloops
     _suspend = false;
+    _controlWakeDelay = 0;
     #ifdef HELIO_USE_MULTITASKING
         if (!isValidTask(_controlTaskId)) {
             _controlTaskId = taskManager.scheduleFixedRate(HELIO_CONTROL_LOOP_INTERVAL, controlLoop);
@@ -1148,6 +1181,8 @@ void Helioduino::setSystemLocation(double latitude, double longitude, double alt
         _systemData->longitude = longitude;
         _systemData->altitude = altitude;
         if (isSigChange) { _systemData->bumpRevisionIfNeeded(); }
+        invalidateSunPositions();
+        wakeControlLoop();
     }
 }
 
@@ -1437,19 +1472,21 @@ void Helioduino::notifyRTCTimeUpdated()
     _rtcBattFail = false;
     _lastAutosave = 0;
     logger.updateInitTracking();
+    wakeControlLoop();
 }
 
 void Helioduino::notifyDayChanged()
 {
+    invalidateSunPositions();
+    wakeControlLoop();
+
     if (getSystemMode() == Helio_SystemMode_Tracking) {
-        for (auto iter = _objects.begin(); iter != _objects.end(); ++iter) {
-            if (iter->second->isPanelType()) {
-                auto panel = static_pointer_cast<HelioPanel>(iter->second);
+        for (auto iter = _objects.getPanels().begin(); iter != _objects.getPanels().end(); ++iter) {
+            auto panel = static_pointer_cast<HelioPanel>(*iter);
 
-                if (panel && panel->isAnyTrackingClass()) {
-                    auto trackingPanel = static_pointer_cast<HelioTrackingPanel>(iter->second);
-                    trackingPanel->notifyDayChanged();
-                }
+            if (panel && panel->isAnyTrackingClass()) {
+                auto trackingPanel = static_pointer_cast<HelioTrackingPanel>(*iter);
+                trackingPanel->notifyDayChanged();
             }
         }
     }
@@ -1466,7 +1503,7 @@ void Helioduino::checkFreeMemory()
 void Helioduino::broadcastLowMemory()
 {
     for (auto iter = _objects.begin(); iter != _objects.end(); ++iter) {
-        iter->second->handleLowMemory();
+        (*iter)->handleLowMemory();
     }
 }
 
@@ -56,6 +56,12 @@
 // Uncomment or -D this define to enable external data storage (SD card or EEPROM) to save on sketch size. Required for constrained devices.
 //#define HELIO_DISABLE_BUILTIN_DATA              // Disables library data existing in Flash, see DataWriter example for exporting details
 
+// Uncomment or -D this define to enable single-precision sun position calculations. Recommended for devices lacking FPU/double support (AVR, Cortex-M0, etc).
+//#define HELIO_ENABLE_FLOAT_SUNPOS               // Replaces SolarCalculator's double-precision path, see calcSunPositionFloat() for error details
+
+// Uncomment or -D this define to enable intrusive reference counting for shared objects. Saves a heap allocated control block per object.
+//#define HELIO_ENABLE_INTRUSIVE_PTR              // Replaces arx::stdx::shared_ptr as SharedPtr, see HelioRefPtr for details
+
 // Uncomment or -D this define to enable debug output (treats Serial output as attached to serial monitor, waiting on start for connection).
 //#define HELIO_ENABLE_DEBUG_OUTPUT
 
@@ -217,7 +223,12 @@ template<class T1, class T2> using Pair = arx::pair<T1,T2>;
 template<typename K, typename V, size_t N = ARX_MAP_DEFAULT_SIZE> using Map = arx::map<K,V,N>;
 #endif
 using namespace arx::stdx;
+#include "HelioRefPtr.hh"
+#ifdef HELIO_ENABLE_INTRUSIVE_PTR
+template <typename T> using SharedPtr = HelioRefPtr<T>;
+#else
 template <typename T> using SharedPtr = arx::stdx::shared_ptr<T>;
+#endif
 
 inline time_t unixNow();
 inline DateTime localNow();
@@ -247,6 +258,7 @@ extern void miscLoop();
 #include "HelioDrivers.h"
 #include "HelioActuators.h"
 #include "HelioSensors.h"
+#include "HelioEphemeris.h"
 #include "HelioPanels.h"
 #include "HelioRails.h"
 #include "HelioModules.h"
@@ -258,7 +270,7 @@ extern void miscLoop();
 
 // Helioduino Controller
 // Main controller interface of the Helioduino solar tracker system.
-class Helioduino : public HelioFactory, public HelioCalibrations, public HelioObjectRegistration, public HelioPinHandlers {
+class Helioduino : public HelioFactory, public HelioCalibrations, public HelioObjectRegistration, public HelioPinHandlers, public HelioSunPositions, public HelioAnalogSampler {
 public:
     HelioScheduler scheduler;                                       // Scheduler public instance
     HelioLogger logger;                                             // Logger public instance
@@ -337,6 +349,8 @@ public:
     // Enables system logging to WiFiStorage. Log file names will append YYMMDD.txt to the specified prefix. Returns success flag.
     inline bool enableSysLoggingToWiFiStorage(String logFilePrefix) { return logger.beginLoggingToWiFiStorage(logFilePrefix); }
 #endif
+    // Sets system logging to write compact binary log files, appending YYMMDD.hlb in place of YYMMDD.txt (see extra/HelioLogToText.cpp for decoding).
+    inline void setSysLoggingBinary(bool logBinary = true) { logger.setLoggingBinary(logBinary); }
 
     // Data Publishing.
 
@@ -349,7 +363,12 @@ public:
 #ifdef HELIO_USE_MQTT
     // Enables data publishing to MQTT broker. Client is expected to be began/connected (with proper broker address/net client) *before* calling this method. Returns success flag.
     inline bool enableDataPublishingToMQTTClient(MQTTClient &client) { return publisher.beginPublishingToMQTTClient(client); }
+    // Sets data publishing to MQTT broker to send one packed message per polling frame(s) in place of one message per sensor, and how many frames to coalesce per message.
+    // Note: MQTTClient needs constructed with a buffer size large enough for packed messages (see HELIO_PUBLISH_MQTT_PAYLOAD_SIZE).
+    inline void setDataPublishingToMQTTMode(Helio_MQTTPublishMode publishMode, uint8_t coalesceFrames = 1) { publisher.setMQTTPublishMode(publishMode, coalesceFrames); }
 #endif
+    // Enables/disables publishing of data rollups (min/max/mean per column) at passed period resolution, alongside raw data rows, to whichever data publishing is enabled.
+    inline void setDataPublishingRollup(Helio_RollupPeriod period, bool enabled = true) { publisher.setRollupEnabled(period, enabled); }
 
     // User Interface.
 
@@ -475,6 +494,8 @@ public:
     uint16_t getPollingInterval() const;
     // System polling frame number for sensor frame tracking
     inline hframe_t getPollingFrame() const { return _pollingFrame; }
+    // Current control loop sleep delay (time until next object updates from last control loop run), in milliseconds, else 0 for next tick
+    inline millis_t getControlWakeDelay() const { return _controlWakeDelay; }
     // Determines if a given frame # is out of date (true) or current (false), with optional frame # allowance
     bool isPollingFrameOld(hframe_t frame, hframe_t allowance = 0) const;
     // Returns if system autosaves are enabled or not
@@ -556,6 +577,8 @@ protected:
     taskid_t _miscTaskId;                                   // Misc task Id if created, else TASKMGR_INVALIDID
 #endif
     bool _suspend;                                          // If system is currently suspended from operation
+    millis_t _controlWakeStart;                             // Control loop sleep start millis, from last control loop run
+    millis_t _controlWakeDelay;                             // Control loop sleep delay, in milliseconds, else 0 for next tick
     hframe_t _pollingFrame;                                 // Current data polling frame # (index 0 reserved for disabled/undef, advanced by publisher)
     time_t _lastSpaceCheck;                                 // Last date storage media free space was checked, if able (UTC)
     time_t _lastAutosave;                                   // Last date autosave was performed, if able (UTC)
@@ -577,7 +600,7 @@ protected:
     void commonPostInit();
     void commonPostSave();
 
-    friend SharedPtr<HelioObjInterface> HelioDLinkObject::resolveObject();
+    friend class HelioDLinkObject;
     friend void controlLoop();
     friend void dataLoop();
     friend void miscLoop();
@@ -589,6 +612,7 @@ protected:
     void checkAutosave();
 
     friend Helioduino *::getController();
+    friend void ::wakeControlLoop();
     friend HelioScheduler *::getScheduler();
     friend HelioLogger *::getLogger();
     friend HelioPublisher *::getPublisher();
@@ -598,12 +622,14 @@ protected:
     friend class HelioScheduler;
     friend class HelioLogger;
     friend class HelioPublisher;
+    friend class HelioBinaryDataWriter;
 };
 
 // Template implementations
 #include "HelioInterfaces.hpp"
 #include "Helioduino.hpp"
 #include "HelioAttachments.hpp"
+#include "HelioModules.hpp"
 #include "HelioUtils.hpp"
 
 #endif // /ifndef Helioduino_H
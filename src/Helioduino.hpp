@@ -77,12 +77,12 @@ inline bool HelioLogger::isLoggingToWiFiStorage() const
 
 inline void HelioLogger::logActivation(const HelioActuator *actuator)
 {
-    if (actuator) { logMessage(actuator->getId().getDisplayString(), SFP(HStr_Log_HasEnabled)); }
+    if (actuator) { logRecord(Helio_LogLevel_Info, HStr_Log_HasEnabled, actuator->getKey()); }
 }
 
 inline void HelioLogger::logDeactivation(const HelioActuator *actuator)
 {
-    if (actuator) { logMessage(actuator->getId().getDisplayString(), SFP(HStr_Log_HasDisabled)); }
+    if (actuator) { logRecord(Helio_LogLevel_Info, HStr_Log_HasDisabled, actuator->getKey()); }
 }
 
 inline void HelioLogger::logProcess(const HelioObjInterface *obj, const String &processString, const String &statusString)
@@ -100,6 +100,21 @@ inline Helio_LogLevel HelioLogger::getLogLevel() const
     return hasLoggerData() ? loggerData()->logLevel : Helio_LogLevel_None;
 }
 
+inline bool HelioLogger::isLevelLogged(Helio_LogLevel level) const
+{
+    return !hasLoggerData() || (loggerData()->logLevel != Helio_LogLevel_None && loggerData()->logLevel <= level);
+}
+
+inline bool HelioLogger::isLoggingBinary() const
+{
+    return hasLoggerData() && loggerData()->logBinary;
+}
+
+inline String HelioLogger::getLogFileExtension() const
+{
+    return SFP(isLoggingBinary() ? HStr_hlb : HStr_txt);
+}
+
 inline bool HelioLogger::isLoggingEnabled() const
 {
     return hasLoggerData() && loggerData()->logLevel != Helio_LogLevel_None && (loggerData()->logToSDCard || loggerData()->logToWiFiStorage);
@@ -136,6 +151,16 @@ inline bool HelioPublisher::isPublishingToMQTTClient() const
     return hasPublisherData() && _mqttClient;
 }
 
+inline Helio_MQTTPublishMode HelioPublisher::getMQTTPublishMode() const
+{
+    return hasPublisherData() ? publisherData()->mqttMode : Helio_MQTTPublishMode_PerSensor;
+}
+
+inline uint8_t HelioPublisher::getMQTTCoalesceFrames() const
+{
+    return hasPublisherData() ? publisherData()->mqttCoalesce : 1;
+}
+
 #endif
 
 inline bool HelioPublisher::isPublishingEnabled() const
@@ -147,11 +172,26 @@ inline bool HelioPublisher::isPublishingEnabled() const
         );
 }
 
+inline bool HelioPublisher::isPublishingBinary() const
+{
+    return hasPublisherData() && publisherData()->pubBinary;
+}
+
+inline bool HelioPublisher::isRollupEnabled(Helio_RollupPeriod period) const
+{
+    return hasPublisherData() && period >= 0 && period < Helio_RollupPeriod_Count && (publisherData()->rollupPeriods & (1 << period));
+}
+
 inline void HelioPublisher::setNeedsTabulation()
 {
     _needsTabulation = hasPublisherData();
 }
 
+inline String HelioPublisher::getDataFileExtension() const
+{
+    return SFP(isPublishingBinary() ? HStr_dat : HStr_csv);
+}
+
 
 inline HelioSchedulerSubData *HelioScheduler::schedulerData() const
 {
@@ -0,0 +1,167 @@
+// Analog sampler tests script checking oversample bursts of muxed analog sensors over unconnected channel select bus pins - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_MUXER_PINS           A0, A1          // Muxer signal pins (read as analog inputs)
+#define SETUP_TEST_SELECT_PINS          2, 3, 4, 5, 6, 7, 8, 9 // Muxer channel select bus pins, 4 per muxer (leave unconnected, read back as driven)
+#define SETUP_TEST_OVERSAMPLE           8               // Sensor filter oversample count (raw reads per measurement)
+#define SETUP_TEST_ROUNDS               5               // Number of measurement rounds over all sensors
+#define SETUP_TEST_TIMEOUT              2000            // Sampler completion timeout, in milliseconds
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+pintype_t selectPins[] = { SETUP_TEST_SELECT_PINS };
+SharedPtr<HelioAnalogSensor> sensors[4];
+uint8_t selectLines[2];
+int lineChanges;
+bool interleaved;
+
+// Reads back muxer channel select bus lines, as currently driven on its output pins
+uint8_t readSelectLines(const pintype_t *muxSelectPins)
+{
+    uint8_t lines = 0;
+    for (int bitIndex = 0; bitIndex < 4; ++bitIndex) { bitWrite(lines, bitIndex, digitalRead(muxSelectPins[bitIndex]) == HIGH ? 1 : 0); }
+    return lines;
+}
+
+// Observes sampler progress between sampler runs, counting select line changes (channel switches) and
+// flagging any time more than one sensor is partway through its oversample burst
+void observeSampler()
+{
+    int partialBursts = 0;
+    for (int sensorIndex = 0; sensorIndex < 4; ++sensorIndex) {
+        if (sensors[sensorIndex]->getFilter().getAccumCount()) { ++partialBursts; }
+    }
+    interleaved = interleaved || partialBursts > 1;
+
+    for (int muxIndex = 0; muxIndex < 2; ++muxIndex) {
+        uint8_t lines = readSelectLines(&selectPins[muxIndex * 4]);
+        if (lines != selectLines[muxIndex]) { selectLines[muxIndex] = lines; ++lineChanges; }
+    }
+}
+
+// Runs sampler until no sensor is still taking a measurement, returning success (else timed out)
+bool runSampler()
+{
+    millis_t start = millis();
+    while (millis() - start < SETUP_TEST_TIMEOUT) {
+        bool measuring = false;
+        for (int sensorIndex = 0; sensorIndex < 4; ++sensorIndex) { measuring = measuring || sensors[sensorIndex]->isTakingMeasurement(); }
+        if (!measuring) { return true; }
+
+        #ifdef HELIO_USE_MULTITASKING
+            taskManager.runLoop();
+        #endif
+        observeSampler();
+    }
+    return false;
+}
+
+// Tests that each sensor's oversample burst completes before the next sensor's starts, such
+// that each muxer switches channels once per sensor per round
+void testBursts()
+{
+    bool completed = true;
+    lineChanges = 0;
+    interleaved = false;
+
+    uint32_t start = micros();
+    for (int roundIndex = 0; roundIndex < SETUP_TEST_ROUNDS; ++roundIndex) {
+        for (int sensorIndex = 0; sensorIndex < 4; ++sensorIndex) {
+            sensors[sensorIndex]->takeMeasurement(true);
+            observeSampler(); // completes inline if not multitasking
+        }
+        completed = runSampler() && completed;
+    }
+    uint32_t elapsed = micros() - start;
+
+    getLogger()->logMessage(F("testBursts: sensors: 4, rounds: "), String(SETUP_TEST_ROUNDS), String(F(", oversample: ")) + String(SETUP_TEST_OVERSAMPLE));
+    getLogger()->logMessage(F("  Observed channel switches: "), String(lineChanges), String(F(", elapsed us: ")) + String(elapsed));
+    if (!completed) {
+        getLogger()->logError(F("testBursts: "), F("Measurements timed out"));
+    }
+    if (interleaved || lineChanges > SETUP_TEST_ROUNDS * 4) {
+        getLogger()->logError(F("testBursts: "), F("Oversample bursts interleaved"));
+    }
+}
+
+// Tests that a busy sensor pin defers, rather than fails, sampling, completing once pin lock is returned
+void testBusyPin()
+{
+    const pintype_t muxerPins[] = { SETUP_TEST_MUXER_PINS };
+    helioController.tryGetPinLock(muxerPins[0]);
+
+    for (int sensorIndex = 0; sensorIndex < 4; ++sensorIndex) { sensors[sensorIndex]->takeMeasurement(true); }
+    #ifdef HELIO_USE_MULTITASKING
+        for (int runIndex = 0; runIndex < 10; ++runIndex) { taskManager.runLoop(); }
+    #endif
+    bool deferred = sensors[0]->getFilter().getAccumCount() == 0;
+
+    helioController.returnPinLock(muxerPins[0]);
+    for (int sensorIndex = 0; sensorIndex < 4; ++sensorIndex) { sensors[sensorIndex]->takeMeasurement(true); } // retries if dropped (no multitasking)
+    bool completed = runSampler();
+
+    getLogger()->logMessage(F("testBusyPin: deferred: "), deferred ? F("true") : F("false"), String(F(", completed: ")) + String(completed ? F("true") : F("false")));
+    if (!deferred || !completed) {
+        getLogger()->logError(F("testBusyPin: "), F("Busy pin not deferred"));
+    }
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    // Two LDRs on each of two muxers, added in interleaved order
+    const pintype_t muxerPins[] = { SETUP_TEST_MUXER_PINS };
+    const int muxerIndicies[] = { 0, 1, 0, 1 };
+    const uint8_t muxerChannels[] = { 3, 4, 9, 11 };
+
+    for (int muxIndex = 0; muxIndex < 2; ++muxIndex) {
+        SharedPtr<HelioPinMuxer> muxer(new HelioPinMuxer(HelioPin(HelioPin::Analog, muxerPins[muxIndex], Helio_PinMode_Analog_Input), &selectPins[muxIndex * 4], 4));
+        muxer->init();
+        helioController.setPinMuxer(muxerPins[muxIndex], muxer);
+        selectLines[muxIndex] = readSelectLines(&selectPins[muxIndex * 4]);
+    }
+    for (int sensorIndex = 0; sensorIndex < 4; ++sensorIndex) {
+        sensors[sensorIndex] = helioController.addLightIntensitySensor(muxerPins[muxerIndicies[sensorIndex]], ADC_RESOLUTION,
+                                                                       pinChannelForMuxerChannel(muxerChannels[sensorIndex]));
+        sensors[sensorIndex]->setFilter(SETUP_TEST_OVERSAMPLE);
+    }
+
+    testBursts();
+    testBusyPin();
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
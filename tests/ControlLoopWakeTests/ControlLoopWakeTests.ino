@@ -0,0 +1,182 @@
+// Control loop wake scheduling tests script running gated control loop over probe objects with set wake delays - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_INPUT_PIN            2               // Digital input pin of probe sensor
+#define SETUP_TEST_WAKE_DELAYS          200, 500, 350   // Probe objects' reported wake delays (sensor, panel, panel), in milliseconds
+#define SETUP_TEST_ASLEEP_RUNS          5               // # of control loop runs made while asleep
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Binary sensor reporting a set wake delay, counting its object updates
+class ProbeSensor : public HelioBinarySensor {
+public:
+    millis_t wakeDelay;
+    int updates;
+
+    ProbeSensor(hposi_t sensorIndex, pintype_t inputPin, millis_t wakeDelayIn)
+        : HelioBinarySensor(Helio_SensorType_IceDetector, sensorIndex, HelioDigitalPin(inputPin, INPUT_PULLUP, true)), wakeDelay(wakeDelayIn), updates(0) { ; }
+
+    virtual void update() override { HelioBinarySensor::update(); ++updates; }
+    virtual millis_t getWakeDelay() override { return wakeDelay; }
+};
+
+// Tracking panel (without drives) reporting a set wake delay, counting its object updates
+class ProbePanel : public HelioTrackingPanel {
+public:
+    millis_t wakeDelay;
+    int updates;
+
+    ProbePanel(hposi_t panelIndex, millis_t wakeDelayIn)
+        : HelioTrackingPanel(Helio_PanelType_Gimballed, panelIndex), wakeDelay(wakeDelayIn), updates(0) { ; }
+
+    virtual void update() override { ++updates; } // no drives to align
+    virtual millis_t getWakeDelay() override { return wakeDelay; }
+};
+
+SharedPtr<ProbeSensor> sensor;
+SharedPtr<ProbePanel> panels[2];
+
+// Returns total # of probe object updates
+int getUpdates()
+{
+    return sensor->updates + panels[0]->updates + panels[1]->updates;
+}
+
+// Returns expected combined wake delay, as earliest of probe objects, scheduler, and max sleep
+millis_t getExpectedWakeDelay()
+{
+    millis_t wakeDelay = min((millis_t)HELIO_CONTROL_LOOP_MAXSLEEP, getScheduler()->getWakeDelay());
+    wakeDelay = min(wakeDelay, sensor->wakeDelay);
+    wakeDelay = min(wakeDelay, min(panels[0]->wakeDelay, panels[1]->wakeDelay));
+    return wakeDelay;
+}
+
+// Tests that object updates are skipped while asleep, then resumed once combined wake delay passes
+void testSleepAndResume()
+{
+    controlLoop();
+    int updates = getUpdates();
+    millis_t wakeDelay = helioController.getControlWakeDelay();
+    millis_t expected = getExpectedWakeDelay();
+
+    for (int runIndex = 0; runIndex < SETUP_TEST_ASLEEP_RUNS; ++runIndex) { controlLoop(); }
+    int asleepUpdates = getUpdates() - updates;
+
+    delay(wakeDelay + 1);
+    controlLoop();
+    int resumedUpdates = getUpdates() - updates - asleepUpdates;
+
+    getLogger()->logMessage(F("testSleepAndResume: wake delay: "), String(wakeDelay), String(F(", expected: ")) + String(expected));
+    getLogger()->logMessage(F("  Updates while asleep: "), String(asleepUpdates), String(F(", once resumed: ")) + String(resumedUpdates));
+    if (wakeDelay != expected) {
+        getLogger()->logError(F("testSleepAndResume: "), F("Wake delays not combined as earliest"));
+    }
+    if (wakeDelay && asleepUpdates) {
+        getLogger()->logError(F("testSleepAndResume: "), F("Objects updated while asleep"));
+    }
+    if (resumedUpdates != 3) {
+        getLogger()->logError(F("testSleepAndResume: "), F("Objects not updated once resumed"));
+    }
+}
+
+// Tests that combined wake delay follows whichever object reports earliest, is bounded by max sleep,
+// and that a zero wake delay (or an explicit wake) updates objects on next run
+void testCombine()
+{
+    const millis_t wakeDelays[] = { SETUP_TEST_WAKE_DELAYS };
+    bool combined = true;
+
+    for (int rotateIndex = 0; rotateIndex < 3; ++rotateIndex) { // earliest deadline moves between objects
+        sensor->wakeDelay = wakeDelays[rotateIndex % 3];
+        panels[0]->wakeDelay = wakeDelays[(rotateIndex + 1) % 3];
+        panels[1]->wakeDelay = wakeDelays[(rotateIndex + 2) % 3];
+        wakeControlLoop();
+        controlLoop();
+        combined = combined && helioController.getControlWakeDelay() == getExpectedWakeDelay();
+    }
+
+    sensor->wakeDelay = panels[0]->wakeDelay = panels[1]->wakeDelay = (millis_t)HELIO_CONTROL_LOOP_MAXSLEEP * 10;
+    wakeControlLoop();
+    controlLoop();
+    bool bounded = helioController.getControlWakeDelay() <= (millis_t)HELIO_CONTROL_LOOP_MAXSLEEP;
+
+    int updates = getUpdates();
+    wakeControlLoop(); // e.g. trigger fire cuts sleep short
+    controlLoop();
+    bool woken = getUpdates() - updates == 3;
+
+    panels[1]->wakeDelay = 0;
+    wakeControlLoop();
+    controlLoop(); // picks up zero delay
+    updates = getUpdates();
+    controlLoop();
+    bool nextTick = helioController.getControlWakeDelay() == 0 && getUpdates() - updates == 3;
+
+    getLogger()->logMessage(F("testCombine: combined: "), combined ? F("true") : F("false"), String(F(", bounded: ")) + String(bounded ? F("true") : F("false")));
+    getLogger()->logMessage(F("  Woken: "), woken ? F("true") : F("false"), String(F(", next tick: ")) + String(nextTick ? F("true") : F("false")));
+    if (!combined) {
+        getLogger()->logError(F("testCombine: "), F("Wake delays not combined as earliest"));
+    }
+    if (!bounded) {
+        getLogger()->logError(F("testCombine: "), F("Wake delay not bounded by max sleep"));
+    }
+    if (!woken) {
+        getLogger()->logError(F("testCombine: "), F("Explicit wake didn't cut sleep short"));
+    }
+    if (!nextTick) {
+        getLogger()->logError(F("testCombine: "), F("Zero wake delay didn't update on next run"));
+    }
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    const millis_t wakeDelays[] = { SETUP_TEST_WAKE_DELAYS };
+    sensor = SharedPtr<ProbeSensor>(new ProbeSensor(0, SETUP_TEST_INPUT_PIN, wakeDelays[0]));
+    helioController.registerObject(sensor);
+    for (int panelIndex = 0; panelIndex < 2; ++panelIndex) {
+        panels[panelIndex] = SharedPtr<ProbePanel>(new ProbePanel(panelIndex, wakeDelays[1 + panelIndex]));
+        helioController.registerObject(panels[panelIndex]);
+    }
+    helioController.launch();
+    controlLoop(); // initial run performs scheduling
+
+    testSleepAndResume();
+    testCombine();
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
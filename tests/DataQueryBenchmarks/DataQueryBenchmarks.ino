@@ -0,0 +1,195 @@
+// Publisher data query benchmarks script measuring time-range query latency against data file size for .csv and binary .dat, versus a linear scan - mainly for dev purposes
+// Requires SD card, which will have benchmark data files written to and left under bench/ folder
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            SS              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_COLUMNS              8               // # of data columns per row
+#define SETUP_TEST_ROW_SECS             15              // Seconds between rows (polling interval)
+#define SETUP_TEST_WINDOW_SECS          300             // Queried time range length, in seconds
+#define SETUP_TEST_FILE_PREFIX          "bench/bq"      // Benchmark data file prefix
+#define SETUP_TEST_RANGE_PREFIX         "bench/br"      // Full range query benchmark data file prefix (kept to a single data file)
+const int testRowCounts[] = { 250, 1000, 5760 };        // # of rows per benchmarked data file (5760 = full day @ 15s)
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Fills data columns with a plausible spread of sensor values for row
+void fillColumns(HelioDataColumn *dataColumns, int rowIndex)
+{
+    for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+        dataColumns[columnIndex].measurement.value = (columnIndex * 37.5f) + sinf((rowIndex + columnIndex) * 0.1f) * 12.25f;
+    }
+}
+
+// Writes day's data file of rowCount rows, as HelioPublisher does (.dat finalized with time index footer). Returns file size.
+uint32_t writeDataFile(HelioDataColumn *dataColumns, time_t dayStart, int rowCount, bool binary, String filePrefix = String(F(SETUP_TEST_FILE_PREFIX)))
+{
+    auto sd = helioController.getSDCard();
+    uint32_t fileSize = 0;
+
+    if (sd) {
+        String dataFilename = getYYMMDDFilename(filePrefix, binary ? SFP(HStr_dat) : SFP(HStr_csv), localTime(dayStart));
+        createDirectoryFor(sd, dataFilename);
+        if (sd->exists(dataFilename.c_str())) { sd->remove(dataFilename.c_str()); }
+        auto dataFile = sd->open(dataFilename.c_str(), FILE_WRITE);
+
+        if (dataFile) {
+            HelioBinaryDataWriter writer;
+
+            if (binary) {
+                writer.writeHeader(dataFile, dataColumns, SETUP_TEST_COLUMNS);
+            } else {
+                dataFile.print(F("timestamp"));
+                for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+                    dataFile.print(F(",Bench")); dataFile.print(columnIndex); dataFile.print(F("_Raw_raw"));
+                }
+                dataFile.println();
+            }
+
+            for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
+                time_t timestamp = dayStart + (time_t)rowIndex * SETUP_TEST_ROW_SECS;
+                fillColumns(dataColumns, rowIndex);
+
+                if (binary) {
+                    uint16_t rowLength = 0;
+                    const uint8_t *row = writer.encodeRow(timestamp, dataColumns, SETUP_TEST_COLUMNS, &rowLength);
+                    if (row) { dataFile.write(row, rowLength); }
+                } else {
+                    dataFile.print(timestamp);
+                    for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+                        dataFile.print(',');
+                        dataFile.print(dataColumns[columnIndex].measurement.value);
+                    }
+                    dataFile.println();
+                }
+            }
+            if (binary) { writer.writeFooter(dataFile); }
+
+            dataFile.flush();
+            fileSize = dataFile.size();
+            dataFile.close();
+        }
+
+        helioController.endSDCard(sd);
+    }
+
+    return fileSize;
+}
+
+// Benchmarks querying last column over [startTime, endTime], logging latency and query cost metrics
+void benchmarkQuery(const __FlashStringHelper *name, hkey_t sensorKey, time_t startTime, time_t endTime, int expectedRows, String filePrefix = String(F(SETUP_TEST_FILE_PREFIX)))
+{
+    HelioDataReader reader(filePrefix);
+    HelioSingleMeasurement measurement;
+    int rows = 0;
+
+    uint32_t start = micros();
+    if (reader.beginQuery(sensorKey, startTime, endTime)) {
+        while (reader.readNext(&measurement)) { ++rows; }
+    }
+    uint32_t elapsed = micros() - start;
+
+    getLogger()->logMessage(name, String(F("us: ")) + String(elapsed), String(F(", rows: ")) + String(rows));
+    getLogger()->logMessage(F("    Rows scanned: "), String(reader.getRowsScanned()), String(F(", seeks: ")) + String(reader.getSeekCount()) + String(F(", files opened: ")) + String(reader.getFilesOpened()));
+    if (rows != expectedRows) {
+        getLogger()->logError(name, F("Row count mismatch"));
+    }
+    reader.endQuery();
+}
+
+// Benchmarks window query near end of data file of rowCount rows, versus a linear scan from start of file
+void benchmarkFileSize(HelioDataColumn *dataColumns, time_t dayStart, int rowCount, bool binary)
+{
+    uint32_t fileSize = writeDataFile(dataColumns, dayStart, rowCount, binary);
+    if (!fileSize) {
+        getLogger()->logError(F("benchmarkFileSize: "), F("Failed writing data file"));
+        return;
+    }
+    hkey_t sensorKey = dataColumns[SETUP_TEST_COLUMNS - 1].sensorKey;
+    time_t windowStart = dayStart + (time_t)(rowCount * 3 / 4) * SETUP_TEST_ROW_SECS;
+    time_t windowEnd = windowStart + SETUP_TEST_WINDOW_SECS - 1;
+    int windowRows = min(SETUP_TEST_WINDOW_SECS / SETUP_TEST_ROW_SECS, rowCount - rowCount * 3 / 4);
+
+    getLogger()->logMessage(binary ? F("benchmarkFileSize (.dat): rows: ") : F("benchmarkFileSize (.csv): rows: "), String(rowCount), String(F(", file bytes: ")) + String(fileSize));
+    benchmarkQuery(F("  Window query: "), sensorKey, windowStart, windowEnd, windowRows);
+    // linear scan baseline: same rows reached by reading forward from start of file
+    benchmarkQuery(F("  Linear scan: "), sensorKey, dayStart, windowEnd, rowCount * 3 / 4 + windowRows);
+}
+
+// Benchmarks query over full time range (epoch to max time) of a single data file, which should narrow to just
+// that file's day rather than probing each day, and end without wrapping past max time
+void benchmarkFullRange(HelioDataColumn *dataColumns, time_t dayStart, int rowCount)
+{
+    String filePrefix(F(SETUP_TEST_RANGE_PREFIX));
+    if (!writeDataFile(dataColumns, dayStart, rowCount, false, filePrefix)) {
+        getLogger()->logError(F("benchmarkFullRange: "), F("Failed writing data file"));
+        return;
+    }
+    hkey_t sensorKey = dataColumns[SETUP_TEST_COLUMNS - 1].sensorKey;
+    time_t maxTime = (time_t)-1 > 0 ? (time_t)-1 : (time_t)(((uint64_t)1 << (sizeof(time_t) * 8 - 1)) - 1);
+
+    getLogger()->logMessage(F("benchmarkFullRange: rows: "), String(rowCount));
+    benchmarkQuery(F("  Full range query: "), sensorKey, 0, maxTime, rowCount, filePrefix);
+
+    auto sd = helioController.getSDCard();
+    if (sd) {
+        sd->remove(getYYMMDDFilename(filePrefix, SFP(HStr_csv), localTime(dayStart)).c_str());
+        helioController.endSDCard(sd);
+    }
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    HelioDataColumn *dataColumns = new HelioDataColumn[SETUP_TEST_COLUMNS];
+    for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+        dataColumns[columnIndex].sensorKey = stringHash(String(F("Bench")) + String(columnIndex));
+        dataColumns[columnIndex].measurement.units = Helio_UnitsType_Raw_1;
+    }
+
+    // each file gets its own day, well before today so that publisher's data files are left alone
+    time_t dayStart = unixTime(localDayStart()) - 30 * SECS_PER_DAY;
+    for (unsigned sizeIndex = 0; sizeIndex < sizeof(testRowCounts) / sizeof(testRowCounts[0]); ++sizeIndex) {
+        benchmarkFileSize(dataColumns, dayStart, testRowCounts[sizeIndex], false);
+        // .dat day file takes precedence over .csv day file of same date, so binary gets the following day
+        benchmarkFileSize(dataColumns, dayStart + SECS_PER_DAY, testRowCounts[sizeIndex], true);
+        dayStart += 2 * SECS_PER_DAY;
+    }
+    benchmarkFullRange(dataColumns, dayStart, testRowCounts[0]);
+
+    delete [] dataColumns;
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
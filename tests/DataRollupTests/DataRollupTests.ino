@@ -0,0 +1,204 @@
+// Data rollup tests script - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_COLUMNS              4               // # of data columns per row
+#define SETUP_TEST_ROWS                 120             // # of rows added per bucket
+#define SETUP_TEST_BUFFER_SIZE          512             // Rollup write-behind buffer size, in bytes
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+HelioDataColumn dataColumns[SETUP_TEST_COLUMNS];
+
+// Fills data columns for row, with last column left undefined on every odd row and first column always undefined
+void fillColumns(time_t timestamp, int rowIndex)
+{
+    for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+        float value = (columnIndex * 10.0f) + (rowIndex % 7);
+        if (columnIndex == 0) { value = FLT_UNDEF; }
+        else if (columnIndex == SETUP_TEST_COLUMNS - 1 && (rowIndex & 1)) { value = NAN; }
+        dataColumns[columnIndex].measurement = HelioSingleMeasurement(value, Helio_UnitsType_Raw_1, timestamp);
+    }
+}
+
+// Tests bucket start alignment and bucket closing
+void testBuckets()
+{
+    time_t timestamp = 1700000000 + 37; // mid-minute, mid-hour
+    HelioDataRollup rollup(Helio_RollupPeriod_Minute);
+
+    if (HelioDataRollup::getBucketStart(Helio_RollupPeriod_Minute, timestamp) != timestamp - (timestamp % SECS_PER_MIN) ||
+        HelioDataRollup::getBucketStart(Helio_RollupPeriod_Hour, timestamp) != timestamp - (timestamp % SECS_PER_HOUR)) {
+        getLogger()->logError(F("testBuckets: "), F("Bucket start misaligned"));
+    }
+    time_t dayStart = HelioDataRollup::getBucketStart(Helio_RollupPeriod_Day, timestamp);
+    if (dayStart > timestamp || timestamp - dayStart >= SECS_PER_DAY ||
+        HelioDataRollup::getBucketStart(Helio_RollupPeriod_Day, dayStart) != dayStart) {
+        getLogger()->logError(F("testBuckets: "), F("Day bucket start misaligned"));
+    }
+
+    if (rollup.isBucketClosed(timestamp + SECS_PER_HOUR)) {
+        getLogger()->logError(F("testBuckets: "), F("Empty bucket closed"));
+    }
+    fillColumns(timestamp, 0);
+    rollup.addRow(timestamp, dataColumns, SETUP_TEST_COLUMNS);
+    time_t bucketEnd = rollup.getBucketStart() + SECS_PER_MIN;
+    if (rollup.isBucketClosed(bucketEnd - 1) || !rollup.isBucketClosed(bucketEnd)) {
+        getLogger()->logError(F("testBuckets: "), F("Bucket closed at wrong time"));
+    }
+
+    getLogger()->logMessage(F("testBuckets: bucket start: "), String((unsigned long)rollup.getBucketStart()), String(F(", day start: ")) + String((unsigned long)dayStart));
+}
+
+// Tests min/max/mean against brute force, and that undefined values are skipped
+void testStats()
+{
+    time_t timestamp = HelioDataRollup::getBucketStart(Helio_RollupPeriod_Hour, 1700000000);
+    HelioDataRollup rollup(Helio_RollupPeriod_Hour);
+    float mins[SETUP_TEST_COLUMNS], maxs[SETUP_TEST_COLUMNS], sums[SETUP_TEST_COLUMNS];
+    int counts[SETUP_TEST_COLUMNS];
+
+    for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+        mins[columnIndex] = FLT_MAX; maxs[columnIndex] = -FLT_MAX; sums[columnIndex] = 0; counts[columnIndex] = 0;
+    }
+
+    for (int rowIndex = 0; rowIndex < SETUP_TEST_ROWS; ++rowIndex) {
+        fillColumns(timestamp + rowIndex, rowIndex);
+        rollup.addRow(timestamp + rowIndex, dataColumns, SETUP_TEST_COLUMNS);
+
+        for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+            float value = dataColumns[columnIndex].measurement.value;
+            if (isnan(value) || isFPEqual(value, FLT_UNDEF)) { continue; }
+            mins[columnIndex] = min(mins[columnIndex], value);
+            maxs[columnIndex] = max(maxs[columnIndex], value);
+            sums[columnIndex] += value; counts[columnIndex]++;
+        }
+    }
+
+    if (rollup.getRowCount() != SETUP_TEST_ROWS || rollup.getBucketStart() != timestamp) {
+        getLogger()->logError(F("testStats: "), F("Row count or bucket start mismatch"));
+    }
+    for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+        if (rollup.getValueCount(columnIndex) != counts[columnIndex]) {
+            getLogger()->logError(F("testStats: "), F("Value count mismatch, column: "), String(columnIndex));
+        } else if (counts[columnIndex] &&
+                   (!isFPEqual(rollup.getMin(columnIndex), mins[columnIndex]) ||
+                    !isFPEqual(rollup.getMax(columnIndex), maxs[columnIndex]) ||
+                    fabsf(rollup.getMean(columnIndex) - sums[columnIndex] / counts[columnIndex]) > 0.001f)) {
+            getLogger()->logError(F("testStats: "), F("Stats mismatch, column: "), String(columnIndex));
+        }
+    }
+
+    // first column never defined, so its fields are left empty
+    String row = rollup.getRowString();
+    String expectedStart = String((unsigned long)timestamp) + String(',') + String(SETUP_TEST_ROWS) + String(F(",,,,"));
+    if (!row.startsWith(expectedStart)) {
+        getLogger()->logError(F("testStats: "), F("Undefined column not left empty: "), row);
+    }
+
+    getLogger()->logMessage(F("testStats: row: "), row);
+}
+
+// Tests header flagging, which is only needed once columns change (new files get their header upon creation)
+void testHeader()
+{
+    time_t timestamp = 1700000000;
+    HelioDataRollup rollup(Helio_RollupPeriod_Minute);
+
+    fillColumns(timestamp, 0);
+    rollup.addRow(timestamp, dataColumns, SETUP_TEST_COLUMNS);
+    rollup.addRow(timestamp + 1, dataColumns, SETUP_TEST_COLUMNS);
+    if (rollup.needsHeader()) {
+        getLogger()->logError(F("testHeader: "), F("Header flagged without column change"));
+    }
+
+    rollup.addRow(timestamp + 2, dataColumns, SETUP_TEST_COLUMNS - 1);
+    if (!rollup.needsHeader() || rollup.getRowCount() != 1 || rollup.getColumnSize() != SETUP_TEST_COLUMNS - 1) {
+        getLogger()->logError(F("testHeader: "), F("Column change did not clear bucket and flag header"));
+    }
+
+    rollup.setNeedsHeader(false);
+    rollup.clear();
+    rollup.addRow(timestamp + SECS_PER_MIN, dataColumns, SETUP_TEST_COLUMNS - 1);
+    if (rollup.needsHeader() || rollup.getBucketStart() != HelioDataRollup::getBucketStart(Helio_RollupPeriod_Minute, timestamp + SECS_PER_MIN)) {
+        getLogger()->logError(F("testHeader: "), F("Next bucket mismatch"));
+    }
+
+    getLogger()->logMessage(F("testHeader: done"));
+}
+
+// Tests queueing rollup rows into a write-behind buffer as publisher does, which should only flush once aged or forced
+void testQueue()
+{
+    time_t timestamp = HelioDataRollup::getBucketStart(Helio_RollupPeriod_Minute, 1700000000);
+    HelioDataRollup rollup(Helio_RollupPeriod_Minute);
+    HelioPublishBuffer buffer(SETUP_TEST_BUFFER_SIZE, HELIO_PUBLISH_ROLLUP_MAXAGE);
+    uint32_t bytesQueued = 0;
+    int queued = 0;
+
+    for (int bucketIndex = 0; bucketIndex < 5; ++bucketIndex) {
+        for (int rowIndex = 0; rowIndex < 10; ++rowIndex) {
+            time_t rowTime = timestamp + bucketIndex * SECS_PER_MIN + rowIndex;
+            fillColumns(rowTime, rowIndex);
+            rollup.addRow(rowTime, dataColumns, SETUP_TEST_COLUMNS);
+        }
+        String row = rollup.getRowString();
+        buffer.beginRow();
+        buffer.println(row);
+        if (buffer.endRow()) { ++queued; bytesQueued += row.length() + 2; } else { buffer.recordDroppedRow(); }
+        rollup.clear();
+    }
+
+    if (buffer.getFlushLength(0) || buffer.getFlushLength(0, true) != buffer.getDepth()) {
+        getLogger()->logError(F("testQueue: "), F("Flush due before max age"));
+    }
+    if (buffer.getDepth() != bytesQueued || buffer.getRowsQueued() != queued) {
+        getLogger()->logError(F("testQueue: "), F("Queued size mismatch"));
+    }
+
+    getLogger()->logMessage(F("testQueue: rows queued: "), String(queued), String(F(", depth: ")) + String(buffer.getDepth()));
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    testBuckets();
+    testStats();
+    testHeader();
+    testQueue();
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
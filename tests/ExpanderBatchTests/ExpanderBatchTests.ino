@@ -0,0 +1,159 @@
+// Expander batch I/O tests script against a simulated i2c pin expander - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_OUTPUT_PINS          8               // Number of simulated relay outputs (expander pins 0-7)
+#define SETUP_TEST_INPUT_PINS           8               // Number of simulated limit switch inputs (expander pins 8-15)
+#define SETUP_TEST_TICKS                10              // Number of simulated control ticks
+
+#ifdef HELIO_USE_MULTITASKING
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Simulated 16-bit i2c pin expander that keeps a port image and counts bus transactions, with
+// each sync costing one transaction (whole-port write-out & read-in, as on a MCP23017)
+class SimulatedI2CExpander : public BasicIoAbstraction {
+public:
+    uint16_t outputPort;
+    uint16_t inputPort;
+    uint16_t busPort;
+    uint16_t busOutputPort;
+    int transactions;
+    bool failing;
+
+    SimulatedI2CExpander() : outputPort(0), inputPort(0), busPort(0), busOutputPort(0), transactions(0), failing(false) { ; }
+
+    virtual void pinDirection(pinid_t pin, uint8_t mode) override { ; }
+    virtual void writeValue(pinid_t pin, uint8_t value) override { bitWrite(outputPort, pin, value ? 1 : 0); }
+    virtual uint8_t readValue(pinid_t pin) override { return bitRead(inputPort, pin); }
+    virtual void attachInterrupt(pinid_t pin, RawIntHandler intHandler, uint8_t mode) override { ; }
+    virtual bool runLoop() override {
+        ++transactions;
+        if (failing) { return false; } // simulated i2c NACK
+        inputPort = busPort; busOutputPort = outputPort;
+        return true;
+    }
+    virtual void writePort(pinid_t pin, uint8_t portVal) override { ; }
+    virtual uint8_t readPort(pinid_t pin) override { return 0; }
+};
+
+SimulatedI2CExpander simExpander;
+
+// Runs simulated control ticks that update all relay outputs and read all limit switch inputs,
+// logging the number of bus transactions performed
+void testTicks(HelioDigitalPin outputs[], HelioDigitalPin inputs[])
+{
+    auto expander = helioController.getPinExpander(0);
+    expander->resetTransactionCount();
+    simExpander.transactions = 0;
+
+    for (int tickIndex = 0; tickIndex < SETUP_TEST_TICKS; ++tickIndex) {
+        simExpander.busPort = (uint16_t)random(0xFFFF);
+        int readCount = 0;
+
+        for (uint8_t pinIndex = 0; pinIndex < SETUP_TEST_OUTPUT_PINS; ++pinIndex) {
+            outputs[pinIndex].digitalWrite((tickIndex + pinIndex) & 1 ? HIGH : LOW);
+        }
+        for (uint8_t pinIndex = 0; pinIndex < SETUP_TEST_INPUT_PINS; ++pinIndex) {
+            readCount += inputs[pinIndex].digitalRead() == HIGH;
+        }
+
+        helioController.updatePinExpanders(); // end of control tick
+    }
+
+    getLogger()->logMessage(F("testTicks: "), HELIO_EXPANDERS_SHADOW_IO ? F("Shadow I/O") : F("Per-pin I/O"),
+                            String(F(", pins: ")) + String(SETUP_TEST_OUTPUT_PINS + SETUP_TEST_INPUT_PINS) + String(F(", ticks: ")) + String(SETUP_TEST_TICKS));
+    getLogger()->logMessage(F("  Bus transactions: "), String(simExpander.transactions), String(F(", per tick: ")) + String(simExpander.transactions / (float)SETUP_TEST_TICKS));
+    if (expander->getTransactionCount() != simExpander.transactions) {
+        getLogger()->logError(F("testTicks: "), F("Transaction count mismatch"));
+    }
+    if (expander->hasPendingWrites()) {
+        getLogger()->logError(F("testTicks: "), F("Writes left unflushed"));
+    }
+}
+
+// Tests that a failed bus sync keeps writes pending, and that they are flushed out once the bus recovers
+void testSyncFailure(HelioDigitalPin outputs[])
+{
+    auto expander = helioController.getPinExpander(0);
+    uint16_t busBefore = simExpander.busOutputPort;
+    uint8_t state = bitRead(busBefore, 0) ? LOW : HIGH;
+
+    simExpander.failing = true;
+    outputs[0].digitalWrite(state);
+    helioController.updatePinExpanders(); // end of control tick, flush fails
+    bool keptPending = expander->hasPendingWrites() && simExpander.busOutputPort == busBefore;
+
+    simExpander.failing = false;
+    helioController.updatePinExpanders(); // next tick, flush retried
+    bool flushed = !expander->hasPendingWrites() && bitRead(simExpander.busOutputPort, 0) == (state == HIGH);
+
+    getLogger()->logMessage(F("testSyncFailure: kept pending: "), keptPending ? F("true") : F("false"), String(F(", flushed: ")) + String(flushed ? F("true") : F("false")));
+    if (!keptPending || !flushed) {
+        getLogger()->logError(F("testSyncFailure: "), F("Writes lost on failed sync"));
+    }
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    helioController.setPinExpander(0, SharedPtr<HelioPinExpander>(new HelioPinExpander(0, 16, &simExpander)));
+
+    HelioDigitalPin outputs[SETUP_TEST_OUTPUT_PINS];
+    HelioDigitalPin inputs[SETUP_TEST_INPUT_PINS];
+
+    for (uint8_t pinIndex = 0; pinIndex < SETUP_TEST_OUTPUT_PINS; ++pinIndex) {
+        outputs[pinIndex] = HelioDigitalPin(pinNumberForPinChannel(pinIndex), OUTPUT, pinIndex);
+        outputs[pinIndex].init();
+    }
+    for (uint8_t pinIndex = 0; pinIndex < SETUP_TEST_INPUT_PINS; ++pinIndex) {
+        uint8_t channel = SETUP_TEST_OUTPUT_PINS + pinIndex;
+        inputs[pinIndex] = HelioDigitalPin(pinNumberForPinChannel(channel), INPUT_PULLUP, channel);
+        inputs[pinIndex].init();
+    }
+
+    testTicks(outputs, inputs);
+    testSyncFailure(outputs);
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+#else
+
+void setup()
+{ ; }
+
+#endif // /ifdef HELIO_USE_MULTITASKING
+
+void loop()
+{ ; }
@@ -0,0 +1,181 @@
+// Binary log record tests script - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_LONG_TEXT_SIZE       300             // Long text argument length, in chars (past both record size and 8-bit lengths)
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Print sink that appends output onto a String
+class StringPrint : public Print {
+public:
+    String &str;
+
+    StringPrint(String &strIn) : str(strIn) { ; }
+
+    virtual size_t write(uint8_t data) override { str.concat((char)data); return 1; }
+};
+
+// Tests encoding then decoding a record of every argument type, which should come back as-is
+void testRoundTrip()
+{
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    HelioLogRecord record(Helio_LogLevel_Warnings, HStr_Log_SystemUptime, (hkey_t)0x1234ABCD,
+                          HelioLogArg(-5), HelioLogArg(7U), HelioLogArg(1.5f), HelioLogArg("abc"));
+    HelioLogRecord decoded;
+
+    uint8_t length = record.encode(buffer);
+    if (length != record.getEncodedSize() || decoded.decode(buffer, length) != length) {
+        getLogger()->logError(F("testRoundTrip: "), F("Encoded length mismatch"));
+        return;
+    }
+    if (decoded.level != record.level || decoded.timestamp != record.timestamp || decoded.msgId != record.msgId ||
+        decoded.objKey != record.objKey || decoded.argCount != record.argCount) {
+        getLogger()->logError(F("testRoundTrip: "), F("Record fields mismatch"));
+    }
+    if (decoded.args[0].type != Helio_LogArgType_Int || decoded.args[0].intValue != -5 ||
+        decoded.args[1].type != Helio_LogArgType_UInt || decoded.args[1].uintValue != 7 ||
+        decoded.args[2].type != Helio_LogArgType_Float || !isFPEqual(decoded.args[2].floatValue, 1.5f) ||
+        decoded.args[3].type != Helio_LogArgType_Text || decoded.args[3].textLength != 3 || memcmp(decoded.args[3].text, "abc", 3)) {
+        getLogger()->logError(F("testRoundTrip: "), F("Argument mismatch"));
+    }
+
+    String recordText, decodedText;
+    { StringPrint recordOut(recordText); record.printTo(recordOut); }
+    { StringPrint decodedOut(decodedText); decoded.printTo(decodedOut); }
+    if (recordText != decodedText) {
+        getLogger()->logError(F("testRoundTrip: "), F("Formatted text mismatch: "), decodedText);
+    }
+
+    getLogger()->logMessage(F("testRoundTrip: encoded bytes: "), String(length), String(F(", text: ")) + decodedText);
+}
+
+// Tests long text argument, which keeps its full length in memory (for direct .txt writes) but is truncated to fit once encoded
+void testTruncation()
+{
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    String longText; longText.reserve(SETUP_TEST_LONG_TEXT_SIZE);
+    for (int charIndex = 0; charIndex < SETUP_TEST_LONG_TEXT_SIZE; ++charIndex) { longText.concat((char)('a' + charIndex % 26)); }
+    HelioLogRecord record(Helio_LogLevel_Info, HStr_Count, hkey_none, HelioLogArg(longText));
+    HelioLogRecord decoded;
+
+    if (record.args[0].textLength != SETUP_TEST_LONG_TEXT_SIZE || record.getEncodedSize() != 13 + 2 + SETUP_TEST_LONG_TEXT_SIZE) {
+        getLogger()->logError(F("testTruncation: "), F("Text length clamped in memory"));
+    }
+
+    String recordText;
+    { StringPrint recordOut(recordText); record.printTo(recordOut); }
+    if (!recordText.endsWith(longText)) {
+        getLogger()->logError(F("testTruncation: "), F("Formatted text truncated"));
+    }
+
+    uint8_t length = record.encode(buffer);
+    if (length != HELIO_LOG_RECORD_MAXSIZE || decoded.decode(buffer, length) != length) {
+        getLogger()->logError(F("testTruncation: "), F("Encoded length mismatch"));
+    } else if (decoded.args[0].textLength != HELIO_LOG_RECORD_MAXSIZE - 15 ||
+               memcmp(decoded.args[0].text, longText.c_str(), decoded.args[0].textLength)) {
+        getLogger()->logError(F("testTruncation: "), F("Truncated text mismatch"));
+    }
+
+    // arguments that no longer fit once text fills record are dropped whole
+    HelioLogRecord overfull(Helio_LogLevel_Info, HStr_Count, hkey_none, HelioLogArg(longText), HelioLogArg(42));
+    length = overfull.encode(buffer);
+    if (length > HELIO_LOG_RECORD_MAXSIZE || !decoded.decode(buffer, length) || decoded.argCount != 1) {
+        getLogger()->logError(F("testTruncation: "), F("Overfull record mismatch"));
+    }
+
+    getLogger()->logMessage(F("testTruncation: text chars: "), String(record.args[0].textLength), String(F(", encoded chars: ")) + String(decoded.args[0].textLength));
+}
+
+// Tests decoding of malformed records, which should be rejected
+void testMalformed()
+{
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    HelioLogRecord record(Helio_LogLevel_Errors, HStr_Count, hkey_none, HelioLogArg("text"));
+    HelioLogRecord decoded;
+    uint8_t length = record.encode(buffer);
+
+    if (decoded.decode(buffer, length - 1)) { // length byte past buffer
+        getLogger()->logError(F("testMalformed: "), F("Short buffer accepted"));
+    }
+    buffer[14] = 0xFF; // text length past record
+    if (decoded.decode(buffer, length)) {
+        getLogger()->logError(F("testMalformed: "), F("Overlong text accepted"));
+    }
+    buffer[13] = (uint8_t)Helio_LogArgType_Count; // unknown argument type
+    if (decoded.decode(buffer, length)) {
+        getLogger()->logError(F("testMalformed: "), F("Unknown argument type accepted"));
+    }
+
+    getLogger()->logMessage(F("testMalformed: done"));
+}
+
+// Tests log events built from records, which should keep suffix positions even when suffix1 is empty
+void testEventFields()
+{
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    String msg(F("msg")), suffix1, suffix2(F("suffix2"));
+    HelioLogRecord record(Helio_LogLevel_Info, HStr_Count, hkey_none, HelioLogArg(msg), HelioLogArg(suffix1), HelioLogArg(suffix2));
+    HelioLogRecord decoded;
+
+    HelioLogEvent event(record);
+    if (event.msg != msg || event.suffix1.length() || event.suffix2 != suffix2) {
+        getLogger()->logError(F("testEventFields: "), F("Suffix positions not kept"));
+    }
+
+    uint8_t length = record.encode(buffer);
+    if (!decoded.decode(buffer, length)) {
+        getLogger()->logError(F("testEventFields: "), F("Decode failed"));
+    } else {
+        HelioLogEvent decodedEvent(decoded);
+        if (decodedEvent.msg != msg || decodedEvent.suffix1.length() || decodedEvent.suffix2 != suffix2) {
+            getLogger()->logError(F("testEventFields: "), F("Decoded suffix positions not kept"));
+        }
+    }
+
+    getLogger()->logMessage(F("testEventFields: done"));
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    testRoundTrip();
+    testTruncation();
+    testMalformed();
+    testEventFields();
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
@@ -0,0 +1,309 @@
+// Log ring tests script - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_RING_SIZE            256             // Log ring capacity, in bytes (power of 2)
+#define SETUP_TEST_WRAP_BYTES           150000UL        // Minimum # of bytes pushed through ring in wrap test (past 16-bit positions, twice over)
+#define SETUP_TEST_GARBAGE_RUNS         200             // # of garbage control blocks recovered from
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+HelioLogRingControl ringControl;                        // External ring control block, as if in no-init RAM
+uint8_t ringData[SETUP_TEST_RING_SIZE];                 // External ring data, as if in no-init RAM
+
+// Encodes test record carrying its sequence # into buffer. Returns encoded length.
+uint8_t encodeRecord(uint8_t *buffer, long sequence)
+{
+    HelioLogRecord record(Helio_LogLevel_Info, HStr_Count, hkey_none, HelioLogArg(sequence), HelioLogArg((unsigned long)(sequence * 7)));
+    return record.encode(buffer);
+}
+
+// Returns sequence # of encoded test record, else -1 if malformed
+long decodeSequence(const uint8_t *buffer, uint8_t length)
+{
+    HelioLogRecord record;
+    return record.decode(buffer, length) && record.argCount == 2 && record.args[1].uintValue == (uint32_t)(record.args[0].intValue * 7) ? record.args[0].intValue : -1;
+}
+
+// Drains all undrained records, checking they come out in sequence from expected onwards. Returns # drained, or -1 if out of sequence.
+int drainInSequence(HelioLogRing &ring, long *expected)
+{
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    uint16_t position = ring.getDrainPosition();
+    uint8_t length;
+    int drained = 0;
+
+    while ((length = ring.drainNext(&position, buffer))) {
+        if (decodeSequence(buffer, length) != *expected) { return -1; }
+        ++*expected; ++drained;
+    }
+    ring.commitDrain(position);
+
+    return drained;
+}
+
+// Tests ring fills then drops (never overwriting undrained records), drains in order, and retains drained records until reclaimed
+void testFIFO()
+{
+    HelioLogRing ring(SETUP_TEST_RING_SIZE);
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    uint8_t recordLength = encodeRecord(buffer, 0);
+    int pushed = 0;
+
+    for (long sequence = 0; sequence < 100; ++sequence) {
+        if (ring.push(buffer, encodeRecord(buffer, sequence))) { ++pushed; }
+    }
+    if (pushed != SETUP_TEST_RING_SIZE / recordLength || ring.getRecordsDropped() != 100 - pushed) {
+        getLogger()->logError(F("testFIFO: "), F("Push/drop count mismatch"));
+    }
+
+    long expected = 0;
+    if (drainInSequence(ring, &expected) != pushed || ring.hasUndrained() || ring.getRecordCount() != pushed) {
+        getLogger()->logError(F("testFIFO: "), F("Drain mismatch"));
+    }
+
+    // next push reclaims oldest drained record only
+    HelioLogRecord record;
+    if (!ring.push(buffer, encodeRecord(buffer, 1000)) || ring.getRecordCount() != pushed ||
+        !ring.readRecord(0, &record, buffer) || record.args[0].intValue != 1 ||
+        !ring.readRecord(ring.getRecordCount() - 1, &record, buffer) || record.args[0].intValue != 1000) {
+        getLogger()->logError(F("testFIFO: "), F("Reclaim mismatch"));
+    }
+
+    getLogger()->logMessage(F("testFIFO: record bytes: "), String(recordLength), String(F(", pushed: ")) + String(pushed));
+}
+
+// Tests pushing and draining in uneven batches long enough for 16-bit ring positions to wrap, which should stay in sequence
+void testWrap()
+{
+    HelioLogRing ring(SETUP_TEST_RING_SIZE);
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    long next = 0, expected = 0;
+    uint32_t bytesPushed = 0;
+    int wraps = 0;
+
+    randomSeed(1234);
+    while (bytesPushed < SETUP_TEST_WRAP_BYTES) {
+        for (int batchIndex = random(5); batchIndex > 0; --batchIndex) {
+            uint8_t length = encodeRecord(buffer, next);
+            if (ring.push(buffer, length)) { ++next; bytesPushed += length; }
+        }
+        if (random(2)) {
+            uint16_t positionBefore = ring.getDrainPosition();
+            if (drainInSequence(ring, &expected) < 0) {
+                getLogger()->logError(F("testWrap: "), F("Out of sequence at: "), String(expected));
+                return;
+            }
+            if (ring.getDrainPosition() < positionBefore) { ++wraps; }
+        }
+    }
+    if (drainInSequence(ring, &expected) < 0 || expected != next) {
+        getLogger()->logError(F("testWrap: "), F("Final drain mismatch"));
+    }
+    if (wraps < 2) {
+        getLogger()->logError(F("testWrap: "), F("Positions never wrapped"));
+    }
+
+    getLogger()->logMessage(F("testWrap: records: "), String(next), String(F(", position wraps: ")) + String(wraps));
+}
+
+// Tests committing only part of a drain (as logger does when a record fails to write out), which should keep the rest undrained
+void testPartialDrain()
+{
+    HelioLogRing ring(SETUP_TEST_RING_SIZE);
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+
+    for (long sequence = 0; sequence < 5; ++sequence) { ring.push(buffer, encodeRecord(buffer, sequence)); }
+
+    uint16_t position = ring.getDrainPosition();
+    uint16_t written = position;
+    uint8_t length;
+    for (int recordIndex = 0; recordIndex < 2 && (length = ring.drainNext(&position, buffer)); ++recordIndex) { written = position; }
+    ring.drainNext(&position, buffer); // read out but not written
+    ring.commitDrain(written);
+
+    long expected = 2;
+    if (drainInSequence(ring, &expected) != 3 || expected != 5) {
+        getLogger()->logError(F("testPartialDrain: "), F("Uncommitted records lost"));
+    }
+
+    getLogger()->logMessage(F("testPartialDrain: done"));
+}
+
+// Tests dropping oldest undrained records to make room (as logger does while storage is unavailable), which should keep newest in sequence
+void testDropOldest()
+{
+    HelioLogRing ring(SETUP_TEST_RING_SIZE);
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    long next = 0;
+    uint16_t dropped = 0;
+
+    for (; next < 100; ++next) {
+        uint8_t length = encodeRecord(buffer, next);
+        if (!ring.hasRoom(length)) { dropped += ring.dropUndrained(length); }
+        if (!ring.push(buffer, length)) {
+            getLogger()->logError(F("testDropOldest: "), F("Push failed at: "), String(next));
+            return;
+        }
+    }
+
+    long expected = next - ring.getRecordCount();
+    int drained = drainInSequence(ring, &expected);
+    if (drained != ring.getRecordCount() || expected != next || ring.getRecordsDropped() != dropped || dropped != next - drained) {
+        getLogger()->logError(F("testDropOldest: "), F("Newest records not kept in sequence"));
+    }
+
+    getLogger()->logMessage(F("testDropOldest: kept: "), String(drained), String(F(", dropped: ")) + String(dropped));
+}
+
+// Tests reading records by sequence # while pushes reclaim records (as an interrupting push may mid-print), which should skip reclaimed records rather than shift onto others
+void testReadBySequence()
+{
+    HelioLogRing ring(SETUP_TEST_RING_SIZE);
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    HelioLogRecord record;
+    long next = 0;
+
+    for (; ring.push(buffer, encodeRecord(buffer, next)); ++next) { ; }
+    long expected = 0;
+    drainInSequence(ring, &expected);
+
+    uint16_t oldestSequence = ring.getOldestSequence();
+    uint16_t recordCount = ring.getRecordCount();
+    int read = 0, skipped = 0;
+    bool inSequence = true;
+
+    for (uint16_t recordIndex = 0; recordIndex < recordCount; ++recordIndex) {
+        if (recordIndex == 2) { // reclaims 4 oldest records, as if interrupted by pushes
+            for (int pushIndex = 0; pushIndex < 4; ++pushIndex) { ring.push(buffer, encodeRecord(buffer, next++)); }
+        }
+
+        if (ring.readRecordSeq(oldestSequence + recordIndex, &record, buffer)) {
+            inSequence = inSequence && record.args[0].intValue == recordIndex;
+            ++read;
+        } else {
+            ++skipped;
+        }
+    }
+
+    if (!inSequence || skipped != 2 || read + skipped != recordCount) {
+        getLogger()->logError(F("testReadBySequence: "), F("Reclaimed records not skipped"));
+    }
+
+    getLogger()->logMessage(F("testReadBySequence: read: "), String(read), String(F(", skipped: ")) + String(skipped));
+}
+
+// Tests recovering ring from external storage left valid by a warm reset, which should keep undrained records in sequence
+void testRecoverValid()
+{
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    long expected = 0;
+    memset(&ringControl, 0xA5, sizeof(ringControl)); memset(ringData, 0x5A, sizeof(ringData));
+
+    {   HelioLogRing ring(&ringControl, ringData, SETUP_TEST_RING_SIZE); // cold boot
+        if (ring.getRecordsRecovered() || ring.getRecordCount() || ring.hasUndrained()) {
+            getLogger()->logError(F("testRecoverValid: "), F("Cold boot ring not empty"));
+        }
+        for (long sequence = 0; sequence < 40; ++sequence) {
+            ring.push(buffer, encodeRecord(buffer, sequence));
+            if (sequence % 3 == 0 && sequence < 35) { drainInSequence(ring, &expected); }
+        }
+    }
+
+    uint16_t undrained = 0;
+    {   HelioLogRing ring(&ringControl, ringData, SETUP_TEST_RING_SIZE); // warm reset
+        undrained = ring.getRecordsRecovered();
+        if (!undrained || drainInSequence(ring, &expected) != undrained || expected != 40) {
+            getLogger()->logError(F("testRecoverValid: "), F("Recovered records mismatch"));
+        }
+    }
+
+    {   HelioLogRing ring(&ringControl, ringData, SETUP_TEST_RING_SIZE / 2); // capacity changed
+        if (ring.getRecordsRecovered() || ring.getRecordCount()) {
+            getLogger()->logError(F("testRecoverValid: "), F("Capacity mismatch recovered"));
+        }
+    }
+
+    getLogger()->logMessage(F("testRecoverValid: recovered: "), String(undrained));
+}
+
+// Tests recovering ring from garbage external storage (with and without a valid signature), which should start empty
+void testRecoverGarbage()
+{
+    uint8_t buffer[HELIO_LOG_RECORD_MAXSIZE];
+    int recoveredRuns = 0;
+
+    randomSeed(4321);
+    for (int runIndex = 0; runIndex < SETUP_TEST_GARBAGE_RUNS; ++runIndex) {
+        for (unsigned byteIndex = 0; byteIndex < sizeof(ringData); ++byteIndex) { ringData[byteIndex] = random(256); }
+        for (unsigned byteIndex = 0; byteIndex < sizeof(ringControl); ++byteIndex) { ((uint8_t *)&ringControl)[byteIndex] = random(256); }
+        if (runIndex & 1) { ringControl.signature = HelioLogRing::Signature ^ SETUP_TEST_RING_SIZE; }
+
+        HelioLogRing ring(&ringControl, ringData, SETUP_TEST_RING_SIZE);
+        if (ring.getRecordsRecovered()) { ++recoveredRuns; }
+
+        // whatever was kept must drain as well-formed records, and ring must remain usable
+        uint16_t position = ring.getDrainPosition();
+        uint8_t length;
+        while ((length = ring.drainNext(&position, buffer))) {
+            HelioLogRecord record;
+            if (!record.decode(buffer, length)) {
+                getLogger()->logError(F("testRecoverGarbage: "), F("Malformed record recovered, run: "), String(runIndex));
+                break;
+            }
+        }
+        ring.commitDrain(position);
+        if (!ring.push(buffer, encodeRecord(buffer, runIndex))) {
+            getLogger()->logError(F("testRecoverGarbage: "), F("Ring unusable after recovery, run: "), String(runIndex));
+        }
+    }
+
+    getLogger()->logMessage(F("testRecoverGarbage: runs: "), String(SETUP_TEST_GARBAGE_RUNS), String(F(", runs recovering records: ")) + String(recoveredRuns));
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    testFIFO();
+    testWrap();
+    testPartialDrain();
+    testDropOldest();
+    testReadBySequence();
+    testRecoverValid();
+    testRecoverGarbage();
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
@@ -0,0 +1,166 @@
+// MQTT packed publishing benchmarks script against a local broker stand-in, comparing packets and bytes sent per frame - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_COLUMNS              8               // # of data columns (sensors) per frame
+#define SETUP_TEST_FRAMES               100             // # of polling frames published per benchmark
+#define SETUP_TEST_COALESCE             4               // # of frames coalesced per packed message, for coalescing benchmarks
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Local MQTT broker stand-in that discards messages, counting PUBLISH packets and their on-wire
+// bytes (2 byte fixed header + 2 byte topic length + topic + payload, at QoS 0)
+class BrokerStandIn {
+public:
+    uint32_t packets;
+    uint32_t bytes;
+
+    BrokerStandIn() : packets(0), bytes(0) { ; }
+
+    bool publish(const char *topic, const char *payload, int length) {
+        ++packets;
+        bytes += 2 + (length + 2 + strlen(topic) > 127 ? 1 : 0) + 2 + strlen(topic) + length;
+        return true;
+    }
+    bool publish(const char *topic, const char *payload) { return publish(topic, payload, strlen(payload)); }
+};
+
+// Fills data columns with a plausible spread of sensor values for frame
+void fillColumns(HelioDataColumn *dataColumns, int frameIndex)
+{
+    for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+        dataColumns[columnIndex].measurement.value = (columnIndex * 37.5f) + sinf((frameIndex + columnIndex) * 0.1f) * 12.25f;
+    }
+}
+
+void logResults(const __FlashStringHelper *name, BrokerStandIn &broker, uint32_t elapsed)
+{
+    getLogger()->logMessage(name, String(F("frames: ")) + String(SETUP_TEST_FRAMES), String(F(", columns: ")) + String(SETUP_TEST_COLUMNS));
+    getLogger()->logMessage(F("  Packets: "), String(broker.packets), String(F(", bytes: ")) + String(broker.bytes) + String(F(", bytes/frame: ")) + String((float)broker.bytes / SETUP_TEST_FRAMES, 1));
+    getLogger()->logMessage(F("  us/frame: "), String((float)elapsed / SETUP_TEST_FRAMES, 1));
+}
+
+// Benchmarks one message per sensor per frame, as HelioPublisher does in PerSensor mode
+void benchmarkPerSensor(HelioDataColumn *dataColumns)
+{
+    BrokerStandIn broker;
+    String topic = helioController.getSystemName();
+    topic.reserve(topic.length() + 1 + HELIO_NAME_MAXSIZE);
+    topic.concat('/');
+    int prefixLength = topic.length();
+    uint32_t elapsed = 0;
+
+    for (int frameIndex = 0; frameIndex < SETUP_TEST_FRAMES; ++frameIndex) {
+        fillColumns(dataColumns, frameIndex);
+
+        uint32_t start = micros();
+        for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+            topic.remove(prefixLength);
+            topic.concat(F("Sensor")); topic.concat(columnIndex);
+            String payload = String(dataColumns[columnIndex].measurement.value, 6);
+            broker.publish(topic.c_str(), payload.c_str());
+        }
+        elapsed += micros() - start;
+    }
+
+    if (broker.packets != SETUP_TEST_FRAMES * SETUP_TEST_COLUMNS) {
+        getLogger()->logError(F("benchmarkPerSensor: "), F("Packet count mismatch"));
+    }
+    logResults(F("benchmarkPerSensor: "), broker, elapsed);
+}
+
+// Benchmarks one packed message per coalesceFrames frames, as HelioPublisher does in packed modes
+void benchmarkPacked(HelioDataColumn *dataColumns, Helio_MQTTPublishMode publishMode, uint8_t coalesceFrames)
+{
+    BrokerStandIn broker;
+    HelioMQTTPayloadWriter payloadWriter;
+    String topic = helioController.getSystemName() + String(F("/data"));
+    uint32_t elapsed = 0;
+    payloadWriter.setPublishMode(publishMode);
+
+    for (int frameIndex = 0; frameIndex < SETUP_TEST_FRAMES; ++frameIndex) {
+        fillColumns(dataColumns, frameIndex);
+
+        uint32_t start = micros();
+        uint16_t length = 0;
+        if (!payloadWriter.addFrame(unixNow() + frameIndex, dataColumns, SETUP_TEST_COLUMNS)) {
+            auto payload = payloadWriter.finish(&length);
+            if (payload) { broker.publish(topic.c_str(), (const char *)payload, length); }
+            payloadWriter.clear();
+
+            if (!payloadWriter.addFrame(unixNow() + frameIndex, dataColumns, SETUP_TEST_COLUMNS)) {
+                getLogger()->logError(F("benchmarkPacked: "), F("Frame exceeds payload buffer"));
+                return;
+            }
+        }
+        if (payloadWriter.getFrameCount() >= coalesceFrames) {
+            auto payload = payloadWriter.finish(&length);
+            if (payload) { broker.publish(topic.c_str(), (const char *)payload, length); }
+            payloadWriter.clear();
+        }
+        elapsed += micros() - start;
+    }
+    uint16_t length = 0;
+    auto payload = payloadWriter.finish(&length); // any remainder
+    if (payload) { broker.publish(topic.c_str(), (const char *)payload, length); }
+
+    if (broker.packets <(SETUP_TEST_FRAMES + coalesceFrames - 1) / coalesceFrames) {
+        getLogger()->logError(F("benchmarkPacked: "), F("Packet count too low"));
+    }
+    logResults(publishMode == Helio_MQTTPublishMode_PackedBinary ? (coalesceFrames > 1 ? F("benchmarkPackedBinary (coalesced): ") : F("benchmarkPackedBinary: "))
+                                                                 : (coalesceFrames > 1 ? F("benchmarkPackedJSON (coalesced): ") : F("benchmarkPackedJSON: ")),
+               broker, elapsed);
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    HelioDataColumn *dataColumns = new HelioDataColumn[SETUP_TEST_COLUMNS];
+    for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+        dataColumns[columnIndex].sensorKey = (hkey_t)columnIndex;
+        dataColumns[columnIndex].measurement.units = Helio_UnitsType_Raw_1;
+    }
+
+    benchmarkPerSensor(dataColumns);
+    benchmarkPacked(dataColumns, Helio_MQTTPublishMode_PackedJSON, 1);
+    benchmarkPacked(dataColumns, Helio_MQTTPublishMode_PackedBinary, 1);
+    benchmarkPacked(dataColumns, Helio_MQTTPublishMode_PackedJSON, SETUP_TEST_COALESCE);
+    benchmarkPacked(dataColumns, Helio_MQTTPublishMode_PackedBinary, SETUP_TEST_COALESCE);
+
+    delete [] dataColumns;
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
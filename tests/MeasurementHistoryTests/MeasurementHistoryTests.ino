@@ -0,0 +1,159 @@
+// Measurement history tests script checking rolling statistics against brute-force recomputation - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_CAPACITY             7               // History window capacity (odd, so wraparound doesn't line up with sample pattern)
+#define SETUP_TEST_SAMPLES              500             // # of samples pushed per test (many ring revolutions)
+#define SETUP_TEST_OFFSET               20000.0f        // Large baseline offset, where non-recentered float sums lose precision
+#define SETUP_TEST_TOLERANCE            0.001f          // Allowed relative error of mean/variance vs brute-force
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Returns if value is within relative (or for small values, absolute) tolerance of expected
+bool isNear(float value, double expected, float scale = 1.0f)
+{
+    return fabs(value - expected) <= SETUP_TEST_TOLERANCE * max((double)scale, fabs(expected));
+}
+
+// Checks history's window statistics against brute-force recomputation over its last pushed samples
+// (held oldest-first in recent), returning success
+bool checkWindow(const HelioMeasurementHistory &history, const float *recent, int count, float scale)
+{
+    double sum = 0, sumSq = 0;
+    float minValue = recent[0], maxValue = recent[0];
+    for (int index = 0; index < count; ++index) {
+        sum += recent[index];
+        minValue = min(minValue, recent[index]);
+        maxValue = max(maxValue, recent[index]);
+    }
+    double mean = sum / count;
+    for (int index = 0; index < count; ++index) { sumSq += (recent[index] - mean) * (recent[index] - mean); }
+    double variance = sumSq / count;
+
+    return history.getCount() == count &&
+           history.getMin() == minValue && history.getMax() == maxValue &&
+           history.getLatest() == recent[count - 1] && history.getSample(count - 1) == recent[0] &&
+           isNear(history.getMean(), mean, scale) &&
+           isNear(history.getVariance(), variance, scale * scale);
+}
+
+// Pushes generated samples through history, checking statistics after every push across ring
+// wraparound and recentering, returning # of failed checks
+template<typename Generator>
+int runWindow(HelioMeasurementHistory &history, Generator generator, float scale)
+{
+    float recent[SETUP_TEST_CAPACITY];
+    int count = 0, failures = 0;
+
+    for (int sampleIndex = 0; sampleIndex < SETUP_TEST_SAMPLES; ++sampleIndex) {
+        float value = generator(sampleIndex);
+        history.push(value, (millis_t)(sampleIndex + 1) * 1000);
+
+        if (count < SETUP_TEST_CAPACITY) { recent[count++] = value; }
+        else { memmove(&recent[0], &recent[1], sizeof(float) * (SETUP_TEST_CAPACITY - 1)); recent[SETUP_TEST_CAPACITY - 1] = value; }
+
+        if (!checkWindow(history, recent, count, scale)) { ++failures; }
+    }
+
+    return failures;
+}
+
+// Tests min/max deques with noisy values, including duplicates and monotonic runs that
+// fully drain one deque while filling the other, with step changes between runs
+void testMinMax()
+{
+    HelioMeasurementHistory history(SETUP_TEST_CAPACITY);
+    int failures = runWindow(history, [](int index) -> float {
+        if ((index / 40) % 3 == 1) { return (float)index; }         // rising run
+        if ((index / 40) % 3 == 2) { return (float)(-index); }      // falling run
+        return (float)((index * 7919) % 13) - 6.0f;                 // noise, with repeats
+    }, 1.0f);
+
+    getLogger()->logMessage(F("testMinMax: samples: "), String(SETUP_TEST_SAMPLES), String(F(", failures: ")) + String(failures));
+    if (failures) { getLogger()->logError(F("testMinMax: "), F("Window min/max mismatch")); }
+}
+
+// Tests mean/variance with small noise atop a large offset, which only stays accurate due
+// to sums being taken about an offset near the window's values
+void testOffset()
+{
+    HelioMeasurementHistory history(SETUP_TEST_CAPACITY);
+    int failures = runWindow(history, [](int index) -> float {
+        return SETUP_TEST_OFFSET + sinf(index * 0.7f) * 2.5f;
+    }, 1.0f);
+
+    getLogger()->logMessage(F("testOffset: mean: "), String(history.getMean(), 3), String(F(", stddev: ")) + String(history.getStdDeviation(), 3) + String(F(", failures: ")) + String(failures));
+    if (failures) { getLogger()->logError(F("testOffset: "), F("Window mean/variance mismatch")); }
+}
+
+// Tests mean/variance with a drifting baseline that leaves the previous offset far behind,
+// which relies on recentering once per ring revolution
+void testDrift()
+{
+    HelioMeasurementHistory history(SETUP_TEST_CAPACITY);
+    int failures = runWindow(history, [](int index) -> float {
+        return index * 150.0f + ((index * 31) % 5);
+    }, 1.0f);
+
+    getLogger()->logMessage(F("testDrift: mean: "), String(history.getMean(), 1), String(F(", rate/s: ")) + String(history.getRateOfChange(), 1) + String(F(", failures: ")) + String(failures));
+    if (failures) { getLogger()->logError(F("testDrift: "), F("Window mean/variance mismatch")); }
+    if (fabsf(history.getRateOfChange() - 150.0f) > 1.0f) { getLogger()->logError(F("testDrift: "), F("Rate of change mismatch")); }
+}
+
+// Tests clearing then refilling, which must not carry over old offset, sums, or deques
+void testClear()
+{
+    HelioMeasurementHistory history(SETUP_TEST_CAPACITY);
+    for (int sampleIndex = 0; sampleIndex < SETUP_TEST_CAPACITY * 3 + 2; ++sampleIndex) { history.push(SETUP_TEST_OFFSET + sampleIndex); }
+    history.clear();
+
+    int failures = history.isEmpty() && !history.getMin() && !history.getMax() && !history.getMean() ? 0 : 1;
+    failures += runWindow(history, [](int index) -> float { return (float)((index * 13) % 9); }, 1.0f);
+
+    getLogger()->logMessage(F("testClear: failures: "), String(failures));
+    if (failures) { getLogger()->logError(F("testClear: "), F("Stale state after clear")); }
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    testMinMax();
+    testOffset();
+    testDrift();
+    testClear();
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
@@ -0,0 +1,127 @@
+// Driver motion profile tests script against simulated actuator plant - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_TRAVEL_RATE          60.0f           // Max travel rate, in distance units / min
+#define SETUP_TEST_MAX_ACCEL            0.5f            // Max acceleration, in distance units / sec^2
+#define SETUP_TEST_MAX_JERK             1.0f            // Max jerk, in distance units / sec^3
+#define SETUP_TEST_MOVE_DISTANCE        10.0f           // Move distance, in distance units
+#define SETUP_TEST_ALIGNED_RANGE        0.05f           // Aligned to target range, in distance units
+#define SETUP_TEST_NEARBY_RANGE         0.5f            // Nearby target range (fine travel), in distance units
+#define SETUP_TEST_MAX_SIMSECS          300             // Max simulated time per move, in seconds
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Simulated variable speed actuator plant with first-order velocity lag (motor + panel inertia)
+struct SimulatedActuator {
+    float position;
+    float velocity;
+    float responseTime;
+
+    SimulatedActuator(float responseTimeIn) : position(0), velocity(0), responseTime(responseTimeIn) { ; }
+
+    // Steps plant by dt secs under commanded velocity, returning realized acceleration
+    float step(float commandVelocity, float dt) {
+        float velocityWas = velocity;
+        velocity += (commandVelocity - velocity) * (1.0f - expf(-dt / responseTime));
+        position += velocity * dt;
+        return (velocity - velocityWas) / dt;
+    }
+};
+
+// Runs single move against simulated plant, with bang-bang fine/coarse control (as in prior
+// incremental driver) if shape is undefined, else with motion profile of given shape.
+void testMove(int shape, float plantResponseTime, float profileResponseTime)
+{
+    const float dt = HELIO_CONTROL_LOOP_INTERVAL / 1000.0f;
+    HelioMotionProfile profile(shape >= 0 ? (HelioMotionProfile::Shape)shape : HelioMotionProfile::Linear,
+                               SETUP_TEST_TRAVEL_RATE / SECS_PER_MIN, SETUP_TEST_MAX_ACCEL, SETUP_TEST_MAX_JERK, profileResponseTime);
+    SimulatedActuator plant(plantResponseTime);
+    float target = SETUP_TEST_MOVE_DISTANCE;
+    float overshoot = 0, peakAccel = 0, settleTime = -1;
+    int activations = 0;
+    bool activated = false;
+
+    for (int stepIndex = 0; stepIndex < (int)(SETUP_TEST_MAX_SIMSECS / dt); ++stepIndex) {
+        float distance = target - plant.position;
+        bool activate = fabsf(distance) > SETUP_TEST_ALIGNED_RANGE;
+        float commandVelocity = 0;
+
+        if (activate) {
+            if (shape >= 0) {
+                commandVelocity = profile.update(distance, dt);
+            } else {
+                commandVelocity = (distance > 0 ? 1.0f : -1.0f) * (SETUP_TEST_TRAVEL_RATE / SECS_PER_MIN) *
+                                  (fabsf(distance) <= SETUP_TEST_NEARBY_RANGE ? HELIO_DRV_FINETRAVEL_RATEMULT : 1.0f);
+            }
+        } else {
+            profile.reset();
+        }
+        if (activate != activated) {
+            activated = activate;
+            if (activated) { ++activations; }
+        }
+
+        peakAccel = max(peakAccel, fabsf(plant.step(commandVelocity, dt)));
+        overshoot = max(overshoot, plant.position - target);
+
+        if (fabsf(target - plant.position) > SETUP_TEST_ALIGNED_RANGE || fabsf(plant.velocity) > 0.01f) { settleTime = -1; }
+        else if (settleTime < 0) { settleTime = stepIndex * dt; }
+    }
+
+    getLogger()->logMessage(F("testMove: shape: "), shape == HelioMotionProfile::Trapezoidal ? F("Trapezoidal") : shape == HelioMotionProfile::SCurve ? F("SCurve") : shape == HelioMotionProfile::Linear ? F("Linear") : F("BangBang"),
+                            String(F(", plant/profile response (s): ")) + String(plantResponseTime, 2) + String(F("/")) + String(profileResponseTime, 2));
+    getLogger()->logMessage(F("  Settle time (s): "), String(settleTime, 1), String(F(", overshoot: ")) + String(overshoot, 3));
+    getLogger()->logMessage(F("  Activations: "), String(activations), String(F(", peak accel: ")) + String(peakAccel, 3));
+    if (settleTime < 0) {
+        getLogger()->logError(F("testMove: "), F("Failed to settle"));
+    }
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    const float plantResponseTimes[] = { 0.05f, 0.5f, 1.0f };
+    for (int plantIndex = 0; plantIndex < 3; ++plantIndex) {
+        testMove(-1, plantResponseTimes[plantIndex], 0);
+        testMove(HelioMotionProfile::Linear, plantResponseTimes[plantIndex], 0);
+        testMove(HelioMotionProfile::Trapezoidal, plantResponseTimes[plantIndex], 0);
+        testMove(HelioMotionProfile::Trapezoidal, plantResponseTimes[plantIndex], plantResponseTimes[plantIndex]);
+        testMove(HelioMotionProfile::SCurve, plantResponseTimes[plantIndex], plantResponseTimes[plantIndex]);
+    }
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
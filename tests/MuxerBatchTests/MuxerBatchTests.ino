@@ -0,0 +1,142 @@
+// Muxer batch access tests script driving pin muxers over unconnected channel select bus pins - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_MUXER_PINS           A0, A1          // Muxer signal pins (read as analog inputs)
+#define SETUP_TEST_SELECT_PINS          2, 3, 4, 5, 6, 7, 8, 9 // Muxer channel select bus pins, 4 per muxer (leave unconnected, read back as driven)
+#define SETUP_TEST_SWEEPS               10              // Number of sweeps over pin set
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Reads back muxer channel select bus lines, as currently driven on its output pins
+uint8_t readSelectLines(const pintype_t *selectPins)
+{
+    uint8_t lines = 0;
+    for (int bitIndex = 0; bitIndex < 4; ++bitIndex) { bitWrite(lines, bitIndex, digitalRead(selectPins[bitIndex]) == HIGH ? 1 : 0); }
+    return lines;
+}
+
+// Returns # of select bus lines that differ between passed line states
+int countToggledLines(uint8_t lines, uint8_t prevLines)
+{
+    int toggled = 0;
+    for (lines ^= prevLines; lines; lines >>= 1) { toggled += lines & 1; }
+    return toggled;
+}
+
+// Sweeps pin set in passed order, as either individual reads or a batch read, logging select line
+// toggles and elapsed time (which includes each channel switch's settle delay)
+void testSweeps(HelioAnalogPin pinSet[], uint8_t pinCount, uint8_t distinctCount, bool useBatch)
+{
+    const pintype_t muxerPins[] = { SETUP_TEST_MUXER_PINS };
+    pintype_t selectPins[] = { SETUP_TEST_SELECT_PINS };
+    SharedPtr<HelioPinMuxer> muxers[2]; // also owned by controller, replacing any prior test's muxers
+    uint8_t lines[2];
+    HelioAnalogPin **pins = new HelioAnalogPin*[pinCount];
+    int *rawReads = new int[pinCount];
+    uint8_t switches = 0;
+    int toggles = 0;
+    bool linesMatch = true;
+
+    for (int muxIndex = 0; muxIndex < 2; ++muxIndex) {
+        muxers[muxIndex] = SharedPtr<HelioPinMuxer>(new HelioPinMuxer(HelioPin(HelioPin::Analog, muxerPins[muxIndex], Helio_PinMode_Analog_Input), &selectPins[muxIndex * 4], 4));
+        muxers[muxIndex]->init();
+        helioController.setPinMuxer(muxerPins[muxIndex], muxers[muxIndex]);
+        lines[muxIndex] = readSelectLines(&selectPins[muxIndex * 4]);
+    }
+
+    uint32_t start = micros();
+    for (int sweepIndex = 0; sweepIndex < SETUP_TEST_SWEEPS; ++sweepIndex) {
+        for (uint8_t pinIndex = 0; pinIndex < pinCount; ++pinIndex) { pins[pinIndex] = &pinSet[pinIndex]; }
+
+        if (useBatch) {
+            switches = analogReadBatch_raw(pins, rawReads, pinCount);
+        } else {
+            for (uint8_t pinIndex = 0; pinIndex < pinCount; ++pinIndex) {
+                rawReads[pinIndex] = pins[pinIndex]->analogRead_raw();
+                int muxIndex = pins[pinIndex]->pin == muxerPins[0] ? 0 : 1;
+                uint8_t pinLines = readSelectLines(&selectPins[muxIndex * 4]);
+                toggles += countToggledLines(pinLines, lines[muxIndex]);
+                lines[muxIndex] = pinLines;
+                linesMatch = linesMatch && pinLines == muxerChannelForPinChannel(pins[pinIndex]->channel);
+            }
+        }
+        for (int muxIndex = 0; muxIndex < 2; ++muxIndex) {
+            uint8_t muxLines = readSelectLines(&selectPins[muxIndex * 4]);
+            toggles += countToggledLines(muxLines, lines[muxIndex]); // batch reads only observed per sweep
+            lines[muxIndex] = muxLines;
+            linesMatch = linesMatch && muxLines == muxers[muxIndex]->getSelectedChannel();
+        }
+    }
+    uint32_t elapsed = micros() - start;
+
+    getLogger()->logMessage(F("testSweeps: "), useBatch ? F("Batch") : F("Individual"),
+                            String(F(", pins: ")) + String(pinCount) + String(F(", sweeps: ")) + String(SETUP_TEST_SWEEPS));
+    getLogger()->logMessage(F("  Select line toggles: "), String(toggles),
+                            String(F(", elapsed us: ")) + String(elapsed) + String(F(" (settle us/switch: ")) + String(HELIO_MUXERS_SETTLE_MICROS) + String(F(")")));
+    if (!linesMatch) {
+        getLogger()->logError(F("testSweeps: "), F("Select lines don't match selected channel"));
+    }
+    if (useBatch && switches != distinctCount) {
+        getLogger()->logError(F("testSweeps: "), F("Batch order revisits channels"));
+    }
+
+    delete [] rawReads;
+    delete [] pins;
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    // Two panels' LDR quads and position pots spread across two muxers, in registration order,
+    // with two channels accessed twice (e.g. a sensor also read directly by a balancer)
+    const pintype_t muxerPins[] = { SETUP_TEST_MUXER_PINS };
+    const int muxerIndicies[] = { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1 };
+    const uint8_t muxerChannels[] = { 5, 2, 0, 7, 10, 3, 6, 12, 1, 9, 5, 7 };
+    const uint8_t pinCount = 12;
+    const uint8_t distinctCount = 10;
+    HelioAnalogPin pinSet[pinCount];
+
+    for (uint8_t pinIndex = 0; pinIndex < pinCount; ++pinIndex) {
+        pinSet[pinIndex] = (HelioAnalogPin)HelioPin(HelioPin::Analog, muxerPins[muxerIndicies[pinIndex]], Helio_PinMode_Analog_Input,
+                                                    pinChannelForMuxerChannel(muxerChannels[pinIndex]));
+    }
+
+    testSweeps(pinSet, pinCount, distinctCount, false);
+    testSweeps(pinSet, pinCount, distinctCount, true);
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
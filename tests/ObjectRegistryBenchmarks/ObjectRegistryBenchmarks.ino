@@ -0,0 +1,195 @@
+// Object registry, attachment & shared pointer benchmarks script comparing type-partitioned registry against keyed map - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_LOOKUP_PASSES        16              // # of lookup passes over all object keys per benchmark
+#define SETUP_TEST_ITERATE_PASSES       16              // # of full-loop iteration passes per benchmark
+#define SETUP_TEST_DEREF_COUNT          10000           // # of attachment dereferences per benchmark
+#define SETUP_TEST_PTR_COPIES           8               // # of shared pointer copies held per pass (build with/without HELIO_ENABLE_INTRUSIVE_PTR to compare)
+#define SETUP_TEST_PTR_PASSES           1000            // # of shared pointer copy/destroy passes
+#define SETUP_TEST_PTR_OBJECTS          16              // # of objects allocated for per-object memory measurement
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Benchmarks objectById-style key lookup and a sensor-only full loop (as dataLoop) at N objects,
+// against both the type-partitioned registry and the previous key-ordered map object store.
+template<size_t N>
+void benchmarkRegistry()
+{
+    HelioObjectRegistry<N> *registry = new HelioObjectRegistry<N>();
+    Map<hkey_t, SharedPtr<HelioObject>, N> *objects = new Map<hkey_t, SharedPtr<HelioObject>, N>();
+    hkey_t *keys = new hkey_t[N];
+    HELIO_SOFT_ASSERT(registry && objects && keys, SFP(HStr_Err_AllocationFailure));
+    if (!registry || !objects || !keys) { return; }
+
+    for (size_t index = 0; index < N; ++index) {
+        HelioIdentity id(String(F("Bench")) + String(index));
+        id.type = (typeof(id.type))(index % (HelioIdentity::Rail + 1));
+        auto obj = SharedPtr<HelioObject>(new HelioObject(id));
+        keys[index] = obj->getKey();
+        registry->insert(obj);
+        (*objects)[keys[index]] = obj;
+    }
+
+    volatile uint32_t found = 0;
+    uint32_t start = micros();
+    for (int pass = 0; pass < SETUP_TEST_LOOKUP_PASSES; ++pass) {
+        for (size_t index = 0; index < N; ++index) {
+            auto iter = objects->find(keys[index]);
+            if (iter != objects->end()) { found = found + 1; }
+        }
+    }
+    uint32_t mapLookup = micros() - start;
+
+    start = micros();
+    for (int pass = 0; pass < SETUP_TEST_LOOKUP_PASSES; ++pass) {
+        for (size_t index = 0; index < N; ++index) {
+            if (registry->find(keys[index])) { found = found + 1; }
+        }
+    }
+    uint32_t registryLookup = micros() - start;
+
+    start = micros();
+    for (int pass = 0; pass < SETUP_TEST_ITERATE_PASSES; ++pass) {
+        for (auto iter = objects->begin(); iter != objects->end(); ++iter) {
+            if (iter->second->isSensorType()) { found = found + 1; }
+        }
+    }
+    uint32_t mapIterate = micros() - start;
+
+    start = micros();
+    for (int pass = 0; pass < SETUP_TEST_ITERATE_PASSES; ++pass) {
+        for (auto iter = registry->getSensors().begin(); iter != registry->getSensors().end(); ++iter) {
+            if (*iter) { found = found + 1; }
+        }
+    }
+    uint32_t registryIterate = micros() - start;
+
+    getLogger()->logMessage(F("benchmarkRegistry: objects: "), String(N), String(F(", registered: ")) + String(registry->size()));
+    getLogger()->logMessage(F("  Lookup (us/op) map: "), String((float)mapLookup / (SETUP_TEST_LOOKUP_PASSES * N), 3),
+                            String(F(", registry: ")) + String((float)registryLookup / (SETUP_TEST_LOOKUP_PASSES * N), 3));
+    getLogger()->logMessage(F("  Sensor loop (us/pass) map: "), String((float)mapIterate / SETUP_TEST_ITERATE_PASSES, 1),
+                            String(F(", registry: ")) + String((float)registryIterate / SETUP_TEST_ITERATE_PASSES, 1));
+
+    delete [] keys;
+    delete objects;
+    delete registry;
+}
+
+// Benchmarks attachment dereference cost via SharedPtr copying getObject() (prior get() path) against
+// handle validated get(), then checks that unregistering the object is detected as a dangling reference.
+void benchmarkAttachment()
+{
+    auto obj = SharedPtr<HelioObject>(new HelioObject(HelioIdentity(Helio_SensorType_LightIntensity, 0)));
+    helioController.registerObject(obj);
+    HelioAttachment attachment;
+    attachment.setObject(obj);
+
+    volatile uintptr_t checksum = 0;
+    uint32_t start = micros();
+    for (int derefIndex = 0; derefIndex < SETUP_TEST_DEREF_COUNT; ++derefIndex) {
+        checksum = checksum + (uintptr_t)attachment.getObject<HelioObject>().get();
+    }
+    uint32_t sharedDeref = micros() - start;
+
+    start = micros();
+    for (int derefIndex = 0; derefIndex < SETUP_TEST_DEREF_COUNT; ++derefIndex) {
+        checksum = checksum + (uintptr_t)attachment.get<HelioObject>();
+    }
+    uint32_t handleDeref = micros() - start;
+
+    helioController.unregisterObject(obj);
+    bool danglingDetected = !attachment.get<HelioObject>() && !attachment.isResolved();
+
+    getLogger()->logMessage(F("benchmarkAttachment: deref (us/op) getObject: "), String((float)sharedDeref / SETUP_TEST_DEREF_COUNT, 3),
+                            String(F(", get: ")) + String((float)handleDeref / SETUP_TEST_DEREF_COUNT, 3));
+    getLogger()->logMessage(F("  Dangling detected: "), danglingDetected ? F("true") : F("false"));
+    if (!danglingDetected) {
+        getLogger()->logError(F("benchmarkAttachment: "), F("Unregistered object still resolved"));
+    }
+}
+
+// Benchmarks SharedPtr copy/destroy throughput and measures per-object heap cost (object plus
+// any separately allocated control block) for whichever SharedPtr implementation is selected.
+void benchmarkSharedPtr()
+{
+    SharedPtr<HelioObject> *objects = new SharedPtr<HelioObject>[SETUP_TEST_PTR_OBJECTS];
+    HELIO_SOFT_ASSERT(objects, SFP(HStr_Err_AllocationFailure));
+    if (!objects) { return; }
+
+    auto memBefore = freeMemory();
+    for (int objIndex = 0; objIndex < SETUP_TEST_PTR_OBJECTS; ++objIndex) {
+        objects[objIndex] = SharedPtr<HelioObject>(new HelioObject(HelioIdentity(Helio_SensorType_LightIntensity, objIndex)));
+    }
+    auto memAfter = freeMemory();
+
+    SharedPtr<HelioObject> copies[SETUP_TEST_PTR_COPIES];
+    uint32_t start = micros();
+    for (int pass = 0; pass < SETUP_TEST_PTR_PASSES; ++pass) {
+        for (int copyIndex = 0; copyIndex < SETUP_TEST_PTR_COPIES; ++copyIndex) {
+            copies[copyIndex] = objects[(pass + copyIndex) % SETUP_TEST_PTR_OBJECTS];
+        }
+        for (int copyIndex = 0; copyIndex < SETUP_TEST_PTR_COPIES; ++copyIndex) {
+            copies[copyIndex] = nullptr;
+        }
+    }
+    uint32_t copyTime = micros() - start;
+
+    #ifdef HELIO_ENABLE_INTRUSIVE_PTR
+        getLogger()->logMessage(F("benchmarkSharedPtr: "), F("HelioRefPtr"));
+    #else
+        getLogger()->logMessage(F("benchmarkSharedPtr: "), F("arx::stdx::shared_ptr"));
+    #endif
+    getLogger()->logMessage(F("  Heap per object (B): "), memBefore != -1 ? String((float)(int)(memBefore - memAfter) / SETUP_TEST_PTR_OBJECTS, 1) : String(F("n/a")),
+                            String(F(", sizeof(HelioObject): ")) + String(sizeof(HelioObject)) + String(F(", sizeof(SharedPtr): ")) + String(sizeof(SharedPtr<HelioObject>)));
+    getLogger()->logMessage(F("  Copy+destroy (us/op): "), String((float)copyTime / (SETUP_TEST_PTR_PASSES * SETUP_TEST_PTR_COPIES), 3));
+
+    delete [] objects;
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    benchmarkRegistry<16>();
+    #if !defined(__AVR__) // larger sizes need more memory than AVR targets have available
+        benchmarkRegistry<256>();
+        benchmarkRegistry<4096>();
+    #endif
+    benchmarkAttachment();
+    benchmarkSharedPtr();
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
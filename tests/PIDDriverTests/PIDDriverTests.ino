@@ -0,0 +1,200 @@
+// PID driver tests script against simulated sticky actuator plant - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_TRAVEL_RATE          60.0f           // Max travel rate, in distance units / min
+#define SETUP_TEST_PID_GAINS            60.0f,10.0f,5.0f // PID gains (prop, int, deriv), in travel rate units
+#define SETUP_TEST_MOVE_DISTANCE        10.0f           // Move distance, in distance units
+#define SETUP_TEST_ALIGNED_RANGE        0.05f           // Aligned to target range, in distance units
+#define SETUP_TEST_NEARBY_RANGE         0.5f            // Nearby target range (fine travel), in distance units
+#define SETUP_TEST_MAX_SIMSECS          300             // Max simulated time per move, in seconds
+#define SETUP_TEST_MAX_DIFFERENCE       1.5f            // Max positional difference between synchronized actuators, in distance units
+#define SETUP_TEST_SYNC_STARTS          1.0f,0.0f       // Synchronized actuators' start positions (leading, trailing), in distance units
+#define SETUP_TEST_SYNC_SPEEDS          1.0f,0.8f       // Synchronized actuators' achieved fraction of commanded rate (leading, trailing)
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Simulated variable speed actuator plant with first-order velocity lag and stiction (motor
+// stalls whenever commanded below stiction fraction of max travel rate)
+struct SimulatedActuator {
+    float position;
+    float velocity;
+    float responseTime;
+    float stiction;
+
+    SimulatedActuator(float responseTimeIn, float stictionIn) : position(0), velocity(0), responseTime(responseTimeIn), stiction(stictionIn) { ; }
+
+    // Steps plant by dt secs under commanded velocity
+    void step(float commandVelocity, float dt) {
+        if (fabsf(commandVelocity) < stiction * (SETUP_TEST_TRAVEL_RATE / SECS_PER_MIN)) { commandVelocity = 0; }
+        velocity += (commandVelocity - velocity) * (1.0f - expf(-dt / responseTime));
+        position += velocity * dt;
+    }
+};
+
+// Runs single step response against simulated plant, with bang-bang fine/coarse control (as in
+// incremental driver) if not usePID, else with PID driver output.
+void testStepResponse(bool usePID, float plantResponseTime, float plantStiction)
+{
+    const float dt = HELIO_CONTROL_LOOP_INTERVAL / 1000.0f;
+    HelioPIDDriver driver(SETUP_TEST_PID_GAINS, HELIO_DRV_PID_DERIVFILTER, HELIO_DRV_PID_DEADBAND,
+                          SETUP_TEST_ALIGNED_RANGE, 2.5f, SETUP_TEST_TRAVEL_RATE);
+    SimulatedActuator plant(plantResponseTime, plantStiction);
+    float target = SETUP_TEST_MOVE_DISTANCE;
+    float overshoot = 0, settleTime = -1, lastOutput = 0;
+    int actuations = 0;
+
+    driver.setTargetSetpoint(target);
+
+    for (int stepIndex = 0; stepIndex < (int)(SETUP_TEST_MAX_SIMSECS / dt); ++stepIndex) {
+        float distance = target - plant.position;
+        float output = 0;
+
+        if (fabsf(distance) > SETUP_TEST_ALIGNED_RANGE) {
+            if (usePID) {
+                output = driver.updateOutput(plant.position, dt);
+            } else {
+                output = (distance > 0 ? 1.0f : -1.0f) * SETUP_TEST_TRAVEL_RATE *
+                         (fabsf(distance) <= SETUP_TEST_NEARBY_RANGE ? HELIO_DRV_FINETRAVEL_RATEMULT : 1.0f);
+            }
+        } else {
+            driver.resetOutput();
+        }
+        if ((isFPEqual(lastOutput, 0.0f) && !isFPEqual(output, 0.0f)) || lastOutput * output < 0) {
+            ++actuations;
+        }
+        lastOutput = output;
+
+        plant.step(output / SECS_PER_MIN, dt);
+        overshoot = max(overshoot, plant.position - target);
+
+        if (fabsf(target - plant.position) > SETUP_TEST_ALIGNED_RANGE || fabsf(plant.velocity) > 0.01f) { settleTime = -1; }
+        else if (settleTime < 0) { settleTime = stepIndex * dt; }
+    }
+
+    getLogger()->logMessage(F("testStepResponse: "), usePID ? F("PID") : F("BangBang"),
+                            String(F(", plant response (s): ")) + String(plantResponseTime, 2) + String(F(", stiction: ")) + String(plantStiction, 2));
+    getLogger()->logMessage(F("  Settle time (s): "), String(settleTime, 1), String(F(", overshoot: ")) + String(overshoot, 3));
+    getLogger()->logMessage(F("  Actuations: "), String(actuations), String(F(", final error: ")) + String(target - plant.position, 3));
+    if (settleTime < 0) {
+        getLogger()->logError(F("testStepResponse: "), F("Failed to settle"));
+    }
+}
+
+// Incremental driver exposing synchronized mode's rate multiplier and skew tracking, for use against simulated plants
+class SyncTestDriver : public HelioIncrementalDriver {
+public:
+    SyncTestDriver() : HelioIncrementalDriver(SETUP_TEST_NEARBY_RANGE, SETUP_TEST_ALIGNED_RANGE, SETUP_TEST_MAX_DIFFERENCE, SETUP_TEST_TRAVEL_RATE) { ; }
+    inline float syncRateMultiplier(float maxOffset, float offset) const { return getSyncRateMultiplier(maxOffset, offset); }
+    inline void trackSkew(float minPosition, float maxPosition) { updateSkew(minPosition, maxPosition); }
+};
+
+// Runs two variable speed actuators with different travel (start position & achieved speed) to a
+// common target, with per-actuator rates chosen as in incremental driver's handleMaxOffset, with
+// or without synchronized mode, checking that both arrive with skew kept within max difference.
+void testSyncArrival(bool useSync)
+{
+    const float dt = HELIO_CONTROL_LOOP_INTERVAL / 1000.0f;
+    const float starts[2] = { SETUP_TEST_SYNC_STARTS };
+    const float speeds[2] = { SETUP_TEST_SYNC_SPEEDS };
+    SyncTestDriver driver;
+    float positions[2] = { starts[0], starts[1] };
+    float lastRates[2] = { 0, 0 };
+    float target = SETUP_TEST_MOVE_DISTANCE;
+    float arrivalSkew = -1, arrivalTimes[2] = { -1, -1 };
+    int actuations = 0;
+
+    driver.setSyncGain(useSync ? HELIO_DRV_SYNC_LEADGAIN : 0);
+    driver.setTargetSetpoint(target);
+
+    for (int stepIndex = 0; stepIndex < (int)(SETUP_TEST_MAX_SIMSECS / dt) && (arrivalTimes[0] < 0 || arrivalTimes[1] < 0); ++stepIndex) {
+        float maxOffset = max(fabsf(target - positions[0]), fabsf(target - positions[1]));
+        float offsetLimit = maxOffset - SETUP_TEST_MAX_DIFFERENCE;
+        float commonRateMult = maxOffset <= SETUP_TEST_NEARBY_RANGE + FLT_EPSILON ? HELIO_DRV_FINETRAVEL_RATEMULT : 1.0f;
+
+        for (int actIndex = 0; actIndex < 2; ++actIndex) {
+            float offset = fabsf(target - positions[actIndex]);
+            float rate = 0;
+
+            if (offset <= SETUP_TEST_ALIGNED_RANGE + FLT_EPSILON || offset < offsetLimit - FLT_EPSILON) { // aligned or too fast
+                if (arrivalTimes[actIndex] < 0 && offset <= SETUP_TEST_ALIGNED_RANGE + FLT_EPSILON) {
+                    arrivalTimes[actIndex] = stepIndex * dt;
+                    if (arrivalSkew < 0) { arrivalSkew = driver.getSkew(); }
+                }
+            } else if (driver.isSynchronized()) {
+                rate = SETUP_TEST_TRAVEL_RATE * commonRateMult * driver.syncRateMultiplier(maxOffset, offset);
+            } else {
+                rate = SETUP_TEST_TRAVEL_RATE * (offset <= SETUP_TEST_NEARBY_RANGE + FLT_EPSILON ? HELIO_DRV_FINETRAVEL_RATEMULT : 1.0f);
+            }
+            if (isFPEqual(lastRates[actIndex], 0.0f) && !isFPEqual(rate, 0.0f)) { ++actuations; }
+            lastRates[actIndex] = rate;
+
+            positions[actIndex] += (target > positions[actIndex] ? 1.0f : -1.0f) * rate * speeds[actIndex] / SECS_PER_MIN * dt;
+        }
+        driver.trackSkew(min(positions[0], positions[1]), max(positions[0], positions[1]));
+    }
+
+    getLogger()->logMessage(F("testSyncArrival: "), useSync ? F("Synchronized") : F("Cutoff"),
+                            String(F(", sync gain: ")) + String(driver.getSyncGain(), 2) + String(F(", max difference: ")) + String(SETUP_TEST_MAX_DIFFERENCE, 2));
+    getLogger()->logMessage(F("  Arrival times (s): "), String(arrivalTimes[0], 1), String(F(", ")) + String(arrivalTimes[1], 1));
+    getLogger()->logMessage(F("  Peak skew: "), String(driver.getPeakSkew(), 3), String(F(", skew at first arrival: ")) + String(arrivalSkew, 3) + String(F(", actuations: ")) + String(actuations));
+    if (arrivalTimes[0] < 0 || arrivalTimes[1] < 0) {
+        getLogger()->logError(F("testSyncArrival: "), F("Actuators failed to arrive"));
+    }
+    if (useSync && (driver.getPeakSkew() > SETUP_TEST_MAX_DIFFERENCE + FLT_EPSILON || arrivalSkew > SETUP_TEST_MAX_DIFFERENCE + FLT_EPSILON)) {
+        getLogger()->logError(F("testSyncArrival: "), F("Skew exceeded max difference"));
+    }
+    if (useSync && actuations > 2) {
+        getLogger()->logError(F("testSyncArrival: "), F("Synchronized actuators start/stop chattered"));
+    }
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    const float plantResponseTimes[] = { 0.05f, 0.5f };
+    const float plantStictions[] = { 0.0f, 0.2f };
+    for (int plantIndex = 0; plantIndex < 2; ++plantIndex) {
+        for (int stictionIndex = 0; stictionIndex < 2; ++stictionIndex) {
+            testStepResponse(false, plantResponseTimes[plantIndex], plantStictions[stictionIndex]);
+            testStepResponse(true, plantResponseTimes[plantIndex], plantStictions[stictionIndex]);
+        }
+    }
+    testSyncArrival(false);
+    testSyncArrival(true);
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
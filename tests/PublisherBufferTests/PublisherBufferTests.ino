@@ -0,0 +1,215 @@
+// Publisher write-behind buffer tests script against a simulated slow file system - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_COLUMNS              8               // # of data columns per row
+#define SETUP_TEST_ROWS                 200             // # of rows written per test
+#define SETUP_TEST_BUFFER_SIZE          1024            // Write-behind buffer size, in bytes
+#define SETUP_TEST_CALL_DELAY           2000            // Simulated file write call overhead (open/seek/block read-modify-write), in microseconds
+#define SETUP_TEST_BYTE_DELAY           2               // Simulated file write per-byte cost, in microseconds
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Simulated slow data file that discards output, charging a fixed delay per write call plus a
+// per-byte delay, and tracking its file size and # of write calls
+class SlowFakeFile : public Print {
+public:
+    uint32_t size;
+    uint32_t calls;
+
+    SlowFakeFile() : size(0), calls(0) { ; }
+
+    virtual size_t write(uint8_t data) override { return write(&data, 1); }
+    virtual size_t write(const uint8_t *buffer, size_t length) override {
+        delayMicroseconds(SETUP_TEST_CALL_DELAY + SETUP_TEST_BYTE_DELAY * length);
+        ++calls; size += length;
+        return length;
+    }
+};
+
+// Print sink that appends output onto a String
+class StringPrint : public Print {
+public:
+    String &str;
+
+    StringPrint(String &strIn) : str(strIn) { ; }
+
+    virtual size_t write(uint8_t data) override { str.concat((char)data); return 1; }
+};
+
+// Prints row as .csv, as HelioPublisher::publish does per row
+void printRow(Print &out, time_t timestamp, int rowIndex)
+{
+    out.print(timestamp);
+    for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+        out.print(',');
+        out.print((columnIndex * 37.5f) + sinf((rowIndex + columnIndex) * 0.1f) * 12.25f);
+    }
+    out.println();
+}
+
+// Tests direct per-row writes, as done with write-behind buffer disabled (data loop bears full cost)
+void testDirect()
+{
+    SlowFakeFile dataFile;
+    time_t timestamp = unixNow();
+    uint32_t elapsed = 0, worst = 0;
+
+    for (int rowIndex = 0; rowIndex < SETUP_TEST_ROWS; ++rowIndex) {
+        String row; // built up front so direct path is charged a single write call per row (conservative baseline)
+        { StringPrint rowOut(row); printRow(rowOut, ++timestamp, rowIndex); }
+
+        uint32_t start = micros();
+        dataFile.write((const uint8_t *)row.c_str(), row.length());
+        uint32_t rowTime = micros() - start;
+        elapsed += rowTime; worst = max(worst, rowTime);
+    }
+
+    getLogger()->logMessage(F("testDirect: rows: "), String(SETUP_TEST_ROWS), String(F(", write calls: ")) + String(dataFile.calls));
+    getLogger()->logMessage(F("  Data loop us/row: "), String((float)elapsed / SETUP_TEST_ROWS, 1), String(F(", worst: ")) + String(worst));
+}
+
+// Tests write-behind buffered writes, with rows queued from data loop and flushed from misc loop
+void testBuffered()
+{
+    SlowFakeFile dataFile;
+    HelioPublishBuffer buffer(SETUP_TEST_BUFFER_SIZE);
+    time_t timestamp = unixNow();
+    uint32_t elapsed = 0, worst = 0, bytesQueued = 0;
+
+    for (int rowIndex = 0; rowIndex < SETUP_TEST_ROWS; ++rowIndex) {
+        uint32_t start = micros();
+        buffer.beginRow();
+        printRow(buffer, ++timestamp, rowIndex);
+        uint16_t depth = buffer.getDepth();
+        if (!buffer.endRow()) { buffer.recordDroppedRow(); }
+        bytesQueued += buffer.getDepth() - depth;
+        uint32_t rowTime = micros() - start;
+        elapsed += rowTime; worst = max(worst, rowTime);
+
+        // misc loop flush
+        uint32_t flushStart = micros();
+        uint16_t length = buffer.getFlushLength(dataFile.size);
+        if (length) {
+            buffer.writeOut(dataFile, length);
+            buffer.consume(length, micros() - flushStart);
+            if (dataFile.size % HELIO_PUBLISH_FLUSH_BLOCKSIZE) {
+                getLogger()->logError(F("testBuffered: "), F("Flush not block aligned"));
+            }
+        }
+    }
+    uint16_t length = buffer.getFlushLength(dataFile.size, true); // day change/shutdown
+    buffer.writeOut(dataFile, length);
+    buffer.consume(length);
+
+    getLogger()->logMessage(F("testBuffered: rows: "), String(buffer.getRowsQueued()), String(F(", write calls: ")) + String(dataFile.calls));
+    getLogger()->logMessage(F("  Data loop us/row: "), String((float)elapsed / SETUP_TEST_ROWS, 1), String(F(", worst: ")) + String(worst));
+    getLogger()->logMessage(F("  Peak depth: "), String(buffer.getPeakDepth()), String(F(", flushes: ")) + String(buffer.getFlushCount()) + String(F(", max flush us: ")) + String(buffer.getMaxFlushMicros()));
+    getLogger()->logMessage(F("  Rows dropped: "), String(buffer.getRowsDropped()));
+    if (dataFile.size != bytesQueued || buffer.getDepth()) {
+        getLogger()->logError(F("testBuffered: "), F("Flushed size mismatch"));
+    }
+}
+
+// Tests overflow handling when misc loop is starved, which should roll back whole rows only
+void testOverflow()
+{
+    HelioPublishBuffer buffer(SETUP_TEST_BUFFER_SIZE / 4);
+    time_t timestamp = unixNow();
+    int committed = 0;
+
+    for (int rowIndex = 0; rowIndex < SETUP_TEST_ROWS; ++rowIndex) {
+        buffer.beginRow();
+        printRow(buffer, ++timestamp, rowIndex);
+        if (buffer.endRow()) { ++committed; } else { buffer.recordDroppedRow(); }
+    }
+
+    getLogger()->logMessage(F("testOverflow: rows committed: "), String(committed), String(F(", dropped: ")) + String(buffer.getRowsDropped()));
+    if (committed + buffer.getRowsDropped() != SETUP_TEST_ROWS || buffer.getRowsQueued() != committed) {
+        getLogger()->logError(F("testOverflow: "), F("Row count mismatch"));
+    }
+
+    // every committed row must be whole, i.e. buffer ends on a newline
+    const uint8_t *data = nullptr;
+    uint16_t offset = 0, runLength;
+    uint8_t last = 0;
+    while ((runLength = buffer.peek(offset, &data))) { last = data[runLength - 1]; offset += runLength; }
+    if (offset != buffer.getDepth() || last != '\n') {
+        getLogger()->logError(F("testOverflow: "), F("Partial row committed"));
+    }
+}
+
+// Tests partial flushes keep the age of the oldest remaining row, rather than restarting it from flush time
+void testRemainderAge()
+{
+    HelioPublishBuffer buffer(SETUP_TEST_BUFFER_SIZE);
+    time_t timestamp = unixNow();
+
+    buffer.beginRow();
+    printRow(buffer, ++timestamp, 0);
+    buffer.endRow();
+    uint16_t firstLength = buffer.getDepth();
+    millis_t firstMillis = buffer.getOldestMillis();
+    delay(50);
+
+    buffer.beginRow();
+    printRow(buffer, ++timestamp, 1);
+    buffer.endRow();
+    delay(50);
+
+    buffer.consume(firstLength / 2); // partial row flush
+    if (buffer.getOldestMillis() != firstMillis) {
+        getLogger()->logError(F("testRemainderAge: "), F("Partially flushed row age changed"));
+    }
+
+    buffer.consume(firstLength - firstLength / 2);
+    millis_t secondAge = millis() - buffer.getOldestMillis();
+    getLogger()->logMessage(F("testRemainderAge: second row age ms: "), String(secondAge));
+    if (buffer.getOldestMillis() - firstMillis < 50 || secondAge < 50) {
+        getLogger()->logError(F("testRemainderAge: "), F("Remaining row age not kept"));
+    }
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    testDirect();
+    testBuffered();
+    testOverflow();
+    testRemainderAge();
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
@@ -0,0 +1,133 @@
+// Publisher data file format benchmarks script comparing bytes written and CPU per row of .csv against binary .dat - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_COLUMNS              12              // # of data columns per row
+#define SETUP_TEST_ROWS                 500             // # of rows written per benchmark
+#define SETUP_TEST_ROW_SECS             15              // Seconds between rows (polling interval)
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Print sink that discards output, counting bytes written (isolates encoding cost from storage cost)
+class CountingPrint : public Print {
+public:
+    uint32_t bytes;
+
+    CountingPrint() : bytes(0) { ; }
+
+    virtual size_t write(uint8_t) override { ++bytes; return 1; }
+    virtual size_t write(const uint8_t *buffer, size_t size) override { bytes += size; return size; }
+};
+
+// Fills data columns with a plausible spread of sensor values for row
+void fillColumns(HelioDataColumn *dataColumns, int rowIndex)
+{
+    for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+        dataColumns[columnIndex].measurement.value = (columnIndex * 37.5f) + sinf((rowIndex + columnIndex) * 0.1f) * 12.25f;
+    }
+}
+
+// Benchmarks writing rows as .csv, as HelioPublisher::publish does per row
+void benchmarkCSV(HelioDataColumn *dataColumns)
+{
+    CountingPrint out;
+    time_t timestamp = unixNow();
+    uint32_t elapsed = 0;
+
+    for (int rowIndex = 0; rowIndex < SETUP_TEST_ROWS; ++rowIndex) {
+        fillColumns(dataColumns, rowIndex);
+        timestamp += SETUP_TEST_ROW_SECS;
+
+        uint32_t start = micros();
+        out.print(timestamp);
+        for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+            out.print(',');
+            out.print(dataColumns[columnIndex].measurement.value);
+        }
+        out.println();
+        elapsed += micros() - start;
+    }
+
+    getLogger()->logMessage(F("benchmarkCSV: rows: "), String(SETUP_TEST_ROWS), String(F(", columns: ")) + String(SETUP_TEST_COLUMNS));
+    getLogger()->logMessage(F("  Bytes/row: "), String((float)out.bytes / SETUP_TEST_ROWS, 1), String(F(", us/row: ")) + String((float)elapsed / SETUP_TEST_ROWS, 1));
+}
+
+// Benchmarks writing rows as binary .dat, as HelioPublisher::publish does per row, plus header and footer
+void benchmarkBinary(HelioDataColumn *dataColumns)
+{
+    CountingPrint out;
+    HelioBinaryDataWriter writer;
+    time_t timestamp = unixNow();
+    uint32_t elapsed = 0;
+
+    uint32_t headerBytes = writer.writeHeader(out, dataColumns, SETUP_TEST_COLUMNS);
+    for (int rowIndex = 0; rowIndex < SETUP_TEST_ROWS; ++rowIndex) {
+        fillColumns(dataColumns, rowIndex);
+        timestamp += SETUP_TEST_ROW_SECS;
+
+        uint32_t start = micros();
+        uint16_t rowLength = 0;
+        const uint8_t *row = writer.encodeRow(timestamp, dataColumns, SETUP_TEST_COLUMNS, &rowLength);
+        if (row) { out.write(row, rowLength); }
+        elapsed += micros() - start;
+    }
+    uint32_t footerBytes = writer.writeFooter(out);
+    uint32_t rowBytes = out.bytes - headerBytes - footerBytes;
+
+    getLogger()->logMessage(F("benchmarkBinary: rows: "), String(SETUP_TEST_ROWS), String(F(", columns: ")) + String(SETUP_TEST_COLUMNS));
+    getLogger()->logMessage(F("  Bytes/row: "), String((float)rowBytes / SETUP_TEST_ROWS, 1), String(F(", us/row: ")) + String((float)elapsed / SETUP_TEST_ROWS, 1));
+    getLogger()->logMessage(F("  Header bytes: "), String(headerBytes), String(F(", footer bytes: ")) + String(footerBytes) + String(F(", index entries: ")) + String(writer.getIndexSize()));
+    if (writer.getFileOffset() != out.bytes - footerBytes) {
+        getLogger()->logError(F("benchmarkBinary: "), F("File offset mismatch"));
+    }
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    HelioDataColumn *dataColumns = new HelioDataColumn[SETUP_TEST_COLUMNS];
+    for (int columnIndex = 0; columnIndex < SETUP_TEST_COLUMNS; ++columnIndex) {
+        dataColumns[columnIndex].sensorKey = (hkey_t)columnIndex;
+        dataColumns[columnIndex].measurement.units = Helio_UnitsType_Raw_1;
+    }
+
+    benchmarkCSV(dataColumns);
+    benchmarkBinary(dataColumns);
+
+    delete [] dataColumns;
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
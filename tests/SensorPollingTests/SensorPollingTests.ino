@@ -0,0 +1,136 @@
+// Sensor polling policy tests script, checking that attachments polled every control tick only read sensors when due - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_INPUT_PINS           2, 3, 4         // Digital input pins of test sensors (fixed, adaptive, on-demand)
+#define SETUP_TEST_FRAMES               32              // # of polling frames run per test
+#define SETUP_TEST_INTERVAL             4               // Fixed polling interval, and adaptive max polling interval, in # of frames
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Binary sensor that counts the # of actual reads taken
+class CountingSensor : public HelioBinarySensor {
+public:
+    int reads;
+
+    CountingSensor(hposi_t sensorIndex, pintype_t inputPin)
+        : HelioBinarySensor(Helio_SensorType_IceDetector, sensorIndex, HelioDigitalPin(inputPin, INPUT_PULLUP, true)), reads(0) { ; }
+
+    virtual bool takeMeasurement(bool force = false) override {
+        bool retVal = HelioBinarySensor::takeMeasurement(force);
+        if (retVal) { ++reads; }
+        return retVal;
+    }
+};
+
+SharedPtr<CountingSensor> sensors[3];
+
+// Runs polling frames, polling sensor's attachment once per frame as control loop object updates do, returning # of reads taken
+int runFrames(SharedPtr<CountingSensor> sensor, int frames)
+{
+    HelioSensorAttachment attachment;
+    attachment.setObject(sensor);
+    attachment.updateIfNeeded(true); // initial read
+    sensor->reads = 0;
+
+    for (int frameIndex = 0; frameIndex < frames; ++frameIndex) {
+        getPublisher()->advancePollingFrame();
+        attachment.updateIfNeeded(true);
+        attachment.updateIfNeeded(true); // repeated polls in same frame shouldn't re-read
+    }
+
+    return sensor->reads;
+}
+
+void testFixed()
+{
+    sensors[0]->setPollingPolicy(Helio_PollingPolicy_Fixed, SETUP_TEST_INTERVAL);
+    int reads = runFrames(sensors[0], SETUP_TEST_FRAMES);
+    int expected = SETUP_TEST_FRAMES / SETUP_TEST_INTERVAL;
+
+    getLogger()->logMessage(F("testFixed: reads: "), String(reads), String(F(", expected: ")) + String(expected));
+    if (reads < expected - 1 || reads > expected + 1) {
+        getLogger()->logError(F("testFixed: "), F("Reads not taken at fixed interval"));
+    }
+}
+
+void testAdaptive()
+{
+    sensors[1]->setPollingPolicy(Helio_PollingPolicy_Adaptive, 1, SETUP_TEST_INTERVAL);
+    int reads = runFrames(sensors[1], SETUP_TEST_FRAMES);
+
+    // stable input backs off from every frame (1) to max interval, so reads land well under one per frame
+    getLogger()->logMessage(F("testAdaptive: reads: "), String(reads), String(F(", polling frames: ")) + String(sensors[1]->getPollingFrames()));
+    if (reads >= SETUP_TEST_FRAMES / 2 || sensors[1]->getPollingFrames() != SETUP_TEST_INTERVAL) {
+        getLogger()->logError(F("testAdaptive: "), F("Reads not backed off while stable"));
+    }
+}
+
+void testOnDemand()
+{
+    sensors[2]->setPollingPolicy(Helio_PollingPolicy_OnDemand);
+    int reads = runFrames(sensors[2], SETUP_TEST_FRAMES);
+
+    HelioSensorAttachment attachment;
+    attachment.setObject(sensors[2]);
+    attachment.updateIfNeeded(true);
+    int readsBefore = sensors[2]->reads;
+    attachment.setNeedsMeasurement(); // explicit request overrides polling policy
+    attachment.updateIfNeeded(true);
+    int explicitReads = sensors[2]->reads - readsBefore;
+
+    getLogger()->logMessage(F("testOnDemand: reads: "), String(reads), String(F(", explicit reads: ")) + String(explicitReads));
+    if (reads != 0 || explicitReads != 1) {
+        getLogger()->logError(F("testOnDemand: "), F("Reads not taken only on explicit request"));
+    }
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    const pintype_t inputPins[] = { SETUP_TEST_INPUT_PINS };
+    for (int sensorIndex = 0; sensorIndex < 3; ++sensorIndex) {
+        sensors[sensorIndex] = SharedPtr<CountingSensor>(new CountingSensor(sensorIndex, inputPins[sensorIndex]));
+        helioController.registerObject(sensors[sensorIndex]);
+    }
+    getPublisher()->advancePollingFrame(); // frame #0 reserved as undef
+
+    testFixed();
+    testAdaptive();
+    testOnDemand();
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }
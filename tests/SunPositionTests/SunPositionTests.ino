@@ -0,0 +1,393 @@
+// Sun position accuracy & benchmark tests script - mainly for dev purposes
+
+#include <Helioduino.h>
+
+// Pins & Class Instances
+#define SETUP_PIEZO_BUZZER_PIN          -1              // Piezo buzzer pin, else -1
+#define SETUP_EEPROM_DEVICE_TYPE        None            // EEPROM device type/size (AT24LC01, AT24LC02, AT24LC04, AT24LC08, AT24LC16, AT24LC32, AT24LC64, AT24LC128, AT24LC256, AT24LC512, None)
+#define SETUP_EEPROM_I2C_ADDR           0b000           // EEPROM i2c address (A0-A2, bitwise or'ed with base address 0x50)
+#define SETUP_RTC_DEVICE_TYPE           None            // RTC device type (DS1307, DS3231, PCF8523, PCF8563, None)
+#define SETUP_SD_CARD_SPI               SPI             // SD card SPI class instance
+#define SETUP_SD_CARD_SPI_CS            -1              // SD card CS pin, else -1
+#define SETUP_SD_CARD_SPI_SPEED         F_SPD           // SD card SPI speed, in Hz (ignored on Teensy)
+#define SETUP_I2C_WIRE                  Wire            // I2C wire class instance
+#define SETUP_I2C_SPEED                 400000U         // I2C speed, in Hz
+#define SETUP_ESP_I2C_SDA               SDA             // I2C SDA pin, if on ESP
+#define SETUP_ESP_I2C_SCL               SCL             // I2C SCL pin, if on ESP
+
+// Test Settings
+#define SETUP_TEST_YEAR                 2023            // Year to run tests across
+#define SETUP_TEST_DAY_STEP             3               // Day step across year (1 = every day, slowest)
+#define SETUP_TEST_TIME_STEP            97              // Time step across day, in seconds (odd so as to land between samples)
+#define SETUP_TEST_BATCH_SIZE           (HAS_LARGE_SRAM ? 256 : 16) // Batch kernel array size
+#define SETUP_TEST_BATCH_ROUNDS         (HAS_LARGE_SRAM ? 64 : 8) // Batch kernel benchmark rounds
+
+Helioduino helioController((pintype_t)SETUP_PIEZO_BUZZER_PIN,
+                           JOIN(Helio_EEPROMType,SETUP_EEPROM_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)SETUP_EEPROM_I2C_ADDR, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           JOIN(Helio_RTCType,SETUP_RTC_DEVICE_TYPE),
+                           I2CDeviceSetup((uint8_t)0b000, &SETUP_I2C_WIRE, SETUP_I2C_SPEED),
+                           SPIDeviceSetup((pintype_t)SETUP_SD_CARD_SPI_CS, &SETUP_SD_CARD_SPI, SETUP_SD_CARD_SPI_SPEED));
+
+// Yields upon time limit exceed, so long running tests don't starve the watchdog or background tasks
+void yieldIfNeeded(millis_t &lastYield)
+{
+    millis_t time = millis();
+    if (time - lastYield >= HELIO_SYS_YIELD_AFTERMILLIS) {
+        lastYield = time; yield();
+    }
+}
+
+// Great-circle angle between two (azi,ele) positions, in degrees
+double angularError(const double *pos1, const double *pos2)
+{
+    double cosAngle = sin(radians(pos1[1])) * sin(radians(pos2[1])) +
+                      cos(radians(pos1[1])) * cos(radians(pos2[1])) * cos(radians(pos1[0] - pos2[0]));
+    return degrees(acos(constrain(cosAngle, -1.0, 1.0)));
+}
+
+void testEphemerisCache(double latitude, double longitude, uint8_t stepMins)
+{
+    HelioEphemerisCache ephemeris(stepMins);
+    time_t yearStart = unixTime(DateTime((uint16_t)SETUP_TEST_YEAR, 1, 1));
+    double directPos[2], cachedPos[2];
+    double maxError = 0, sumError = 0;
+    time_t maxErrorTime = 0;
+    uint32_t sampleCount = 0, directMicros = 0, cachedMicros = 0, rebuildMicros = 0;
+    millis_t lastYield = millis();
+
+    for (int dayIndex = 0; dayIndex < 365; dayIndex += SETUP_TEST_DAY_STEP) {
+        time_t dayStart = yearStart + (dayIndex * SECS_PER_DAY);
+
+        uint32_t startMicros = micros();
+        ephemeris.rebuild(dayStart, latitude, longitude);
+        rebuildMicros += micros() - startMicros;
+
+        for (time_t time = dayStart; time < dayStart + SECS_PER_DAY; time += SETUP_TEST_TIME_STEP) {
+            startMicros = micros();
+            calcSunPosition(time, latitude, longitude, directPos);
+            directMicros += micros() - startMicros;
+
+            startMicros = micros();
+            if (!ephemeris.lookup(time, cachedPos, latitude, longitude)) {
+                getLogger()->logError(F("testEphemerisCache: Lookup failure: "), String((unsigned long)time));
+                return;
+            }
+            cachedMicros += micros() - startMicros;
+
+            if (directPos[1] > 0) {
+                double error = angularError(directPos, cachedPos);
+                sumError += error;
+                ++sampleCount;
+                if (error > maxError) { maxError = error; maxErrorTime = time; }
+            }
+        }
+
+        yieldIfNeeded(lastYield);
+    }
+
+    getLogger()->logMessage(F("testEphemerisCache: lat/long: "), String(latitude, 2), String(F(", ")) + String(longitude, 2));
+    getLogger()->logMessage(F("  Step (mins): "), String(stepMins), String(F(", samples: ")) + String(ephemeris.getSampleCount()));
+    getLogger()->logMessage(F("  Avg error (deg): "), String(sampleCount ? sumError / sampleCount : 0.0, 6));
+    getLogger()->logMessage(F("  Max error (deg): "), String(maxError, 6), String(F(" @ ")) + DateTime((uint32_t)maxErrorTime).timestamp());
+    getLogger()->logMessage(F("  Direct time (us): "), String(directMicros));
+    getLogger()->logMessage(F("  Cached time (us): "), String(cachedMicros), String(F(" (+")) + String(rebuildMicros) + String(F(" rebuild)")));
+
+    if (maxError > HELIO_PANEL_ALIGN_DEGTOL) {
+        getLogger()->logError(F("testEphemerisCache: Max error exceeds alignment tolerance: "), String(maxError, 6));
+    }
+}
+
+void testSunPositionService(double latitude, double longitude)
+{
+    helioController.setSystemLocation(latitude, longitude);
+    time_t dayStart = unixTime(DateTime((uint16_t)SETUP_TEST_YEAR, 6, 21));
+    const double offsets[] = { 0.0, 0.00001, 0.0001, 0.001, 0.01, 0.1 }; // heliostat field (~1m) to bucket-wide
+    double maxError[sizeof(offsets) / sizeof(offsets[0])] = {0};
+    uint32_t calcCount = helioController.getSunPositionCalcCount();
+    uint32_t queryCount = helioController.getSunPositionQueryCount();
+    double sharedPos[2], directPos[2];
+
+    for (time_t time = dayStart; time < dayStart + SECS_PER_DAY; time += SETUP_TEST_TIME_STEP) {
+        helioController.updateSunPositions(time);
+
+        for (int offsetIndex = 0; offsetIndex < sizeof(offsets) / sizeof(offsets[0]); ++offsetIndex) {
+            double panelLatitude = latitude + offsets[offsetIndex];
+            double panelLongitude = longitude - offsets[offsetIndex];
+
+            helioController.getSunPosition(time, panelLatitude, panelLongitude, sharedPos);
+            calcSunPosition(time - (time % HELIO_SYS_SUNPOS_QUANTUM), panelLatitude, panelLongitude, directPos);
+
+            if (directPos[1] > 3) {
+                maxError[offsetIndex] = max(maxError[offsetIndex], angularError(directPos, sharedPos));
+            }
+        }
+    }
+
+    getLogger()->logMessage(F("testSunPositionService: lat/long: "), String(latitude, 2), String(F(", ")) + String(longitude, 2));
+    for (int offsetIndex = 0; offsetIndex < sizeof(offsets) / sizeof(offsets[0]); ++offsetIndex) {
+        getLogger()->logMessage(F("  Offset (deg): "), String(offsets[offsetIndex], 5), String(F(", max error (deg): ")) + String(maxError[offsetIndex], 6));
+    }
+    getLogger()->logMessage(F("  Full calcs: "), String(helioController.getSunPositionCalcCount() - calcCount),
+                            String(F(", queries: ")) + String(helioController.getSunPositionQueryCount() - queryCount));
+}
+
+void testSunPositionLookahead(double latitude, double longitude)
+{
+    helioController.setSystemLocation(latitude, longitude);
+    time_t dayStart = unixTime(DateTime((uint16_t)SETUP_TEST_YEAR, 6, 21));
+    const time_t leadTime = 60; // lookahead query, as panel sun-step planning makes
+    uint32_t calcCount = helioController.getSunPositionCalcCount();
+    uint32_t ticks = 0;
+    double position[2];
+
+    // current & lookahead queries interleaved each tick, as from several panels, should share entries rather than thrash them
+    for (time_t time = dayStart; time < dayStart + SECS_PER_DAY; time += SETUP_TEST_TIME_STEP, ++ticks) {
+        helioController.updateSunPositions(time);
+        for (int panelIndex = 0; panelIndex < 3; ++panelIndex) {
+            helioController.getSunPosition(time, latitude, longitude, position);
+            helioController.getSunPosition(time + leadTime, latitude, longitude, position);
+        }
+    }
+
+    uint32_t calcs = helioController.getSunPositionCalcCount() - calcCount;
+    getLogger()->logMessage(F("testSunPositionLookahead: Full calcs: "), String(calcs), String(F(", ticks: ")) + String(ticks));
+    if (calcs > ticks * 2) {
+        getLogger()->logError(F("testSunPositionLookahead: "), F("Lookahead queries thrashing shared entries"));
+    }
+}
+
+void testBatchKernel()
+{
+    static double julianDays[SETUP_TEST_BATCH_SIZE], latitudes[SETUP_TEST_BATCH_SIZE], longitudes[SETUP_TEST_BATCH_SIZE];
+    static double azimuths[SETUP_TEST_BATCH_SIZE], elevations[SETUP_TEST_BATCH_SIZE];
+    time_t yearStart = unixTime(DateTime((uint16_t)SETUP_TEST_YEAR, 1, 1));
+    time_t timeStep = (365UL * SECS_PER_DAY) / (SETUP_TEST_BATCH_SIZE * SETUP_TEST_BATCH_ROUNDS);
+    double maxError = 0, scalarPos[2], batchPos[2];
+    uint32_t batchMicros = 0, scalarMicros = 0, positions = 0;
+    millis_t lastYield = millis();
+
+    for (int round = 0; round < SETUP_TEST_BATCH_ROUNDS; ++round) {
+        for (int index = 0; index < SETUP_TEST_BATCH_SIZE; ++index) {
+            JulianDay julianTime((unsigned long)(yearStart + ((round * SETUP_TEST_BATCH_SIZE) + index) * timeStep));
+            julianDays[index] = julianTime.JD + julianTime.m;
+            latitudes[index] = -60.0 + ((index * 7) % 121);
+            longitudes[index] = -180.0 + ((index * 13) % 360);
+        }
+
+        uint32_t startMicros = micros();
+        calcSunPositions(julianDays, latitudes, longitudes, azimuths, elevations, SETUP_TEST_BATCH_SIZE);
+        batchMicros += micros() - startMicros;
+
+        for (int index = 0; index < SETUP_TEST_BATCH_SIZE; ++index) {
+            time_t time = yearStart + ((round * SETUP_TEST_BATCH_SIZE) + index) * timeStep;
+            startMicros = micros();
+            calcSunPosition(time, latitudes[index], longitudes[index], scalarPos);
+            scalarMicros += micros() - startMicros;
+
+            batchPos[0] = azimuths[index]; batchPos[1] = elevations[index];
+            maxError = max(maxError, angularError(scalarPos, batchPos));
+        }
+        positions += SETUP_TEST_BATCH_SIZE;
+
+        yieldIfNeeded(lastYield);
+    }
+
+    getLogger()->logMessage(F("testBatchKernel: positions: "), String(positions), String(F(", max error (deg): ")) + String(maxError, 9));
+    getLogger()->logMessage(F("  Batch (pos/sec): "), String(batchMicros ? (positions * 1000000.0) / batchMicros : 0.0, 1));
+    getLogger()->logMessage(F("  Scalar (pos/sec): "), String(scalarMicros ? (positions * 1000000.0) / scalarMicros : 0.0, 1));
+
+    if (maxError > 0.0001) {
+        getLogger()->logError(F("testBatchKernel: Batch kernel disagrees with scalar path: "), String(maxError, 9));
+    }
+}
+
+void testFloatPath(double latitude, double longitude)
+{
+    time_t yearStart = unixTime(DateTime((uint16_t)SETUP_TEST_YEAR, 1, 1));
+    double doublePos[2], floatPosD[2];
+    float floatPos[2];
+    double maxError = 0;
+    uint32_t doubleMicros = 0, floatMicros = 0, sampleCount = 0;
+    millis_t lastYield = millis();
+
+    for (int dayIndex = 0; dayIndex < 365; dayIndex += SETUP_TEST_DAY_STEP) {
+        time_t dayStart = yearStart + (dayIndex * SECS_PER_DAY);
+
+        for (time_t time = dayStart; time < dayStart + SECS_PER_DAY; time += SETUP_TEST_TIME_STEP * 10) {
+            JulianDay julianTime((unsigned long)time);
+            uint32_t startMicros = micros();
+            calcHorizontalCoordinates(julianTime, latitude, longitude, doublePos[0], doublePos[1]);
+            doubleMicros += micros() - startMicros;
+
+            startMicros = micros();
+            calcSunPositionFloat(time, (float)latitude, (float)longitude, floatPos);
+            floatMicros += micros() - startMicros;
+
+            if (doublePos[1] > 0) {
+                floatPosD[0] = floatPos[0]; floatPosD[1] = floatPos[1];
+                maxError = max(maxError, angularError(doublePos, floatPosD));
+            }
+            ++sampleCount;
+        }
+
+        yieldIfNeeded(lastYield);
+    }
+
+    getLogger()->logMessage(F("testFloatPath: lat/long: "), String(latitude, 2), String(F(", ")) + String(longitude, 2));
+    getLogger()->logMessage(F("  Worst-case error (deg): "), String(maxError, 6), String(sizeof(double) == sizeof(float) ? F(" (note: double is float on this device)") : F("")));
+    getLogger()->logMessage(F("  Double time (us/calc): "), String(sampleCount ? doubleMicros / (float)sampleCount : 0.0f, 2));
+    getLogger()->logMessage(F("  Float time (us/calc): "), String(sampleCount ? floatMicros / (float)sampleCount : 0.0f, 2));
+}
+
+// Tracking panel with ideal axis drives that are always aligned upon poll
+class IdealTrackingPanel : public HelioTrackingPanel {
+public:
+    IdealTrackingPanel() : HelioTrackingPanel(Helio_PanelType_Gimballed, 0) { setInDaytimeMode(true); }
+    virtual bool isAligned(bool poll = false) override {
+        if (poll) { recalcSunPosition(); recalcFacingPosition(); return true; }
+        return HelioTrackingPanel::isAligned(poll);
+    }
+    inline const float *getFacingPosition() const { return _facingPosition; }
+};
+
+void testWakeSchedule(double latitude, double longitude, float sunStepLead)
+{
+    helioController.setSystemLocation(latitude, longitude);
+    IdealTrackingPanel panel;
+    panel.setSunStepLead(sunStepLead);
+    time_t dayStart = unixTime(DateTime((uint16_t)SETUP_TEST_YEAR, 6, 21));
+    uint64_t simMillis = 0;
+    uint32_t updateCount = 0;
+    double maxFacingError = 0;
+    time_t origTime = unixNow();
+
+    while (simMillis < SECS_PER_DAY * 1000ULL) {
+        time_t time = dayStart + (time_t)(simMillis / 1000);
+        setTime(time);
+        helioController.updateSunPositions(time);
+
+        double sunPos[2];
+        calcSunPosition(time, latitude, longitude, sunPos);
+        if (panel.isDaylight() && sunPos[1] > 0) { // facing error just before panel re-aligns
+            double facingPos[2] = { panel.getFacingPosition()[0], panel.getFacingPosition()[1] };
+            maxFacingError = max(maxFacingError, angularError(sunPos, facingPos));
+        }
+        panel.setInDaytimeMode(sunPos[1] > 0);
+        panel.update();
+        ++updateCount;
+
+        millis_t wakeDelay = min((millis_t)HELIO_CONTROL_LOOP_MAXSLEEP, panel.getWakeDelay());
+        simMillis += max(wakeDelay, (millis_t)HELIO_CONTROL_LOOP_INTERVAL); // next control loop tick at/after deadline
+    }
+    setTime(origTime);
+
+    getLogger()->logMessage(F("testWakeSchedule: lat/long: "), String(latitude, 2), String(F(", ")) + String(longitude, 2));
+    getLogger()->logMessage(F("  Sun-step lead (deg): "), String(sunStepLead, 2));
+    getLogger()->logMessage(F("  Fixed-rate updates/day: "), String((uint32_t)(SECS_PER_DAY * 1000UL / HELIO_CONTROL_LOOP_INTERVAL)));
+    getLogger()->logMessage(F("  Scheduled updates/day: "), String(updateCount));
+    getLogger()->logMessage(F("  Planned moves/day: "), String(panel.getPlannedMoveCount()),
+                            String(F(", travel (deg): ")) + String(panel.getPlannedTravel(0), 1) + String(F(", ")) + String(panel.getPlannedTravel(1), 1));
+    getLogger()->logMessage(F("  Max facing error (deg): "), String(maxFacingError, 4),
+                            String(F(", tolerance (deg): ")) + String(HELIO_PANEL_ALIGN_DEGTOL, 4));
+    if (maxFacingError > HELIO_PANEL_ALIGN_DEGTOL * 1.5f) {
+        getLogger()->logError(F("testWakeSchedule: "), F("Facing error exceeded alignment tolerance"));
+    }
+}
+
+// Reflecting panel with ideal axis drives that are always aligned upon poll
+class IdealReflectingPanel : public HelioReflectingPanel {
+public:
+    IdealReflectingPanel() : HelioReflectingPanel(Helio_PanelType_Gimballed, 1) { setInDaytimeMode(true); }
+    virtual bool isAligned(bool poll = false) override {
+        if (poll) { recalcSunPosition(); recalcFacingPosition(); return true; }
+        return HelioReflectingPanel::isAligned(poll);
+    }
+    inline const float *getFacingPosition() const { return _facingPosition; }
+    inline void getFacingTarget(const double *sunPosition, float *facingPositionOut) const { calcFacingTarget(sunPosition, facingPositionOut); }
+};
+
+void testReflectingWakeSchedule(double latitude, double longitude, float sunStepLead)
+{
+    helioController.setSystemLocation(latitude, longitude);
+    IdealReflectingPanel panel;
+    const float reflectPosition[2] = { 0.0f, 10.0f }; // receiver due north, slightly raised
+    panel.setReflectPosition(reflectPosition);
+    panel.setSunStepLead(sunStepLead);
+    time_t dayStart = unixTime(DateTime((uint16_t)SETUP_TEST_YEAR, 6, 21));
+    uint64_t simMillis = 0;
+    uint32_t updateCount = 0;
+    double maxFacingError = 0;
+    time_t origTime = unixNow();
+
+    while (simMillis < SECS_PER_DAY * 1000ULL) {
+        time_t time = dayStart + (time_t)(simMillis / 1000);
+        setTime(time);
+        helioController.updateSunPositions(time);
+
+        double sunPos[2];
+        calcSunPosition(time, latitude, longitude, sunPos);
+        if (panel.isDaylight() && sunPos[1] > 0) { // facing error from bisector target just before panel re-aligns
+            float target[2];
+            panel.getFacingTarget(sunPos, target);
+            double targetPos[2] = { target[0], target[1] };
+            double facingPos[2] = { panel.getFacingPosition()[0], panel.getFacingPosition()[1] };
+            maxFacingError = max(maxFacingError, angularError(targetPos, facingPos));
+        }
+        panel.setInDaytimeMode(sunPos[1] > 0);
+        panel.update();
+        ++updateCount;
+
+        millis_t wakeDelay = min((millis_t)HELIO_CONTROL_LOOP_MAXSLEEP, panel.getWakeDelay());
+        simMillis += max(wakeDelay, (millis_t)HELIO_CONTROL_LOOP_INTERVAL);
+    }
+    setTime(origTime);
+
+    getLogger()->logMessage(F("testReflectingWakeSchedule: lat/long: "), String(latitude, 2), String(F(", ")) + String(longitude, 2));
+    getLogger()->logMessage(F("  Sun-step lead (deg): "), String(sunStepLead, 2));
+    getLogger()->logMessage(F("  Scheduled updates/day: "), String(updateCount));
+    getLogger()->logMessage(F("  Planned moves/day: "), String(panel.getPlannedMoveCount()),
+                            String(F(", travel (deg): ")) + String(panel.getPlannedTravel(0), 1) + String(F(", ")) + String(panel.getPlannedTravel(1), 1));
+    getLogger()->logMessage(F("  Max facing error (deg): "), String(maxFacingError, 4));
+    if (panel.isPlanningSunSteps() && !panel.getPlannedMoveCount()) {
+        getLogger()->logError(F("testReflectingWakeSchedule: "), F("Sun-steps not planned"));
+    }
+    if (maxFacingError > HELIO_PANEL_ALIGN_DEGTOL * 1.5f) {
+        getLogger()->logError(F("testReflectingWakeSchedule: "), F("Facing error exceeded alignment tolerance"));
+    }
+}
+
+void setup() {
+    // Setup base interfaces
+    #ifdef HELIO_ENABLE_DEBUG_OUTPUT
+        Serial.begin(115200);           // Begin USB Serial interface
+        while (!Serial) { ; }           // Wait for USB Serial to connect
+    #endif
+    #if defined(ESP_PLATFORM)
+        SETUP_I2C_WIRE.begin(SETUP_ESP_I2C_SDA, SETUP_ESP_I2C_SCL); // Begin i2c Wire for ESP
+    #endif
+
+    helioController.init();
+
+    getLogger()->logMessage(F("=BEGIN="));
+
+    testEphemerisCache(40.0, -105.0, 5);
+    testEphemerisCache(60.0, 25.0, 5);
+    testEphemerisCache(10.0, 80.0, 5);
+    testEphemerisCache(40.0, -105.0, 10);
+    testSunPositionService(40.0, -105.0);
+    testSunPositionService(10.0, 80.0);
+    testSunPositionLookahead(40.0, -105.0);
+    testBatchKernel();
+    testFloatPath(40.0, -105.0);
+    testFloatPath(-33.9, 18.4);
+    testWakeSchedule(40.0, -105.0, 0);
+    testWakeSchedule(40.0, -105.0, 1.0f);
+    testWakeSchedule(10.0, 80.0, 1.0f);
+    testReflectingWakeSchedule(40.0, -105.0, 1.0f);
+
+    getLogger()->logMessage(F("=FINISH="));
+}
+
+void loop()
+{ ; }